@@ -3,7 +3,7 @@ using namespace Simplex;
 void Application::InitVariables(void)
 {
 	//Set the position and target of the camera
-	m_pCameraMngr->SetPositionTargetAndUp(
+	m_pCamera->SetPositionTargetAndUp(
 		vector3(0.0f, 5.0f, 25.0f), //Position
 		vector3(0.0f, 0.0f, 0.0f),	//Target
 		AXIS_Y);					//Up
@@ -12,6 +12,7 @@ void Application::InitVariables(void)
 
 	m_pEntityMngr->AddEntity("Minecraft\\Steve.obj", "Steve");
 	m_pEntityMngr->UsePhysicsSolver();
+	m_pEntityMngr->UseConvexHull();
 	
 	for (int i = 0; i < 100; i++)
 	{
@@ -23,6 +24,58 @@ void Application::InitVariables(void)
 		m_pEntityMngr->UsePhysicsSolver();
 		//m_pEntityMngr->SetMass(i+1);
 	}
+
+	//the rest of the Minecraft set in front of the wall
+	String sModel[4] = { "Creeper", "Pig", "Cow", "Zombie" };
+	for (int i = 0; i < 4; i++)
+	{
+		m_pEntityMngr->AddEntity("Minecraft\\" + sModel[i] + ".obj", sModel[i]);
+		m_pEntityMngr->SetModelMatrix(glm::translate(vector3(i * 4.0f - 6.0f, 0.0f, -14.0f)));
+	}
+
+	//with every texture loaded they can go in the atlas, the static entities of different textures
+	//share their batches after this
+	MyTextureAtlas::GetInstance()->Build();
+	for (int i = 0; i < 4; i++)
+	{
+		m_pEntityMngr->SetStatic(true, sModel[i]);
+	}
+
+	//ground and wall in the back are blocks of the voxel world, a mesh per chunk instead of an entity per cube
+	MyVoxelWorld* pVoxelWorld = MyVoxelWorld::GetInstance();
+	MaterialManager* pMatMngr = MaterialManager::GetInstance();
+	uint8_t uGrass = pVoxelWorld->AddBlockType(pMatMngr->AddMaterial("VoxelGrass"), vector3(0.35f, 0.6f, 0.25f));
+	uint8_t uStone = pVoxelWorld->AddBlockType(pMatMngr->AddMaterial("VoxelStone"), vector3(0.55f, 0.55f, 0.55f));
+	pVoxelWorld->Fill(glm::ivec3(-64, -2, -64), glm::ivec3(63, -1, 63), uGrass);
+	pVoxelWorld->Fill(glm::ivec3(-12, 0, -16), glm::ivec3(11, 5, -16), uStone);
+
+	//small colored lights over the floor, each fragment only shades the ones of its cluster
+	MyLightClusters* pLightClusters = MyLightClusters::GetInstance();
+	for (int x = 0; x < 32; x++)
+	{
+		for (int z = 0; z < 32; z++)
+		{
+			vector3 v3Color = glm::abs(glm::sphericalRand(1.0f));
+			pLightClusters->AddLight(vector3(x * 1.5f - 24.0f, 0.5f, z * 1.5f - 24.0f), v3Color, 0.1f);
+		}
+	}
+
+	//fountain in front of the wall, its drops bounce on the ground and on the entities
+	MyParticleEmitter fountain;
+	fountain.m_v3Position = vector3(0.0f, 0.5f, -10.0f);
+	fountain.m_fRadius = 0.2f;
+	fountain.m_v3Velocity = vector3(0.0f, 9.0f, 0.0f);
+	fountain.m_fSpread = 3.0f;
+	fountain.m_fRate = 40000.0f;
+	fountain.m_fLife = 3.0f;
+	fountain.m_fLifeVariance = 0.25f;
+	fountain.m_fDrag = 0.2f;
+	fountain.m_v4ColorStart = vector4(0.6f, 0.8f, 1.0f, 1.0f);
+	fountain.m_v4ColorEnd = vector4(0.1f, 0.3f, 1.0f, 0.0f);
+	fountain.m_fSizeStart = 0.08f;
+	fountain.m_fSizeEnd = 0.15f;
+	fountain.m_bEntities = true;
+	MyParticleSystem::GetInstance()->AddEmitter(fountain);
 }
 void Application::Update(void)
 {
@@ -38,38 +91,123 @@ void Application::Update(void)
 	//Update Entity Manager
 	m_pEntityMngr->Update();
 
+	//Update the particles after the entities so they bounce on their new boxes
+	MyParticleSystem::GetInstance()->Update(MyTimeSystem::GetInstance()->GetFrameDelta());
+
 	//Set the model matrix for the main object
 	//m_pEntityMngr->SetModelMatrix(m_m4Steve, "Steve");
 
-	//Add objects to render list
+	//normal of the surface picked with the mouse
+	if (m_pickHit.m_nEntity >= 0)
+		MyDebugDraw::GetInstance()->AddLine(m_pickHit.m_v3Point, m_pickHit.m_v3Point + m_pickHit.m_v3Normal, C_YELLOW, true);
+
+	//Add objects to render list, culled against the camera of the simulation
+	m_pCamera->CalculateView();
+	m_pCamera->CalculateProjection();
+	MyRenderQueue::GetInstance()->SetViewProjection(m_pCamera->GetProjectionMatrix() * m_pCamera->GetViewMatrix());
 	m_pEntityMngr->AddEntityToRenderList(-1, true);
 	//m_pEntityMngr->AddEntityToRenderList(-1, true);
 }
-void Application::Display(void)
+void Application::WriteFrame(MyFrameSnapshot* a_pFrame)
+{
+	MyFrameSnapshot& frame = *a_pFrame;
+	frame.m_uWidth = m_pSystem->GetWindowWidth();
+	frame.m_uHeight = m_pSystem->GetWindowHeight();
+	frame.m_v4ClearColor = m_v4ClearColor;
+	frame.m_m4View = m_pCamera->GetViewMatrix();
+	frame.m_m4Projection = m_pCamera->GetProjectionMatrix();
+	frame.m_v3CameraPosition = m_pCamera->GetPosition();
+
+	//merge the command buffers of all threads into the snapshot
+	MyRenderQueue::GetInstance()->Flush(frame.m_commandList, frame.m_modelList);
+
+	//debug lines of this frame (only on debug builds)
+	MyDebugDraw::GetInstance()->Publish(frame.m_depthLineList, frame.m_overlayLineList);
+
+	//particles, only their position, size and color
+	MyParticleSystem::GetInstance()->Publish(frame.m_particleList);
+
+	//bin the point lights for the camera
+	MyLightClusters* pLightClusters = MyLightClusters::GetInstance();
+	pLightClusters->Bin(frame.m_m4View, frame.m_m4Projection);
+	pLightClusters->Publish(frame.m_light);
+
+	//text of this frame
+	PrintInfo();
+	MyText::GetInstance()->Publish(frame.m_text);
+
+	//input of the GUI, the wheel and the characters are only sent once
+	frame.m_gui = m_guiInput;
+	m_guiInput.m_fMouseWheel = 0.0f;
+	m_guiInput.m_uCharacterCount = 0;
+}
+Simplex::uint Application::Display(MyFrameSnapshot const& a_frame)
 {
+	//adjust the viewport when the window was resized
+	if (a_frame.m_uWidth != m_uViewportWidth || a_frame.m_uHeight != m_uViewportHeight)
+	{
+		m_uViewportWidth = a_frame.m_uWidth;
+		m_uViewportHeight = a_frame.m_uHeight;
+		glViewport(0, 0, m_uViewportWidth, m_uViewportHeight);
+		m_pMeshMngr->SetRenderTarget(0, 0, 0, m_uViewportWidth, m_uViewportHeight);
+	}
+
 	// Clear the screen
-	ClearScreen();
+	glClearColor(a_frame.m_v4ClearColor.r, a_frame.m_v4ClearColor.g, a_frame.m_v4ClearColor.b, a_frame.m_v4ClearColor.a);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	// draw a skybox
 	m_pMeshMngr->AddSkyboxToRenderList();
 
+	//the instances of the snapshot go into the render list
+	MyRenderQueue::GetInstance()->Submit(a_frame.m_commandList, a_frame.m_modelList);
+
+	//hand the light lists to the shader
+	MyLightClusters::GetInstance()->Upload(a_frame.m_light);
+
 	//render list call
-	m_uRenderCallCount = m_pMeshMngr->Render();
+	uint uRenderCallCount = m_pMeshMngr->Render();
 
 	//clear the render list
 	m_pMeshMngr->ClearRenderList();
 
-	//draw gui,
-	DrawGUI();
+	//particles are blended over the scene in one instanced call
+	MyParticleSystem::GetInstance()->Render(a_frame.m_particleList, a_frame.m_m4View, a_frame.m_m4Projection);
+
+	//draw the debug lines on top of the scene (only on debug builds)
+	MyDebugDraw::GetInstance()->Render(a_frame.m_depthLineList, a_frame.m_overlayLineList, a_frame.m_m4Projection * a_frame.m_m4View);
+
+	//draw gui, the render thread presents the frame after this
+	DrawGUI(a_frame);
 
-	//end the current frame (internally swaps the front and back buffers)
-	m_pWindow->display();
+	return uRenderCallCount;
 }
 void Application::Release(void)
 {
 	//Release MyEntityManager
 	MyEntityManager::ReleaseInstance();
 
+	//release the solver pool after the entities, their solvers return the slots on release
+	MySolverPool::ReleaseInstance();
+
+	//and the transform system, the entities return their nodes on release
+	MyTransformSystem::ReleaseInstance();
+
+	//and the archetype store, the entities destroy their records on release
+	MyArchetypeStore::ReleaseInstance();
+
+	//Release the render queue and the job system it uses
+	MyRenderQueue::ReleaseInstance();
+	MyLightClusters::ReleaseInstance();
+	MyTextureAtlas::ReleaseInstance();
+	MyDebugDraw::ReleaseInstance();
+	MyParticleSystem::ReleaseInstance();
+	MyText::ReleaseInstance();
+	MyJobSystem::ReleaseInstance();
+	MyVoxelWorld::ReleaseInstance();
+	MyRenderThread::ReleaseInstance();
+	MyTimeSystem::ReleaseInstance();
+
 	//release GUI
 	ShutdownGUI();
 }
\ No newline at end of file
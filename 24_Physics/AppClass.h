@@ -11,6 +11,8 @@ Date: 2017/06
 #include "imgui\ImGuiObject.h"
 
 #include "MyEntityManager.h"
+#include "MyText.h"
+#include "MyRenderThread.h"
 
 namespace Simplex
 {
@@ -27,7 +29,10 @@ private:
 	bool m_bGUI_Test = false; //show Test GUI window?
 	bool m_bGUI_Controller = false; //show Controller GUI window?
 
-	uint m_uRenderCallCount = 0; //count of render calls per frame
+	MyGUIInput m_guiInput; //input of the GUI gathered by the simulation, it goes to the render thread in the snapshot
+	std::atomic<bool> m_bGUIMouse; //was the mouse over the GUI in the last frame drawn?
+	uint m_uViewportWidth = 0; //size of the viewport the render thread last set
+	uint m_uViewportHeight = 0;
 	uint m_uControllerCount = 0; //count of controllers connected
 
 	bool m_bFocused = true; //is the window focused?
@@ -35,6 +40,7 @@ private:
 	float m_fMovementSpeed = 0.1f; //how fast the camera will move
 
 	vector3 m_v3Mouse = vector3(); //position of the mouse in the window
+	MyRayHit m_pickHit; //hit of the last click on the scene
 	bool m_bFPC = false;// First Person Camera flag
 	bool m_bArcBall = false;// ArcBall flag
 	quaternion m_qArcBall; //ArcBall quaternion
@@ -48,6 +54,7 @@ private:
 	LightManager* m_pLightMngr = nullptr; //Light Manager of the system
 	MeshManager* m_pMeshMngr = nullptr; //Mesh Manager
 	CameraManager* m_pCameraMngr = nullptr; //Singleton for the camera manager
+	Camera* m_pCamera = nullptr; //camera moved by the simulation, the render thread draws with a copy of it
 	
 	ControllerInput* m_pController[8]; //Controller
 	uint m_uActCont = 0; //Active Controller of the Application
@@ -143,11 +150,17 @@ private:
 	*/
 	void Update(void);
 	/*
-	USAGE: Displays the scene
-	ARGUMENTS: ---
+	USAGE: Writes the state of the scene into the snapshot the render thread draws next
+	ARGUMENTS: MyFrameSnapshot* a_pFrame -> snapshot to write
 	OUTPUT: ---
 	*/
-	void Display(void);
+	void WriteFrame(MyFrameSnapshot* a_pFrame);
+	/*
+	USAGE: Displays a snapshot of the scene, runs on the render thread
+	ARGUMENTS: MyFrameSnapshot const& a_frame -> snapshot to draw
+	OUTPUT: draw calls
+	*/
+	uint Display(MyFrameSnapshot const& a_frame);
 	/*
 	USAGE: Clears the OpenGL screen by the specified color
 	ARGUMENTS: vector4 a_v4ClearColor = vector4(-1.0f) -> Color to clear the screen with
@@ -194,6 +207,12 @@ private:
 	OUTPUT: ---
 	*/
 	void CameraRotation(float a_fSpeed = 0.005f);
+	/*
+	USAGE: Casts a ray from the camera through the mouse and keeps the entity hit
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void PickEntity(void);
 #pragma endregion
 
 #pragma region Process Events
@@ -273,11 +292,17 @@ private:
 	*/
 	void InitIMGUI(void);
 	/*
-	USAGE: Draw GUI elements
+	USAGE: Prints the information of the frame, runs on the simulation
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
-	void DrawGUI(void);
+	void PrintInfo(void);
+	/*
+	USAGE: Draw GUI elements, runs on the render thread
+	ARGUMENTS: MyFrameSnapshot const& a_frame -> snapshot being drawn
+	OUTPUT: ---
+	*/
+	void DrawGUI(MyFrameSnapshot const& a_frame);
 	/*
 	USAGE: //release gui
 	ARGUMENTS: ---
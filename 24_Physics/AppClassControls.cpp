@@ -10,7 +10,7 @@ void Application::ProcessMouseMovement(sf::Event a_event)
 	m_v3Mouse.y = static_cast<float>(mouse.y - window.y);
 	if (!m_pSystem->IsWindowFullscreen() && !m_pSystem->IsWindowBorderless())
 		m_v3Mouse += vector3(-8.0f, -32.0f, 0.0f);
-	gui.io.MousePos = ImVec2(m_v3Mouse.x, m_v3Mouse.y);
+	m_guiInput.m_v2Mouse = vector2(m_v3Mouse.x, m_v3Mouse.y);
 }
 void Application::ProcessMousePressed(sf::Event a_event)
 {
@@ -18,20 +18,20 @@ void Application::ProcessMousePressed(sf::Event a_event)
 	{
 	default: break;
 	case sf::Mouse::Button::Left:
-		gui.m_bMousePressed[0] = true;
+		m_guiInput.m_bMouseDown[0] = true;
+		//clicks on the gui windows (as of the last frame drawn) do not pick
+		if (!m_bGUIMouse)
+			PickEntity();
 		break;
 	case sf::Mouse::Button::Middle:
-		gui.m_bMousePressed[1] = true;
+		m_guiInput.m_bMouseDown[1] = true;
 		m_bArcBall = true;
 		break;
 	case sf::Mouse::Button::Right:
-		gui.m_bMousePressed[2] = true;
+		m_guiInput.m_bMouseDown[2] = true;
 		m_bFPC = true;
 		break;
 	}
-
-	for (int i = 0; i < 3; i++)
-		gui.io.MouseDown[i] = gui.m_bMousePressed[i];
 }
 void Application::ProcessMouseReleased(sf::Event a_event)
 {
@@ -39,31 +39,28 @@ void Application::ProcessMouseReleased(sf::Event a_event)
 	{
 	default: break;
 	case sf::Mouse::Button::Left:
-		gui.m_bMousePressed[0] = false;
+		m_guiInput.m_bMouseDown[0] = false;
 		break;
 	case sf::Mouse::Button::Middle:
-		gui.m_bMousePressed[1] = false;
+		m_guiInput.m_bMouseDown[1] = false;
 		m_bArcBall = false;
 		break;
 	case sf::Mouse::Button::Right:
-		gui.m_bMousePressed[2] = false;
+		m_guiInput.m_bMouseDown[2] = false;
 		m_bFPC = false;
 		break;
 	}
-
-	for (int i = 0; i < 3; i++)
-		gui.io.MouseDown[i] = gui.m_bMousePressed[i];
 }
 void Application::ProcessMouseScroll(sf::Event a_event)
 {
-	gui.io.MouseWheel = a_event.mouseWheelScroll.delta;
+	m_guiInput.m_fMouseWheel += a_event.mouseWheelScroll.delta;
 	float fSpeed = a_event.mouseWheelScroll.delta;
 	float fMultiplier = sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) ||
 		sf::Keyboard::isKeyPressed(sf::Keyboard::RShift);
 
 	if (fMultiplier)
 		fSpeed *= 2.0f;
-	m_pCameraMngr->MoveForward(-fSpeed);
+	m_pCamera->MoveForward(-fSpeed);
 }
 //Keyboard
 void Application::ProcessKeyPressed(sf::Event a_event)
@@ -82,9 +79,10 @@ void Application::ProcessKeyPressed(sf::Event a_event)
 	}
 
 	//gui
-	gui.io.KeysDown[a_event.key.code] = true;
-	gui.io.KeyCtrl = a_event.key.control;
-	gui.io.KeyShift = a_event.key.shift;
+	if (a_event.key.code >= 0 && a_event.key.code < 512)
+		m_guiInput.m_bKeyDown[a_event.key.code] = true;
+	m_guiInput.m_bControl = a_event.key.control;
+	m_guiInput.m_bShift = a_event.key.shift;
 }
 void Application::ProcessKeyReleased(sf::Event a_event)
 {
@@ -97,21 +95,35 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 		m_bRunning = false;
 		break;
 	case sf::Keyboard::F1:
-		m_pCameraMngr->SetCameraMode(CAM_PERSP);
+		m_pCamera->SetCameraMode(CAM_PERSP);
 		break;
 	case sf::Keyboard::F2:
-		m_pCameraMngr->SetCameraMode(CAM_ORTHO_Z);
+		m_pCamera->SetCameraMode(CAM_ORTHO_Z);
 		break;
 	case sf::Keyboard::F3:
-		m_pCameraMngr->SetCameraMode(CAM_ORTHO_Y);
+		m_pCamera->SetCameraMode(CAM_ORTHO_Y);
 		break;
 	case sf::Keyboard::F4:
-		m_pCameraMngr->SetCameraMode(CAM_ORTHO_X);
+		m_pCamera->SetCameraMode(CAM_ORTHO_X);
 		break;
 	case sf::Keyboard::F:
 		bFPSControl = !bFPSControl;
-		m_pCameraMngr->SetFPS(bFPSControl);
+		m_pCamera->SetFPS(bFPSControl);
+		break;
+	case sf::Keyboard::B:
+		//cycle through the broad phases
+		if (m_pEntityMngr->GetBroadPhaseType() == BROADPHASE_GRID)
+			m_pEntityMngr->SetBroadPhase(BROADPHASE_ALLPAIRS);
+		else
+			m_pEntityMngr->SetBroadPhase(static_cast<MY_BROADPHASE>(m_pEntityMngr->GetBroadPhaseType() + 1));
+		break;
+	case sf::Keyboard::O:
+	{
+		//toggle the occlusion culling of the render queue
+		MyOcclusionCuller* pCuller = MyRenderQueue::GetInstance()->GetOcclusionCuller();
+		pCuller->SetEnabled(!pCuller->IsEnabled());
 		break;
+	}
 	case sf::Keyboard::PageUp:
 		break;
 	case sf::Keyboard::PageDown:
@@ -126,9 +138,10 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 	}
 
 	//gui
-	gui.io.KeysDown[a_event.key.code] = false;
-	gui.io.KeyCtrl = a_event.key.control;
-	gui.io.KeyShift = a_event.key.shift;
+	if (a_event.key.code >= 0 && a_event.key.code < 512)
+		m_guiInput.m_bKeyDown[a_event.key.code] = false;
+	m_guiInput.m_bControl = a_event.key.control;
+	m_guiInput.m_bShift = a_event.key.shift;
 }
 //Joystick
 void Application::ProcessJoystickConnected(uint nController)
@@ -371,10 +384,23 @@ void Application::CameraRotation(float a_fSpeed)
 		fAngleX += fDeltaMouse * a_fSpeed;
 	}
 	//Change the Yaw and the Pitch of the camera
-	m_pCameraMngr->ChangeYaw(fAngleY * 3.0f);
-	m_pCameraMngr->ChangePitch(-fAngleX * 3.0f);
+	m_pCamera->ChangeYaw(fAngleY * 3.0f);
+	m_pCamera->ChangePitch(-fAngleX * 3.0f);
 	SetCursorPos(CenterX, CenterY);//Position the mouse in the center
 }
+void Application::PickEntity(void)
+{
+	//unproject the mouse on the near and far planes, window coordinates go down and OpenGL ones go up
+	float fWidth = static_cast<float>(m_pSystem->GetWindowWidth());
+	float fHeight = static_cast<float>(m_pSystem->GetWindowHeight());
+	vector4 v4Viewport = vector4(0.0f, 0.0f, fWidth, fHeight);
+	matrix4 m4View = m_pCamera->GetViewMatrix();
+	matrix4 m4Projection = m_pCamera->GetProjectionMatrix();
+	vector3 v3Near = glm::unProject(vector3(m_v3Mouse.x, fHeight - m_v3Mouse.y, 0.0f), m4View, m4Projection, v4Viewport);
+	vector3 v3Far = glm::unProject(vector3(m_v3Mouse.x, fHeight - m_v3Mouse.y, 1.0f), m4View, m4Projection, v4Viewport);
+
+	m_pEntityMngr->RayCast(v3Near, v3Far - v3Near, glm::length(v3Far - v3Near), m_pickHit);
+}
 //Keyboard
 void Application::ProcessKeyboard(void)
 {
@@ -394,26 +420,26 @@ void Application::ProcessKeyboard(void)
 
 #pragma region Camera Position
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::W))
-		m_pCameraMngr->MoveForward(m_fMovementSpeed * fMultiplier);
+		m_pCamera->MoveForward(m_fMovementSpeed * fMultiplier);
 
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::S))
-		m_pCameraMngr->MoveForward(-m_fMovementSpeed * fMultiplier);
+		m_pCamera->MoveForward(-m_fMovementSpeed * fMultiplier);
 
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::A))
-		m_pCameraMngr->MoveSideways(-m_fMovementSpeed * fMultiplier);
+		m_pCamera->MoveSideways(-m_fMovementSpeed * fMultiplier);
 
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::D))
-		m_pCameraMngr->MoveSideways(m_fMovementSpeed * fMultiplier);
+		m_pCamera->MoveSideways(m_fMovementSpeed * fMultiplier);
 
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Q))
-		m_pCameraMngr->MoveVertical(-m_fMovementSpeed * fMultiplier);
+		m_pCamera->MoveVertical(-m_fMovementSpeed * fMultiplier);
 
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::E))
-		m_pCameraMngr->MoveVertical(m_fMovementSpeed * fMultiplier);
+		m_pCamera->MoveVertical(m_fMovementSpeed * fMultiplier);
 #pragma endregion
 
 #pragma region Character Position
-	float fDelta = m_pSystem->GetDeltaTime(0);
+	float fDelta = MyTimeSystem::GetInstance()->GetFrameDelta();
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
 	{
 		m_pEntityMngr->ApplyForce(vector3(-2.0f * fDelta, 0.0f, 0.0f), "Steve");
@@ -460,14 +486,14 @@ void Application::ProcessJoystick(void)
 		fVerticalSpeed *= 3.0f;
 	}
 
-	m_pCameraMngr->MoveForward(fForwardSpeed);
-	m_pCameraMngr->MoveSideways(fHorizontalSpeed);
-	m_pCameraMngr->MoveVertical(fVerticalSpeed);
+	m_pCamera->MoveForward(fForwardSpeed);
+	m_pCamera->MoveSideways(fHorizontalSpeed);
+	m_pCamera->MoveVertical(fVerticalSpeed);
 #pragma endregion
 #pragma region Camera Orientation
 	//Change the Yaw and the Pitch of the camera
-	m_pCameraMngr->ChangeYaw(-m_pController[m_uActCont]->axis[SimplexAxis_U] / 150.0f);
-	m_pCameraMngr->ChangePitch(m_pController[m_uActCont]->axis[SimplexAxis_V] / 150.0f);
+	m_pCamera->ChangeYaw(-m_pController[m_uActCont]->axis[SimplexAxis_U] / 150.0f);
+	m_pCamera->ChangePitch(m_pController[m_uActCont]->axis[SimplexAxis_V] / 150.0f);
 #pragma endregion
 #pragma region ModelOrientation Orientation
 	m_qArcBall = quaternion(vector3(glm::radians(m_pController[m_uActCont]->axis[SimplexAxis_POVY] / 20.0f), 0.0f, 0.0f)) * m_qArcBall;
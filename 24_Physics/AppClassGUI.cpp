@@ -1,26 +1,155 @@
 #include "AppClass.h"
 using namespace Simplex;
 ImGuiObject Application::gui;
-void Application::DrawGUI(void)
+void Application::PrintInfo(void)
 {
-#pragma region Debugging Information
-	//Print info on the screen
+	//Print info on the screen, the render thread draws it with the snapshot
+	MyText* pText = MyText::GetInstance();
 	uint nEmptyLines = 20;
 	for (uint i = 0; i < nEmptyLines; ++i)
-		m_pMeshMngr->PrintLine("");//Add a line on top
-	//m_pMeshMngr->Print("						");
-	m_pMeshMngr->PrintLine(m_pSystem->GetAppName(), C_YELLOW);
-	//m_pMeshMngr->Print("						");
-
-	//m_pMeshMngr->Print("						");
-	m_pMeshMngr->Print("RenderCalls: ");//Add a line on top
-	m_pMeshMngr->PrintLine(std::to_string(m_uRenderCallCount), C_YELLOW);
-
-	//m_pMeshMngr->Print("						");
-	m_pMeshMngr->Print("FPS:");
-	m_pMeshMngr->PrintLine(std::to_string(m_pSystem->GetFPS()), C_RED);
+		pText->PrintLine("");//Add a line on top
+	pText->PrintLine(m_pSystem->GetAppName(), C_YELLOW);
+
+	uint uMicroseconds = 0;
+
+	//the render thread draws the snapshots published by the simulation, each side measures its own time
+	MyRenderThread* pRenderThread = MyRenderThread::GetInstance();
+	pText->Print("RenderCalls: ");//Add a line on top
+	pText->PrintLine(std::to_string(pRenderThread->GetDrawCount()), C_YELLOW);
+
+	uMicroseconds = static_cast<uint>(pRenderThread->GetSimulationTime() * 1000.0f);
+	pText->Print("Simulation: ");
+	pText->PrintLine(std::to_string(uMicroseconds) + " us", C_YELLOW);
+
+	uint uPresent = static_cast<uint>(pRenderThread->GetPresentTime() * 1000.0f);
+	uMicroseconds = static_cast<uint>(pRenderThread->GetRenderTime() * 1000.0f);
+	pText->Print("Render: ");
+	pText->PrintLine(std::to_string(uMicroseconds) + " us + " + std::to_string(uPresent) + " us present (" +
+		std::to_string(pRenderThread->GetDroppedCount()) + " snapshots dropped)", C_YELLOW);
+
+	pText->Print("Sleeping: ");
+	pText->PrintLine(std::to_string(m_pEntityMngr->GetAsleepCount()) + "/" + std::to_string(m_pEntityMngr->GetEntityCount()), C_YELLOW);
+
+	pText->Print("Broad phase: ");
+	pText->PrintLine(m_pEntityMngr->GetBroadPhase()->GetName(), C_YELLOW);
+
+	//timing of the broad phase so the different ones can be compared on the same scene
+	uMicroseconds = static_cast<uint>(m_pEntityMngr->GetBroadPhaseTime() * 1000.0f);
+	pText->Print("Pairs: ");
+	pText->PrintLine(std::to_string(m_pEntityMngr->GetPairCount()) + " in " + std::to_string(uMicroseconds) + " us", C_YELLOW);
+
+	//the solvers are integrated in batch, eight per instruction with AVX2
+	MySolverPool* pSolverPool = MySolverPool::GetInstance();
+	uMicroseconds = static_cast<uint>(m_pEntityMngr->GetIntegrationTime() * 1000.0f);
+	pText->Print("Integration: ");
+	pText->PrintLine(std::to_string(pSolverPool->GetActiveCount()) + " bodies in " + std::to_string(uMicroseconds) + " us" +
+		(pSolverPool->IsUsingAVX2() ? " (AVX2)" : " (SSE)"), C_YELLOW);
+
+	MySATCache* pSATCache = m_pEntityMngr->GetSATCache();
+	pText->Print("SAT first axis exits: ");
+	pText->PrintLine(std::to_string(pSATCache->GetFirstAxisCount()) + "/" + std::to_string(pSATCache->GetSeparatedCount()), C_YELLOW);
+
+	//iterations per pair stay low while the cached simplex is still close to the answer
+	pText->Print("GJK iterations: ");
+	pText->PrintLine(std::to_string(pSATCache->GetGJKIterationCount()) + "/" + std::to_string(pSATCache->GetGJKCount()) + " pairs", C_YELLOW);
+
+	pText->Print("Contacts (enter/stay/exit): ");
+	pText->PrintLine(std::to_string(m_pEntityMngr->GetCollisionEventList(COLLISION_ENTER).size()) + "/" +
+		std::to_string(m_pEntityMngr->GetCollisionEventList(COLLISION_STAY).size()) + "/" +
+		std::to_string(m_pEntityMngr->GetCollisionEventList(COLLISION_EXIT).size()), C_YELLOW);
+
+	//commands of the last frame hidden behind the occluders rasterized on the CPU
+	MyOcclusionCuller* pCuller = MyRenderQueue::GetInstance()->GetOcclusionCuller();
+	pText->Print("Occluded: ");
+	if (pCuller->IsEnabled())
+		pText->PrintLine(std::to_string(pCuller->GetOccludedCount()) + " by " + std::to_string(pCuller->GetOccluderCount()) + " occluders", C_YELLOW);
+	else
+		pText->PrintLine("off", C_YELLOW);
+
+	MyStaticBatcher* pStaticBatcher = m_pEntityMngr->GetStaticBatcher();
+	pText->Print("Static batches: ");
+	pText->PrintLine(std::to_string(pStaticBatcher->GetDrawnCount()) + "/" + std::to_string(pStaticBatcher->GetClusterCount()) +
+		" (" + std::to_string(pStaticBatcher->GetEntityCount()) + " entities)", C_YELLOW);
+
+	//components of the entities packed by archetype, and the waves the systems run in
+	MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+	MySystemScheduler* pRenderScheduler = m_pEntityMngr->GetRenderScheduler();
+	uMicroseconds = static_cast<uint>((m_pEntityMngr->GetUpdateScheduler()->GetTime() + pRenderScheduler->GetTime()) * 1000.0f);
+	pText->Print("Archetypes: ");
+	pText->PrintLine(std::to_string(pStore->GetEntityCount()) + " entities in " + std::to_string(pStore->GetArchetypeCount()) + " archetypes, " +
+		std::to_string(pStore->GetChunkCount()) + " chunks, systems " + std::to_string(uMicroseconds) + " us", C_YELLOW);
+
+	//chunks of the voxel world, their faces merged into quads
+	MyVoxelWorld* pVoxelWorld = MyVoxelWorld::GetInstance();
+	pText->Print("Voxels: ");
+	pText->PrintLine(std::to_string(pVoxelWorld->GetBlockCount()) + " blocks in " + std::to_string(pVoxelWorld->GetQuadCount()) + " quads, " +
+		std::to_string(pVoxelWorld->GetDrawnCount()) + "/" + std::to_string(pVoxelWorld->GetChunkCount()) + " chunks", C_YELLOW);
+
+	//particles of all the emitters, updated in batch like the solvers
+	MyParticleSystem* pParticleSystem = MyParticleSystem::GetInstance();
+	uMicroseconds = static_cast<uint>(pParticleSystem->GetUpdateTime() * 1000.0f);
+	pText->Print("Particles: ");
+	pText->PrintLine(std::to_string(pParticleSystem->GetParticleCount()) + " from " + std::to_string(pParticleSystem->GetEmitterCount()) +
+		" emitters in " + std::to_string(uMicroseconds) + " us" + (pParticleSystem->IsUsingAVX2() ? " (AVX2)" : " (SSE)"), C_YELLOW);
+
+	//textures sharing the atlas pages, the meshes using them can be drawn together
+	MyTextureAtlas* pAtlas = MyTextureAtlas::GetInstance();
+	pText->Print("Atlas: ");
+	pText->PrintLine(std::to_string(pAtlas->GetTextureCount()) + " textures in " + std::to_string(pAtlas->GetPageCount()) + " pages", C_YELLOW);
+
+	//point lights binned into the clusters of the view frustum this frame
+	MyLightClusters* pLightClusters = MyLightClusters::GetInstance();
+	uMicroseconds = static_cast<uint>(pLightClusters->GetBinTime() * 1000.0f);
+	pText->Print("Lights: ");
+	pText->PrintLine(std::to_string(pLightClusters->GetLightCount()) + " in " + std::to_string(pLightClusters->GetIndexList().size()) +
+		" cluster entries in " + std::to_string(uMicroseconds) + " us", C_YELLOW);
+
+	if (m_pEntityMngr->GetAnimatedCount() > 0)
+	{
+		uMicroseconds = static_cast<uint>(m_pEntityMngr->GetAnimationTime() * 1000.0f);
+		pText->Print("Animation: ");
+		MyPoseCache* pPoseCache = m_pEntityMngr->GetPoseCache();
+		pText->PrintLine(std::to_string(m_pEntityMngr->GetAnimatedCount()) + " poses (" + std::to_string(pPoseCache->GetPoseCount()) + " sampled, " +
+			std::to_string(static_cast<uint>(pPoseCache->GetHitRate() * 100.0f)) + "% hits) in " + std::to_string(uMicroseconds) + " us", C_YELLOW);
+	}
+
+	pText->Print("Picked: ");
+	pText->PrintLine(m_pickHit.m_nEntity < 0 ? "---" : m_pEntityMngr->GetUniqueID(m_pickHit.m_nEntity), C_YELLOW);
+
+	//frame times of the simulation over the last frames, the spikes show in the percentile and the maximum
+	MyFrameStats frameStats = MyTimeSystem::GetInstance()->GetFrameStats();
+	pText->Print("Frame (mean/p50/p99/max): ");
+	pText->PrintLine(std::to_string(static_cast<uint>(frameStats.m_fMean * 1000.0f)) + "/" + std::to_string(static_cast<uint>(frameStats.m_fMedian * 1000.0f)) + "/" +
+		std::to_string(static_cast<uint>(frameStats.m_fP99 * 1000.0f)) + "/" + std::to_string(static_cast<uint>(frameStats.m_fMax * 1000.0f)) + " us", C_YELLOW);
+
+	pText->Print("FPS:");
+	pText->PrintLine(std::to_string(frameStats.m_fMean > 0.0f ? static_cast<uint>(1000.0f / frameStats.m_fMean) : 0), C_RED);
+
+	float fFrameTime = pRenderThread->GetFrameTime();
+	pText->Print("Render FPS:");
+	pText->PrintLine(std::to_string(fFrameTime > 0.0f ? static_cast<uint>(1000.0f / fFrameTime) : 0), C_RED);
+}
+void Application::DrawGUI(MyFrameSnapshot const& a_frame)
+{
+#pragma region Debugging Information
+	//single draw call for all the lines, only the lines that change are encoded again
+	MyText::GetInstance()->Render(a_frame.m_text);
 #pragma endregion
 
+	//input gathered by the simulation for this snapshot
+	ImGuiIO& io = ImGui::GetIO();
+	MyGUIInput const& input = a_frame.m_gui;
+	io.MousePos = ImVec2(input.m_v2Mouse.x, input.m_v2Mouse.y);
+	for (uint i = 0; i < 3; ++i)
+		io.MouseDown[i] = input.m_bMouseDown[i];
+	io.MouseWheel = input.m_fMouseWheel;
+	for (uint i = 0; i < 512; ++i)
+		io.KeysDown[i] = input.m_bKeyDown[i];
+	io.KeyCtrl = input.m_bControl;
+	io.KeyShift = input.m_bShift;
+	for (uint i = 0; i < input.m_uCharacterCount && i < 16; ++i)
+		io.AddInputCharacter(input.m_character[i]);
+
 	//Calculate the window size to know how to draw
 	NewFrame();
 
@@ -47,6 +176,9 @@ void Application::DrawGUI(void)
 			ImGui::Text("	 F4: Orthographic Z\n");
 			ImGui::Separator();
 			ImGui::Text("Arrows: Apply force to Steve\n");
+			ImGui::Text("     B: Change broad phase\n");
+			ImGui::Text("     O: Toggle occlusion culling\n");
+			ImGui::Text(" Click: Pick an entity\n");
 		}
 		ImGui::End();
 	}
@@ -56,6 +188,9 @@ void Application::DrawGUI(void)
 
 	ImDrawData* pData = ImGui::GetDrawData();
 	RenderDrawLists(pData);
+
+	//the simulation does not pick through the GUI
+	m_bGUIMouse = io.WantCaptureMouse;
 }
 void Application::RenderDrawLists(ImDrawData* draw_data)
 {
@@ -263,8 +398,8 @@ void Application::NewFrame()
 	ImGuiIO& io = ImGui::GetIO();
 
 	// Setup display size (every frame to accommodate for window resizing)
-	float width = static_cast<float>(m_pSystem->GetWindowWidth());
-	float height = static_cast<float>(m_pSystem->GetWindowHeight());
+	float width = static_cast<float>(m_uViewportWidth);
+	float height = static_cast<float>(m_uViewportHeight);
 	io.DisplaySize = ImVec2(width, height);
 	GLint m_viewport[4];
 	glGetIntegerv(GL_VIEWPORT, m_viewport);
@@ -274,8 +409,10 @@ void Application::NewFrame()
 	ImVec2(	width > 0 ? ((float)m_viewport[2] / width) : 0,
 	height > 0 ? ((float)m_viewport[3] / height) : 0);
 	*/
-	// Setup time step
-	float fDelta = m_pSystem->GetDeltaTime(gui.m_nClock);
+	// Setup time step, measured by the render thread (the clocks of the system belong to the simulation)
+	float fDelta = MyRenderThread::GetInstance()->GetFrameTime() / 1000.0f;
+	if (fDelta <= 0.0f)
+		fDelta = 1.0f / 60.0f;
 	io.DeltaTime = fDelta;
 	gui.m_dTimeTotal += fDelta;
 
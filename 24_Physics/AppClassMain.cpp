@@ -77,12 +77,20 @@ void Application::Run(void)
 	//Initialize the system with default values it was not done in the Main.cpp
 	Init();
 
+	//the render thread takes the context and draws the snapshots, this thread simulates
+	//(the events of the window can only be polled by the thread that created it)
+	MyRenderThread* pRenderThread = MyRenderThread::GetInstance();
+	pRenderThread->Start(m_pWindow, [this](MyFrameSnapshot const& a_frame) { return Display(a_frame); });
+
 	// run the main loop
 	m_bRunning = true;
 	sf::Vector2i pos = m_pWindow->getPosition();
 	sf::Vector2u size = m_pWindow->getSize();
+	MyTimeSystem* pTimeSystem = MyTimeSystem::GetInstance();
 	while (m_bRunning)
 	{
+		MyFrameSnapshot* pFrame = pRenderThread->BeginFrame();
+
 		// handle events
 		sf::Event appEvent;
 		while (m_pWindow->pollEvent(appEvent))
@@ -128,8 +136,8 @@ void Application::Run(void)
 				ProcessKeyReleased(appEvent);
 				break;
 			case sf::Event::TextEntered:
-				if (appEvent.text.unicode > 0 && appEvent.text.unicode < 0x10000)
-					ImGui::GetIO().AddInputCharacter(appEvent.text.unicode);
+				if (appEvent.text.unicode > 0 && appEvent.text.unicode < 0x10000 && m_guiInput.m_uCharacterCount < 16)
+					m_guiInput.m_character[m_guiInput.m_uCharacterCount++] = static_cast<unsigned short>(appEvent.text.unicode);
 				break;
 			case sf::Event::JoystickButtonPressed:
 				ProcessJoystickPressed(appEvent);
@@ -157,8 +165,14 @@ void Application::Run(void)
 		ProcessKeyboard();//Continuous events
 		ProcessJoystick();//Continuous events
 		Update();
-		Display();
+		WriteFrame(pFrame);
+		pRenderThread->Publish();
+
+		//the render thread is paced by the vertical sync, the simulation waits for the start of its next frame
+		pTimeSystem->SetTargetRate(m_pSystem->GetMaxFrameRate());
+		pTimeSystem->Pace();
 	}
+	pRenderThread->Stop();
 
 	//Write configuration of this program
 	WriteConfig();
@@ -182,9 +196,7 @@ void Application::Reshape(void)
 	m_pSystem->SetWindowWidth(size.x);
 	m_pSystem->SetWindowHeight(size.y);
 
-	// adjust the viewport when the window is resized
-	glViewport(0, 0, size.x, size.y);
-	m_pMeshMngr->SetRenderTarget(0, 0, 0, size.x, size.y);
+	//the viewport is adjusted by the render thread when it draws a snapshot of the new size
 }
 void Application::Init(String a_sApplicationName, int a_uSize, bool a_bFullscreen, bool a_bBorderless)
 {
@@ -238,6 +250,10 @@ void Application::Init(String a_sApplicationName, uint a_uWidth, uint a_uHeight,
 		vector3(0.0f, 2.5f, 0.0f),//What I'm looking at
 		AXIS_Y);//What is up
 	
+	//the render thread adds its own camera, the simulation keeps moving this one
+	MyRenderThread::GetInstance();
+	m_pCamera = m_pCameraMngr->GetCamera();
+	
 	//Init Mesh Manager
 	m_pMeshMngr = MeshManager::GetInstance();
 
@@ -249,6 +265,7 @@ void Application::Init(String a_sApplicationName, uint a_uWidth, uint a_uHeight,
 	m_bGUI_Console = true;
 	m_bGUI_Controller = false;
 	m_bGUI_Test = false;
+	m_bGUIMouse = false;
 	InitIMGUI();
 
 	//Init controllers
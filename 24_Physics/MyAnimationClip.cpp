@@ -0,0 +1,381 @@
+#include "MyAnimationClip.h"
+#include <immintrin.h>
+using namespace Simplex;
+//largest value of the three smallest components of a unit quaternion
+static const float ROTATION_RANGE = 0.70710678f;
+static MyPackedRotation PackRotation(quaternion a_qRotation)
+{
+	float fValue[4] = { a_qRotation.x, a_qRotation.y, a_qRotation.z, a_qRotation.w };
+	uint uLargest = 0;
+	for (uint i = 1; i < 4; ++i)
+	{
+		if (glm::abs(fValue[i]) > glm::abs(fValue[uLargest]))
+			uLargest = i;
+	}
+	//q and -q are the same rotation, the largest is kept positive so its sign does not need to be stored
+	float fSign = fValue[uLargest] < 0.0f ? -1.0f : 1.0f;
+
+	MyPackedRotation packed;
+	for (uint i = 0, j = 0; i < 4; ++i)
+	{
+		if (i == uLargest)
+			continue;
+		float fFraction = glm::clamp(fValue[i] * fSign / ROTATION_RANGE * 0.5f + 0.5f, 0.0f, 1.0f);
+		packed.m_uData[j++] = static_cast<uint16_t>(fFraction * 32767.0f + 0.5f);
+	}
+	packed.m_uData[0] |= static_cast<uint16_t>((uLargest & 1) << 15);
+	packed.m_uData[1] |= static_cast<uint16_t>((uLargest >> 1) << 15);
+	return packed;
+}
+//writes x, y, z and w
+static void UnpackRotation(MyPackedRotation const& a_packed, float* a_pValue)
+{
+	uint uLargest = (a_packed.m_uData[0] >> 15) | ((a_packed.m_uData[1] >> 15) << 1);
+	float fSum = 0.0f;
+	for (uint i = 0, j = 0; i < 4; ++i)
+	{
+		if (i == uLargest)
+			continue;
+		float fFraction = (a_packed.m_uData[j++] & 0x7FFF) / 32767.0f;
+		a_pValue[i] = (fFraction * 2.0f - 1.0f) * ROTATION_RANGE;
+		fSum += a_pValue[i] * a_pValue[i];
+	}
+	a_pValue[uLargest] = glm::sqrt((glm::max)(1.0f - fSum, 0.0f));
+}
+static MyPackedVector PackVector(vector3 a_v3Value, MyAnimationChannel const& a_channel)
+{
+	MyPackedVector packed;
+	for (uint i = 0; i < 3; ++i)
+	{
+		float fFraction = a_channel.m_v3Extent[i] > 0.0f ? (a_v3Value[i] - a_channel.m_v3Min[i]) / a_channel.m_v3Extent[i] : 0.0f;
+		packed.m_uData[i] = static_cast<uint16_t>(glm::clamp(fFraction, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+	return packed;
+}
+static void UnpackVector(MyPackedVector const& a_packed, MyAnimationChannel const& a_channel, float* a_pValue)
+{
+	for (uint i = 0; i < 3; ++i)
+	{
+		a_pValue[i] = a_channel.m_v3Min[i] + a_channel.m_v3Extent[i] * (a_packed.m_uData[i] / 65535.0f);
+	}
+}
+static quaternion Nlerp(quaternion const& a_qA, quaternion const& a_qB, float a_fT)
+{
+	quaternion qB = glm::dot(a_qA, a_qB) < 0.0f ? -a_qB : a_qB;
+	return glm::normalize(a_qA * (1.0f - a_fT) + qB * a_fT);
+}
+//  MyAnimationClip
+MyAnimationClip::MyAnimationClip(float a_fPositionTolerance, float a_fRotationTolerance, float a_fScaleTolerance)
+{
+	m_fPositionTolerance = a_fPositionTolerance;
+	m_fRotationTolerance = a_fRotationTolerance;
+	m_fScaleTolerance = a_fScaleTolerance;
+}
+MyAnimationClip::MyAnimationClip(MyAnimationClip const& other) {}
+MyAnimationClip& MyAnimationClip::operator=(MyAnimationClip const& other) { return *this; }
+MyAnimationClip::~MyAnimationClip(void)
+{
+	m_trackList.clear();
+	m_rotationFrameList.clear();
+	m_rotationList.clear();
+	m_vectorFrameList.clear();
+	m_vectorList.clear();
+}
+uint MyAnimationClip::GetTrackCount(void) { return m_trackList.size(); }
+MyAnimationTrack* MyAnimationClip::GetTrack(uint a_uIndex) { return &m_trackList[a_uIndex]; }
+uint MyAnimationClip::GetFrameCount(void) { return m_uFrameCount; }
+uint MyAnimationClip::GetKeyCount(void) { return m_rotationList.size() + m_vectorList.size(); }
+uint MyAnimationClip::GetMemoryUsage(void)
+{
+	return m_trackList.size() * sizeof(MyAnimationTrack) +
+		m_rotationList.size() * (sizeof(MyPackedRotation) + sizeof(uint16_t)) +
+		m_vectorList.size() * (sizeof(MyPackedVector) + sizeof(uint16_t));
+}
+uint MyAnimationClip::GetBakedMemoryUsage(void) { return m_trackList.size() * m_uFrameCount * (sizeof(Frame) + sizeof(matrix4)); }
+int MyAnimationClip::GetTrackIndex(String a_sName)
+{
+	for (uint i = 0; i < m_trackList.size(); ++i)
+	{
+		if (m_trackList[i].m_sName == a_sName)
+			return i;
+	}
+	return -1;
+}
+void MyAnimationClip::CompressRotation(std::vector<quaternion> const& a_frameList, MyAnimationChannel& a_channel)
+{
+	//a key is kept when the frames since the last one cannot be interpolated to the next
+	std::vector<uint> keyList(1, 0);
+	uint uLast = 0;
+	for (uint uNext = 2; uNext < a_frameList.size(); ++uNext)
+	{
+		for (uint i = uLast + 1; i < uNext; ++i)
+		{
+			quaternion qSample = Nlerp(a_frameList[uLast], a_frameList[uNext], static_cast<float>(i - uLast) / (uNext - uLast));
+			float fAngle = 2.0f * glm::acos((glm::min)(glm::abs(glm::dot(qSample, a_frameList[i])), 1.0f));
+			if (fAngle > m_fRotationTolerance)
+			{
+				uLast = uNext - 1;
+				keyList.push_back(uLast);
+				break;
+			}
+		}
+	}
+	if (a_frameList.size() > 1)
+		keyList.push_back(a_frameList.size() - 1);
+
+	a_channel.m_uFirst = m_rotationList.size();
+	a_channel.m_uCount = keyList.size();
+	for (uint i = 0; i < keyList.size(); ++i)
+	{
+		m_rotationFrameList.push_back(static_cast<uint16_t>(keyList[i]));
+		m_rotationList.push_back(PackRotation(a_frameList[keyList[i]]));
+	}
+}
+void MyAnimationClip::CompressVector(std::vector<vector3> const& a_frameList, float a_fTolerance, MyAnimationChannel& a_channel)
+{
+	std::vector<uint> keyList(1, 0);
+	uint uLast = 0;
+	for (uint uNext = 2; uNext < a_frameList.size(); ++uNext)
+	{
+		for (uint i = uLast + 1; i < uNext; ++i)
+		{
+			vector3 v3Sample = glm::mix(a_frameList[uLast], a_frameList[uNext], static_cast<float>(i - uLast) / (uNext - uLast));
+			if (glm::distance(v3Sample, a_frameList[i]) > a_fTolerance)
+			{
+				uLast = uNext - 1;
+				keyList.push_back(uLast);
+				break;
+			}
+		}
+	}
+	if (a_frameList.size() > 1)
+		keyList.push_back(a_frameList.size() - 1);
+
+	//the range only needs to cover the keys
+	vector3 v3Min = a_frameList[0];
+	vector3 v3Max = a_frameList[0];
+	for (uint i = 1; i < keyList.size(); ++i)
+	{
+		v3Min = (glm::min)(v3Min, a_frameList[keyList[i]]);
+		v3Max = (glm::max)(v3Max, a_frameList[keyList[i]]);
+	}
+	a_channel.m_v3Min = v3Min;
+	a_channel.m_v3Extent = v3Max - v3Min;
+	a_channel.m_uFirst = m_vectorList.size();
+	a_channel.m_uCount = keyList.size();
+	for (uint i = 0; i < keyList.size(); ++i)
+	{
+		m_vectorFrameList.push_back(static_cast<uint16_t>(keyList[i]));
+		m_vectorList.push_back(PackVector(a_frameList[keyList[i]], a_channel));
+	}
+}
+int MyAnimationClip::AddTrack(String a_sName, int a_nParent, vector3 a_v3Pivot, std::vector<uint> const& a_meshList,
+	std::vector<vector3> const& a_translationList, std::vector<vector3> const& a_rotationList, std::vector<vector3> const& a_scaleList)
+{
+	//frames of the keys are stored in 16 bits
+	uint uFrameCount = a_translationList.size();
+	if (uFrameCount == 0 || uFrameCount > 65536 || a_rotationList.size() != uFrameCount || a_scaleList.size() != uFrameCount)
+		return -1;
+	if (a_nParent >= static_cast<int>(m_trackList.size()))
+		a_nParent = -1;
+
+	MyAnimationTrack track;
+	track.m_sName = a_sName;
+	track.m_nParent = a_nParent;
+	track.m_v3Pivot = a_v3Pivot;
+	track.m_meshList = a_meshList;
+
+	//consecutive rotations in the same hemisphere so the error of the interpolation is the real one
+	std::vector<quaternion> rotationList(uFrameCount);
+	for (uint i = 0; i < uFrameCount; ++i)
+	{
+		rotationList[i] = glm::normalize(quaternion(glm::radians(a_rotationList[i])));
+		if (i > 0 && glm::dot(rotationList[i - 1], rotationList[i]) < 0.0f)
+			rotationList[i] = -rotationList[i];
+	}
+	CompressVector(a_translationList, m_fPositionTolerance, track.m_translation);
+	CompressRotation(rotationList, track.m_rotation);
+	CompressVector(a_scaleList, m_fScaleTolerance, track.m_scale);
+
+	m_trackList.push_back(track);
+	if (uFrameCount > m_uFrameCount)
+		m_uFrameCount = uFrameCount;
+	return m_trackList.size() - 1;
+}
+int MyAnimationClip::AddGroup(Group* a_pGroup)
+{
+	if (a_pGroup == nullptr)
+		return -1;
+	int nTrack = GetTrackIndex(a_pGroup->GetName());
+	if (nTrack >= 0)
+		return nTrack;
+
+	//the parent goes first so the hierarchy is solved in a single pass
+	int nParent = AddGroup(a_pGroup->GetParent());
+
+	uint uFrameCount = a_pGroup->GetFrameCount();
+	std::vector<vector3> translationList(uFrameCount);
+	std::vector<vector3> rotationList(uFrameCount);
+	std::vector<vector3> scaleList(uFrameCount);
+	for (uint i = 0; i < uFrameCount; ++i)
+	{
+		Frame frame = a_pGroup->GetFrame(i);
+		translationList[i] = frame.GetPos();
+		rotationList[i] = frame.GetAng();
+		scaleList[i] = frame.GetSize();
+	}
+	return AddTrack(a_pGroup->GetName(), nParent, a_pGroup->GetPivot(), a_pGroup->GetMeshList(), translationList, rotationList, scaleList);
+}
+float MyAnimationClip::FindKey(uint16_t const* a_pFrame, uint a_uCount, float a_fFrame, uint& a_uKey)
+{
+	//first key after the frame
+	uint16_t const* pNext = std::upper_bound(a_pFrame, a_pFrame + a_uCount, a_fFrame,
+		[](float a_fValue, uint16_t a_uFrame) { return a_fValue < a_uFrame; });
+	if (pNext == a_pFrame)
+	{
+		a_uKey = 0;
+		return 0.0f;
+	}
+	if (pNext == a_pFrame + a_uCount)
+	{
+		a_uKey = a_uCount - 1;
+		return 0.0f;
+	}
+	a_uKey = static_cast<uint>(pNext - a_pFrame) - 1;
+	return (a_fFrame - a_pFrame[a_uKey]) / (a_pFrame[a_uKey + 1] - a_pFrame[a_uKey]);
+}
+void MyAnimationClip::Sample(float a_fFrame, matrix4* a_pPose)
+{
+	if (m_uFrameCount == 0)
+		return;
+	a_fFrame = glm::clamp(a_fFrame, 0.0f, static_cast<float>(m_uFrameCount - 1));
+
+	//four tracks at a time, the keys are decoded to lanes and interpolated together
+	alignas(16) float fRotationA[4][4]; //x, y, z, w of the key before the frame
+	alignas(16) float fRotationB[4][4]; //x, y, z, w of the key after the frame
+	alignas(16) float fRotationT[4];
+	alignas(16) float fTranslationA[3][4];
+	alignas(16) float fTranslationB[3][4];
+	alignas(16) float fTranslationT[4];
+	alignas(16) float fScaleA[3][4];
+	alignas(16) float fScaleB[3][4];
+	alignas(16) float fScaleT[4];
+	alignas(16) float fRotation[4][4]; //results
+	alignas(16) float fTranslation[3][4];
+	alignas(16) float fScale[3][4];
+
+	uint uTrackCount = m_trackList.size();
+	for (uint uFirst = 0; uFirst < uTrackCount; uFirst += 4)
+	{
+		for (uint uLane = 0; uLane < 4; ++uLane)
+		{
+			//lanes past the last track repeat it
+			MyAnimationTrack& track = m_trackList[(glm::min)(uFirst + uLane, uTrackCount - 1)];
+			float fA[4];
+			float fB[4];
+			uint uKey = 0;
+
+			MyAnimationChannel& rotation = track.m_rotation;
+			fRotationT[uLane] = FindKey(&m_rotationFrameList[rotation.m_uFirst], rotation.m_uCount, a_fFrame, uKey);
+			UnpackRotation(m_rotationList[rotation.m_uFirst + uKey], fA);
+			UnpackRotation(m_rotationList[rotation.m_uFirst + (glm::min)(uKey + 1, rotation.m_uCount - 1)], fB);
+			for (uint i = 0; i < 4; ++i)
+			{
+				fRotationA[i][uLane] = fA[i];
+				fRotationB[i][uLane] = fB[i];
+			}
+
+			MyAnimationChannel& translation = track.m_translation;
+			fTranslationT[uLane] = FindKey(&m_vectorFrameList[translation.m_uFirst], translation.m_uCount, a_fFrame, uKey);
+			UnpackVector(m_vectorList[translation.m_uFirst + uKey], translation, fA);
+			UnpackVector(m_vectorList[translation.m_uFirst + (glm::min)(uKey + 1, translation.m_uCount - 1)], translation, fB);
+			for (uint i = 0; i < 3; ++i)
+			{
+				fTranslationA[i][uLane] = fA[i];
+				fTranslationB[i][uLane] = fB[i];
+			}
+
+			MyAnimationChannel& scale = track.m_scale;
+			fScaleT[uLane] = FindKey(&m_vectorFrameList[scale.m_uFirst], scale.m_uCount, a_fFrame, uKey);
+			UnpackVector(m_vectorList[scale.m_uFirst + uKey], scale, fA);
+			UnpackVector(m_vectorList[scale.m_uFirst + (glm::min)(uKey + 1, scale.m_uCount - 1)], scale, fB);
+			for (uint i = 0; i < 3; ++i)
+			{
+				fScaleA[i][uLane] = fA[i];
+				fScaleB[i][uLane] = fB[i];
+			}
+		}
+
+		//nlerp, the second key is flipped to the hemisphere of the first so the shortest path is taken
+		__m128 t = _mm_load_ps(fRotationT);
+		__m128 a[4];
+		__m128 b[4];
+		__m128 dot = _mm_setzero_ps();
+		for (uint i = 0; i < 4; ++i)
+		{
+			a[i] = _mm_load_ps(fRotationA[i]);
+			b[i] = _mm_load_ps(fRotationB[i]);
+			dot = _mm_add_ps(dot, _mm_mul_ps(a[i], b[i]));
+		}
+		__m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+		__m128 length = _mm_setzero_ps();
+		for (uint i = 0; i < 4; ++i)
+		{
+			b[i] = _mm_xor_ps(b[i], flip);
+			a[i] = _mm_add_ps(a[i], _mm_mul_ps(_mm_sub_ps(b[i], a[i]), t));
+			length = _mm_add_ps(length, _mm_mul_ps(a[i], a[i]));
+		}
+		__m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(length));
+		for (uint i = 0; i < 4; ++i)
+		{
+			_mm_store_ps(fRotation[i], _mm_mul_ps(a[i], inverse));
+		}
+
+		//lerp of translation and scale
+		__m128 tt = _mm_load_ps(fTranslationT);
+		__m128 ts = _mm_load_ps(fScaleT);
+		for (uint i = 0; i < 3; ++i)
+		{
+			__m128 ta = _mm_load_ps(fTranslationA[i]);
+			_mm_store_ps(fTranslation[i], _mm_add_ps(ta, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(fTranslationB[i]), ta), tt)));
+			__m128 sa = _mm_load_ps(fScaleA[i]);
+			_mm_store_ps(fScale[i], _mm_add_ps(sa, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(fScaleB[i]), sa), ts)));
+		}
+
+		//local matrix around the pivot, parents are always solved first
+		for (uint uLane = 0; uLane < 4 && uFirst + uLane < uTrackCount; ++uLane)
+		{
+			MyAnimationTrack& track = m_trackList[uFirst + uLane];
+			quaternion qRotation = quaternion(fRotation[3][uLane], fRotation[0][uLane], fRotation[1][uLane], fRotation[2][uLane]);
+			vector3 v3Translation = vector3(fTranslation[0][uLane], fTranslation[1][uLane], fTranslation[2][uLane]);
+			vector3 v3Scale = vector3(fScale[0][uLane], fScale[1][uLane], fScale[2][uLane]);
+
+			//translate(t + pivot) * rotate * scale * translate(-pivot) without the matrix products
+			matrix3 m3RotationScale = glm::mat3_cast(qRotation);
+			m3RotationScale[0] *= v3Scale.x;
+			m3RotationScale[1] *= v3Scale.y;
+			m3RotationScale[2] *= v3Scale.z;
+			matrix4 m4Local = matrix4(m3RotationScale);
+			m4Local[3] = vector4(v3Translation + track.m_v3Pivot - m3RotationScale * track.m_v3Pivot, 1.0f);
+			if (track.m_nParent >= 0)
+				a_pPose[uFirst + uLane] = a_pPose[track.m_nParent] * m4Local;
+			else
+				a_pPose[uFirst + uLane] = m4Local;
+		}
+	}
+}
+void MyAnimationClip::SampleBatch(MyAnimationInstance** a_pInstance, uint a_uCount)
+{
+	MyJobSystem::GetInstance()->ParallelFor(a_uCount, 16, [a_pInstance](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			MyAnimationInstance* pInstance = a_pInstance[i];
+			if (pInstance->m_pClip == nullptr || pInstance->m_pClip->GetTrackCount() == 0)
+				continue;
+			pInstance->m_poseList.resize(pInstance->m_pClip->GetTrackCount());
+			pInstance->m_pClip->Sample(pInstance->m_fFrame, pInstance->m_poseList.data());
+			pInstance->m_pPose = pInstance->m_poseList.data();
+		}
+	});
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYANIMATIONCLIP_H_
+#define __MYANIMATIONCLIP_H_
+
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+class MyAnimationClip;
+
+//Rotation stored as its three smallest components (15 bits each), the top bits of the first two hold
+//the index of the largest one which is rebuilt from the unit length
+struct MyPackedRotation
+{
+	uint16_t m_uData[3];
+};
+
+//Vector stored as 16 bit fractions of the range of its channel
+struct MyPackedVector
+{
+	uint16_t m_uData[3];
+};
+
+//Keys of one channel of a track, they live in the arrays of the clip
+struct MyAnimationChannel
+{
+	uint m_uFirst = 0; //first key in the arrays of the clip
+	uint m_uCount = 0; //keys of the channel, the first and last frames are always keys
+	vector3 m_v3Min = ZERO_V3; //range the packed vectors are fractions of (translation and scale only)
+	vector3 m_v3Extent = ZERO_V3;
+};
+
+//Animated node, one per group of the model
+struct MyAnimationTrack
+{
+	String m_sName = ""; //name of the group
+	int m_nParent = -1; //track of the parent, always before this one, -1 if none
+	vector3 m_v3Pivot = ZERO_V3; //point the track rotates and scales around
+	std::vector<uint> m_meshList; //meshes of the group in the MeshManager
+	MyAnimationChannel m_translation; //keys of each channel
+	MyAnimationChannel m_rotation;
+	MyAnimationChannel m_scale;
+};
+
+//Clip played by one instance, the poses are sampled on demand at its fractional frame
+struct MyAnimationInstance
+{
+	MyAnimationClip* m_pClip = nullptr; //clip played, nullptr if none
+	float m_fFrame = 0.0f; //current frame, fractional
+	float m_fFramesPerSecond = 24.0f; //speed of the playback
+	std::vector<matrix4> m_poseList; //model matrix of each track, for the instances sampled on their own
+	matrix4 const* m_pPose = nullptr; //pose at the current frame, one matrix per track (own or shared by a MyPoseCache)
+};
+
+//Animation stored as compressed keyframe curves: quantized rotations and vectors, keys that can be
+//interpolated from their neighbors within a tolerance are dropped. Poses are sampled on demand four
+//tracks at a time with SSE instead of being baked for every frame
+class MyAnimationClip
+{
+	uint m_uFrameCount = 0; //frames of the longest track
+	float m_fPositionTolerance = 0.001f; //largest error of a dropped translation key
+	float m_fRotationTolerance = 0.001f; //largest error of a dropped rotation key (radians)
+	float m_fScaleTolerance = 0.001f; //largest error of a dropped scale key
+
+	std::vector<MyAnimationTrack> m_trackList; //tracks, parents before children
+	std::vector<uint16_t> m_rotationFrameList; //frame of each rotation key
+	std::vector<MyPackedRotation> m_rotationList; //value of each rotation key
+	std::vector<uint16_t> m_vectorFrameList; //frame of each translation and scale key
+	std::vector<MyPackedVector> m_vectorList; //value of each translation and scale key
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS:
+	-	float a_fPositionTolerance = 0.001f -> largest error of a dropped translation key
+	-	float a_fRotationTolerance = 0.001f -> largest error of a dropped rotation key in radians
+	-	float a_fScaleTolerance = 0.001f -> largest error of a dropped scale key
+	OUTPUT: class object instance
+	*/
+	MyAnimationClip(float a_fPositionTolerance = 0.001f, float a_fRotationTolerance = 0.001f, float a_fScaleTolerance = 0.001f);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyAnimationClip(void);
+	/*
+	USAGE: Compresses the frames of a track
+	ARGUMENTS:
+	-	String a_sName -> name of the track
+	-	int a_nParent -> track of the parent (added before), -1 if none
+	-	vector3 a_v3Pivot -> point the track rotates and scales around
+	-	std::vector<uint> const& a_meshList -> meshes drawn with the track
+	-	std::vector<vector3> const& a_translationList -> translation of each frame
+	-	std::vector<vector3> const& a_rotationList -> euler angles of each frame in degrees (as in Frame)
+	-	std::vector<vector3> const& a_scaleList -> scale of each frame
+	OUTPUT: track index, -1 if the lists do not have the same size
+	*/
+	int AddTrack(String a_sName, int a_nParent, vector3 a_v3Pivot, std::vector<uint> const& a_meshList,
+		std::vector<vector3> const& a_translationList, std::vector<vector3> const& a_rotationList, std::vector<vector3> const& a_scaleList);
+	/*
+	USAGE: Compresses the frames of a group of a model, adding its parents first
+	ARGUMENTS: Group* a_pGroup -> group to add
+	OUTPUT: track index, -1 if the group is nullptr
+	*/
+	int AddGroup(Group* a_pGroup);
+	/*
+	USAGE: Gets the index of a track by name
+	ARGUMENTS: String a_sName -> name of the track
+	OUTPUT: track index, -1 if not found
+	*/
+	int GetTrackIndex(String a_sName);
+	/*
+	USAGE: Gets a track
+	ARGUMENTS: uint a_uIndex -> track index
+	OUTPUT: track
+	*/
+	MyAnimationTrack* GetTrack(uint a_uIndex);
+	/*
+	USAGE: Gets the number of tracks
+	ARGUMENTS: ---
+	OUTPUT: track count
+	*/
+	uint GetTrackCount(void);
+	/*
+	USAGE: Gets the number of frames of the clip
+	ARGUMENTS: ---
+	OUTPUT: frame count
+	*/
+	uint GetFrameCount(void);
+	/*
+	USAGE: Gets the number of keys kept by all the channels
+	ARGUMENTS: ---
+	OUTPUT: key count
+	*/
+	uint GetKeyCount(void);
+	/*
+	USAGE: Gets the bytes used by the keys and tracks
+	ARGUMENTS: ---
+	OUTPUT: bytes
+	*/
+	uint GetMemoryUsage(void);
+	/*
+	USAGE: Gets the bytes the same animation takes baked as one Frame and one matrix per frame and group
+	ARGUMENTS: ---
+	OUTPUT: bytes
+	*/
+	uint GetBakedMemoryUsage(void);
+	/*
+	USAGE: Samples the model matrix of every track at a fractional frame
+	ARGUMENTS:
+	-	float a_fFrame -> frame to sample, clamped to the clip
+	-	matrix4* a_pPose -> output, one matrix per track
+	OUTPUT: ---
+	*/
+	void Sample(float a_fFrame, matrix4* a_pPose);
+	/*
+	USAGE: Samples the poses of many instances in parallel
+	ARGUMENTS:
+	-	MyAnimationInstance** a_pInstance -> instances to sample, the ones without clip are skipped
+	-	uint a_uCount -> number of instances
+	OUTPUT: ---
+	*/
+	static void SampleBatch(MyAnimationInstance** a_pInstance, uint a_uCount);
+private:
+	/*
+	USAGE: copy constructor, clips are shared by pointer
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyAnimationClip(MyAnimationClip const& other);
+	/*
+	USAGE: copy assignment operator, clips are shared by pointer
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyAnimationClip& operator=(MyAnimationClip const& other);
+	/*
+	USAGE: Keeps the keys of a rotation channel that cannot be interpolated from their neighbors
+	ARGUMENTS:
+	-	std::vector<quaternion> const& a_frameList -> rotation of each frame
+	-	MyAnimationChannel& a_channel -> output
+	OUTPUT: ---
+	*/
+	void CompressRotation(std::vector<quaternion> const& a_frameList, MyAnimationChannel& a_channel);
+	/*
+	USAGE: Keeps the keys of a vector channel that cannot be interpolated from their neighbors
+	ARGUMENTS:
+	-	std::vector<vector3> const& a_frameList -> value of each frame
+	-	float a_fTolerance -> largest error of a dropped key
+	-	MyAnimationChannel& a_channel -> output
+	OUTPUT: ---
+	*/
+	void CompressVector(std::vector<vector3> const& a_frameList, float a_fTolerance, MyAnimationChannel& a_channel);
+	/*
+	USAGE: Finds the keys around a frame
+	ARGUMENTS:
+	-	uint16_t const* a_pFrame -> frames of the keys of the channel
+	-	uint a_uCount -> keys of the channel
+	-	float a_fFrame -> frame to sample
+	-	uint& a_uKey -> output, key before the frame
+	OUTPUT: fraction of the way to the next key
+	*/
+	static float FindKey(uint16_t const* a_pFrame, uint a_uCount, float a_fFrame, uint& a_uKey);
+};
+
+} //namespace Simplex
+
+#endif //__MYANIMATIONCLIP_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "MyArchetypeStore.h"
+using namespace Simplex;
+//helpers
+//bytes of each component by index, the tags have no data
+static uint GetComponentSize(uint a_uIndex)
+{
+	switch (a_uIndex)
+	{
+	case MyTransformComponent::m_uIndex: return sizeof(MyTransformComponent);
+	case MyBoundsComponent::m_uIndex: return sizeof(MyBoundsComponent);
+	case MySolverComponent::m_uIndex: return sizeof(MySolverComponent);
+	case MyRenderMeshComponent::m_uIndex: return sizeof(MyRenderMeshComponent);
+	case MyDimensionsComponent::m_uIndex: return sizeof(MyDimensionsComponent);
+	default: return 0;
+	}
+}
+//writes the default value of a component
+static void Construct(uint a_uIndex, void* a_pComponent)
+{
+	switch (a_uIndex)
+	{
+	case MyTransformComponent::m_uIndex: new (a_pComponent) MyTransformComponent(); break;
+	case MyBoundsComponent::m_uIndex: new (a_pComponent) MyBoundsComponent(); break;
+	case MySolverComponent::m_uIndex: new (a_pComponent) MySolverComponent(); break;
+	case MyRenderMeshComponent::m_uIndex: new (a_pComponent) MyRenderMeshComponent(); break;
+	case MyDimensionsComponent::m_uIndex: new (a_pComponent) MyDimensionsComponent(); break;
+	default: break;
+	}
+}
+//the records of a chunk go after its entity pointers
+static uint* GetRecordArray(MyArchetypeChunk* a_pChunk)
+{
+	return reinterpret_cast<uint*>(a_pChunk->m_pData + sizeof(MyEntity*) * a_pChunk->m_uCapacity);
+}
+//  MyArchetypeStore
+Simplex::MyArchetypeStore* Simplex::MyArchetypeStore::m_pInstance = nullptr;
+void Simplex::MyArchetypeStore::Init(void)
+{
+	m_uEntityCount = 0;
+}
+void Simplex::MyArchetypeStore::Release(void)
+{
+	for (uint i = 0; i < m_archetypeList.size(); ++i)
+	{
+		MyArchetype* pArchetype = m_archetypeList[i];
+		for (uint j = 0; j < pArchetype->m_chunkList.size(); ++j)
+		{
+			delete[] pArchetype->m_chunkList[j]->m_pData;
+			SafeDelete(pArchetype->m_chunkList[j]);
+		}
+		SafeDelete(pArchetype);
+	}
+	m_archetypeList.clear();
+	m_archetypeMap.clear();
+	m_recordList.clear();
+	m_freeList.clear();
+	m_uEntityCount = 0;
+}
+Simplex::MyArchetypeStore* Simplex::MyArchetypeStore::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyArchetypeStore();
+	}
+	return m_pInstance;
+}
+void Simplex::MyArchetypeStore::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyArchetypeStore::MyArchetypeStore() { Init(); }
+Simplex::MyArchetypeStore::MyArchetypeStore(MyArchetypeStore const& other) { }
+Simplex::MyArchetypeStore& Simplex::MyArchetypeStore::operator=(MyArchetypeStore const& other) { return *this; }
+Simplex::MyArchetypeStore::~MyArchetypeStore() { Release(); }
+//Accessors
+Simplex::uint Simplex::MyArchetypeStore::GetEntityCount(void) { return m_uEntityCount; }
+Simplex::uint Simplex::MyArchetypeStore::GetArchetypeCount(void)
+{
+	uint uCount = 0;
+	for (uint i = 0; i < m_archetypeList.size(); ++i)
+	{
+		if (m_archetypeList[i]->m_chunkList[0]->m_uCount > 0)
+			++uCount;
+	}
+	return uCount;
+}
+Simplex::uint Simplex::MyArchetypeStore::GetChunkCount(void)
+{
+	uint uCount = 0;
+	for (uint i = 0; i < m_archetypeList.size(); ++i)
+	{
+		std::vector<MyArchetypeChunk*>& chunkList = m_archetypeList[i]->m_chunkList;
+		for (uint j = 0; j < chunkList.size(); ++j)
+		{
+			if (chunkList[j]->m_uCount > 0)
+				++uCount;
+		}
+	}
+	return uCount;
+}
+void Simplex::MyArchetypeStore::SetEntity(uint a_uRecord, MyEntity* a_pEntity)
+{
+	MyRecord& record = m_recordList[a_uRecord];
+	record.m_pEntity = a_pEntity;
+	m_archetypeList[record.m_uArchetype]->m_chunkList[record.m_uChunk]->GetEntityArray()[record.m_uRow] = a_pEntity;
+}
+Simplex::uint Simplex::MyArchetypeStore::GetMask(uint a_uRecord) { return m_archetypeList[m_recordList[a_uRecord].m_uArchetype]->m_uMask; }
+bool Simplex::MyArchetypeStore::HasComponents(uint a_uRecord, uint a_uMask) { return (GetMask(a_uRecord) & a_uMask) == a_uMask; }
+//Entities
+Simplex::uint Simplex::MyArchetypeStore::Create(MyEntity* a_pEntity, uint a_uMask)
+{
+	uint uRecord;
+	if (m_freeList.size() > 0)
+	{
+		uRecord = m_freeList.back();
+		m_freeList.pop_back();
+	}
+	else
+	{
+		uRecord = m_recordList.size();
+		m_recordList.push_back(MyRecord());
+	}
+	m_recordList[uRecord].m_pEntity = a_pEntity;
+
+	uint uArchetype = GetArchetype(a_uMask);
+	PushRow(uArchetype, uRecord);
+	MyRecord const& record = m_recordList[uRecord];
+	MyArchetypeChunk* pChunk = m_archetypeList[uArchetype]->m_chunkList[record.m_uChunk];
+	for (uint i = 0; i < m_uComponentCount; ++i)
+	{
+		uint uSize = GetComponentSize(i);
+		if ((a_uMask & (1 << i)) != 0 && uSize > 0)
+			Construct(i, pChunk->m_pData + pChunk->m_pOffset[i] + uSize * record.m_uRow);
+	}
+	++m_uEntityCount;
+	return uRecord;
+}
+void Simplex::MyArchetypeStore::Destroy(uint a_uRecord)
+{
+	MyRecord& record = m_recordList[a_uRecord];
+	if (record.m_pEntity == nullptr)
+		return;
+	RemoveRow(record.m_uArchetype, record.m_uChunk, record.m_uRow);
+	record.m_pEntity = nullptr;
+	m_freeList.push_back(a_uRecord);
+	--m_uEntityCount;
+}
+void Simplex::MyArchetypeStore::AddComponents(uint a_uRecord, uint a_uMask) { Move(a_uRecord, GetMask(a_uRecord) | a_uMask); }
+void Simplex::MyArchetypeStore::RemoveComponents(uint a_uRecord, uint a_uMask) { Move(a_uRecord, GetMask(a_uRecord) & ~a_uMask); }
+void Simplex::MyArchetypeStore::Query(uint a_uRequire, uint a_uExclude, std::vector<MyArchetypeChunk*>& a_chunkList)
+{
+	a_chunkList.clear();
+	for (uint i = 0; i < m_archetypeList.size(); ++i)
+	{
+		MyArchetype* pArchetype = m_archetypeList[i];
+		if ((pArchetype->m_uMask & a_uRequire) != a_uRequire || (pArchetype->m_uMask & a_uExclude) != 0)
+			continue;
+		for (uint j = 0; j < pArchetype->m_chunkList.size(); ++j)
+		{
+			if (pArchetype->m_chunkList[j]->m_uCount > 0)
+				a_chunkList.push_back(pArchetype->m_chunkList[j]);
+		}
+	}
+}
+//Chunks
+Simplex::uint Simplex::MyArchetypeStore::GetArchetype(uint a_uMask)
+{
+	auto archetype = m_archetypeMap.find(a_uMask);
+	if (archetype != m_archetypeMap.end())
+		return archetype->second;
+
+	//the entity pointers and the records go first, then the array of each component
+	uint uRowSize = sizeof(MyEntity*) + sizeof(uint);
+	for (uint i = 0; i < m_uComponentCount; ++i)
+	{
+		if ((a_uMask & (1 << i)) != 0)
+			uRowSize += GetComponentSize(i);
+	}
+	//every array starts on 16 bytes, the padding comes out of the chunk
+	MyArchetype* pArchetype = new MyArchetype();
+	pArchetype->m_uMask = a_uMask;
+	pArchetype->m_uCapacity = (m_uChunkSize - 16 * (m_uComponentCount + 1)) / uRowSize;
+	uint uOffset = (uint)((sizeof(MyEntity*) + sizeof(uint)) * pArchetype->m_uCapacity);
+	for (uint i = 0; i < m_uComponentCount; ++i)
+	{
+		pArchetype->m_uOffset[i] = 0;
+		uint uSize = GetComponentSize(i);
+		if ((a_uMask & (1 << i)) == 0 || uSize == 0)
+			continue;
+		uOffset = (uOffset + 15) & ~15u;
+		pArchetype->m_uOffset[i] = uOffset;
+		uOffset += uSize * pArchetype->m_uCapacity;
+	}
+
+	//an archetype always has a chunk, even when it runs out of entities
+	MyArchetypeChunk* pChunk = new MyArchetypeChunk();
+	pChunk->m_uMask = a_uMask;
+	pChunk->m_uCapacity = pArchetype->m_uCapacity;
+	pChunk->m_pOffset = pArchetype->m_uOffset;
+	pChunk->m_pData = new uint8_t[m_uChunkSize];
+	pArchetype->m_chunkList.push_back(pChunk);
+
+	m_archetypeList.push_back(pArchetype);
+	m_archetypeMap[a_uMask] = m_archetypeList.size() - 1;
+	return m_archetypeList.size() - 1;
+}
+void Simplex::MyArchetypeStore::PushRow(uint a_uArchetype, uint a_uRecord)
+{
+	MyArchetype* pArchetype = m_archetypeList[a_uArchetype];
+	MyArchetypeChunk* pChunk = pArchetype->m_chunkList.back();
+	if (pChunk->m_uCount == pChunk->m_uCapacity)
+	{
+		pChunk = new MyArchetypeChunk();
+		pChunk->m_uMask = pArchetype->m_uMask;
+		pChunk->m_uCapacity = pArchetype->m_uCapacity;
+		pChunk->m_pOffset = pArchetype->m_uOffset;
+		pChunk->m_pData = new uint8_t[m_uChunkSize];
+		pArchetype->m_chunkList.push_back(pChunk);
+	}
+
+	uint uRow = pChunk->m_uCount++;
+	MyRecord& record = m_recordList[a_uRecord];
+	pChunk->GetEntityArray()[uRow] = record.m_pEntity;
+	GetRecordArray(pChunk)[uRow] = a_uRecord;
+	record.m_uArchetype = a_uArchetype;
+	record.m_uChunk = pArchetype->m_chunkList.size() - 1;
+	record.m_uRow = uRow;
+}
+void Simplex::MyArchetypeStore::RemoveRow(uint a_uArchetype, uint a_uChunk, uint a_uRow)
+{
+	MyArchetype* pArchetype = m_archetypeList[a_uArchetype];
+	MyArchetypeChunk* pChunk = pArchetype->m_chunkList[a_uChunk];
+	MyArchetypeChunk* pLast = pArchetype->m_chunkList.back();
+	uint uLastRow = pLast->m_uCount - 1;
+
+	//the last row of the archetype fills the hole so only the last chunk has room
+	if (pChunk != pLast || a_uRow != uLastRow)
+	{
+		uint uMoved = GetRecordArray(pLast)[uLastRow];
+		pChunk->GetEntityArray()[a_uRow] = pLast->GetEntityArray()[uLastRow];
+		GetRecordArray(pChunk)[a_uRow] = uMoved;
+		for (uint i = 0; i < m_uComponentCount; ++i)
+		{
+			uint uSize = GetComponentSize(i);
+			if ((pArchetype->m_uMask & (1 << i)) == 0 || uSize == 0)
+				continue;
+			memcpy(pChunk->m_pData + pChunk->m_pOffset[i] + uSize * a_uRow, pLast->m_pData + pLast->m_pOffset[i] + uSize * uLastRow, uSize);
+		}
+		m_recordList[uMoved].m_uChunk = a_uChunk;
+		m_recordList[uMoved].m_uRow = a_uRow;
+	}
+
+	--pLast->m_uCount;
+	if (pLast->m_uCount == 0 && pArchetype->m_chunkList.size() > 1)
+	{
+		delete[] pLast->m_pData;
+		SafeDelete(pLast);
+		pArchetype->m_chunkList.pop_back();
+	}
+}
+void Simplex::MyArchetypeStore::Move(uint a_uRecord, uint a_uMask)
+{
+	MyRecord& record = m_recordList[a_uRecord];
+	if (record.m_pEntity == nullptr)
+		return;
+	uint uOldMask = GetMask(a_uRecord);
+	if (uOldMask == a_uMask)
+		return;
+
+	uint uOldArchetype = record.m_uArchetype;
+	uint uOldChunk = record.m_uChunk;
+	uint uOldRow = record.m_uRow;
+	uint uArchetype = GetArchetype(a_uMask);
+	PushRow(uArchetype, a_uRecord);
+
+	//the components both archetypes have are copied, the new ones start with their default
+	MyArchetypeChunk* pOld = m_archetypeList[uOldArchetype]->m_chunkList[uOldChunk];
+	MyArchetypeChunk* pNew = m_archetypeList[uArchetype]->m_chunkList[record.m_uChunk];
+	for (uint i = 0; i < m_uComponentCount; ++i)
+	{
+		uint uSize = GetComponentSize(i);
+		if ((a_uMask & (1 << i)) == 0 || uSize == 0)
+			continue;
+		uint8_t* pComponent = pNew->m_pData + pNew->m_pOffset[i] + uSize * record.m_uRow;
+		if ((uOldMask & (1 << i)) != 0)
+			memcpy(pComponent, pOld->m_pData + pOld->m_pOffset[i] + uSize * uOldRow, uSize);
+		else
+			Construct(i, pComponent);
+	}
+
+	RemoveRow(uOldArchetype, uOldChunk, uOldRow);
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYARCHETYPESTORE_H_
+#define __MYARCHETYPESTORE_H_
+
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+class MyEntity;
+class MySolver;
+
+//Components an entity can have, an archetype is a combination of them
+enum MY_COMPONENT
+{
+	COMPONENT_TRANSFORM = 1 << 0, //MyTransformComponent
+	COMPONENT_BOUNDS = 1 << 1, //MyBoundsComponent
+	COMPONENT_SOLVER = 1 << 2, //MySolverComponent
+	COMPONENT_RENDERMESH = 1 << 3, //MyRenderMeshComponent
+	COMPONENT_DIMENSIONS = 1 << 4, //MyDimensionsComponent
+	COMPONENT_STATIC = 1 << 5, //tag without data, drawn by a static batch
+	COMPONENT_ANIMATED = 1 << 6, //tag without data, plays an animation clip
+};
+
+//Model to world matrix of an entity
+struct MyTransformComponent
+{
+	static const uint m_uIndex = 0; //bit of the component in the masks
+	matrix4 m_m4ToWorld = IDENTITY_M4; //model matrix of the entity
+};
+
+//Boxes of the rigid body of an entity, the global one follows the transform
+struct MyBoundsComponent
+{
+	static const uint m_uIndex = 1;
+	vector3 m_v3Min = ZERO_V3; //minimum of the ARBB in global space
+	vector3 m_v3Max = ZERO_V3; //maximum of the ARBB in global space
+	vector3 m_v3CenterLocal = ZERO_V3; //center of the OBB in local space
+	vector3 m_v3HalfWidth = ZERO_V3; //half the size of the OBB
+};
+
+//Solver of an entity simulated by the solver pool, only the entities using physics have it
+struct MySolverComponent
+{
+	static const uint m_uIndex = 2;
+	MySolver* m_pSolver = nullptr; //solver of the entity, its state lives in the pool
+};
+
+//Meshes drawn at the transform of an entity, only the entities that know their meshes have it
+struct MyRenderMeshComponent
+{
+	static const uint m_uIndex = 3;
+	uint const* m_pMesh = nullptr; //indices of the meshes in the MeshManager
+	uint m_uMeshCount = 0; //meshes in the array
+};
+
+//Spatial dimensions an entity is in, sorted; entities that never had a dimension do not have it, the
+//others keep it while the octree broad phase clears and assigns their leaves after each rebuild
+struct MyDimensionsComponent
+{
+	static const uint m_uIndex = 4;
+	uint* m_pDimension = nullptr; //dimensions of the entity (the entity owns the array)
+	uint m_uCount = 0; //dimensions in the array
+};
+
+//Block of memory holding the entities of one archetype, each component in its own packed array
+struct MyArchetypeChunk
+{
+	uint m_uMask = 0; //components of the archetype
+	uint m_uCount = 0; //entities in the chunk
+	uint m_uCapacity = 0; //entities that fit in the chunk
+	uint const* m_pOffset = nullptr; //offset of the array of each component, by index
+	uint8_t* m_pData = nullptr; //entity pointers, records and component arrays
+
+	/*
+	USAGE: Gets the entities of the chunk
+	ARGUMENTS: ---
+	OUTPUT: array of m_uCount entities
+	*/
+	MyEntity** GetEntityArray(void) { return reinterpret_cast<MyEntity**>(m_pData); }
+	/*
+	USAGE: Gets the array of a component of the entities of the chunk
+	ARGUMENTS: ---
+	OUTPUT: array of m_uCount components, nullptr if the archetype does not have it
+	*/
+	template <class T> T* GetArray(void)
+	{
+		if ((m_uMask & (1 << T::m_uIndex)) == 0)
+			return nullptr;
+		return reinterpret_cast<T*>(m_pData + m_pOffset[T::m_uIndex]);
+	}
+};
+
+//System Class, the components of the entities packed by archetype (the combination of components
+//they have) in chunks of 16 KB, so a query only walks the chunks of the archetypes it needs and finds
+//the data of the component it reads one after the other; the entities are found by record
+class MyArchetypeStore
+{
+	static const uint m_uChunkSize = 16384; //bytes of each chunk
+	static const uint m_uComponentCount = 7; //bits of the masks
+
+	//combination of components and the chunks of its entities, only the last chunk has room
+	struct MyArchetype
+	{
+		uint m_uMask = 0; //components of the archetype
+		uint m_uCapacity = 0; //entities per chunk
+		uint m_uOffset[m_uComponentCount]; //offset of the array of each component in a chunk
+		std::vector<MyArchetypeChunk*> m_chunkList; //chunks of the archetype
+	};
+
+	//where the components of an entity are
+	struct MyRecord
+	{
+		MyEntity* m_pEntity = nullptr; //entity of the record, nullptr for the free ones
+		uint m_uArchetype = 0; //archetype of the entity
+		uint m_uChunk = 0; //chunk of the archetype
+		uint m_uRow = 0; //row of the chunk
+	};
+
+	std::vector<MyArchetype*> m_archetypeList; //all the archetypes, the empty ones keep their chunk
+	std::map<uint, uint> m_archetypeMap; //index of each archetype by its mask
+	std::vector<MyRecord> m_recordList; //location of each entity
+	std::vector<uint> m_freeList; //records returned to the store
+	uint m_uEntityCount = 0; //records in use
+
+	static MyArchetypeStore* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyArchetypeStore* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds an entity with the default value of each of its components
+	ARGUMENTS:
+	-	MyEntity* a_pEntity -> entity the components belong to
+	-	uint a_uMask -> components of the entity (MY_COMPONENT bits)
+	OUTPUT: record of the entity
+	*/
+	uint Create(MyEntity* a_pEntity, uint a_uMask);
+	/*
+	USAGE: Removes an entity and its components, the record can be handed out again
+	ARGUMENTS: uint a_uRecord -> record of the entity
+	OUTPUT: ---
+	*/
+	void Destroy(uint a_uRecord);
+	/*
+	USAGE: Changes the entity of a record, for entities that swap their content
+	ARGUMENTS:
+	-	uint a_uRecord -> record of the entity
+	-	MyEntity* a_pEntity -> entity the components belong to now
+	OUTPUT: ---
+	*/
+	void SetEntity(uint a_uRecord, MyEntity* a_pEntity);
+	/*
+	USAGE: Gets the components of an entity
+	ARGUMENTS: uint a_uRecord -> record of the entity
+	OUTPUT: mask of MY_COMPONENT bits
+	*/
+	uint GetMask(uint a_uRecord);
+	/*
+	USAGE: Asks if an entity has all the components of a mask
+	ARGUMENTS:
+	-	uint a_uRecord -> record of the entity
+	-	uint a_uMask -> components to look for
+	OUTPUT: does it have them?
+	*/
+	bool HasComponents(uint a_uRecord, uint a_uMask);
+	/*
+	USAGE: Adds components to an entity, moving it to the chunks of its new archetype; the added ones start
+	with their default value and the pointers to its old components are no longer valid
+	ARGUMENTS:
+	-	uint a_uRecord -> record of the entity
+	-	uint a_uMask -> components to add (the ones it has already keep their value)
+	OUTPUT: ---
+	*/
+	void AddComponents(uint a_uRecord, uint a_uMask);
+	/*
+	USAGE: Removes components from an entity, moving it to the chunks of its new archetype
+	ARGUMENTS:
+	-	uint a_uRecord -> record of the entity
+	-	uint a_uMask -> components to remove
+	OUTPUT: ---
+	*/
+	void RemoveComponents(uint a_uRecord, uint a_uMask);
+	/*
+	USAGE: Gets a component of an entity, valid until an entity is created, destroyed or changes its components
+	ARGUMENTS: uint a_uRecord -> record of the entity
+	OUTPUT: component, nullptr if the entity does not have it
+	*/
+	template <class T> T* Get(uint a_uRecord)
+	{
+		MyRecord const& record = m_recordList[a_uRecord];
+		MyArchetypeChunk* pChunk = m_archetypeList[record.m_uArchetype]->m_chunkList[record.m_uChunk];
+		T* pArray = pChunk->GetArray<T>();
+		return pArray == nullptr ? nullptr : pArray + record.m_uRow;
+	}
+	/*
+	USAGE: Gets the chunks of the archetypes with all the components required and none of the excluded
+	ARGUMENTS:
+	-	uint a_uRequire -> components the entities need to have
+	-	uint a_uExclude -> components the entities cannot have
+	-	std::vector<MyArchetypeChunk*>& a_chunkList -> list to fill (will be cleared first), empty chunks are not added
+	OUTPUT: ---
+	*/
+	void Query(uint a_uRequire, uint a_uExclude, std::vector<MyArchetypeChunk*>& a_chunkList);
+	/*
+	USAGE: Gets the number of entities in the store
+	ARGUMENTS: ---
+	OUTPUT: entity count
+	*/
+	uint GetEntityCount(void);
+	/*
+	USAGE: Gets the number of archetypes with entities
+	ARGUMENTS: ---
+	OUTPUT: archetype count
+	*/
+	uint GetArchetypeCount(void);
+	/*
+	USAGE: Gets the number of chunks with entities
+	ARGUMENTS: ---
+	OUTPUT: chunk count
+	*/
+	uint GetChunkCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyArchetypeStore(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyArchetypeStore(MyArchetypeStore const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyArchetypeStore& operator=(MyArchetypeStore const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyArchetypeStore(void);
+	/*
+	Usage: releases the archetypes and their chunks
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Gets the archetype of a mask, creating it if it does not exist
+	ARGUMENTS: uint a_uMask -> components of the archetype
+	OUTPUT: index of the archetype
+	*/
+	uint GetArchetype(uint a_uMask);
+	/*
+	USAGE: Adds a row at the end of the last chunk of an archetype (in a new chunk if it is full)
+	ARGUMENTS:
+	-	uint a_uArchetype -> index of the archetype
+	-	uint a_uRecord -> record the row belongs to
+	OUTPUT: ---
+	*/
+	void PushRow(uint a_uArchetype, uint a_uRecord);
+	/*
+	USAGE: Removes a row moving the last row of its archetype into it, the last chunk is freed when it runs
+	out of rows (unless it is the only one)
+	ARGUMENTS:
+	-	uint a_uArchetype -> index of the archetype
+	-	uint a_uChunk -> chunk of the row
+	-	uint a_uRow -> row to remove
+	OUTPUT: ---
+	*/
+	void RemoveRow(uint a_uArchetype, uint a_uChunk, uint a_uRow);
+	/*
+	USAGE: Moves an entity to the archetype of a mask copying the components both have
+	ARGUMENTS:
+	-	uint a_uRecord -> record of the entity
+	-	uint a_uMask -> components of the new archetype
+	OUTPUT: ---
+	*/
+	void Move(uint a_uRecord, uint a_uMask);
+};
+
+} //namespace Simplex
+
+#endif //__MYARCHETYPESTORE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "MyBroadPhase.h"
+using namespace Simplex;
+//  MyBroadPhase
+bool Simplex::MyBroadPhase::IntersectRayAABB(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance,
+	vector3 a_v3Min, vector3 a_v3Max, float& a_fEnter, float& a_fExit)
+{
+	//the ray is inside all three slabs between enter and exit
+	a_fEnter = 0.0f;
+	a_fExit = a_fMaxDistance;
+	for (uint uAxis = 0; uAxis < 3; ++uAxis)
+	{
+		float fOrigin = a_v3Origin[uAxis];
+		float fDirection = a_v3Direction[uAxis];
+		if (fDirection == 0.0f)
+		{
+			//parallel to the slab, it needs to start inside of it
+			if (fOrigin < a_v3Min[uAxis] || fOrigin > a_v3Max[uAxis])
+				return false;
+			continue;
+		}
+		float fT1 = (a_v3Min[uAxis] - fOrigin) / fDirection;
+		float fT2 = (a_v3Max[uAxis] - fOrigin) / fDirection;
+		if (fT1 > fT2)
+			std::swap(fT1, fT2);
+		if (fT1 > a_fEnter)
+			a_fEnter = fT1;
+		if (fT2 < a_fExit)
+			a_fExit = fT2;
+		if (a_fEnter > a_fExit)
+			return false;
+	}
+	return true;
+}
+//  MyAllPairsBroadPhase
+void Simplex::MyAllPairsBroadPhase::Update(PEntity* a_pEntityArray, uint a_uEntityCount)
+{
+	m_pEntityArray = a_pEntityArray;
+	m_uEntityCount = a_uEntityCount;
+}
+void Simplex::MyAllPairsBroadPhase::GetPairs(std::vector<MyBroadPhasePair>& a_pairList)
+{
+	a_pairList.clear();
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		bool bAsleep = m_pEntityArray[i]->IsAsleep();
+		for (uint j = i + 1; j < m_uEntityCount; j++)
+		{
+			//two sleeping entities cannot change each other
+			if (bAsleep && m_pEntityArray[j]->IsAsleep())
+				continue;
+
+			MyBroadPhasePair pair;
+			pair.m_uA = i;
+			pair.m_uB = j;
+			a_pairList.push_back(pair);
+		}
+	}
+}
+Simplex::String Simplex::MyAllPairsBroadPhase::GetName(void) { return "All Pairs"; }
+void Simplex::MyAllPairsBroadPhase::QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		MyRigidBody* pRigidBody = m_pEntityArray[i]->GetRigidBody();
+		vector3 v3Min = pRigidBody->GetMinGlobal();
+		vector3 v3Max = pRigidBody->GetMaxGlobal();
+		if (v3Max.x < a_v3Min.x || v3Min.x > a_v3Max.x ||
+			v3Max.y < a_v3Min.y || v3Min.y > a_v3Max.y ||
+			v3Max.z < a_v3Min.z || v3Min.z > a_v3Max.z)
+			continue;
+		a_entityList.push_back(i);
+	}
+}
+void Simplex::MyAllPairsBroadPhase::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+	std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	vector3 v3Radius = vector3(a_fRadius);
+	float fEnter, fExit;
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		MyRigidBody* pRigidBody = m_pEntityArray[i]->GetRigidBody();
+		if (IntersectRayAABB(a_v3Origin, a_v3Direction, a_fMaxDistance,
+			pRigidBody->GetMinGlobal() - v3Radius, pRigidBody->GetMaxGlobal() + v3Radius, fEnter, fExit))
+			a_entityList.push_back(i);
+	}
+}
\ No newline at end of file
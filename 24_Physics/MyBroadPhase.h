@@ -0,0 +1,157 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYBROADPHASE_H_
+#define __MYBROADPHASE_H_
+
+#include "MyEntity.h"
+
+namespace Simplex
+{
+
+//Broad phase algorithms the entity manager can use
+enum MY_BROADPHASE
+{
+	BROADPHASE_ALLPAIRS = 0,
+	BROADPHASE_TREE,
+	BROADPHASE_OCTREE,
+	BROADPHASE_GRID,
+};
+
+//Pair of entities (by index in the entity list) that might be colliding, m_uA < m_uB
+struct MyBroadPhasePair
+{
+	uint m_uA; //index of the first entity
+	uint m_uB; //index of the second entity
+};
+
+//Interface of the broad phases
+class MyBroadPhase
+{
+public:
+	typedef MyEntity* PEntity; //MyEntity Pointer
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	virtual ~MyBroadPhase(void) {}
+	/*
+	USAGE: Refreshes the structure with the current state of the entities
+	ARGUMENTS:
+	-	PEntity* a_pEntityArray -> list of entities
+	-	uint a_uEntityCount -> number of entities in the list
+	OUTPUT: ---
+	*/
+	virtual void Update(PEntity* a_pEntityArray, uint a_uEntityCount) = 0;
+	/*
+	USAGE: Gets the pairs of entities that might be colliding, pairs of two sleeping entities are not reported
+	ARGUMENTS: std::vector<MyBroadPhasePair>& a_pairList -> list to fill (will be cleared first)
+	OUTPUT: ---
+	*/
+	virtual void GetPairs(std::vector<MyBroadPhasePair>& a_pairList) = 0;
+	/*
+	USAGE: Gets the name of the broad phase
+	ARGUMENTS: ---
+	OUTPUT: name
+	*/
+	virtual String GetName(void) = 0;
+	/*
+	USAGE: Gets the entities whose bounding box overlaps an AABB, each one once; the structure is not
+	changed so several threads can query at the same time
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	virtual void QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList) = 0;
+	/*
+	USAGE: Gets the entities whose bounding box, grown by a radius, is hit by a ray, each one once; the
+	structure is not changed so several threads can query at the same time
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> direction of the ray (does not need to be normalized)
+	-	float a_fMaxDistance -> length of the ray in units of the direction
+	-	float a_fRadius -> how much the boxes grow, 0 for a ray and the radius of the sphere for a sweep
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	virtual void RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+		std::vector<uint>& a_entityList) = 0;
+protected:
+	/*
+	USAGE: Slab test of a ray against an AABB
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> direction of the ray
+	-	float a_fMaxDistance -> length of the ray in units of the direction
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	float& a_fEnter -> distance at which the ray enters the box (0 if it starts inside)
+	-	float& a_fExit -> distance at which the ray leaves the box (or the length of the ray)
+	OUTPUT: does the ray hit the box?
+	*/
+	static bool IntersectRayAABB(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance,
+		vector3 a_v3Min, vector3 a_v3Max, float& a_fEnter, float& a_fExit);
+};
+
+//Tests every entity against every other one
+class MyAllPairsBroadPhase : public MyBroadPhase
+{
+	PEntity* m_pEntityArray = nullptr; //list of entities of the last update
+	uint m_uEntityCount = 0; //number of entities of the last update
+public:
+	/*
+	USAGE: Refreshes the structure with the current state of the entities
+	ARGUMENTS:
+	-	PEntity* a_pEntityArray -> list of entities
+	-	uint a_uEntityCount -> number of entities in the list
+	OUTPUT: ---
+	*/
+	void Update(PEntity* a_pEntityArray, uint a_uEntityCount) override;
+	/*
+	USAGE: Gets every pair of entities where at least one is awake
+	ARGUMENTS: std::vector<MyBroadPhasePair>& a_pairList -> list to fill (will be cleared first)
+	OUTPUT: ---
+	*/
+	void GetPairs(std::vector<MyBroadPhasePair>& a_pairList) override;
+	/*
+	USAGE: Gets the name of the broad phase
+	ARGUMENTS: ---
+	OUTPUT: name
+	*/
+	String GetName(void) override;
+	/*
+	USAGE: Gets the entities whose ARBB overlaps an AABB, testing all of them
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList) override;
+	/*
+	USAGE: Gets the entities whose ARBB, grown by a radius, is hit by a ray, testing all of them
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> direction of the ray (does not need to be normalized)
+	-	float a_fMaxDistance -> length of the ray in units of the direction
+	-	float a_fRadius -> how much the boxes grow
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+		std::vector<uint>& a_entityList) override;
+};
+
+} //namespace Simplex
+
+#endif //__MYBROADPHASE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
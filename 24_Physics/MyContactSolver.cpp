@@ -0,0 +1,310 @@
+#include "MyContactSolver.h"
+#include <xmmintrin.h>
+using namespace Simplex;
+//puts the entries of a list in the given order
+template <class T>
+static void Reorder(std::vector<T>& a_list, std::vector<uint> const& a_order)
+{
+	std::vector<T> temp(a_order.size());
+	for (uint i = 0; i < a_order.size(); ++i)
+		temp[i] = a_list[a_order[i]];
+	a_list.swap(temp);
+}
+//  MyContactSolver
+Simplex::MyContactSolver::MyContactSolver(void) { }
+Simplex::MyContactSolver::MyContactSolver(MyContactSolver const& other) { }
+Simplex::MyContactSolver& Simplex::MyContactSolver::operator=(MyContactSolver const& other) { return *this; }
+Simplex::MyContactSolver::~MyContactSolver(void) { }
+//Accessors
+void Simplex::MyContactSolver::SetIterationCount(uint a_uIterations) { m_uIterations = a_uIterations; }
+Simplex::uint Simplex::MyContactSolver::GetIterationCount(void) { return m_uIterations; }
+void Simplex::MyContactSolver::SetCorrection(float a_fBaumgarte, float a_fSlop)
+{
+	m_fBaumgarte = a_fBaumgarte;
+	m_fSlop = a_fSlop;
+}
+Simplex::uint Simplex::MyContactSolver::GetRowCount(void) { return static_cast<uint>(m_rowA.size()); }
+Simplex::uint Simplex::MyContactSolver::GetGroupRowCount(void) { return m_uGroupRowCount; }
+//Rows
+void Simplex::MyContactSolver::AddRow(uint a_uBodyA, uint a_uBodyB, vector3 a_v3Normal, float a_fDepth, float* a_pCache)
+{
+	float fInverseMass = m_inverseMass[a_uBodyA] + m_inverseMass[a_uBodyB];
+	if (fInverseMass <= 0.0f)
+		return;
+
+	//penetrations are pushed out a bit each update, gaps let the bodies close them and no more
+	float fBias = 0.0f;
+	if (a_fDepth > m_fSlop)
+		fBias = m_fBaumgarte * (a_fDepth - m_fSlop);
+	else if (a_fDepth < 0.0f)
+		fBias = a_fDepth;
+
+	m_rowA.push_back(a_uBodyA);
+	m_rowB.push_back(a_uBodyB);
+	m_normalX.push_back(a_v3Normal.x);
+	m_normalY.push_back(a_v3Normal.y);
+	m_normalZ.push_back(a_v3Normal.z);
+	m_bias.push_back(fBias);
+	m_normalMass.push_back(1.0f / fInverseMass);
+	m_impulse.push_back(*a_pCache);
+	m_cacheList.push_back(a_pCache);
+}
+void Simplex::MyContactSolver::GroupRows(void)
+{
+	//a few groups are filled at the same time, the rows that do not fit any go to the end
+	const uint uMaxOpen = 8;
+	uint uOpenRow[uMaxOpen][4];
+	uint uOpenCount[uMaxOpen];
+	uint uOpen = 0;
+
+	uint uRowCount = static_cast<uint>(m_rowA.size());
+	std::vector<uint> order;
+	std::vector<uint> leftoverList;
+	order.reserve(uRowCount);
+	for (uint uRow = 0; uRow < uRowCount; ++uRow)
+	{
+		uint uBodyA = m_rowA[uRow];
+		uint uBodyB = m_rowB[uRow];
+		bool bPlaced = false;
+		for (uint uGroup = 0; uGroup < uOpen && !bPlaced; ++uGroup)
+		{
+			//the static body is never written so it can be in all the lanes
+			bool bFits = true;
+			for (uint uLane = 0; uLane < uOpenCount[uGroup] && bFits; ++uLane)
+			{
+				uint uOtherA = m_rowA[uOpenRow[uGroup][uLane]];
+				uint uOtherB = m_rowB[uOpenRow[uGroup][uLane]];
+				bFits = (uBodyA == 0 || (uBodyA != uOtherA && uBodyA != uOtherB)) &&
+					(uBodyB == 0 || (uBodyB != uOtherA && uBodyB != uOtherB));
+			}
+			if (!bFits)
+				continue;
+
+			uOpenRow[uGroup][uOpenCount[uGroup]++] = uRow;
+			bPlaced = true;
+			if (uOpenCount[uGroup] == 4)
+			{
+				order.insert(order.end(), uOpenRow[uGroup], uOpenRow[uGroup] + 4);
+				--uOpen;
+				uOpenCount[uGroup] = uOpenCount[uOpen];
+				for (uint uLane = 0; uLane < uOpenCount[uGroup]; ++uLane)
+					uOpenRow[uGroup][uLane] = uOpenRow[uOpen][uLane];
+			}
+		}
+		if (bPlaced)
+			continue;
+
+		if (uOpen < uMaxOpen)
+		{
+			uOpenRow[uOpen][0] = uRow;
+			uOpenCount[uOpen] = 1;
+			++uOpen;
+		}
+		else
+			leftoverList.push_back(uRow);
+	}
+	m_uGroupRowCount = static_cast<uint>(order.size());
+	for (uint uGroup = 0; uGroup < uOpen; ++uGroup)
+		leftoverList.insert(leftoverList.end(), uOpenRow[uGroup], uOpenRow[uGroup] + uOpenCount[uGroup]);
+	order.insert(order.end(), leftoverList.begin(), leftoverList.end());
+
+	Reorder(m_rowA, order);
+	Reorder(m_rowB, order);
+	Reorder(m_normalX, order);
+	Reorder(m_normalY, order);
+	Reorder(m_normalZ, order);
+	Reorder(m_bias, order);
+	Reorder(m_normalMass, order);
+	Reorder(m_impulse, order);
+	Reorder(m_cacheList, order);
+}
+void Simplex::MyContactSolver::ApplyImpulse(uint a_uRow, float a_fImpulse)
+{
+	uint uBodyA = m_rowA[a_uRow];
+	uint uBodyB = m_rowB[a_uRow];
+	float fImpulseA = a_fImpulse * m_inverseMass[uBodyA];
+	float fImpulseB = a_fImpulse * m_inverseMass[uBodyB];
+	m_velocityX[uBodyA] -= m_normalX[a_uRow] * fImpulseA;
+	m_velocityY[uBodyA] -= m_normalY[a_uRow] * fImpulseA;
+	m_velocityZ[uBodyA] -= m_normalZ[a_uRow] * fImpulseA;
+	m_velocityX[uBodyB] += m_normalX[a_uRow] * fImpulseB;
+	m_velocityY[uBodyB] += m_normalY[a_uRow] * fImpulseB;
+	m_velocityZ[uBodyB] += m_normalZ[a_uRow] * fImpulseB;
+}
+void Simplex::MyContactSolver::SolveRow(uint a_uRow)
+{
+	uint uBodyA = m_rowA[a_uRow];
+	uint uBodyB = m_rowB[a_uRow];
+
+	//separating velocity along the normal
+	float fVelocity = (m_velocityX[uBodyB] - m_velocityX[uBodyA]) * m_normalX[a_uRow] +
+		(m_velocityY[uBodyB] - m_velocityY[uBodyA]) * m_normalY[a_uRow] +
+		(m_velocityZ[uBodyB] - m_velocityZ[uBodyA]) * m_normalZ[a_uRow];
+
+	//contacts can only push, the accumulated impulse is clamped instead of each step
+	float fImpulse = (m_bias[a_uRow] - fVelocity) * m_normalMass[a_uRow];
+	float fOld = m_impulse[a_uRow];
+	m_impulse[a_uRow] = fOld + fImpulse > 0.0f ? fOld + fImpulse : 0.0f;
+	ApplyImpulse(a_uRow, m_impulse[a_uRow] - fOld);
+}
+void Simplex::MyContactSolver::SolveGroups(void)
+{
+	const __m128 zero = _mm_setzero_ps();
+	float fOut[4];
+	for (uint uRow = 0; uRow < m_uGroupRowCount; uRow += 4)
+	{
+		const uint* a = &m_rowA[uRow];
+		const uint* b = &m_rowB[uRow];
+
+		//gather the bodies of the four lanes
+		__m128 vAX = _mm_setr_ps(m_velocityX[a[0]], m_velocityX[a[1]], m_velocityX[a[2]], m_velocityX[a[3]]);
+		__m128 vAY = _mm_setr_ps(m_velocityY[a[0]], m_velocityY[a[1]], m_velocityY[a[2]], m_velocityY[a[3]]);
+		__m128 vAZ = _mm_setr_ps(m_velocityZ[a[0]], m_velocityZ[a[1]], m_velocityZ[a[2]], m_velocityZ[a[3]]);
+		__m128 vBX = _mm_setr_ps(m_velocityX[b[0]], m_velocityX[b[1]], m_velocityX[b[2]], m_velocityX[b[3]]);
+		__m128 vBY = _mm_setr_ps(m_velocityY[b[0]], m_velocityY[b[1]], m_velocityY[b[2]], m_velocityY[b[3]]);
+		__m128 vBZ = _mm_setr_ps(m_velocityZ[b[0]], m_velocityZ[b[1]], m_velocityZ[b[2]], m_velocityZ[b[3]]);
+		__m128 inverseMassA = _mm_setr_ps(m_inverseMass[a[0]], m_inverseMass[a[1]], m_inverseMass[a[2]], m_inverseMass[a[3]]);
+		__m128 inverseMassB = _mm_setr_ps(m_inverseMass[b[0]], m_inverseMass[b[1]], m_inverseMass[b[2]], m_inverseMass[b[3]]);
+
+		__m128 nX = _mm_loadu_ps(&m_normalX[uRow]);
+		__m128 nY = _mm_loadu_ps(&m_normalY[uRow]);
+		__m128 nZ = _mm_loadu_ps(&m_normalZ[uRow]);
+
+		//same as SolveRow for the four lanes
+		__m128 velocity = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_sub_ps(vBX, vAX), nX),
+			_mm_mul_ps(_mm_sub_ps(vBY, vAY), nY)),
+			_mm_mul_ps(_mm_sub_ps(vBZ, vAZ), nZ));
+		__m128 impulse = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_bias[uRow]), velocity), _mm_loadu_ps(&m_normalMass[uRow]));
+		__m128 old = _mm_loadu_ps(&m_impulse[uRow]);
+		__m128 accumulated = _mm_max_ps(_mm_add_ps(old, impulse), zero);
+		_mm_storeu_ps(&m_impulse[uRow], accumulated);
+		impulse = _mm_sub_ps(accumulated, old);
+
+		__m128 impulseA = _mm_mul_ps(impulse, inverseMassA);
+		__m128 impulseB = _mm_mul_ps(impulse, inverseMassB);
+		vAX = _mm_sub_ps(vAX, _mm_mul_ps(nX, impulseA));
+		vAY = _mm_sub_ps(vAY, _mm_mul_ps(nY, impulseA));
+		vAZ = _mm_sub_ps(vAZ, _mm_mul_ps(nZ, impulseA));
+		vBX = _mm_add_ps(vBX, _mm_mul_ps(nX, impulseB));
+		vBY = _mm_add_ps(vBY, _mm_mul_ps(nY, impulseB));
+		vBZ = _mm_add_ps(vBZ, _mm_mul_ps(nZ, impulseB));
+
+		//scatter, no body is repeated in a group other than the static one which does not change
+		_mm_storeu_ps(fOut, vAX); for (uint i = 0; i < 4; ++i) m_velocityX[a[i]] = fOut[i];
+		_mm_storeu_ps(fOut, vAY); for (uint i = 0; i < 4; ++i) m_velocityY[a[i]] = fOut[i];
+		_mm_storeu_ps(fOut, vAZ); for (uint i = 0; i < 4; ++i) m_velocityZ[a[i]] = fOut[i];
+		_mm_storeu_ps(fOut, vBX); for (uint i = 0; i < 4; ++i) m_velocityX[b[i]] = fOut[i];
+		_mm_storeu_ps(fOut, vBY); for (uint i = 0; i < 4; ++i) m_velocityY[b[i]] = fOut[i];
+		_mm_storeu_ps(fOut, vBZ); for (uint i = 0; i < 4; ++i) m_velocityZ[b[i]] = fOut[i];
+	}
+}
+//Solve
+void Simplex::MyContactSolver::Solve(PEntity* a_pEntityArray, uint a_uEntityCount, std::vector<MyBroadPhasePair> const& a_pairList,
+	std::vector<uint> const& a_collidingList, MySATCache* a_pSATCache)
+{
+	//sleeping entities hit by something still moving wake up, the others hold like the ground does
+	uint uPairCount = static_cast<uint>(a_pairList.size());
+	for (uint uPair = 0; uPair < uPairCount; ++uPair)
+	{
+		if (!a_collidingList[uPair])
+			continue;
+		MyEntity* pEntityA = a_pEntityArray[a_pairList[uPair].m_uA];
+		MyEntity* pEntityB = a_pEntityArray[a_pairList[uPair].m_uB];
+		if (!pEntityA->IsUsingPhysicsSolver() || !pEntityB->IsUsingPhysicsSolver())
+			continue;
+		if (pEntityA->IsAsleep() && !pEntityB->IsAsleep() && !pEntityB->GetSolver()->IsReadyToSleep())
+			pEntityA->GetSolver()->Wake();
+		else if (pEntityB->IsAsleep() && !pEntityA->IsAsleep() && !pEntityA->GetSolver()->IsReadyToSleep())
+			pEntityB->GetSolver()->Wake();
+	}
+
+	//the moving entities are the bodies, everything else is the static body
+	m_solverList.assign(1, nullptr);
+	m_velocityX.assign(1, 0.0f);
+	m_velocityY.assign(1, 0.0f);
+	m_velocityZ.assign(1, 0.0f);
+	m_inverseMass.assign(1, 0.0f);
+	m_bodyList.resize(a_uEntityCount);
+	for (uint i = 0; i < a_uEntityCount; ++i)
+	{
+		MyEntity* pEntity = a_pEntityArray[i];
+		m_bodyList[i] = 0;
+		if (!pEntity->IsUsingPhysicsSolver() || pEntity->IsAsleep())
+			continue;
+
+		MySolver* pSolver = pEntity->GetSolver();
+		vector3 v3Velocity = pSolver->GetVelocity();
+		float fMass = pSolver->GetMass();
+		m_bodyList[i] = static_cast<uint>(m_solverList.size());
+		m_solverList.push_back(pSolver);
+		m_velocityX.push_back(v3Velocity.x);
+		m_velocityY.push_back(v3Velocity.y);
+		m_velocityZ.push_back(v3Velocity.z);
+		m_inverseMass.push_back(fMass > 0.01f ? 1.0f / fMass : 100.0f);
+	}
+
+	m_rowA.clear();
+	m_rowB.clear();
+	m_normalX.clear();
+	m_normalY.clear();
+	m_normalZ.clear();
+	m_bias.clear();
+	m_normalMass.clear();
+	m_impulse.clear();
+	m_cacheList.clear();
+
+	//a row for each colliding pair, a single normal is enough as the bodies do not rotate
+	MyPairCache* pPairCache = a_pSATCache->GetPairCache();
+	for (uint uPair = 0; uPair < uPairCount; ++uPair)
+	{
+		if (!a_collidingList[uPair])
+			continue;
+		uint uBodyA = m_bodyList[a_pairList[uPair].m_uA];
+		uint uBodyB = m_bodyList[a_pairList[uPair].m_uB];
+		MyContact contact = a_pSATCache->GetContact(uPair);
+		if ((uBodyA == 0 && uBodyB == 0) || glm::dot(contact.m_v3Normal, contact.m_v3Normal) < 0.5f)
+			continue;
+		MyPair* pPair = pPairCache->Find(a_pEntityArray[a_pairList[uPair].m_uA], a_pEntityArray[a_pairList[uPair].m_uB]);
+		if (pPair)
+			AddRow(uBodyA, uBodyB, contact.m_v3Normal, contact.m_fDepth, &pPair->m_contact.m_fImpulse);
+	}
+
+	//the ground is a contact too, added before the bodies reach it so stacks rest on it
+	if (m_groundImpulseList.size() != a_uEntityCount)
+		m_groundImpulseList.assign(a_uEntityCount, 0.0f);
+	for (uint i = 0; i < a_uEntityCount; ++i)
+	{
+		uint uBody = m_bodyList[i];
+		if (uBody == 0)
+			continue;
+		float fHeight = m_solverList[uBody]->GetPosition().y;
+		if (fHeight + m_velocityY[uBody] <= m_fSlop)
+			AddRow(0, uBody, AXIS_Y, -fHeight, &m_groundImpulseList[i]);
+		else
+			m_groundImpulseList[i] = 0.0f;
+	}
+
+	GroupRows();
+
+	//warm start with the impulses of the last update, resting contacts barely change
+	uint uRowCount = static_cast<uint>(m_rowA.size());
+	for (uint uRow = 0; uRow < uRowCount; ++uRow)
+		ApplyImpulse(uRow, m_impulse[uRow]);
+
+	for (uint uIteration = 0; uIteration < m_uIterations; ++uIteration)
+	{
+		SolveGroups();
+		for (uint uRow = m_uGroupRowCount; uRow < uRowCount; ++uRow)
+			SolveRow(uRow);
+	}
+
+	//store the impulses for the next update and give the velocities back
+	for (uint uRow = 0; uRow < uRowCount; ++uRow)
+		*m_cacheList[uRow] = m_impulse[uRow];
+	for (uint uBody = 1; uBody < m_solverList.size(); ++uBody)
+	{
+		MySolver* pSolver = m_solverList[uBody];
+		pSolver->ApplyContactVelocity(vector3(m_velocityX[uBody], m_velocityY[uBody], m_velocityZ[uBody]) - pSolver->GetVelocity());
+	}
+}
\ No newline at end of file
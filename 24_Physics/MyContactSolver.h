@@ -0,0 +1,162 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYCONTACTSOLVER_H_
+#define __MYCONTACTSOLVER_H_
+
+#include "MySATCache.h"
+
+namespace Simplex
+{
+
+//Sequential impulse solver for the contacts of the narrow phase and the ground, the contact rows are
+//grouped four at a time with no body repeated so each group is solved with SSE
+class MyContactSolver
+{
+	typedef MyEntity* PEntity; //MyEntity Pointer
+
+	uint m_uIterations = 8; //passes over all the contact rows
+	float m_fBaumgarte = 0.2f; //fraction of the penetration corrected each update
+	float m_fSlop = 0.01f; //penetration left alone so resting contacts do not jitter
+
+	//bodies, the first one is the static body used for the ground and the entities that do not move
+	std::vector<MySolver*> m_solverList; //solver of each body
+	std::vector<float> m_velocityX; //velocity of each body
+	std::vector<float> m_velocityY;
+	std::vector<float> m_velocityZ;
+	std::vector<float> m_inverseMass; //one over the mass of each body, zero for the static one
+	std::vector<uint> m_bodyList; //body of each entity
+
+	//contact rows, first the groups of four then the ones that did not fit in a group
+	std::vector<uint> m_rowA; //first body of each row
+	std::vector<uint> m_rowB; //second body of each row, the normal goes from the first to the second
+	std::vector<float> m_normalX; //normal of each row
+	std::vector<float> m_normalY;
+	std::vector<float> m_normalZ;
+	std::vector<float> m_bias; //separating velocity each row has to reach
+	std::vector<float> m_normalMass; //one over the sum of the inverse masses of each row
+	std::vector<float> m_impulse; //accumulated impulse of each row
+	std::vector<float*> m_cacheList; //where the impulse of each row is kept for the next update
+	uint m_uGroupRowCount = 0; //rows solved in groups of four
+
+	std::vector<float> m_groundImpulseList; //ground impulse of each entity, for the next update
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object instance
+	*/
+	MyContactSolver(void);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyContactSolver(void);
+	/*
+	USAGE: Solves the contacts of the colliding pairs changing the velocity of the solvers, goes after
+	the forces are applied and before the positions are updated
+	ARGUMENTS:
+	-	PEntity* a_pEntityArray -> list of entities
+	-	uint a_uEntityCount -> number of entities
+	-	std::vector<MyBroadPhasePair> const& a_pairList -> pairs of the narrow phase
+	-	std::vector<uint> const& a_collidingList -> 1 for each colliding pair
+	-	MySATCache* a_pSATCache -> narrow phase with the contacts of the pairs
+	OUTPUT: ---
+	*/
+	void Solve(PEntity* a_pEntityArray, uint a_uEntityCount, std::vector<MyBroadPhasePair> const& a_pairList,
+		std::vector<uint> const& a_collidingList, MySATCache* a_pSATCache);
+	/*
+	USAGE: Sets the number of passes over the contacts
+	ARGUMENTS: uint a_uIterations -> passes, more are stiffer and slower
+	OUTPUT: ---
+	*/
+	void SetIterationCount(uint a_uIterations);
+	/*
+	USAGE: Gets the number of passes over the contacts
+	ARGUMENTS: ---
+	OUTPUT: passes
+	*/
+	uint GetIterationCount(void);
+	/*
+	USAGE: Sets how the penetration is corrected
+	ARGUMENTS:
+	-	float a_fBaumgarte -> fraction of the penetration corrected each update
+	-	float a_fSlop -> penetration left alone
+	OUTPUT: ---
+	*/
+	void SetCorrection(float a_fBaumgarte, float a_fSlop);
+	/*
+	USAGE: Gets the number of contact rows of the last solve
+	ARGUMENTS: ---
+	OUTPUT: row count
+	*/
+	uint GetRowCount(void);
+	/*
+	USAGE: Gets the number of contact rows of the last solve solved in groups of four
+	ARGUMENTS: ---
+	OUTPUT: row count
+	*/
+	uint GetGroupRowCount(void);
+private:
+	/*
+	USAGE: copy constructor, solvers are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyContactSolver(MyContactSolver const& other);
+	/*
+	USAGE: copy assignment operator, solvers are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyContactSolver& operator=(MyContactSolver const& other);
+	/*
+	USAGE: Adds a contact row
+	ARGUMENTS:
+	-	uint a_uBodyA -> first body
+	-	uint a_uBodyB -> second body
+	-	vector3 a_v3Normal -> unit normal from the first body to the second one
+	-	float a_fDepth -> penetration, negative for a gap the bodies can still close this update
+	-	float* a_pCache -> impulse of the last update, the new one is stored there
+	OUTPUT: ---
+	*/
+	void AddRow(uint a_uBodyA, uint a_uBodyB, vector3 a_v3Normal, float a_fDepth, float* a_pCache);
+	/*
+	USAGE: Orders the rows in groups of four with no body repeated inside a group
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void GroupRows(void);
+	/*
+	USAGE: Solves the groups of four rows with SSE
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void SolveGroups(void);
+	/*
+	USAGE: Solves one row
+	ARGUMENTS: uint a_uRow -> row to solve
+	OUTPUT: ---
+	*/
+	void SolveRow(uint a_uRow);
+	/*
+	USAGE: Applies an impulse along the normal of a row to its bodies
+	ARGUMENTS:
+	-	uint a_uRow -> row
+	-	float a_fImpulse -> impulse to apply
+	OUTPUT: ---
+	*/
+	void ApplyImpulse(uint a_uRow, float a_fImpulse);
+};
+
+} //namespace Simplex
+
+#endif //__MYCONTACTSOLVER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
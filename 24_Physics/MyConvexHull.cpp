@@ -0,0 +1,297 @@
+#include "MyConvexHull.h"
+using namespace Simplex;
+//Face of the hull while it is being built
+struct MyHullFace
+{
+	uint m_uVertex[3]; //vertices, counter clockwise seen from outside
+	vector3 m_v3Normal; //outward normal
+	float m_fDistance; //distance of the plane to the origin
+	std::vector<uint> m_outsideList; //points in front of the face
+	uint m_uFurthest; //point of the outside list furthest from the face
+	float m_fFurthest; //distance of the furthest point
+	bool m_bAlive; //is the face part of the hull?
+};
+static MyHullFace MakeFace(std::vector<vector3>& a_pointList, uint a_uA, uint a_uB, uint a_uC)
+{
+	MyHullFace face;
+	face.m_uVertex[0] = a_uA;
+	face.m_uVertex[1] = a_uB;
+	face.m_uVertex[2] = a_uC;
+	vector3 v3Normal = glm::cross(a_pointList[a_uB] - a_pointList[a_uA], a_pointList[a_uC] - a_pointList[a_uA]);
+	float fLength = glm::length(v3Normal);
+	face.m_v3Normal = fLength > 0.0f ? v3Normal / fLength : AXIS_Y;
+	face.m_fDistance = glm::dot(face.m_v3Normal, a_pointList[a_uA]);
+	face.m_uFurthest = 0;
+	face.m_fFurthest = 0.0f;
+	face.m_bAlive = true;
+	return face;
+}
+static void AddToOutsideList(MyHullFace& a_face, uint a_uPoint, float a_fDistance)
+{
+	if (a_face.m_outsideList.size() == 0 || a_fDistance > a_face.m_fFurthest)
+	{
+		a_face.m_uFurthest = a_uPoint;
+		a_face.m_fFurthest = a_fDistance;
+	}
+	a_face.m_outsideList.push_back(a_uPoint);
+}
+//  MyConvexHull
+Simplex::MyConvexHull::MyConvexHull(std::vector<vector3> a_pointList, uint a_uMaxPoints)
+{
+	Build(a_pointList, a_uMaxPoints);
+}
+Simplex::MyConvexHull::MyConvexHull(MyConvexHull const& other) { }
+Simplex::MyConvexHull& Simplex::MyConvexHull::operator=(MyConvexHull const& other) { return *this; }
+Simplex::MyConvexHull::~MyConvexHull(void)
+{
+	m_pointList.clear();
+	m_faceList.clear();
+	m_edgeList.clear();
+}
+//Accessors
+vector3 Simplex::MyConvexHull::GetPoint(uint a_uIndex) { return m_pointList[a_uIndex]; }
+Simplex::uint Simplex::MyConvexHull::GetPointCount(void) { return static_cast<uint>(m_pointList.size()); }
+std::vector<uint>& Simplex::MyConvexHull::GetEdgeList(void) { return m_edgeList; }
+Simplex::uint Simplex::MyConvexHull::GetSupport(vector3 a_v3Direction)
+{
+	uint uSupport = 0;
+	float fMax = -FLT_MAX;
+	for (uint i = 0; i < m_pointList.size(); ++i)
+	{
+		float fDot = glm::dot(m_pointList[i], a_v3Direction);
+		if (fDot > fMax)
+		{
+			fMax = fDot;
+			uSupport = i;
+		}
+	}
+	return uSupport;
+}
+//Quickhull
+void Simplex::MyConvexHull::Build(std::vector<vector3>& a_pointList, uint a_uMaxPoints)
+{
+	uint uPointCount = static_cast<uint>(a_pointList.size());
+	if (uPointCount < 4 || a_uMaxPoints < 4)
+	{
+		m_pointList = a_pointList;
+		return;
+	}
+
+	//extreme points on each axis
+	uint uExtreme[6] = { 0, 0, 0, 0, 0, 0 };
+	for (uint i = 1; i < uPointCount; ++i)
+	{
+		for (uint uAxis = 0; uAxis < 3; ++uAxis)
+		{
+			if (a_pointList[i][uAxis] < a_pointList[uExtreme[uAxis * 2]][uAxis])
+				uExtreme[uAxis * 2] = i;
+			if (a_pointList[i][uAxis] > a_pointList[uExtreme[uAxis * 2 + 1]][uAxis])
+				uExtreme[uAxis * 2 + 1] = i;
+		}
+	}
+	vector3 v3Size = vector3(a_pointList[uExtreme[1]].x - a_pointList[uExtreme[0]].x,
+		a_pointList[uExtreme[3]].y - a_pointList[uExtreme[2]].y,
+		a_pointList[uExtreme[5]].z - a_pointList[uExtreme[4]].z);
+	float fEpsilon = (v3Size.x + v3Size.y + v3Size.z) * 1e-5f;
+
+	//the initial tetrahedron, first the two extreme points furthest apart
+	uint uA = uExtreme[0], uB = uExtreme[1];
+	float fMax = -1.0f;
+	for (uint i = 0; i < 6; ++i)
+	{
+		for (uint j = i + 1; j < 6; ++j)
+		{
+			float fDistance = glm::distance(a_pointList[uExtreme[i]], a_pointList[uExtreme[j]]);
+			if (fDistance > fMax)
+			{
+				fMax = fDistance;
+				uA = uExtreme[i];
+				uB = uExtreme[j];
+			}
+		}
+	}
+	//then the point furthest from their line
+	uint uC = uA;
+	fMax = 0.0f;
+	vector3 v3Line = a_pointList[uB] - a_pointList[uA];
+	for (uint i = 0; i < uPointCount; ++i)
+	{
+		float fDistance = glm::length(glm::cross(a_pointList[i] - a_pointList[uA], v3Line));
+		if (fDistance > fMax)
+		{
+			fMax = fDistance;
+			uC = i;
+		}
+	}
+	//and the point furthest from their plane
+	uint uD = uA;
+	fMax = 0.0f;
+	vector3 v3Normal = glm::cross(v3Line, a_pointList[uC] - a_pointList[uA]);
+	if (glm::length(v3Normal) > 0.0f)
+		v3Normal = glm::normalize(v3Normal);
+	for (uint i = 0; i < uPointCount; ++i)
+	{
+		float fDistance = glm::abs(glm::dot(a_pointList[i] - a_pointList[uA], v3Normal));
+		if (fDistance > fMax)
+		{
+			fMax = fDistance;
+			uD = i;
+		}
+	}
+
+	//flat point clouds have no volume, keep the extreme points
+	if (fMax <= fEpsilon)
+	{
+		for (uint i = 0; i < 6; ++i)
+		{
+			bool bFound = false;
+			for (uint j = 0; j < m_pointList.size(); ++j)
+				bFound = bFound || m_pointList[j] == a_pointList[uExtreme[i]];
+			if (!bFound)
+				m_pointList.push_back(a_pointList[uExtreme[i]]);
+		}
+		return;
+	}
+
+	//faces of the tetrahedron facing away from its centroid
+	std::vector<MyHullFace> faceList;
+	vector3 v3Centroid = (a_pointList[uA] + a_pointList[uB] + a_pointList[uC] + a_pointList[uD]) * 0.25f;
+	uint uTetrahedron[4][3] = { { uA, uB, uC },{ uA, uD, uB },{ uA, uC, uD },{ uB, uD, uC } };
+	for (uint i = 0; i < 4; ++i)
+	{
+		MyHullFace face = MakeFace(a_pointList, uTetrahedron[i][0], uTetrahedron[i][1], uTetrahedron[i][2]);
+		if (glm::dot(face.m_v3Normal, v3Centroid) - face.m_fDistance > 0.0f)
+			face = MakeFace(a_pointList, uTetrahedron[i][0], uTetrahedron[i][2], uTetrahedron[i][1]);
+		faceList.push_back(face);
+	}
+
+	//each point goes to the first face it is in front of
+	for (uint i = 0; i < uPointCount; ++i)
+	{
+		for (uint uFace = 0; uFace < faceList.size(); ++uFace)
+		{
+			float fDistance = glm::dot(faceList[uFace].m_v3Normal, a_pointList[i]) - faceList[uFace].m_fDistance;
+			if (fDistance > fEpsilon)
+			{
+				AddToOutsideList(faceList[uFace], i, fDistance);
+				break;
+			}
+		}
+	}
+
+	//grow the hull with the point furthest out until there are enough vertices
+	uint uVertexCount = 4;
+	std::vector<uint> visibleList;
+	std::vector<uint> edgeList;
+	std::vector<uint> orphanList;
+	while (uVertexCount < a_uMaxPoints)
+	{
+		int nFace = -1;
+		fMax = 0.0f;
+		for (uint uFace = 0; uFace < faceList.size(); ++uFace)
+		{
+			if (faceList[uFace].m_bAlive && faceList[uFace].m_outsideList.size() > 0 && faceList[uFace].m_fFurthest > fMax)
+			{
+				fMax = faceList[uFace].m_fFurthest;
+				nFace = uFace;
+			}
+		}
+		if (nFace < 0)
+			break;
+		uint uEye = faceList[nFace].m_uFurthest;
+		vector3 v3Eye = a_pointList[uEye];
+
+		//faces that can see the new point are replaced
+		visibleList.clear();
+		edgeList.clear();
+		orphanList.clear();
+		for (uint uFace = 0; uFace < faceList.size(); ++uFace)
+		{
+			MyHullFace& face = faceList[uFace];
+			if (!face.m_bAlive || glm::dot(face.m_v3Normal, v3Eye) - face.m_fDistance <= fEpsilon)
+				continue;
+			visibleList.push_back(uFace);
+			face.m_bAlive = false;
+			orphanList.insert(orphanList.end(), face.m_outsideList.begin(), face.m_outsideList.end());
+			face.m_outsideList.clear();
+
+			//edges shared by two visible faces are not on the horizon
+			for (uint uEdge = 0; uEdge < 3; ++uEdge)
+			{
+				uint uFrom = face.m_uVertex[uEdge];
+				uint uTo = face.m_uVertex[(uEdge + 1) % 3];
+				bool bShared = false;
+				for (uint i = 0; i < edgeList.size(); i += 2)
+				{
+					if (edgeList[i] == uTo && edgeList[i + 1] == uFrom)
+					{
+						edgeList.erase(edgeList.begin() + i, edgeList.begin() + i + 2);
+						bShared = true;
+						break;
+					}
+				}
+				if (!bShared)
+				{
+					edgeList.push_back(uFrom);
+					edgeList.push_back(uTo);
+				}
+			}
+		}
+
+		//connect the horizon to the new point
+		uint uFirstNewFace = static_cast<uint>(faceList.size());
+		for (uint i = 0; i < edgeList.size(); i += 2)
+			faceList.push_back(MakeFace(a_pointList, edgeList[i], edgeList[i + 1], uEye));
+
+		//the points of the removed faces go to the new ones, or are inside now
+		for (uint i = 0; i < orphanList.size(); ++i)
+		{
+			if (orphanList[i] == uEye)
+				continue;
+			for (uint uFace = uFirstNewFace; uFace < faceList.size(); ++uFace)
+			{
+				float fDistance = glm::dot(faceList[uFace].m_v3Normal, a_pointList[orphanList[i]]) - faceList[uFace].m_fDistance;
+				if (fDistance > fEpsilon)
+				{
+					AddToOutsideList(faceList[uFace], orphanList[i], fDistance);
+					break;
+				}
+			}
+		}
+		++uVertexCount;
+	}
+
+	//keep only the vertices used by the faces of the hull
+	std::map<uint, uint> vertexMap;
+	for (uint uFace = 0; uFace < faceList.size(); ++uFace)
+	{
+		if (!faceList[uFace].m_bAlive)
+			continue;
+		for (uint i = 0; i < 3; ++i)
+		{
+			uint uVertex = faceList[uFace].m_uVertex[i];
+			auto vertex = vertexMap.find(uVertex);
+			if (vertex == vertexMap.end())
+			{
+				vertexMap[uVertex] = static_cast<uint>(m_pointList.size());
+				m_pointList.push_back(a_pointList[uVertex]);
+			}
+			m_faceList.push_back(vertexMap[uVertex]);
+		}
+	}
+
+	//every edge is shared by two faces, keep it once
+	for (uint i = 0; i < m_faceList.size(); i += 3)
+	{
+		for (uint uEdge = 0; uEdge < 3; ++uEdge)
+		{
+			uint uFrom = m_faceList[i + uEdge];
+			uint uTo = m_faceList[i + (uEdge + 1) % 3];
+			if (uFrom < uTo)
+			{
+				m_edgeList.push_back(uFrom);
+				m_edgeList.push_back(uTo);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYCONVEXHULL_H_
+#define __MYCONVEXHULL_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+//Convex hull of a point cloud in local space, built with Quickhull
+class MyConvexHull
+{
+	std::vector<vector3> m_pointList; //vertices of the hull
+	std::vector<uint> m_faceList; //triangles of the hull, three vertex indices each
+	std::vector<uint> m_edgeList; //edges of the hull, two vertex indices each (for display)
+public:
+	/*
+	USAGE: Builds the hull of a point list, stopping once it has the maximum number of vertices
+	(every step adds the point furthest out so the first vertices are the ones that matter the most)
+	ARGUMENTS:
+	-	std::vector<vector3> a_pointList -> list of points
+	-	uint a_uMaxPoints = 64 -> maximum number of vertices of the hull
+	OUTPUT: class object instance
+	*/
+	MyConvexHull(std::vector<vector3> a_pointList, uint a_uMaxPoints = 64);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyConvexHull(void);
+	/*
+	USAGE: Gets the vertex furthest along a direction
+	ARGUMENTS: vector3 a_v3Direction -> direction in local space
+	OUTPUT: index of the vertex
+	*/
+	uint GetSupport(vector3 a_v3Direction);
+	/*
+	USAGE: Gets a vertex of the hull
+	ARGUMENTS: uint a_uIndex -> index of the vertex
+	OUTPUT: vertex in local space
+	*/
+	vector3 GetPoint(uint a_uIndex);
+	/*
+	USAGE: Gets the number of vertices of the hull
+	ARGUMENTS: ---
+	OUTPUT: vertex count
+	*/
+	uint GetPointCount(void);
+	/*
+	USAGE: Gets the edges of the hull
+	ARGUMENTS: ---
+	OUTPUT: list of vertex indices, two per edge
+	*/
+	std::vector<uint>& GetEdgeList(void);
+private:
+	/*
+	USAGE: copy constructor, hulls are shared not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyConvexHull(MyConvexHull const& other);
+	/*
+	USAGE: copy assignment operator, hulls are shared not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyConvexHull& operator=(MyConvexHull const& other);
+	/*
+	USAGE: Runs Quickhull over the point list
+	ARGUMENTS:
+	-	std::vector<vector3>& a_pointList -> list of points
+	-	uint a_uMaxPoints -> maximum number of vertices of the hull
+	OUTPUT: ---
+	*/
+	void Build(std::vector<vector3>& a_pointList, uint a_uMaxPoints);
+};
+
+} //namespace Simplex
+
+#endif //__MYCONVEXHULL_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "MyDebugDraw.h"
+using namespace Simplex;
+#ifdef MYDEBUGDRAW
+//  MyDebugDraw
+Simplex::MyDebugDraw* Simplex::MyDebugDraw::m_pInstance = nullptr;
+void Simplex::MyDebugDraw::Init(void)
+{
+	//one list per thread so lines can be added from inside jobs without locking
+	m_uListCount = MyJobSystem::GetInstance()->GetThreadCount();
+	m_pDepthList = new VertexList[m_uListCount];
+	m_pOverlayList = new VertexList[m_uListCount];
+
+	//unit circle used for the rings of the spheres
+	uint uSegments = 24;
+	for (uint i = 0; i < uSegments; ++i)
+	{
+		float fAngle = static_cast<float>((2.0 * PI * i) / uSegments);
+		m_circleList.push_back(vector3(cos(fAngle), sin(fAngle), 0.0f));
+	}
+
+	//OpenGL objects are created on the first render
+	m_uShader = 0;
+	m_uVAO = 0;
+	m_uVBO = 0;
+	m_uVBOCapacity = 0;
+	m_nVP = -1;
+	m_uLastCount = 0;
+}
+void Simplex::MyDebugDraw::Release(void)
+{
+	if (m_pDepthList)
+	{
+		delete[] m_pDepthList;
+		m_pDepthList = nullptr;
+	}
+	if (m_pOverlayList)
+	{
+		delete[] m_pOverlayList;
+		m_pOverlayList = nullptr;
+	}
+	m_uListCount = 0;
+	m_circleList.clear();
+
+	if (m_uVBO)
+		glDeleteBuffers(1, &m_uVBO);
+	if (m_uVAO)
+		glDeleteVertexArrays(1, &m_uVAO);
+	if (m_uShader)
+		glDeleteProgram(m_uShader);
+	m_uVBO = 0;
+	m_uVAO = 0;
+	m_uShader = 0;
+	m_uVBOCapacity = 0;
+}
+Simplex::MyDebugDraw* Simplex::MyDebugDraw::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyDebugDraw();
+	}
+	return m_pInstance;
+}
+void Simplex::MyDebugDraw::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//Accessors
+Simplex::uint Simplex::MyDebugDraw::GetLineCount(void) { return m_uLastCount / 2; }
+Simplex::MyDebugDraw::VertexList& Simplex::MyDebugDraw::GetList(bool a_bOverlay)
+{
+	//threads not owned by the job system share the main list
+	uint uThread = MyJobSystem::GetThreadIndex();
+	if (uThread >= m_uListCount)
+		uThread = 0;
+	return a_bOverlay ? m_pOverlayList[uThread] : m_pDepthList[uThread];
+}
+//The big 3
+Simplex::MyDebugDraw::MyDebugDraw() { Init(); }
+Simplex::MyDebugDraw::MyDebugDraw(MyDebugDraw const& a_pOther) { }
+Simplex::MyDebugDraw& Simplex::MyDebugDraw::operator=(MyDebugDraw const& a_pOther) { return *this; }
+Simplex::MyDebugDraw::~MyDebugDraw() { Release(); };
+// other methods
+void Simplex::MyDebugDraw::AddLine(vector3 a_v3Start, vector3 a_v3End, vector3 a_v3Color, bool a_bOverlay)
+{
+	VertexList& list = GetList(a_bOverlay);
+	MyDebugVertex vertex;
+	vertex.m_v3Color = a_v3Color;
+	vertex.m_v3Position = a_v3Start;
+	list.push_back(vertex);
+	vertex.m_v3Position = a_v3End;
+	list.push_back(vertex);
+}
+void Simplex::MyDebugDraw::AddBox(matrix4 const& a_m4Transform, vector3 a_v3Color, bool a_bOverlay)
+{
+	//corners of the unit cube, bit 0 is x, bit 1 is y and bit 2 is z
+	vector3 v3Corner[8];
+	for (uint i = 0; i < 8; ++i)
+	{
+		vector4 v4Local(
+			(i & 1) ? 0.5f : -0.5f,
+			(i & 2) ? 0.5f : -0.5f,
+			(i & 4) ? 0.5f : -0.5f,
+			1.0f);
+		v3Corner[i] = vector3(a_m4Transform * v4Local);
+	}
+
+	//edges connect the corners that differ in one bit
+	static const uint uEdge[24] = {
+		0, 1, 2, 3, 4, 5, 6, 7, //along x
+		0, 2, 1, 3, 4, 6, 5, 7, //along y
+		0, 4, 1, 5, 2, 6, 3, 7 }; //along z
+
+	VertexList& list = GetList(a_bOverlay);
+	MyDebugVertex vertex;
+	vertex.m_v3Color = a_v3Color;
+	for (uint i = 0; i < 24; ++i)
+	{
+		vertex.m_v3Position = v3Corner[uEdge[i]];
+		list.push_back(vertex);
+	}
+}
+void Simplex::MyDebugDraw::AddBox(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Color, bool a_bOverlay)
+{
+	AddBox(glm::translate((a_v3Min + a_v3Max) * 0.5f) * glm::scale(a_v3Max - a_v3Min), a_v3Color, a_bOverlay);
+}
+void Simplex::MyDebugDraw::AddSphere(matrix4 const& a_m4Transform, vector3 a_v3Color, bool a_bOverlay)
+{
+	uint uSegments = m_circleList.size();
+	VertexList& list = GetList(a_bOverlay);
+	MyDebugVertex vertex;
+	vertex.m_v3Color = a_v3Color;
+	//one ring on each of the XY, XZ and YZ planes
+	for (uint uRing = 0; uRing < 3; ++uRing)
+	{
+		for (uint i = 0; i < uSegments; ++i)
+		{
+			vector3 v3Circle[2] = { m_circleList[i], m_circleList[(i + 1) % uSegments] };
+			for (uint j = 0; j < 2; ++j)
+			{
+				vector4 v4Local;
+				if (uRing == 0)
+					v4Local = vector4(v3Circle[j].x, v3Circle[j].y, 0.0f, 1.0f);
+				else if (uRing == 1)
+					v4Local = vector4(v3Circle[j].x, 0.0f, v3Circle[j].y, 1.0f);
+				else
+					v4Local = vector4(0.0f, v3Circle[j].x, v3Circle[j].y, 1.0f);
+				vertex.m_v3Position = vector3(a_m4Transform * v4Local);
+				list.push_back(vertex);
+			}
+		}
+	}
+}
+void Simplex::MyDebugDraw::AddAxis(matrix4 const& a_m4Transform, bool a_bOverlay)
+{
+	vector3 v3Origin = vector3(a_m4Transform * vector4(ZERO_V3, 1.0f));
+	AddLine(v3Origin, vector3(a_m4Transform * vector4(AXIS_X, 1.0f)), C_RED, a_bOverlay);
+	AddLine(v3Origin, vector3(a_m4Transform * vector4(AXIS_Y, 1.0f)), C_GREEN, a_bOverlay);
+	AddLine(v3Origin, vector3(a_m4Transform * vector4(AXIS_Z, 1.0f)), C_BLUE, a_bOverlay);
+}
+void Simplex::MyDebugDraw::AddGrid(matrix4 const& a_m4Transform, float a_fSize, uint a_uDivisions, vector3 a_v3Color, bool a_bOverlay)
+{
+	if (a_uDivisions < 1)
+		a_uDivisions = 1;
+
+	float fHalf = a_fSize * 0.5f;
+	float fStep = a_fSize / a_uDivisions;
+	for (uint i = 0; i <= a_uDivisions; ++i)
+	{
+		float fOffset = -fHalf + fStep * i;
+		AddLine(vector3(a_m4Transform * vector4(fOffset, 0.0f, -fHalf, 1.0f)),
+			vector3(a_m4Transform * vector4(fOffset, 0.0f, fHalf, 1.0f)), a_v3Color, a_bOverlay);
+		AddLine(vector3(a_m4Transform * vector4(-fHalf, 0.0f, fOffset, 1.0f)),
+			vector3(a_m4Transform * vector4(fHalf, 0.0f, fOffset, 1.0f)), a_v3Color, a_bOverlay);
+	}
+}
+void Simplex::MyDebugDraw::CreateDeviceObjects(void)
+{
+	const GLchar *vertex_shader =
+		"#version 330\n"
+		"uniform mat4 VP;\n"
+		"in vec3 Position;\n"
+		"in vec3 Color;\n"
+		"out vec3 Frag_Color;\n"
+		"void main()\n"
+		"{\n"
+		"	Frag_Color = Color;\n"
+		"	gl_Position = VP * vec4(Position, 1);\n"
+		"}\n";
+
+	const GLchar* fragment_shader =
+		"#version 330\n"
+		"in vec3 Frag_Color;\n"
+		"out vec4 Out_Color;\n"
+		"void main()\n"
+		"{\n"
+		"	Out_Color = vec4(Frag_Color, 1);\n"
+		"}\n";
+
+	m_uShader = glCreateProgram();
+	GLuint uVertHandle = glCreateShader(GL_VERTEX_SHADER);
+	GLuint uFragHandle = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(uVertHandle, 1, &vertex_shader, 0);
+	glShaderSource(uFragHandle, 1, &fragment_shader, 0);
+	glCompileShader(uVertHandle);
+	glCompileShader(uFragHandle);
+	glAttachShader(m_uShader, uVertHandle);
+	glAttachShader(m_uShader, uFragHandle);
+	glLinkProgram(m_uShader);
+	//the program keeps them alive
+	glDeleteShader(uVertHandle);
+	glDeleteShader(uFragHandle);
+
+	m_nVP = glGetUniformLocation(m_uShader, "VP");
+	GLint nPosition = glGetAttribLocation(m_uShader, "Position");
+	GLint nColor = glGetAttribLocation(m_uShader, "Color");
+
+	glGenBuffers(1, &m_uVBO);
+	glGenVertexArrays(1, &m_uVAO);
+	glBindVertexArray(m_uVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+	glEnableVertexAttribArray(nPosition);
+	glEnableVertexAttribArray(nColor);
+	glVertexAttribPointer(nPosition, 3, GL_FLOAT, GL_FALSE, sizeof(MyDebugVertex), (GLvoid*)offsetof(MyDebugVertex, m_v3Position));
+	glVertexAttribPointer(nColor, 3, GL_FLOAT, GL_FALSE, sizeof(MyDebugVertex), (GLvoid*)offsetof(MyDebugVertex, m_v3Color));
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+void Simplex::MyDebugDraw::Publish(VertexList& a_depthList, VertexList& a_overlayList)
+{
+	a_depthList.clear();
+	a_overlayList.clear();
+	for (uint i = 0; i < m_uListCount; ++i)
+	{
+		a_depthList.insert(a_depthList.end(), m_pDepthList[i].begin(), m_pDepthList[i].end());
+		a_overlayList.insert(a_overlayList.end(), m_pOverlayList[i].begin(), m_pOverlayList[i].end());
+
+		//forget the lines but keep the memory for the next frame
+		m_pDepthList[i].clear();
+		m_pOverlayList[i].clear();
+	}
+}
+void Simplex::MyDebugDraw::Render(VertexList const& a_depthList, VertexList const& a_overlayList, matrix4 const& a_m4ViewProjection)
+{
+	uint uDepthCount = a_depthList.size();
+	uint uOverlayCount = a_overlayList.size();
+	m_uLastCount = uDepthCount + uOverlayCount;
+	if (m_uLastCount == 0)
+		return;
+
+	if (m_uShader == 0)
+		CreateDeviceObjects();
+
+	// Backup GL state
+	GLint last_program, last_array_buffer, last_vertex_array;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+	glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
+	GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+
+	glBindVertexArray(m_uVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+
+	//orphan the buffer so we do not wait for the previous frame, grow it only if needed
+	if (m_uLastCount > m_uVBOCapacity)
+		m_uVBOCapacity = m_uLastCount * 2;
+	glBufferData(GL_ARRAY_BUFFER, sizeof(MyDebugVertex) * m_uVBOCapacity, nullptr, GL_STREAM_DRAW);
+
+	//depth tested lines go first and overlay lines after them
+	if (uDepthCount > 0)
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(MyDebugVertex) * uDepthCount, a_depthList.data());
+	if (uOverlayCount > 0)
+		glBufferSubData(GL_ARRAY_BUFFER, sizeof(MyDebugVertex) * uDepthCount, sizeof(MyDebugVertex) * uOverlayCount, a_overlayList.data());
+
+	glUseProgram(m_uShader);
+	glUniformMatrix4fv(m_nVP, 1, GL_FALSE, glm::value_ptr(a_m4ViewProjection));
+
+	if (uDepthCount > 0)
+	{
+		glEnable(GL_DEPTH_TEST);
+		glDrawArrays(GL_LINES, 0, uDepthCount);
+	}
+	if (uOverlayCount > 0)
+	{
+		glDisable(GL_DEPTH_TEST);
+		glDrawArrays(GL_LINES, uDepthCount, uOverlayCount);
+	}
+
+	// Restore modified GL state
+	glUseProgram(last_program);
+	glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+	glBindVertexArray(last_vertex_array);
+	if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+}
+#endif //MYDEBUGDRAW
\ No newline at end of file
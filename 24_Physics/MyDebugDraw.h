@@ -0,0 +1,222 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYDEBUGDRAW_H_
+#define __MYDEBUGDRAW_H_
+
+#include "MyJobSystem.h"
+
+//Debug drawing only exists on debug builds, on release every call is an empty inline function
+#ifdef DEBUG
+#define MYDEBUGDRAW
+#endif
+
+namespace Simplex
+{
+
+//Vertex of a debug line
+struct MyDebugVertex
+{
+	vector3 m_v3Position; //position in world space
+	vector3 m_v3Color; //color of the vertex
+};
+
+//System Class
+class MyDebugDraw
+{
+public:
+	typedef std::vector<MyDebugVertex> VertexList; //list of line vertices (two per line)
+
+private:
+	uint m_uListCount = 0; //one list per thread of the job system
+	VertexList* m_pDepthList = nullptr; //per thread lines that are hidden behind geometry
+	VertexList* m_pOverlayList = nullptr; //per thread lines that are drawn on top of everything
+
+	std::vector<vector3> m_circleList; //unit circle on the XY plane used for the sphere rings
+
+	GLuint m_uShader = 0; //shader program
+	GLuint m_uVAO = 0; //vertex array object
+	GLuint m_uVBO = 0; //streaming vertex buffer
+	uint m_uVBOCapacity = 0; //vertices that fit in the vertex buffer
+	GLint m_nVP = -1; //location of the view projection uniform
+
+	uint m_uLastCount = 0; //vertices drawn on the last Render call
+
+	static MyDebugDraw* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyDebugDraw* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds a line segment
+	ARGUMENTS:
+	-	vector3 a_v3Start -> start of the segment in world space
+	-	vector3 a_v3End -> end of the segment in world space
+	-	vector3 a_v3Color -> color of the segment
+	-	bool a_bOverlay = false -> draw on top of the geometry?
+	OUTPUT: ---
+	*/
+	void AddLine(vector3 a_v3Start, vector3 a_v3End, vector3 a_v3Color, bool a_bOverlay = false);
+	/*
+	USAGE: Adds the 12 edges of a box
+	ARGUMENTS:
+	-	matrix4 const& a_m4Transform -> transform of a unit cube centered at the origin
+	-	vector3 a_v3Color -> color of the edges
+	-	bool a_bOverlay = false -> draw on top of the geometry?
+	OUTPUT: ---
+	*/
+	void AddBox(matrix4 const& a_m4Transform, vector3 a_v3Color, bool a_bOverlay = false);
+	/*
+	USAGE: Adds the 12 edges of an axis aligned box
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	vector3 a_v3Color -> color of the edges
+	-	bool a_bOverlay = false -> draw on top of the geometry?
+	OUTPUT: ---
+	*/
+	void AddBox(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Color, bool a_bOverlay = false);
+	/*
+	USAGE: Adds three rings (one per axis plane) of a sphere
+	ARGUMENTS:
+	-	matrix4 const& a_m4Transform -> transform of a unit sphere centered at the origin
+	-	vector3 a_v3Color -> color of the rings
+	-	bool a_bOverlay = false -> draw on top of the geometry?
+	OUTPUT: ---
+	*/
+	void AddSphere(matrix4 const& a_m4Transform, vector3 a_v3Color, bool a_bOverlay = false);
+	/*
+	USAGE: Adds the X (red), Y (green) and Z (blue) axis of a space
+	ARGUMENTS:
+	-	matrix4 const& a_m4Transform -> space to draw the axis of
+	-	bool a_bOverlay = true -> draw on top of the geometry?
+	OUTPUT: ---
+	*/
+	void AddAxis(matrix4 const& a_m4Transform, bool a_bOverlay = true);
+	/*
+	USAGE: Adds a grid on the XZ plane of a space
+	ARGUMENTS:
+	-	matrix4 const& a_m4Transform -> space of the grid
+	-	float a_fSize -> length of the side of the grid
+	-	uint a_uDivisions -> number of cells per side
+	-	vector3 a_v3Color -> color of the grid
+	-	bool a_bOverlay = false -> draw on top of the geometry?
+	OUTPUT: ---
+	*/
+	void AddGrid(matrix4 const& a_m4Transform, float a_fSize, uint a_uDivisions, vector3 a_v3Color, bool a_bOverlay = false);
+	/*
+	USAGE: Moves the lines added this frame by all the threads to two lists drawn by another thread, then
+	forgets them; both sides keep their memory from frame to frame
+	ARGUMENTS:
+	-	VertexList& a_depthList -> gets the lines hidden behind geometry
+	-	VertexList& a_overlayList -> gets the lines drawn on top of everything
+	OUTPUT: ---
+	*/
+	void Publish(VertexList& a_depthList, VertexList& a_overlayList);
+	/*
+	USAGE: Uploads the lines in a single buffer and draws them, one call for the depth tested ones and one
+	for the overlay. Call from the thread with the context after the scene has been rendered.
+	ARGUMENTS:
+	-	VertexList const& a_depthList -> lines hidden behind geometry
+	-	VertexList const& a_overlayList -> lines drawn on top of everything
+	-	matrix4 const& a_m4ViewProjection -> camera the lines are seen from
+	OUTPUT: ---
+	*/
+	void Render(VertexList const& a_depthList, VertexList const& a_overlayList, matrix4 const& a_m4ViewProjection);
+	/*
+	USAGE: Gets the number of lines drawn on the last Render call
+	ARGUMENTS: ---
+	OUTPUT: line count
+	*/
+	uint GetLineCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyDebugDraw(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyDebugDraw(MyDebugDraw const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyDebugDraw& operator=(MyDebugDraw const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyDebugDraw(void);
+	/*
+	Usage: releases the allocated member pointers and OpenGL objects
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Creates the shader and the buffers, done on the first Render so we are sure there is a context
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void CreateDeviceObjects(void);
+	/*
+	USAGE: Gets the list of the calling thread
+	ARGUMENTS: bool a_bOverlay -> overlay list?
+	OUTPUT: vertex list
+	*/
+	VertexList& GetList(bool a_bOverlay);
+};//class
+
+#ifndef MYDEBUGDRAW
+//On release builds all the calls compile to nothing, the instance is an empty placeholder
+inline MyDebugDraw::MyDebugDraw(void) { }
+inline MyDebugDraw::~MyDebugDraw(void) { }
+inline MyDebugDraw* MyDebugDraw::GetInstance()
+{
+	static MyDebugDraw instance;
+	return &instance;
+}
+inline void MyDebugDraw::ReleaseInstance(void) { }
+inline void MyDebugDraw::AddLine(vector3 a_v3Start, vector3 a_v3End, vector3 a_v3Color, bool a_bOverlay) { }
+inline void MyDebugDraw::AddBox(matrix4 const& a_m4Transform, vector3 a_v3Color, bool a_bOverlay) { }
+inline void MyDebugDraw::AddBox(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Color, bool a_bOverlay) { }
+inline void MyDebugDraw::AddSphere(matrix4 const& a_m4Transform, vector3 a_v3Color, bool a_bOverlay) { }
+inline void MyDebugDraw::AddAxis(matrix4 const& a_m4Transform, bool a_bOverlay) { }
+inline void MyDebugDraw::AddGrid(matrix4 const& a_m4Transform, float a_fSize, uint a_uDivisions, vector3 a_v3Color, bool a_bOverlay) { }
+inline void MyDebugDraw::Publish(VertexList& a_depthList, VertexList& a_overlayList) { }
+inline void MyDebugDraw::Render(VertexList const& a_depthList, VertexList const& a_overlayList, matrix4 const& a_m4ViewProjection) { }
+inline uint MyDebugDraw::GetLineCount(void) { return 0; }
+#endif //MYDEBUGDRAW
+
+} //namespace Simplex
+
+#endif //__MYDEBUGDRAW_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
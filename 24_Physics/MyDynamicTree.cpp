@@ -0,0 +1,539 @@
+#include "MyDynamicTree.h"
+using namespace Simplex;
+//helpers (parenthesis keep the min/max macros of windows.h away)
+static vector3 MinV3(vector3 a_v3A, vector3 a_v3B) { return (glm::min)(a_v3A, a_v3B); }
+static vector3 MaxV3(vector3 a_v3A, vector3 a_v3B) { return (glm::max)(a_v3A, a_v3B); }
+static int MaxInt(int a_nA, int a_nB) { return a_nA > a_nB ? a_nA : a_nB; }
+//  MyDynamicTree
+Simplex::MyDynamicTree::MyDynamicTree(void)
+{
+	m_uNodeCapacity = 16;
+	m_uNodeCount = 0;
+	m_pNode = new MyTreeNode[m_uNodeCapacity];
+	//link all the nodes in the free list
+	for (uint i = 0; i < m_uNodeCapacity; ++i)
+	{
+		m_pNode[i].m_nParent = i + 1;
+		m_pNode[i].m_nHeight = -1;
+	}
+	m_pNode[m_uNodeCapacity - 1].m_nParent = -1;
+	m_nFreeList = 0;
+	m_nRoot = -1;
+	m_fMargin = 0.1f;
+}
+Simplex::MyDynamicTree::MyDynamicTree(MyDynamicTree const& other) { }
+Simplex::MyDynamicTree& Simplex::MyDynamicTree::operator=(MyDynamicTree const& other) { return *this; }
+Simplex::MyDynamicTree::~MyDynamicTree(void)
+{
+	if (m_pNode)
+	{
+		delete[] m_pNode;
+		m_pNode = nullptr;
+	}
+	m_uNodeCapacity = 0;
+	m_uNodeCount = 0;
+	m_nFreeList = -1;
+	m_nRoot = -1;
+	m_proxyList.clear();
+}
+//Accessors
+Simplex::String Simplex::MyDynamicTree::GetName(void) { return "Dynamic AABB Tree"; }
+int Simplex::MyDynamicTree::GetHeight(void) { return m_nRoot == -1 ? 0 : m_pNode[m_nRoot].m_nHeight + 1; }
+void Simplex::MyDynamicTree::SetMargin(float a_fMargin) { m_fMargin = a_fMargin; }
+//Node pool
+int Simplex::MyDynamicTree::AllocateNode(void)
+{
+	//if the pool is empty double it and link the new nodes in the free list
+	if (m_nFreeList == -1)
+	{
+		MyTreeNode* pTemp = new MyTreeNode[m_uNodeCapacity * 2];
+		memcpy(pTemp, m_pNode, sizeof(MyTreeNode) * m_uNodeCapacity);
+		delete[] m_pNode;
+		m_pNode = pTemp;
+		for (uint i = m_uNodeCapacity; i < m_uNodeCapacity * 2; ++i)
+		{
+			m_pNode[i].m_nParent = i + 1;
+			m_pNode[i].m_nHeight = -1;
+		}
+		m_pNode[m_uNodeCapacity * 2 - 1].m_nParent = -1;
+		m_nFreeList = m_uNodeCapacity;
+		m_uNodeCapacity *= 2;
+	}
+
+	int nNode = m_nFreeList;
+	m_nFreeList = m_pNode[nNode].m_nParent;
+	m_pNode[nNode].m_nParent = -1;
+	m_pNode[nNode].m_nChild1 = -1;
+	m_pNode[nNode].m_nChild2 = -1;
+	m_pNode[nNode].m_nHeight = 0;
+	m_pNode[nNode].m_uEntity = 0;
+	++m_uNodeCount;
+	return nNode;
+}
+void Simplex::MyDynamicTree::FreeNode(int a_nNode)
+{
+	m_pNode[a_nNode].m_nParent = m_nFreeList;
+	m_pNode[a_nNode].m_nHeight = -1;
+	m_nFreeList = a_nNode;
+	--m_uNodeCount;
+}
+//Tree
+float Simplex::MyDynamicTree::Area(vector3 a_v3Min, vector3 a_v3Max)
+{
+	vector3 v3Size = a_v3Max - a_v3Min;
+	return 2.0f * (v3Size.x * v3Size.y + v3Size.y * v3Size.z + v3Size.z * v3Size.x);
+}
+bool Simplex::MyDynamicTree::Overlap(vector3 a_v3MinA, vector3 a_v3MaxA, vector3 a_v3MinB, vector3 a_v3MaxB)
+{
+	if (a_v3MaxA.x < a_v3MinB.x || a_v3MinA.x > a_v3MaxB.x)
+		return false;
+	if (a_v3MaxA.y < a_v3MinB.y || a_v3MinA.y > a_v3MaxB.y)
+		return false;
+	if (a_v3MaxA.z < a_v3MinB.z || a_v3MinA.z > a_v3MaxB.z)
+		return false;
+	return true;
+}
+void Simplex::MyDynamicTree::SetFatAABB(int a_nLeaf, MyEntity* a_pEntity)
+{
+	MyRigidBody* pRigidBody = a_pEntity->GetRigidBody();
+	vector3 v3Min = pRigidBody->GetMinGlobal();
+	vector3 v3Max = pRigidBody->GetMaxGlobal();
+	//the fat AABB grows with the size so big and small bodies get a similar amount of slack
+	vector3 v3Margin = (v3Max - v3Min) * m_fMargin + vector3(0.05f);
+	m_pNode[a_nLeaf].m_v3Min = v3Min - v3Margin;
+	m_pNode[a_nLeaf].m_v3Max = v3Max + v3Margin;
+}
+int Simplex::MyDynamicTree::CreateLeaf(MyEntity* a_pEntity, uint a_uEntity)
+{
+	int nLeaf = AllocateNode();
+	m_pNode[nLeaf].m_uEntity = a_uEntity;
+	SetFatAABB(nLeaf, a_pEntity);
+	InsertLeaf(nLeaf);
+	return nLeaf;
+}
+void Simplex::MyDynamicTree::InsertLeaf(int a_nLeaf)
+{
+	if (m_nRoot == -1)
+	{
+		m_nRoot = a_nLeaf;
+		m_pNode[m_nRoot].m_nParent = -1;
+		return;
+	}
+
+	//descend the tree looking for the cheapest sibling
+	vector3 v3LeafMin = m_pNode[a_nLeaf].m_v3Min;
+	vector3 v3LeafMax = m_pNode[a_nLeaf].m_v3Max;
+	int nIndex = m_nRoot;
+	while (m_pNode[nIndex].m_nChild1 != -1)
+	{
+		MyTreeNode& node = m_pNode[nIndex];
+		int nChild1 = node.m_nChild1;
+		int nChild2 = node.m_nChild2;
+
+		float fArea = Area(node.m_v3Min, node.m_v3Max);
+		float fCombinedArea = Area(MinV3(node.m_v3Min, v3LeafMin), MaxV3(node.m_v3Max, v3LeafMax));
+
+		//cost of creating a new parent for this node and the new leaf
+		float fCost = 2.0f * fCombinedArea;
+		//minimum cost of pushing the leaf further down the tree
+		float fInheritanceCost = 2.0f * (fCombinedArea - fArea);
+
+		float fCost1 = Area(MinV3(m_pNode[nChild1].m_v3Min, v3LeafMin), MaxV3(m_pNode[nChild1].m_v3Max, v3LeafMax)) + fInheritanceCost;
+		if (m_pNode[nChild1].m_nChild1 != -1)
+			fCost1 -= Area(m_pNode[nChild1].m_v3Min, m_pNode[nChild1].m_v3Max);
+
+		float fCost2 = Area(MinV3(m_pNode[nChild2].m_v3Min, v3LeafMin), MaxV3(m_pNode[nChild2].m_v3Max, v3LeafMax)) + fInheritanceCost;
+		if (m_pNode[nChild2].m_nChild1 != -1)
+			fCost2 -= Area(m_pNode[nChild2].m_v3Min, m_pNode[nChild2].m_v3Max);
+
+		//descend according to the minimum cost
+		if (fCost < fCost1 && fCost < fCost2)
+			break;
+		nIndex = fCost1 < fCost2 ? nChild1 : nChild2;
+	}
+	int nSibling = nIndex;
+
+	//create a new parent for the sibling and the leaf
+	int nOldParent = m_pNode[nSibling].m_nParent;
+	int nNewParent = AllocateNode();
+	m_pNode[nNewParent].m_nParent = nOldParent;
+	m_pNode[nNewParent].m_v3Min = MinV3(m_pNode[nSibling].m_v3Min, v3LeafMin);
+	m_pNode[nNewParent].m_v3Max = MaxV3(m_pNode[nSibling].m_v3Max, v3LeafMax);
+	m_pNode[nNewParent].m_nHeight = m_pNode[nSibling].m_nHeight + 1;
+	m_pNode[nNewParent].m_nChild1 = nSibling;
+	m_pNode[nNewParent].m_nChild2 = a_nLeaf;
+	m_pNode[nSibling].m_nParent = nNewParent;
+	m_pNode[a_nLeaf].m_nParent = nNewParent;
+
+	if (nOldParent != -1)
+	{
+		if (m_pNode[nOldParent].m_nChild1 == nSibling)
+			m_pNode[nOldParent].m_nChild1 = nNewParent;
+		else
+			m_pNode[nOldParent].m_nChild2 = nNewParent;
+	}
+	else
+	{
+		m_nRoot = nNewParent;
+	}
+
+	//walk back up fixing heights and AABBs
+	Refit(m_pNode[a_nLeaf].m_nParent);
+}
+void Simplex::MyDynamicTree::RemoveLeaf(int a_nLeaf)
+{
+	if (a_nLeaf == m_nRoot)
+	{
+		m_nRoot = -1;
+		return;
+	}
+
+	int nParent = m_pNode[a_nLeaf].m_nParent;
+	int nGrandParent = m_pNode[nParent].m_nParent;
+	int nSibling = m_pNode[nParent].m_nChild1 == a_nLeaf ? m_pNode[nParent].m_nChild2 : m_pNode[nParent].m_nChild1;
+
+	if (nGrandParent != -1)
+	{
+		//destroy the parent and connect the sibling to the grand parent
+		if (m_pNode[nGrandParent].m_nChild1 == nParent)
+			m_pNode[nGrandParent].m_nChild1 = nSibling;
+		else
+			m_pNode[nGrandParent].m_nChild2 = nSibling;
+		m_pNode[nSibling].m_nParent = nGrandParent;
+		FreeNode(nParent);
+
+		Refit(nGrandParent);
+	}
+	else
+	{
+		m_nRoot = nSibling;
+		m_pNode[nSibling].m_nParent = -1;
+		FreeNode(nParent);
+	}
+}
+void Simplex::MyDynamicTree::Refit(int a_nNode)
+{
+	while (a_nNode != -1)
+	{
+		a_nNode = Balance(a_nNode);
+
+		MyTreeNode& node = m_pNode[a_nNode];
+		MyTreeNode& child1 = m_pNode[node.m_nChild1];
+		MyTreeNode& child2 = m_pNode[node.m_nChild2];
+		node.m_nHeight = 1 + MaxInt(child1.m_nHeight, child2.m_nHeight);
+		node.m_v3Min = MinV3(child1.m_v3Min, child2.m_v3Min);
+		node.m_v3Max = MaxV3(child1.m_v3Max, child2.m_v3Max);
+
+		a_nNode = node.m_nParent;
+	}
+}
+int Simplex::MyDynamicTree::Balance(int a_nNode)
+{
+	int iA = a_nNode;
+	MyTreeNode& A = m_pNode[iA];
+	if (A.m_nChild1 == -1 || A.m_nHeight < 2)
+		return iA;
+
+	int iB = A.m_nChild1;
+	int iC = A.m_nChild2;
+	MyTreeNode& B = m_pNode[iB];
+	MyTreeNode& C = m_pNode[iC];
+
+	int nBalance = C.m_nHeight - B.m_nHeight;
+
+	//rotate C up
+	if (nBalance > 1)
+	{
+		int iF = C.m_nChild1;
+		int iG = C.m_nChild2;
+		MyTreeNode& F = m_pNode[iF];
+		MyTreeNode& G = m_pNode[iG];
+
+		//swap A and C
+		C.m_nChild1 = iA;
+		C.m_nParent = A.m_nParent;
+		A.m_nParent = iC;
+
+		//A's old parent should point to C
+		if (C.m_nParent != -1)
+		{
+			if (m_pNode[C.m_nParent].m_nChild1 == iA)
+				m_pNode[C.m_nParent].m_nChild1 = iC;
+			else
+				m_pNode[C.m_nParent].m_nChild2 = iC;
+		}
+		else
+		{
+			m_nRoot = iC;
+		}
+
+		//the taller grandchild stays with C
+		if (F.m_nHeight > G.m_nHeight)
+		{
+			C.m_nChild2 = iF;
+			A.m_nChild2 = iG;
+			G.m_nParent = iA;
+			A.m_v3Min = MinV3(B.m_v3Min, G.m_v3Min);
+			A.m_v3Max = MaxV3(B.m_v3Max, G.m_v3Max);
+			C.m_v3Min = MinV3(A.m_v3Min, F.m_v3Min);
+			C.m_v3Max = MaxV3(A.m_v3Max, F.m_v3Max);
+			A.m_nHeight = 1 + MaxInt(B.m_nHeight, G.m_nHeight);
+			C.m_nHeight = 1 + MaxInt(A.m_nHeight, F.m_nHeight);
+		}
+		else
+		{
+			C.m_nChild2 = iG;
+			A.m_nChild2 = iF;
+			F.m_nParent = iA;
+			A.m_v3Min = MinV3(B.m_v3Min, F.m_v3Min);
+			A.m_v3Max = MaxV3(B.m_v3Max, F.m_v3Max);
+			C.m_v3Min = MinV3(A.m_v3Min, G.m_v3Min);
+			C.m_v3Max = MaxV3(A.m_v3Max, G.m_v3Max);
+			A.m_nHeight = 1 + MaxInt(B.m_nHeight, F.m_nHeight);
+			C.m_nHeight = 1 + MaxInt(A.m_nHeight, G.m_nHeight);
+		}
+		return iC;
+	}
+
+	//rotate B up
+	if (nBalance < -1)
+	{
+		int iD = B.m_nChild1;
+		int iE = B.m_nChild2;
+		MyTreeNode& D = m_pNode[iD];
+		MyTreeNode& E = m_pNode[iE];
+
+		//swap A and B
+		B.m_nChild1 = iA;
+		B.m_nParent = A.m_nParent;
+		A.m_nParent = iB;
+
+		//A's old parent should point to B
+		if (B.m_nParent != -1)
+		{
+			if (m_pNode[B.m_nParent].m_nChild1 == iA)
+				m_pNode[B.m_nParent].m_nChild1 = iB;
+			else
+				m_pNode[B.m_nParent].m_nChild2 = iB;
+		}
+		else
+		{
+			m_nRoot = iB;
+		}
+
+		//the taller grandchild stays with B
+		if (D.m_nHeight > E.m_nHeight)
+		{
+			B.m_nChild2 = iD;
+			A.m_nChild1 = iE;
+			E.m_nParent = iA;
+			A.m_v3Min = MinV3(C.m_v3Min, E.m_v3Min);
+			A.m_v3Max = MaxV3(C.m_v3Max, E.m_v3Max);
+			B.m_v3Min = MinV3(A.m_v3Min, D.m_v3Min);
+			B.m_v3Max = MaxV3(A.m_v3Max, D.m_v3Max);
+			A.m_nHeight = 1 + MaxInt(C.m_nHeight, E.m_nHeight);
+			B.m_nHeight = 1 + MaxInt(A.m_nHeight, D.m_nHeight);
+		}
+		else
+		{
+			B.m_nChild2 = iE;
+			A.m_nChild1 = iD;
+			D.m_nParent = iA;
+			A.m_v3Min = MinV3(C.m_v3Min, D.m_v3Min);
+			A.m_v3Max = MaxV3(C.m_v3Max, D.m_v3Max);
+			B.m_v3Min = MinV3(A.m_v3Min, E.m_v3Min);
+			B.m_v3Max = MaxV3(A.m_v3Max, E.m_v3Max);
+			A.m_nHeight = 1 + MaxInt(C.m_nHeight, D.m_nHeight);
+			B.m_nHeight = 1 + MaxInt(A.m_nHeight, E.m_nHeight);
+		}
+		return iB;
+	}
+
+	return iA;
+}
+//Broad phase
+void Simplex::MyDynamicTree::Update(PEntity* a_pEntityArray, uint a_uEntityCount)
+{
+	//entities removed from the end of the list
+	while (m_proxyList.size() > a_uEntityCount)
+	{
+		RemoveLeaf(m_proxyList.back().m_nLeaf);
+		FreeNode(m_proxyList.back().m_nLeaf);
+		m_proxyList.pop_back();
+	}
+
+	for (uint i = 0; i < a_uEntityCount; ++i)
+	{
+		MyEntity* pEntity = a_pEntityArray[i];
+
+		//new entity at the end of the list
+		if (i >= m_proxyList.size())
+		{
+			MyTreeProxy proxy;
+			proxy.m_pEntity = pEntity;
+			proxy.m_nLeaf = CreateLeaf(pEntity, i);
+			m_proxyList.push_back(proxy);
+			continue;
+		}
+
+		//a different entity is in this slot (the list changed)
+		MyTreeProxy& proxy = m_proxyList[i];
+		if (proxy.m_pEntity != pEntity)
+		{
+			RemoveLeaf(proxy.m_nLeaf);
+			FreeNode(proxy.m_nLeaf);
+			proxy.m_pEntity = pEntity;
+			proxy.m_nLeaf = CreateLeaf(pEntity, i);
+			continue;
+		}
+
+		//reinsert only if the body left its fat AABB
+		MyRigidBody* pRigidBody = pEntity->GetRigidBody();
+		MyTreeNode& leaf = m_pNode[proxy.m_nLeaf];
+		vector3 v3Min = pRigidBody->GetMinGlobal();
+		vector3 v3Max = pRigidBody->GetMaxGlobal();
+		if (v3Min.x < leaf.m_v3Min.x || v3Min.y < leaf.m_v3Min.y || v3Min.z < leaf.m_v3Min.z ||
+			v3Max.x > leaf.m_v3Max.x || v3Max.y > leaf.m_v3Max.y || v3Max.z > leaf.m_v3Max.z)
+		{
+			RemoveLeaf(proxy.m_nLeaf);
+			SetFatAABB(proxy.m_nLeaf, pEntity);
+			InsertLeaf(proxy.m_nLeaf);
+		}
+	}
+}
+void Simplex::MyDynamicTree::GetPairs(std::vector<MyBroadPhasePair>& a_pairList)
+{
+	a_pairList.clear();
+	if (m_nRoot == -1)
+		return;
+
+	for (uint i = 0; i < m_proxyList.size(); ++i)
+	{
+		//sleeping entities do not look for pairs, the awake ones find them
+		if (m_proxyList[i].m_pEntity->IsAsleep())
+			continue;
+
+		int nLeaf = m_proxyList[i].m_nLeaf;
+		vector3 v3Min = m_pNode[nLeaf].m_v3Min;
+		vector3 v3Max = m_pNode[nLeaf].m_v3Max;
+
+		m_stack.clear();
+		m_stack.push_back(m_nRoot);
+		while (m_stack.size() > 0)
+		{
+			int nNode = m_stack.back();
+			m_stack.pop_back();
+
+			MyTreeNode& node = m_pNode[nNode];
+			if (!Overlap(v3Min, v3Max, node.m_v3Min, node.m_v3Max))
+				continue;
+
+			if (node.m_nChild1 != -1)
+			{
+				m_stack.push_back(node.m_nChild1);
+				m_stack.push_back(node.m_nChild2);
+				continue;
+			}
+
+			//each pair of awake entities is reported once, by the one with the lower index
+			uint j = node.m_uEntity;
+			if (j == i)
+				continue;
+			bool bOtherAsleep = m_proxyList[j].m_pEntity->IsAsleep();
+			if (!bOtherAsleep && j < i)
+				continue;
+
+			MyBroadPhasePair pair;
+			pair.m_uA = i < j ? i : j;
+			pair.m_uB = i < j ? j : i;
+			a_pairList.push_back(pair);
+		}
+	}
+}
+//Queries (each one keeps its own stack so several threads can query at the same time)
+void Simplex::MyDynamicTree::QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	if (m_nRoot == -1)
+		return;
+
+	int nStack[m_nMaxStack];
+	int nStackSize = 0;
+	nStack[nStackSize++] = m_nRoot;
+	while (nStackSize > 0)
+	{
+		MyTreeNode& node = m_pNode[nStack[--nStackSize]];
+		if (!Overlap(a_v3Min, a_v3Max, node.m_v3Min, node.m_v3Max))
+			continue;
+
+		if (node.m_nChild1 != -1)
+		{
+			nStack[nStackSize++] = node.m_nChild1;
+			nStack[nStackSize++] = node.m_nChild2;
+		}
+		else
+		{
+			a_entityList.push_back(node.m_uEntity);
+		}
+	}
+}
+void Simplex::MyDynamicTree::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+	std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	if (m_nRoot == -1)
+		return;
+
+	vector3 v3Radius = vector3(a_fRadius);
+	float fEnter, fExit;
+	int nStack[m_nMaxStack];
+	int nStackSize = 0;
+	nStack[nStackSize++] = m_nRoot;
+	while (nStackSize > 0)
+	{
+		MyTreeNode& node = m_pNode[nStack[--nStackSize]];
+		if (!IntersectRayAABB(a_v3Origin, a_v3Direction, a_fMaxDistance, node.m_v3Min - v3Radius, node.m_v3Max + v3Radius, fEnter, fExit))
+			continue;
+
+		if (node.m_nChild1 != -1)
+		{
+			nStack[nStackSize++] = node.m_nChild1;
+			nStack[nStackSize++] = node.m_nChild2;
+		}
+		else
+		{
+			a_entityList.push_back(node.m_uEntity);
+		}
+	}
+}
+void Simplex::MyDynamicTree::QuerySphere(vector3 a_v3Center, float a_fRadius, std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	if (m_nRoot == -1)
+		return;
+
+	float fRadiusSquared = a_fRadius * a_fRadius;
+	int nStack[m_nMaxStack];
+	int nStackSize = 0;
+	nStack[nStackSize++] = m_nRoot;
+	while (nStackSize > 0)
+	{
+		MyTreeNode& node = m_pNode[nStack[--nStackSize]];
+
+		//distance from the center to the closest point of the AABB
+		vector3 v3Closest = glm::clamp(a_v3Center, node.m_v3Min, node.m_v3Max);
+		vector3 v3Distance = v3Closest - a_v3Center;
+		if (glm::dot(v3Distance, v3Distance) > fRadiusSquared)
+			continue;
+
+		if (node.m_nChild1 != -1)
+		{
+			nStack[nStackSize++] = node.m_nChild1;
+			nStack[nStackSize++] = node.m_nChild2;
+		}
+		else
+		{
+			a_entityList.push_back(node.m_uEntity);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYDYNAMICTREE_H_
+#define __MYDYNAMICTREE_H_
+
+#include "MyBroadPhase.h"
+
+namespace Simplex
+{
+
+//Node of the tree, leaves hold an entity
+struct MyTreeNode
+{
+	vector3 m_v3Min; //minimum corner of the (fat for leaves) AABB
+	vector3 m_v3Max; //maximum corner of the (fat for leaves) AABB
+	int m_nParent; //parent node, next free node while in the free list
+	int m_nChild1; //first child, -1 for leaves
+	int m_nChild2; //second child, -1 for leaves
+	int m_nHeight; //0 for leaves, -1 for free nodes
+	uint m_uEntity; //index of the entity held by a leaf
+};
+
+//Dynamic bounding volume hierarchy of fat AABBs
+class MyDynamicTree : public MyBroadPhase
+{
+	//entity slot of the tree, tells which leaf holds which entity
+	struct MyTreeProxy
+	{
+		MyEntity* m_pEntity; //entity of the slot
+		int m_nLeaf; //leaf holding it
+	};
+
+	static const int m_nMaxStack = 256; //size of the query stacks, balancing keeps the height far below it
+
+	MyTreeNode* m_pNode = nullptr; //node pool
+	uint m_uNodeCapacity = 0; //nodes in the pool
+	uint m_uNodeCount = 0; //nodes in use
+	int m_nFreeList = -1; //first free node of the pool
+	int m_nRoot = -1; //root of the tree
+
+	float m_fMargin = 0.1f; //the AABBs are fattened by this fraction of their size on each side
+
+	std::vector<MyTreeProxy> m_proxyList; //one per entity, in the order of the entity list
+	std::vector<int> m_stack; //traversal stack of the pair search, kept to avoid allocations
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object instance
+	*/
+	MyDynamicTree(void);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyDynamicTree(void);
+	/*
+	USAGE: Refreshes the tree, leaves are reinserted only if their entity left their fat AABB
+	ARGUMENTS:
+	-	PEntity* a_pEntityArray -> list of entities
+	-	uint a_uEntityCount -> number of entities in the list
+	OUTPUT: ---
+	*/
+	void Update(PEntity* a_pEntityArray, uint a_uEntityCount) override;
+	/*
+	USAGE: Gets the pairs of entities whose fat AABBs overlap, queries only from the awake entities
+	ARGUMENTS: std::vector<MyBroadPhasePair>& a_pairList -> list to fill (will be cleared first)
+	OUTPUT: ---
+	*/
+	void GetPairs(std::vector<MyBroadPhasePair>& a_pairList) override;
+	/*
+	USAGE: Gets the name of the broad phase
+	ARGUMENTS: ---
+	OUTPUT: name
+	*/
+	String GetName(void) override;
+	/*
+	USAGE: Gets the entities whose fat AABB overlaps an AABB
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList) override;
+	/*
+	USAGE: Gets the entities whose fat AABB, grown by a radius, is hit by a ray
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> direction of the ray (does not need to be normalized)
+	-	float a_fMaxDistance -> length of the ray in units of the direction
+	-	float a_fRadius -> how much the boxes grow
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+		std::vector<uint>& a_entityList) override;
+	/*
+	USAGE: Gets the entities whose fat AABB overlaps a sphere
+	ARGUMENTS:
+	-	vector3 a_v3Center -> center of the sphere
+	-	float a_fRadius -> radius of the sphere
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void QuerySphere(vector3 a_v3Center, float a_fRadius, std::vector<uint>& a_entityList);
+	/*
+	USAGE: Gets the height of the tree
+	ARGUMENTS: ---
+	OUTPUT: height, 0 if empty
+	*/
+	int GetHeight(void);
+	/*
+	USAGE: Sets how much the AABBs are fattened
+	ARGUMENTS: float a_fMargin -> fraction of the size added on each side
+	OUTPUT: ---
+	*/
+	void SetMargin(float a_fMargin);
+private:
+	/*
+	USAGE: copy constructor, trees are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyDynamicTree(MyDynamicTree const& other);
+	/*
+	USAGE: copy assignment operator, trees are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyDynamicTree& operator=(MyDynamicTree const& other);
+	/*
+	USAGE: Takes a node from the pool, growing it if needed
+	ARGUMENTS: ---
+	OUTPUT: index of the node
+	*/
+	int AllocateNode(void);
+	/*
+	USAGE: Returns a node to the pool
+	ARGUMENTS: int a_nNode -> node to free
+	OUTPUT: ---
+	*/
+	void FreeNode(int a_nNode);
+	/*
+	USAGE: Creates a leaf for an entity with its fat AABB
+	ARGUMENTS:
+	-	MyEntity* a_pEntity -> entity
+	-	uint a_uEntity -> index of the entity
+	OUTPUT: index of the leaf
+	*/
+	int CreateLeaf(MyEntity* a_pEntity, uint a_uEntity);
+	/*
+	USAGE: Finds the best sibling for a leaf using the surface area heuristic and inserts it
+	ARGUMENTS: int a_nLeaf -> leaf to insert
+	OUTPUT: ---
+	*/
+	void InsertLeaf(int a_nLeaf);
+	/*
+	USAGE: Removes a leaf from the tree (the node is kept)
+	ARGUMENTS: int a_nLeaf -> leaf to remove
+	OUTPUT: ---
+	*/
+	void RemoveLeaf(int a_nLeaf);
+	/*
+	USAGE: Rotates the subtree if it is unbalanced
+	ARGUMENTS: int a_nNode -> root of the subtree
+	OUTPUT: new root of the subtree
+	*/
+	int Balance(int a_nNode);
+	/*
+	USAGE: Refits the AABBs and heights from a node up to the root, balancing on the way
+	ARGUMENTS: int a_nNode -> first node to refit
+	OUTPUT: ---
+	*/
+	void Refit(int a_nNode);
+	/*
+	USAGE: Sets the fat AABB of a leaf from the ARBB of its entity
+	ARGUMENTS:
+	-	int a_nLeaf -> leaf
+	-	MyEntity* a_pEntity -> entity
+	OUTPUT: ---
+	*/
+	void SetFatAABB(int a_nLeaf, MyEntity* a_pEntity);
+	/*
+	USAGE: Computes the surface area of an AABB
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	OUTPUT: area
+	*/
+	static float Area(vector3 a_v3Min, vector3 a_v3Max);
+	/*
+	USAGE: Tells if two AABBs overlap
+	ARGUMENTS:
+	-	vector3 a_v3MinA -> minimum corner of the first
+	-	vector3 a_v3MaxA -> maximum corner of the first
+	-	vector3 a_v3MinB -> minimum corner of the second
+	-	vector3 a_v3MaxB -> maximum corner of the second
+	OUTPUT: do they overlap?
+	*/
+	static bool Overlap(vector3 a_v3MinA, vector3 a_v3MaxA, vector3 a_v3MinB, vector3 a_v3MaxB);
+};
+
+} //namespace Simplex
+
+#endif //__MYDYNAMICTREE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -1,27 +1,99 @@
 #include "MyEntity.h"
+#include "MyRenderThread.h"
 using namespace Simplex;
 std::map<String, MyEntity*> MyEntity::m_IDMap;
+std::map<String, std::vector<uint>> MyEntity::m_meshListMap;
+std::map<String, MyConvexHull*> MyEntity::m_hullMap;
+//are the meshes, drawn with the matrix of the entity, the model as it draws itself? the vertices of the
+//model are the ones of its groups in model space, they match only if every group is at the origin
+static bool IsModelAtOrigin(Model* a_pModel, std::vector<uint> const& a_meshList)
+{
+	MeshManager* pMeshMngr = MeshManager::GetInstance();
+	std::vector<vector3> modelList = a_pModel->GetVertexList();
+	std::vector<vector3> meshList;
+	for (uint i = 0; i < a_meshList.size(); ++i)
+	{
+		Mesh* pMesh = pMeshMngr->GetMesh(a_meshList[i]);
+		if (pMesh == nullptr)
+			return false;
+		std::vector<vector3> vertexList = pMesh->GetVertexList();
+		meshList.insert(meshList.end(), vertexList.begin(), vertexList.end());
+	}
+	if (meshList.size() == 0 || meshList.size() != modelList.size())
+		return false;
+
+	//the groups can come in any order, both lists are sorted before comparing them
+	auto less = [](vector3 const& a, vector3 const& b)
+	{
+		if (a.x != b.x)
+			return a.x < b.x;
+		if (a.y != b.y)
+			return a.y < b.y;
+		return a.z < b.z;
+	};
+	std::sort(modelList.begin(), modelList.end(), less);
+	std::sort(meshList.begin(), meshList.end(), less);
+	for (uint i = 0; i < meshList.size(); ++i)
+	{
+		if (glm::distance(modelList[i], meshList[i]) > 0.0001f)
+			return false;
+	}
+	return true;
+}
 //  Accessors
 Simplex::MySolver* Simplex::MyEntity::GetSolver(void) { return m_pSolver; }
 bool Simplex::MyEntity::HasThisRigidBody(MyRigidBody* a_pRigidBody) { return m_pRigidBody == a_pRigidBody; }
 Simplex::MyRigidBody::PRigidBody* Simplex::MyEntity::GetColliderArray(void) { return m_pRigidBody->GetColliderArray(); }
 uint Simplex::MyEntity::GetCollidingCount(void) { return m_pRigidBody->GetCollidingCount(); }
-matrix4 Simplex::MyEntity::GetModelMatrix(void){ return m_m4ToWorld; }
+matrix4 Simplex::MyEntity::GetModelMatrix(void){ return MyArchetypeStore::GetInstance()->Get<MyTransformComponent>(m_uRecord)->m_m4ToWorld; }
 void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
 {
 	if (!m_bInMemory)
 		return;
 
-	m_m4ToWorld = a_m4ToWorld;
-	m_pModel->SetModelMatrix(m_m4ToWorld);
-	m_pRigidBody->SetModelMatrix(m_m4ToWorld);
-	m_pSolver->SetPosition(vector3(m_m4ToWorld[3]));
+	//the same matrix again does not need to go anywhere
+	MyTransformSystem* pTransformSystem = MyTransformSystem::GetInstance();
+	if (!pTransformSystem->SetLocal(m_uTransform, a_m4ToWorld))
+		return;
+
+	//roots know their world matrix already, children need the one of their parent
+	if (pTransformSystem->GetParent(m_uTransform) < 0)
+		ApplyTransform();
+}
+bool Simplex::MyEntity::SetParent(MyEntity* a_pParent)
+{
+	return MyTransformSystem::GetInstance()->SetParent(m_uTransform, a_pParent == nullptr ? -1 : static_cast<int>(a_pParent->GetTransform()));
+}
+uint Simplex::MyEntity::GetTransform(void) { return m_uTransform; }
+void Simplex::MyEntity::ApplyTransform(void)
+{
+	if (!m_bInMemory)
+		return;
+
+	MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+	MyTransformComponent* pTransform = pStore->Get<MyTransformComponent>(m_uRecord);
+	matrix4 m4ToWorld = MyTransformSystem::GetInstance()->GetWorld(m_uTransform);
+	if (m4ToWorld == pTransform->m_m4ToWorld)
+		return;
+
+	pTransform->m_m4ToWorld = m4ToWorld;
+	m_pRigidBody->SetModelMatrix(m4ToWorld);
+	m_pSolver->SetPosition(vector3(m4ToWorld[3]));
+
+	//the box of the component follows the one of the rigid body
+	MyBoundsComponent* pBounds = pStore->Get<MyBoundsComponent>(m_uRecord);
+	pBounds->m_v3Min = m_pRigidBody->GetMinGlobal();
+	pBounds->m_v3Max = m_pRigidBody->GetMaxGlobal();
 }
 Model* Simplex::MyEntity::GetModel(void){return m_pModel;}
+uint Simplex::MyEntity::GetMeshCount(void) { return m_meshList.size(); }
+uint Simplex::MyEntity::GetMeshIndex(uint a_uIndex) { return m_meshList[a_uIndex]; }
 MyRigidBody* Simplex::MyEntity::GetRigidBody(void){	return m_pRigidBody; }
 bool Simplex::MyEntity::IsInitialized(void){ return m_bInMemory; }
 String Simplex::MyEntity::GetUniqueID(void) { return m_sUniqueID; }
 void Simplex::MyEntity::SetAxisVisible(bool a_bSetAxis) { m_bSetAxis = a_bSetAxis; }
+bool Simplex::MyEntity::IsAxisVisible(void) { return m_bSetAxis; }
+uint Simplex::MyEntity::GetRecord(void) { return m_uRecord; }
 void Simplex::MyEntity::SetPosition(vector3 a_v3Position) { if(m_pSolver) m_pSolver->SetPosition(a_v3Position); }
 Simplex::vector3 Simplex::MyEntity::GetPosition(void)
 {
@@ -53,26 +125,35 @@ void Simplex::MyEntity::Init(void)
 	m_bSetAxis = false;
 	m_pModel = nullptr;
 	m_pRigidBody = nullptr;
-	m_DimensionArray = nullptr;
-	m_m4ToWorld = IDENTITY_M4;
 	m_sUniqueID = "";
-	m_nDimensionCount = 0;
-	m_bUsePhysicsSolver = false;
+	m_animation = MyAnimationInstance();
 	m_pSolver = nullptr;
+	m_uTransform = MyTransformSystem::GetInstance()->Create();
+	m_uRecord = MyArchetypeStore::GetInstance()->Create(this, COMPONENT_TRANSFORM);
 }
 void Simplex::MyEntity::Swap(MyEntity& other)
 {
 	m_bInMemory = false;
 	std::swap(m_pModel, other.m_pModel);
 	std::swap(m_pRigidBody, other.m_pRigidBody);
-	std::swap(m_m4ToWorld, other.m_m4ToWorld);
 	std::swap(m_pMeshMngr, other.m_pMeshMngr);
 	std::swap(m_bInMemory, other.m_bInMemory);
 	std::swap(m_sUniqueID, other.m_sUniqueID);
 	std::swap(m_bSetAxis, other.m_bSetAxis);
-	std::swap(m_nDimensionCount, other.m_nDimensionCount);
-	std::swap(m_DimensionArray, other.m_DimensionArray);
 	std::swap(m_pSolver, other.m_pSolver);
+	std::swap(m_meshList, other.m_meshList);
+	std::swap(m_animation, other.m_animation);
+	std::swap(m_uTransform, other.m_uTransform);
+	//the components go with the content, the store needs to know who owns them now
+	std::swap(m_uRecord, other.m_uRecord);
+	MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+	pStore->SetEntity(m_uRecord, this);
+	pStore->SetEntity(other.m_uRecord, &other);
+	//the list moved with the vector, but the component pointing to it did not know
+	if (pStore->HasComponents(m_uRecord, COMPONENT_RENDERMESH))
+		pStore->Get<MyRenderMeshComponent>(m_uRecord)->m_pMesh = m_meshList.data();
+	if (pStore->HasComponents(other.m_uRecord, COMPONENT_RENDERMESH))
+		pStore->Get<MyRenderMeshComponent>(other.m_uRecord)->m_pMesh = other.m_meshList.data();
 }
 void Simplex::MyEntity::Release(void)
 {
@@ -80,13 +161,11 @@ void Simplex::MyEntity::Release(void)
 	//it is not the job of the entity to release the model, 
 	//it is for the mesh manager to do so.
 	m_pModel = nullptr;
-	if (m_DimensionArray)
-	{
-		delete[] m_DimensionArray;
-		m_DimensionArray = nullptr;
-	}
+	ClearDimensionSet();
 	SafeDelete(m_pRigidBody);
 	SafeDelete(m_pSolver);
+	MyTransformSystem::GetInstance()->Destroy(m_uTransform);
+	MyArchetypeStore::GetInstance()->Destroy(m_uRecord);
 	m_IDMap.erase(m_sUniqueID);
 }
 //The big 3
@@ -94,15 +173,57 @@ Simplex::MyEntity::MyEntity(String a_sFileName, String a_sUniqueID)
 {
 	Init();
 	m_pModel = new Model();
-	m_pModel->Load(a_sFileName);
+	uint uMeshCount = m_pMeshMngr->GetMeshCount();
+	//loading compiles meshes and textures, it happens on the render thread if there is one
+	MyRenderThread::GetInstance()->Invoke([this, &a_sFileName]() { m_pModel->Load(a_sFileName); });
 	//if the model is loaded
 	if (m_pModel->GetName() != "")
 	{
+		//the meshes created by the load are the ones of this model, if none were
+		//created the model reused the meshes of a previous load of the same file
+		for (uint i = uMeshCount; i < m_pMeshMngr->GetMeshCount(); ++i)
+		{
+			m_meshList.push_back(i);
+		}
+		if (m_meshList.size() > 0)
+		{
+			//groups away from the origin need their own matrix, those models are drawn whole
+			if (!IsModelAtOrigin(m_pModel, m_meshList))
+				m_meshList.clear();
+			//models are closed so they can hide what is behind them
+			for (uint i = 0; i < m_meshList.size(); ++i)
+			{
+				MyRenderQueue::GetInstance()->AddOccluder(m_meshList[i]);
+			}
+			m_meshListMap[a_sFileName] = m_meshList;
+		}
+		else
+		{
+			auto meshList = m_meshListMap.find(a_sFileName);
+			if (meshList != m_meshListMap.end())
+				m_meshList = meshList->second;
+		}
+
 		GenUniqueID(a_sUniqueID);
 		m_sUniqueID = a_sUniqueID;
 		m_IDMap[a_sUniqueID] = this;
 		m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); //generate a rigid body
 		m_bInMemory = true; //mark this entity as viable
+
+		//entities that know their meshes are drawn by chunk, the others through their model
+		MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+		pStore->AddComponents(m_uRecord, m_meshList.size() > 0 ? COMPONENT_BOUNDS | COMPONENT_RENDERMESH : COMPONENT_BOUNDS);
+		MyBoundsComponent* pBounds = pStore->Get<MyBoundsComponent>(m_uRecord);
+		pBounds->m_v3Min = m_pRigidBody->GetMinGlobal();
+		pBounds->m_v3Max = m_pRigidBody->GetMaxGlobal();
+		pBounds->m_v3CenterLocal = m_pRigidBody->GetCenterLocal();
+		pBounds->m_v3HalfWidth = m_pRigidBody->GetHalfWidth();
+		if (m_meshList.size() > 0)
+		{
+			MyRenderMeshComponent* pRenderMesh = pStore->Get<MyRenderMeshComponent>(m_uRecord);
+			pRenderMesh->m_pMesh = m_meshList.data();
+			pRenderMesh->m_uMeshCount = m_meshList.size();
+		}
 	}
 	m_pSolver = new MySolver();
 }
@@ -112,13 +233,47 @@ Simplex::MyEntity::MyEntity(MyEntity const& other)
 	m_pModel = other.m_pModel;
 	//generate a new rigid body we do not share the same rigid body as we do the model
 	m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); 
-	m_m4ToWorld = other.m_m4ToWorld;
+	m_pRigidBody->SetConvexHull(other.m_pRigidBody->GetConvexHull());
 	m_pMeshMngr = other.m_pMeshMngr;
 	m_sUniqueID = other.m_sUniqueID;
 	m_bSetAxis = other.m_bSetAxis;
-	m_nDimensionCount = other.m_nDimensionCount;
-	m_DimensionArray = other.m_DimensionArray;
 	m_pSolver = new MySolver(*other.m_pSolver);
+	m_meshList = other.m_meshList;
+	m_animation = other.m_animation;
+	//the pose might be in the list of the original, it is sampled again on the next update
+	m_animation.m_pPose = nullptr;
+
+	//the copy has the components of the original, but it is not in the batch of the original
+	MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+	m_uRecord = pStore->Create(this, pStore->GetMask(other.m_uRecord) & ~COMPONENT_STATIC);
+	matrix4 m4ToWorld = pStore->Get<MyTransformComponent>(other.m_uRecord)->m_m4ToWorld;
+	pStore->Get<MyTransformComponent>(m_uRecord)->m_m4ToWorld = m4ToWorld;
+	if (pStore->HasComponents(m_uRecord, COMPONENT_BOUNDS))
+		*pStore->Get<MyBoundsComponent>(m_uRecord) = *pStore->Get<MyBoundsComponent>(other.m_uRecord);
+	if (pStore->HasComponents(m_uRecord, COMPONENT_SOLVER))
+		pStore->Get<MySolverComponent>(m_uRecord)->m_pSolver = m_pSolver;
+	if (pStore->HasComponents(m_uRecord, COMPONENT_RENDERMESH))
+	{
+		MyRenderMeshComponent* pRenderMesh = pStore->Get<MyRenderMeshComponent>(m_uRecord);
+		pRenderMesh->m_pMesh = m_meshList.data();
+		pRenderMesh->m_uMeshCount = m_meshList.size();
+	}
+	//the dimensions are copied, not shared
+	if (pStore->HasComponents(m_uRecord, COMPONENT_DIMENSIONS))
+	{
+		MyDimensionsComponent const* pOther = pStore->Get<MyDimensionsComponent>(other.m_uRecord);
+		MyDimensionsComponent* pDimensions = pStore->Get<MyDimensionsComponent>(m_uRecord);
+		pDimensions->m_uCount = pOther->m_uCount;
+		if (pOther->m_uCount > 0)
+		{
+			pDimensions->m_pDimension = new uint[pOther->m_uCount];
+			memcpy(pDimensions->m_pDimension, pOther->m_pDimension, sizeof(uint) * pOther->m_uCount);
+		}
+	}
+
+	//the copy is a root at the place of the original
+	m_uTransform = MyTransformSystem::GetInstance()->Create();
+	MyTransformSystem::GetInstance()->SetLocal(m_uTransform, m4ToWorld);
 }
 MyEntity& Simplex::MyEntity::operator=(MyEntity const& other)
 {
@@ -139,15 +294,51 @@ void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 	if (!m_bInMemory)
 		return;
 
-	//draw model
-	m_pModel->AddToRenderList();
+	MyRenderQueue* pRenderQueue = MyRenderQueue::GetInstance();
+	matrix4 m4ToWorld = GetModelMatrix();
+
+	//draw model, animated ones draw the meshes of each track with its pose
+	if (m_animation.m_pClip != nullptr && m_animation.m_pPose != nullptr)
+	{
+		MyCommandBuffer* pBuffer = pRenderQueue->GetBuffer();
+		for (uint i = 0; i < m_animation.m_pClip->GetTrackCount(); ++i)
+		{
+			matrix4 m4Pose = m4ToWorld * m_animation.m_pPose[i];
+			std::vector<uint>& meshList = m_animation.m_pClip->GetTrack(i)->m_meshList;
+			for (uint j = 0; j < meshList.size(); ++j)
+			{
+				pBuffer->Push(meshList[j], RENDER_SOLID, m4Pose);
+			}
+		}
+	}
+	//static ones are drawn by the batch they belong to
+	else if (m_meshList.size() > 0 && !IsStatic())
+	{
+		MyCommandBuffer* pBuffer = pRenderQueue->GetBuffer();
+		for (uint i = 0; i < m_meshList.size(); ++i)
+		{
+			pBuffer->Push(m_meshList[i], RENDER_SOLID, m4ToWorld);
+		}
+	}
+	else if (m_meshList.size() == 0)
+	{
+		//we do not know the meshes of this model (or its groups are not at the origin), it goes whole
+		//with the snapshot and the render thread lets the model talk to the MeshManager
+		pRenderQueue->AddModel(m_pModel, m4ToWorld);
+	}
 	
 	//draw rigid body
 	if(a_bDrawRigidBody)
 		m_pRigidBody->AddToRenderList();
 
 	if (m_bSetAxis)
-		m_pMeshMngr->AddAxisToRenderList(m_m4ToWorld);
+	{
+#ifdef MYDEBUGDRAW
+		MyDebugDraw::GetInstance()->AddAxis(m4ToWorld);
+#else
+		pRenderQueue->AddAxis(m4ToWorld);
+#endif //MYDEBUGDRAW
+	}
 }
 MyEntity* Simplex::MyEntity::GetEntity(String a_sUniqueID)
 {
@@ -176,46 +367,55 @@ void Simplex::MyEntity::AddDimension(uint a_uDimension)
 	if (IsInDimension(a_uDimension))
 		return;//it is, so there is no need to add
 
+	//the component is added with the first dimension and kept after, with the octree broad phase
+	//MyLinearOctree::AssignDimensions clears and refills the dimensions on every update and the entity
+	//would change archetype twice each time
+	MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+	if (!pStore->HasComponents(m_uRecord, COMPONENT_DIMENSIONS))
+		pStore->AddComponents(m_uRecord, COMPONENT_DIMENSIONS);
+	MyDimensionsComponent* pDimensions = pStore->Get<MyDimensionsComponent>(m_uRecord);
+
 	//insert the entry
 	uint* pTemp;
-	pTemp = new uint[m_nDimensionCount + 1];
-	if(m_DimensionArray)
+	pTemp = new uint[pDimensions->m_uCount + 1];
+	if(pDimensions->m_pDimension)
 	{
-		memcpy(pTemp, m_DimensionArray, sizeof(uint) * m_nDimensionCount);
-		delete[] m_DimensionArray;
-		m_DimensionArray = nullptr;
+		memcpy(pTemp, pDimensions->m_pDimension, sizeof(uint) * pDimensions->m_uCount);
+		delete[] pDimensions->m_pDimension;
+		pDimensions->m_pDimension = nullptr;
 	}
-	pTemp[m_nDimensionCount] = a_uDimension;
-	m_DimensionArray = pTemp;
+	pTemp[pDimensions->m_uCount] = a_uDimension;
+	pDimensions->m_pDimension = pTemp;
 
-	++m_nDimensionCount;
+	++pDimensions->m_uCount;
 
 	SortDimensions();
 }
 void Simplex::MyEntity::RemoveDimension(uint a_uDimension)
 {
 	//if there are no dimensions return
-	if (m_nDimensionCount == 0)
+	MyDimensionsComponent* pDimensions = MyArchetypeStore::GetInstance()->Get<MyDimensionsComponent>(m_uRecord);
+	if (pDimensions == nullptr || pDimensions->m_uCount == 0)
 		return;
 
 	//we look one by one if its the one wanted
-	for (uint i = 0; i < m_nDimensionCount; i++)
+	for (uint i = 0; i < pDimensions->m_uCount; i++)
 	{
-		if (m_DimensionArray[i] == a_uDimension)
+		if (pDimensions->m_pDimension[i] == a_uDimension)
 		{
 			//if it is, then we swap it with the last one and then we pop
-			std::swap(m_DimensionArray[i], m_DimensionArray[m_nDimensionCount - 1]);
+			std::swap(pDimensions->m_pDimension[i], pDimensions->m_pDimension[pDimensions->m_uCount - 1]);
 			uint* pTemp;
-			pTemp = new uint[m_nDimensionCount - 1];
-			if (m_DimensionArray)
+			pTemp = new uint[pDimensions->m_uCount - 1];
+			if (pDimensions->m_pDimension)
 			{
-				memcpy(pTemp, m_DimensionArray, sizeof(uint) * (m_nDimensionCount-1));
-				delete[] m_DimensionArray;
-				m_DimensionArray = nullptr;
+				memcpy(pTemp, pDimensions->m_pDimension, sizeof(uint) * (pDimensions->m_uCount - 1));
+				delete[] pDimensions->m_pDimension;
+				pDimensions->m_pDimension = nullptr;
 			}
-			m_DimensionArray = pTemp;
+			pDimensions->m_pDimension = pTemp;
 			
-			--m_nDimensionCount;
+			--pDimensions->m_uCount;
 			SortDimensions();
 			return;
 		}
@@ -223,42 +423,53 @@ void Simplex::MyEntity::RemoveDimension(uint a_uDimension)
 }
 void Simplex::MyEntity::ClearDimensionSet(void)
 {
-	if (m_DimensionArray)
+	MyDimensionsComponent* pDimensions = MyArchetypeStore::GetInstance()->Get<MyDimensionsComponent>(m_uRecord);
+	if (pDimensions == nullptr)
+		return;
+	if (pDimensions->m_pDimension)
 	{
-		delete[] m_DimensionArray;
-		m_DimensionArray = nullptr;
+		delete[] pDimensions->m_pDimension;
+		pDimensions->m_pDimension = nullptr;
 	}
-	m_nDimensionCount = 0;
+	pDimensions->m_uCount = 0;
 }
 bool Simplex::MyEntity::IsInDimension(uint a_uDimension)
 {
 	//see if the entry is in the set
-	for (uint i = 0; i < m_nDimensionCount; i++)
+	MyDimensionsComponent* pDimensions = MyArchetypeStore::GetInstance()->Get<MyDimensionsComponent>(m_uRecord);
+	if (pDimensions == nullptr)
+		return false;
+	for (uint i = 0; i < pDimensions->m_uCount; i++)
 	{
-		if (m_DimensionArray[i] == a_uDimension)
+		if (pDimensions->m_pDimension[i] == a_uDimension)
 			return true;
 	}
 	return false;
 }
 bool Simplex::MyEntity::SharesDimension(MyEntity* const a_pOther)
 {
+	MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+	MyDimensionsComponent* pDimensions = pStore->Get<MyDimensionsComponent>(m_uRecord);
+	MyDimensionsComponent* pOther = pStore->Get<MyDimensionsComponent>(a_pOther->m_uRecord);
+	uint uCount = pDimensions == nullptr ? 0 : pDimensions->m_uCount;
+	uint uOtherCount = pOther == nullptr ? 0 : pOther->m_uCount;
 	
 	//special case: if there are no dimensions on either MyEntity
 	//then they live in the special global dimension
-	if (0 == m_nDimensionCount)
+	if (0 == uCount)
 	{
 		//if no spatial optimization all cases should fall here as every 
 		//entity is by default, under the special global dimension only
-		if(0 == a_pOther->m_nDimensionCount)
+		if(0 == uOtherCount)
 			return true;
 	}
 
 	//for each dimension on both Entities we check if there is a common dimension
-	for (uint i = 0; i < m_nDimensionCount; ++i)
+	for (uint i = 0; i < uCount; ++i)
 	{
-		for (uint j = 0; j < a_pOther->m_nDimensionCount; j++)
+		for (uint j = 0; j < uOtherCount; j++)
 		{
-			if (m_DimensionArray[i] == a_pOther->m_DimensionArray[j])
+			if (pDimensions->m_pDimension[i] == pOther->m_pDimension[j])
 				return true; //as soon as we find one we know they share dimensionality
 		}
 	}
@@ -285,28 +496,96 @@ void Simplex::MyEntity::ClearCollisionList(void)
 }
 void Simplex::MyEntity::SortDimensions(void)
 {
-	std::sort(m_DimensionArray, m_DimensionArray + m_nDimensionCount);
+	MyDimensionsComponent* pDimensions = MyArchetypeStore::GetInstance()->Get<MyDimensionsComponent>(m_uRecord);
+	if (pDimensions != nullptr)
+		std::sort(pDimensions->m_pDimension, pDimensions->m_pDimension + pDimensions->m_uCount);
 }
 void Simplex::MyEntity::ApplyForce(vector3 a_v3Force)
 {
 	m_pSolver->ApplyForce(a_v3Force);
 }
+bool Simplex::MyEntity::IsAsleep(void) { return IsUsingPhysicsSolver() && m_pSolver->IsAsleep(); }
+bool Simplex::MyEntity::IsUsingPhysicsSolver(void) { return MyArchetypeStore::GetInstance()->HasComponents(m_uRecord, COMPONENT_SOLVER); }
 void Simplex::MyEntity::Update(void)
 {
-	if (m_bUsePhysicsSolver)
+	//the solver pool already moved the solver, a sleeping one did not move so there is nothing to update
+	if (IsUsingPhysicsSolver() && !m_pSolver->IsAsleep())
 	{
-		m_pSolver->Update();
 		SetModelMatrix(glm::translate(m_pSolver->GetPosition()));
 	}
 }
-void Simplex::MyEntity::ResolveCollision(MyEntity* a_pOther)
+void Simplex::MyEntity::UsePhysicsSolver(bool a_bUse)
 {
-	if (m_bUsePhysicsSolver)
+	m_pSolver->SetSimulated(a_bUse);
+	MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+	if (!a_bUse)
 	{
-		m_pSolver->ResolveCollision(a_pOther->GetSolver());
+		pStore->RemoveComponents(m_uRecord, COMPONENT_SOLVER);
+		return;
 	}
+	pStore->AddComponents(m_uRecord, COMPONENT_SOLVER);
+	pStore->Get<MySolverComponent>(m_uRecord)->m_pSolver = m_pSolver;
 }
-void Simplex::MyEntity::UsePhysicsSolver(bool a_bUse)
+void Simplex::MyEntity::SetStatic(bool a_bStatic)
 {
-	m_bUsePhysicsSolver = a_bUse;
+	if (a_bStatic)
+		MyArchetypeStore::GetInstance()->AddComponents(m_uRecord, COMPONENT_STATIC);
+	else
+		MyArchetypeStore::GetInstance()->RemoveComponents(m_uRecord, COMPONENT_STATIC);
+}
+bool Simplex::MyEntity::IsStatic(void) { return MyArchetypeStore::GetInstance()->HasComponents(m_uRecord, COMPONENT_STATIC); }
+void Simplex::MyEntity::SetAnimation(MyAnimationClip* a_pClip, float a_fFramesPerSecond)
+{
+	//entities that failed to load are not drawn, they cannot play anything either
+	if (a_pClip != nullptr && m_bInMemory)
+		MyArchetypeStore::GetInstance()->AddComponents(m_uRecord, COMPONENT_ANIMATED);
+	else
+		MyArchetypeStore::GetInstance()->RemoveComponents(m_uRecord, COMPONENT_ANIMATED);
+
+	m_animation.m_pClip = a_pClip;
+	m_animation.m_fFrame = 0.0f;
+	m_animation.m_fFramesPerSecond = a_fFramesPerSecond;
+	m_animation.m_poseList.clear();
+	m_animation.m_pPose = nullptr;
+}
+MyAnimationInstance* Simplex::MyEntity::GetAnimation(void) { return &m_animation; }
+void Simplex::MyEntity::AdvanceAnimation(float a_fSeconds)
+{
+	if (m_animation.m_pClip == nullptr || m_animation.m_pClip->GetFrameCount() < 2)
+		return;
+
+	//the last frame is the first one of the next loop
+	float fLength = static_cast<float>(m_animation.m_pClip->GetFrameCount() - 1);
+	m_animation.m_fFrame = glm::mod(m_animation.m_fFrame + a_fSeconds * m_animation.m_fFramesPerSecond, fLength);
+}
+void Simplex::MyEntity::UseConvexHull(bool a_bUse)
+{
+	if (!m_bInMemory)
+		return;
+
+	if (!a_bUse)
+	{
+		m_pRigidBody->SetConvexHull(nullptr);
+		return;
+	}
+
+	//all the entities of a model share its hull
+	MyConvexHull* pConvexHull = nullptr;
+	auto hull = m_hullMap.find(m_pModel->GetName());
+	if (hull != m_hullMap.end())
+		pConvexHull = hull->second;
+	else
+	{
+		pConvexHull = new MyConvexHull(m_pModel->GetVertexList());
+		m_hullMap[m_pModel->GetName()] = pConvexHull;
+	}
+	m_pRigidBody->SetConvexHull(pConvexHull);
+}
+void Simplex::MyEntity::ReleaseConvexHulls(void)
+{
+	for (auto hull = m_hullMap.begin(); hull != m_hullMap.end(); ++hull)
+	{
+		SafeDelete(hull->second);
+	}
+	m_hullMap.clear();
 }
\ No newline at end of file
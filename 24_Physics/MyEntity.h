@@ -6,6 +6,9 @@ Date: 2017/07
 #define __MYENTITY_H_
 
 #include "MySolver.h"
+#include "MyAnimationClip.h"
+#include "MyTransformSystem.h"
+#include "MyArchetypeStore.h"
 
 namespace Simplex
 {
@@ -17,20 +20,22 @@ class MyEntity
 	bool m_bSetAxis = false; //render axis flag
 	String m_sUniqueID = ""; //Unique identifier name
 
-	uint m_nDimensionCount = 0; //tells how many dimensions this entity lives in
-	uint* m_DimensionArray = nullptr; //Dimensions on which this entity is located
-
 	Model* m_pModel = nullptr; //Model associated with this MyEntity
 	MyRigidBody* m_pRigidBody = nullptr; //Rigid Body associated with this MyEntity
 
-	matrix4 m_m4ToWorld = IDENTITY_M4; //Model matrix associated with this MyEntity
+	uint m_uRecord = 0; //record of the entity in the archetype store, its matrix, bounds and dimensions live there
+	uint m_uTransform = 0; //node of the entity in the transform system, its local matrix is the one set
 	MeshManager* m_pMeshMngr = nullptr; //For rendering shapes
 
 	static std::map<String, MyEntity*> m_IDMap; //a map of the unique ID's
 
-	bool m_bUsePhysicsSolver = false; //Indicates if we will use a physics solver 
+	std::vector<uint> m_meshList; //indices of the meshes of the model in the MeshManager, empty if it is drawn whole
+	static std::map<String, std::vector<uint>> m_meshListMap; //mesh indices by file name, for models that share meshes
+	static std::map<String, MyConvexHull*> m_hullMap; //convex hull by model name, built once for all its entities
+
+	MyAnimationInstance m_animation; //clip played by the entity and its pose at the current frame
 
-	MySolver* m_pSolver = nullptr; //Physics MySolver
+	MySolver* m_pSolver = nullptr; //Physics MySolver, in the solver component while the entity uses it
 
 public:
 	/*
@@ -72,12 +77,32 @@ public:
 	*/
 	matrix4 GetModelMatrix(void);
 	/*
-	USAGE: Sets the model matrix associated with this entity
+	USAGE: Sets the model matrix associated with this entity, relative to the parent entity if it has one;
+	nothing is updated if the matrix did not change and children wait for the transform system update
 	ARGUMENTS: matrix4 a_m4ToWorld -> model matrix to set
 	OUTPUT: ---
 	*/
 	void SetModelMatrix(matrix4 a_m4ToWorld);
 	/*
+	USAGE: Makes the entity move with another one, its model matrix becomes relative to the parent
+	ARGUMENTS: MyEntity* a_pParent -> parent entity, nullptr to make it a root
+	OUTPUT: was it set? (an entity cannot be parented to one of its children)
+	*/
+	bool SetParent(MyEntity* a_pParent);
+	/*
+	USAGE: Gets the node of the entity in the transform system
+	ARGUMENTS: ---
+	OUTPUT: transform handle
+	*/
+	uint GetTransform(void);
+	/*
+	USAGE: Moves the model, rigid body and solver to the world matrix of the transform system if it
+	changed, called for the nodes the system reports as changed
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ApplyTransform(void);
+	/*
 	USAGE: Gets the model associated with this entity
 	ARGUMENTS: ---
 	OUTPUT: Model
@@ -96,8 +121,22 @@ public:
 	*/
 	bool IsInitialized(void);
 	/*
-	USAGE: Adds the entity to the render list
+	USAGE: Gets the number of meshes of the model known by this entity, if 0 the entity
+	does not know them and needs to be added to the render list from the main thread
 	ARGUMENTS: ---
+	OUTPUT: mesh count
+	*/
+	uint GetMeshCount(void);
+	/*
+	USAGE: Gets the index in the MeshManager of one of the meshes of the model
+	ARGUMENTS: uint a_uIndex -> mesh of the model (less than GetMeshCount())
+	OUTPUT: index of the mesh in the MeshManager
+	*/
+	uint GetMeshIndex(uint a_uIndex);
+	/*
+	USAGE: Adds the entity to the render list, records in the command buffer of the calling thread
+	so it can be called from a job (if GetMeshCount() > 0)
+	ARGUMENTS: bool a_bDrawRigidBody = false -> add the rigid body as well?
 	OUTPUT: ---
 	*/
 	void AddToRenderList(bool a_bDrawRigidBody = false);
@@ -132,6 +171,18 @@ public:
 	*/
 	void SetAxisVisible(bool a_bSetAxis = true);
 	/*
+	USAGE: Asks if the axis of this MyEntity is visible
+	ARGUMENTS: ---
+	OUTPUT: axis visible?
+	*/
+	bool IsAxisVisible(void);
+	/*
+	USAGE: Gets the record of the entity in the archetype store
+	ARGUMENTS: ---
+	OUTPUT: record
+	*/
+	uint GetRecord(void);
+	/*
 	USAGE: Will set a dimension to the MyEntity
 	ARGUMENTS: uint a_uDimension -> dimension to set
 	OUTPUT: ---
@@ -197,13 +248,6 @@ public:
 	*/
 	bool HasThisRigidBody(MyRigidBody* a_pRigidBody);
 
-	/*
-	USAGE: Asks the entity to resolve the collision with the incoming one
-	ARGUMENTS: MyEntity* a_pOther -> Queried entity
-	OUTPUT: ---
-	*/
-	void ResolveCollision(MyEntity* a_pOther);
-
 	/*
 	USAGE: Gets the solver applied to this MyEntity
 	ARGUMENTS: ---
@@ -256,7 +300,21 @@ public:
 	float GetMass(void);
 
 	/*
-	USAGE: Updates the MyEntity
+	USAGE: Asks if the solver of this entity is sleeping, entities not using the solver never sleep
+	ARGUMENTS: ---
+	OUTPUT: is it sleeping?
+	*/
+	bool IsAsleep(void);
+	/*
+	USAGE: Asks if this entity uses the physics solver
+	ARGUMENTS: ---
+	OUTPUT: uses the solver?
+	*/
+	bool IsUsingPhysicsSolver(void);
+
+	/*
+	USAGE: Moves the MyEntity to the position of its solver (integrated in batch by MySolverPool),
+	sleeping entities are not updated
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
@@ -267,6 +325,53 @@ public:
 	OUTPUT: ---
 	*/
 	void UsePhysicsSolver(bool a_bUse = true);
+	/*
+	USAGE: Marks the entity as static, its model is then drawn by the static batch it belongs to
+	(see MyStaticBatcher) so it should not move while static
+	ARGUMENTS: bool a_bStatic = true -> is it static?
+	OUTPUT: ---
+	*/
+	void SetStatic(bool a_bStatic = true);
+	/*
+	USAGE: Asks if the entity is static
+	ARGUMENTS: ---
+	OUTPUT: is it static?
+	*/
+	bool IsStatic(void);
+	/*
+	USAGE: Plays a clip on the entity from its first frame, looping; each of its tracks draws the
+	meshes of its group with the pose sampled by the entity manager
+	ARGUMENTS:
+	-	MyAnimationClip* a_pClip -> clip to play (shared, not owned), nullptr to stop
+	-	float a_fFramesPerSecond = 24.0f -> speed of the playback
+	OUTPUT: ---
+	*/
+	void SetAnimation(MyAnimationClip* a_pClip, float a_fFramesPerSecond = 24.0f);
+	/*
+	USAGE: Gets the clip played by the entity and its current pose
+	ARGUMENTS: ---
+	OUTPUT: animation instance
+	*/
+	MyAnimationInstance* GetAnimation(void);
+	/*
+	USAGE: Moves the current frame of the clip forward, the pose is sampled later for all entities at once
+	ARGUMENTS: float a_fSeconds -> time passed
+	OUTPUT: ---
+	*/
+	void AdvanceAnimation(float a_fSeconds);
+	/*
+	USAGE: Makes the rigid body collide with the convex hull of the model instead of its OBB,
+	the hull is built the first time a model asks for it
+	ARGUMENTS: bool a_bUse = true -> use the convex hull?
+	OUTPUT: ---
+	*/
+	void UseConvexHull(bool a_bUse = true);
+	/*
+	USAGE: Deletes the convex hulls of all models, no rigid body can be using them
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	static void ReleaseConvexHulls(void);
 
 private:
 	/*
@@ -1,4 +1,5 @@
 #include "MyEntityManager.h"
+#include "MyRenderThread.h"
 using namespace Simplex;
 //  MyEntityManager
 Simplex::MyEntityManager* Simplex::MyEntityManager::m_pInstance = nullptr;
@@ -6,9 +7,23 @@ void Simplex::MyEntityManager::Init(void)
 {
 	m_uEntityCount = 0;
 	m_mEntityArray = nullptr;
+	m_uIslandCount = 0;
+	m_uAsleepCount = 0;
+	m_pBroadPhase = new MyDynamicTree();
+	m_eBroadPhase = BROADPHASE_TREE;
+	m_fBroadPhaseTime = 0.0f;
+	m_bQueryDirty = true;
+	m_queryList.resize(MyJobSystem::GetInstance()->GetThreadCount());
+	m_uAnimationClock = MyTimeSystem::GetInstance()->GenClock();
+	m_fAnimationTime = 0.0f;
+	m_bDrawRigidBody = false;
+	AddSystems();
 }
 void Simplex::MyEntityManager::Release(void)
 {
+	SafeDelete(m_pBroadPhase);
+	m_staticBatcher.Clear();
+
 	for (uint uEntity = 0; uEntity < m_uEntityCount; ++uEntity)
 	{
 		MyEntity* pEntity = m_mEntityArray[uEntity];
@@ -16,6 +31,18 @@ void Simplex::MyEntityManager::Release(void)
 	}
 	m_uEntityCount = 0;
 	m_mEntityArray = nullptr;
+
+	//the hulls are shared by the entities, they go after all of them
+	MyEntity::ReleaseConvexHulls();
+
+	//and so are the animation clips
+	for (auto animation = m_animationMap.begin(); animation != m_animationMap.end(); ++animation)
+	{
+		SafeDelete(animation->second);
+	}
+	m_animationMap.clear();
+	m_animatedList.clear();
+	m_poseCache.Clear();
 }
 Simplex::MyEntityManager* Simplex::MyEntityManager::GetInstance()
 {
@@ -46,6 +73,43 @@ int Simplex::MyEntityManager::GetEntityIndex(String a_sUniqueID)
 }
 //Accessors
 Simplex::uint Simplex::MyEntityManager::GetEntityCount(void) {	return m_uEntityCount; }
+Simplex::uint Simplex::MyEntityManager::GetAsleepCount(void) { return m_uAsleepCount; }
+Simplex::MyBroadPhase* Simplex::MyEntityManager::GetBroadPhase(void) { return m_pBroadPhase; }
+Simplex::MY_BROADPHASE Simplex::MyEntityManager::GetBroadPhaseType(void) { return m_eBroadPhase; }
+float Simplex::MyEntityManager::GetBroadPhaseTime(void) { return m_fBroadPhaseTime; }
+float Simplex::MyEntityManager::GetIntegrationTime(void) { return m_fIntegrationTime; }
+Simplex::uint Simplex::MyEntityManager::GetPairCount(void) { return static_cast<uint>(m_pairList.size()); }
+Simplex::MySATCache* Simplex::MyEntityManager::GetSATCache(void) { return &m_satCache; }
+Simplex::MyContactSolver* Simplex::MyEntityManager::GetContactSolver(void) { return &m_contactSolver; }
+std::vector<Simplex::MyCollisionEvent>& Simplex::MyEntityManager::GetCollisionEventList(MY_COLLISION_EVENT a_eEvent)
+{
+	return m_satCache.GetPairCache()->GetEventList(a_eEvent);
+}
+void Simplex::MyEntityManager::SetBroadPhase(MY_BROADPHASE a_eBroadPhase)
+{
+	SafeDelete(m_pBroadPhase);
+	//the dimensions of the octree leaves mean nothing to the other broad phases
+	if (m_eBroadPhase == BROADPHASE_OCTREE)
+		ClearDimensionSetAll();
+	m_eBroadPhase = a_eBroadPhase;
+	switch (a_eBroadPhase)
+	{
+	case BROADPHASE_ALLPAIRS:
+		m_pBroadPhase = new MyAllPairsBroadPhase();
+		break;
+	case BROADPHASE_OCTREE:
+		m_pBroadPhase = new MyLinearOctree();
+		break;
+	case BROADPHASE_GRID:
+		m_pBroadPhase = new MySpatialHashGrid();
+		break;
+	default:
+		m_pBroadPhase = new MyDynamicTree();
+		m_eBroadPhase = BROADPHASE_TREE;
+		break;
+	}
+	m_bQueryDirty = true;
+}
 Simplex::Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 {
 	//if the list is empty return
@@ -123,6 +187,13 @@ void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, String a_sUni
 	if (pTemp)
 	{
 		pTemp->SetModelMatrix(a_m4ToWorld);
+		m_bQueryDirty = true;
+		//static entities that move go to the cluster of their new place
+		if (pTemp->IsStatic())
+		{
+			m_staticBatcher.Remove(pTemp);
+			m_staticBatcher.Add(pTemp);
+		}
 	}
 }
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uIndex)
@@ -158,6 +229,13 @@ void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, uint a_uIndex
 		a_uIndex = m_uEntityCount - 1;
 
 	m_mEntityArray[a_uIndex]->SetModelMatrix(a_m4ToWorld);
+	m_bQueryDirty = true;
+	//static entities that move go to the cluster of their new place
+	if (m_mEntityArray[a_uIndex]->IsStatic())
+	{
+		m_staticBatcher.Remove(m_mEntityArray[a_uIndex]);
+		m_staticBatcher.Add(m_mEntityArray[a_uIndex]);
+	}
 }
 //The big 3
 Simplex::MyEntityManager::MyEntityManager(){Init();}
@@ -165,28 +243,332 @@ Simplex::MyEntityManager::MyEntityManager(MyEntityManager const& a_pOther){ }
 Simplex::MyEntityManager& Simplex::MyEntityManager::operator=(MyEntityManager const& a_pOther) { return *this; }
 Simplex::MyEntityManager::~MyEntityManager(){Release();};
 // other methods
+Simplex::uint Simplex::MyEntityManager::FindIsland(uint a_uIndex)
+{
+	uint uRoot = a_uIndex;
+	while (m_islandParent[uRoot] != uRoot)
+		uRoot = m_islandParent[uRoot];
+
+	//point every entity on the way straight to the root
+	while (m_islandParent[a_uIndex] != uRoot)
+	{
+		uint uNext = m_islandParent[a_uIndex];
+		m_islandParent[a_uIndex] = uRoot;
+		a_uIndex = uNext;
+	}
+	return uRoot;
+}
+void Simplex::MyEntityManager::UnionIslands(uint a_uIndexA, uint a_uIndexB)
+{
+	uint uRootA = FindIsland(a_uIndexA);
+	uint uRootB = FindIsland(a_uIndexB);
+	if (uRootA != uRootB)
+		m_islandParent[uRootB] = uRootA;
+}
+void Simplex::MyEntityManager::UpdateIslands(void)
+{
+	//a sleeping entity woken up by a contact wakes up the whole pile it went to sleep with, the woken
+	//islands are sorted so each sleeping entity looks its island up once instead of every waking one
+	//going through all the entities
+	m_wakeList.clear();
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		if (m_wasAsleepList[i] && !m_mEntityArray[i]->IsAsleep())
+			m_wakeList.push_back(std::make_pair(m_mEntityArray[i]->GetSolver()->GetIsland(), i));
+	}
+	if (m_wakeList.size() > 0)
+	{
+		std::sort(m_wakeList.begin(), m_wakeList.end());
+		for (uint i = 1; i < m_wakeList.size(); ++i)
+		{
+			if (m_wakeList[i].first == m_wakeList[i - 1].first)
+				UnionIslands(m_wakeList[i - 1].second, m_wakeList[i].second);
+		}
+		for (uint j = 0; j < m_uEntityCount; ++j)
+		{
+			if (!m_mEntityArray[j]->IsAsleep())
+				continue;
+			MySolver* pSolver = m_mEntityArray[j]->GetSolver();
+			auto wake = std::lower_bound(m_wakeList.begin(), m_wakeList.end(), std::make_pair(pSolver->GetIsland(), 0u));
+			if (wake != m_wakeList.end() && wake->first == pSolver->GetIsland())
+			{
+				pSolver->Wake();
+				UnionIslands(wake->second, j);
+			}
+		}
+	}
+
+	//an island can only sleep if all of its entities are ready
+	m_islandReadyList.assign(m_uEntityCount, true);
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		MyEntity* pEntity = m_mEntityArray[i];
+		if (!pEntity->IsUsingPhysicsSolver() || pEntity->IsAsleep())
+			continue;
+		if (!pEntity->GetSolver()->IsReadyToSleep())
+			m_islandReadyList[FindIsland(i)] = false;
+	}
+
+	//put the islands at rest to sleep, all their entities share an identifier
+	m_islandIDList.assign(m_uEntityCount, 0);
+	m_uAsleepCount = 0;
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		MyEntity* pEntity = m_mEntityArray[i];
+		if (!pEntity->IsUsingPhysicsSolver())
+			continue;
+		if (!pEntity->IsAsleep())
+		{
+			uint uRoot = FindIsland(i);
+			if (!m_islandReadyList[uRoot])
+				continue;
+			if (m_islandIDList[uRoot] == 0)
+				m_islandIDList[uRoot] = ++m_uIslandCount;
+			pEntity->GetSolver()->Sleep(m_islandIDList[uRoot]);
+		}
+		++m_uAsleepCount;
+	}
+}
+void Simplex::MyEntityManager::AddSystems(void)
+{
+	//the blocks of the voxel world have no rigid bodies, the solvers that moved into one are stopped by looking at the grid
+	MySystem voxels;
+	voxels.m_sName = "Voxels";
+	voxels.m_uRequire = COMPONENT_SOLVER | COMPONENT_BOUNDS;
+	voxels.m_uRead = COMPONENT_BOUNDS;
+	voxels.m_uWrite = COMPONENT_SOLVER;
+	voxels.m_update = [](MyArchetypeChunk* a_pChunk)
+	{
+		MyVoxelWorld* pVoxelWorld = MyVoxelWorld::GetInstance();
+		if (pVoxelWorld->GetChunkCount() == 0)
+			return;
+
+		MySolverComponent* pSolverArray = a_pChunk->GetArray<MySolverComponent>();
+		MyBoundsComponent* pBoundsArray = a_pChunk->GetArray<MyBoundsComponent>();
+		for (uint i = 0; i < a_pChunk->m_uCount; ++i)
+		{
+			MySolver* pSolver = pSolverArray[i].m_pSolver;
+			if (pSolver->IsAsleep())
+				continue;
+
+			//box of the entity before the solver moved it by its velocity
+			vector3 v3Velocity = pSolver->GetVelocity();
+			vector3 v3Start = pSolver->GetPosition() - v3Velocity;
+			vector3 v3Min = v3Start + pBoundsArray[i].m_v3CenterLocal - pBoundsArray[i].m_v3HalfWidth;
+			vector3 v3Max = v3Start + pBoundsArray[i].m_v3CenterLocal + pBoundsArray[i].m_v3HalfWidth;
+			glm::bvec3 bHit;
+			vector3 v3Move = pVoxelWorld->MoveBox(v3Min, v3Max, v3Velocity, bHit);
+			if (!glm::any(bHit))
+				continue;
+			for (uint k = 0; k < 3; ++k)
+			{
+				if (bHit[k])
+					v3Velocity[k] = 0.0f;
+			}
+			pSolver->SetPosition(v3Start + v3Move);
+			pSolver->SetVelocity(v3Velocity);
+		}
+	};
+	m_updateScheduler.AddSystem(voxels);
+
+	//the entities copy the position of their solver, a sleeping one did not move; it goes through the
+	//transform system so the chunks are done in order on one thread
+	MySystem solvers;
+	solvers.m_sName = "Solvers";
+	solvers.m_uRequire = COMPONENT_SOLVER | COMPONENT_TRANSFORM;
+	solvers.m_uRead = COMPONENT_SOLVER;
+	solvers.m_uWrite = COMPONENT_TRANSFORM | COMPONENT_BOUNDS;
+	solvers.m_bParallel = false;
+	solvers.m_update = [](MyArchetypeChunk* a_pChunk)
+	{
+		MyEntity** pEntityArray = a_pChunk->GetEntityArray();
+		MySolverComponent* pSolverArray = a_pChunk->GetArray<MySolverComponent>();
+		for (uint i = 0; i < a_pChunk->m_uCount; ++i)
+		{
+			MySolver* pSolver = pSolverArray[i].m_pSolver;
+			if (!pSolver->IsAsleep())
+				pEntityArray[i]->SetModelMatrix(glm::translate(pSolver->GetPosition()));
+		}
+	};
+	m_updateScheduler.AddSystem(solvers);
+
+	//the entities that know their meshes only need the matrix and the mesh list, static ones are drawn by
+	//their batch and animated ones by their pose
+	MySystem meshes;
+	meshes.m_sName = "Meshes";
+	meshes.m_uRequire = COMPONENT_TRANSFORM | COMPONENT_RENDERMESH;
+	meshes.m_uExclude = COMPONENT_STATIC | COMPONENT_ANIMATED;
+	meshes.m_uRead = COMPONENT_TRANSFORM | COMPONENT_RENDERMESH;
+	meshes.m_update = [](MyArchetypeChunk* a_pChunk)
+	{
+		MyCommandBuffer* pBuffer = MyRenderQueue::GetInstance()->GetBuffer();
+		MyTransformComponent* pTransformArray = a_pChunk->GetArray<MyTransformComponent>();
+		MyRenderMeshComponent* pRenderMeshArray = a_pChunk->GetArray<MyRenderMeshComponent>();
+		for (uint i = 0; i < a_pChunk->m_uCount; ++i)
+		{
+			for (uint j = 0; j < pRenderMeshArray[i].m_uMeshCount; ++j)
+			{
+				pBuffer->Push(pRenderMeshArray[i].m_pMesh[j], RENDER_SOLID, pTransformArray[i].m_m4ToWorld);
+			}
+		}
+	};
+	m_renderScheduler.AddSystem(meshes);
+
+	//animated entities draw the meshes of each track with its pose, they wait for the first one to be sampled
+	MySystem poses;
+	poses.m_sName = "Poses";
+	poses.m_uRequire = COMPONENT_TRANSFORM | COMPONENT_ANIMATED;
+	poses.m_uRead = COMPONENT_TRANSFORM;
+	poses.m_update = [](MyArchetypeChunk* a_pChunk)
+	{
+		MyCommandBuffer* pBuffer = MyRenderQueue::GetInstance()->GetBuffer();
+		MyEntity** pEntityArray = a_pChunk->GetEntityArray();
+		MyTransformComponent* pTransformArray = a_pChunk->GetArray<MyTransformComponent>();
+		for (uint i = 0; i < a_pChunk->m_uCount; ++i)
+		{
+			MyAnimationInstance* pAnimation = pEntityArray[i]->GetAnimation();
+			if (pAnimation->m_pPose == nullptr)
+				continue;
+			for (uint j = 0; j < pAnimation->m_pClip->GetTrackCount(); ++j)
+			{
+				matrix4 m4Pose = pTransformArray[i].m_m4ToWorld * pAnimation->m_pPose[j];
+				std::vector<uint>& meshList = pAnimation->m_pClip->GetTrack(j)->m_meshList;
+				for (uint k = 0; k < meshList.size(); ++k)
+				{
+					pBuffer->Push(meshList[k], RENDER_SOLID, m4Pose);
+				}
+			}
+		}
+	};
+	m_renderScheduler.AddSystem(poses);
+
+	//rigid bodies and axis of all the loaded entities, batched or not
+	MySystem debug;
+	debug.m_sName = "Debug";
+	debug.m_uRequire = COMPONENT_TRANSFORM | COMPONENT_BOUNDS;
+	debug.m_uRead = COMPONENT_TRANSFORM;
+	debug.m_update = [this](MyArchetypeChunk* a_pChunk)
+	{
+		MyEntity** pEntityArray = a_pChunk->GetEntityArray();
+		MyTransformComponent* pTransformArray = a_pChunk->GetArray<MyTransformComponent>();
+		for (uint i = 0; i < a_pChunk->m_uCount; ++i)
+		{
+			if (m_bDrawRigidBody)
+				pEntityArray[i]->GetRigidBody()->AddToRenderList();
+			if (!pEntityArray[i]->IsAxisVisible())
+				continue;
+#ifdef MYDEBUGDRAW
+			MyDebugDraw::GetInstance()->AddAxis(pTransformArray[i].m_m4ToWorld);
+#else
+			MyRenderQueue::GetInstance()->AddAxis(pTransformArray[i].m_m4ToWorld);
+#endif //MYDEBUGDRAW
+		}
+	};
+	m_renderScheduler.AddSystem(debug);
+}
 void Simplex::MyEntityManager::Update(void)
 {
-	//Clear all collisions
+	//every entity starts on its own island
+	m_islandParent.resize(m_uEntityCount);
+	m_wasAsleepList.resize(m_uEntityCount);
 	for (uint i = 0; i < m_uEntityCount; i++)
 	{
-		m_mEntityArray[i]->ClearCollisionList();
+		m_islandParent[i] = i;
+		m_wasAsleepList[i] = m_mEntityArray[i]->IsAsleep();
 	}
-	
-	//check collisions
-	for (uint i = 0; i < m_uEntityCount; i++)
+
+	//ask the broad phase for the pairs worth testing, sorted so the contacts are solved in the same order every time
+	auto start = std::chrono::high_resolution_clock::now();
+	m_pBroadPhase->Update(m_mEntityArray, m_uEntityCount);
+	//the octree puts the entities in the dimensions of its leaves so the pairs can check they share one
+	if (m_eBroadPhase == BROADPHASE_OCTREE)
+		static_cast<MyLinearOctree*>(m_pBroadPhase)->AssignDimensions();
+	m_pBroadPhase->GetPairs(m_pairList);
+	m_fBroadPhaseTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	std::sort(m_pairList.begin(), m_pairList.end(),
+		[](MyBroadPhasePair const& a, MyBroadPhasePair const& b) { return a.m_uA < b.m_uA || (a.m_uA == b.m_uA && a.m_uB < b.m_uB); });
+
+	//test all the pairs at once, the entities do not move until their pairs are resolved
+	m_satCache.TestPairs(m_mEntityArray, m_pairList, m_collidingList);
+
+	//the colliding lists persist between updates, only the pairs that changed touch them
+	MyPairCache* pPairCache = m_satCache.GetPairCache();
+	std::vector<MyCollisionEvent>& enterList = pPairCache->GetEventList(COLLISION_ENTER);
+	for (uint uEvent = 0; uEvent < enterList.size(); ++uEvent)
 	{
-		for (uint j = i + 1; j < m_uEntityCount; j++)
+		enterList[uEvent].m_pA->GetRigidBody()->AddCollisionWith(enterList[uEvent].m_pB->GetRigidBody());
+		enterList[uEvent].m_pB->GetRigidBody()->AddCollisionWith(enterList[uEvent].m_pA->GetRigidBody());
+	}
+	std::vector<MyCollisionEvent>& exitList = pPairCache->GetEventList(COLLISION_EXIT);
+	for (uint uEvent = 0; uEvent < exitList.size(); ++uEvent)
+	{
+		exitList[uEvent].m_pA->GetRigidBody()->RemoveCollisionWith(exitList[uEvent].m_pB->GetRigidBody());
+		exitList[uEvent].m_pB->GetRigidBody()->RemoveCollisionWith(exitList[uEvent].m_pA->GetRigidBody());
+	}
+
+	//entities in contact belong to the same island
+	for (uint uPair = 0; uPair < m_pairList.size(); ++uPair)
+	{
+		uint i = m_pairList[uPair].m_uA;
+		uint j = m_pairList[uPair].m_uB;
+		if (m_collidingList[uPair] && m_mEntityArray[i]->IsUsingPhysicsSolver() && m_mEntityArray[j]->IsUsingPhysicsSolver())
+			UnionIslands(i, j);
+	}
+
+	//forces go into the velocities of all the awake solvers at once, the contacts correct them and
+	//then the solvers move, the entities only copy their new position
+	MySolverPool* pSolverPool = MySolverPool::GetInstance();
+	start = std::chrono::high_resolution_clock::now();
+	pSolverPool->IntegrateVelocity();
+	m_fIntegrationTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	m_contactSolver.Solve(m_mEntityArray, m_uEntityCount, m_pairList, m_collidingList, &m_satCache);
+	start = std::chrono::high_resolution_clock::now();
+	pSolverPool->IntegratePosition();
+	m_fIntegrationTime += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	//the solvers that moved into a block are stopped and the entities copy the position of the rest
+	m_updateScheduler.Run();
+
+	//the children follow their parents, only the entities whose world matrix changed are touched
+	MyTransformSystem* pTransformSystem = MyTransformSystem::GetInstance();
+	pTransformSystem->Update();
+	if (pTransformSystem->GetChangedCount() > 0)
+	{
+		for (uint i = 0; i < m_uEntityCount; i++)
 		{
-			//if objects are colliding resolve the collision
-			if (m_mEntityArray[i]->IsColliding(m_mEntityArray[j]))
+			MyEntity* pEntity = m_mEntityArray[i];
+			if (!pTransformSystem->HasChanged(pEntity->GetTransform()))
+				continue;
+			matrix4 m4Previous = pEntity->GetModelMatrix();
+			pEntity->ApplyTransform();
+			//static entities carried by a parent go to the cluster of their new place
+			if (pEntity->IsStatic() && pEntity->GetModelMatrix() != m4Previous)
 			{
-				m_mEntityArray[i]->ResolveCollision(m_mEntityArray[j]);
+				m_staticBatcher.Remove(pEntity);
+				m_staticBatcher.Add(pEntity);
 			}
 		}
-		//Update each entity
-		m_mEntityArray[i]->Update();
 	}
+
+	UpdateIslands();
+
+	//the entities moved after the broad phase, the queries update it again if they are used
+	m_bQueryDirty = true;
+
+	//advance the clips and sample the distinct poses of all the animated entities at once
+	float fDelta = MyTimeSystem::GetInstance()->GetDeltaTime(m_uAnimationClock);
+	start = std::chrono::high_resolution_clock::now();
+	m_animatedList.clear();
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		MyAnimationInstance* pAnimation = m_mEntityArray[i]->GetAnimation();
+		if (pAnimation->m_pClip == nullptr)
+			continue;
+		m_mEntityArray[i]->AdvanceAnimation(fDelta);
+		m_animatedList.push_back(pAnimation);
+	}
+	m_poseCache.Update(m_animatedList.data(), m_animatedList.size());
+	m_fAnimationTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
 }
 void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 {
@@ -214,6 +596,12 @@ void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 		m_mEntityArray = tempArray;
 		//add one entity to the count
 		++m_uEntityCount;
+		m_bQueryDirty = true;
+	}
+	else
+	{
+		//its components would stay in the store
+		SafeDelete(pTemp);
 	}
 }
 void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
@@ -226,11 +614,18 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	//the pairs of the entity go away with it
+	m_satCache.GetPairCache()->Remove(m_mEntityArray[a_uIndex]);
+	//and so does its place in the static batches
+	m_staticBatcher.Remove(m_mEntityArray[a_uIndex]);
+
 	// if the entity is not the very last we swap it for the last one
 	if (a_uIndex != m_uEntityCount - 1)
 	{
 		std::swap(m_mEntityArray[a_uIndex], m_mEntityArray[m_uEntityCount - 1]);
 	}
+	//the entity goes away with its components, the systems would find them otherwise
+	SafeDelete(m_mEntityArray[m_uEntityCount - 1]);
 	
 	//and then pop the last one
 	//create a new temp array with one less entry
@@ -249,6 +644,7 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	m_mEntityArray = tempArray;
 	//add one entity to the count
 	--m_uEntityCount;
+	m_bQueryDirty = true;
 }
 void Simplex::MyEntityManager::RemoveEntity(String a_sUniqueID)
 {
@@ -284,11 +680,25 @@ void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigi
 	//if out of bounds will do it for all
 	if (a_uIndex >= m_uEntityCount)
 	{
-		//add for each one in the entity list
-		for (a_uIndex = 0; a_uIndex < m_uEntityCount; ++a_uIndex)
+		//the systems walk the chunks of the entities they draw, each thread records in its own buffer
+		m_bDrawRigidBody = a_bRigidBody;
+		m_renderScheduler.Run();
+		//the ones that do not know their meshes go whole with the snapshot, the render thread draws their model
+		MyRenderQueue* pRenderQueue = MyRenderQueue::GetInstance();
+		MyArchetypeStore::GetInstance()->Query(COMPONENT_TRANSFORM | COMPONENT_BOUNDS, COMPONENT_RENDERMESH | COMPONENT_ANIMATED, m_chunkList);
+		for (uint i = 0; i < m_chunkList.size(); ++i)
 		{
-			m_mEntityArray[a_uIndex]->AddToRenderList(a_bRigidBody);
+			MyEntity** pEntityArray = m_chunkList[i]->GetEntityArray();
+			MyTransformComponent* pTransformArray = m_chunkList[i]->GetArray<MyTransformComponent>();
+			for (uint j = 0; j < m_chunkList[i]->m_uCount; ++j)
+			{
+				pRenderQueue->AddModel(pEntityArray[j]->GetModel(), pTransformArray[j].m_m4ToWorld);
+			}
 		}
+		//the static ones are drawn by cluster, their meshes might need to be rebuilt
+		m_staticBatcher.AddToRenderList();
+		//and the blocks by chunk
+		MyVoxelWorld::GetInstance()->AddToRenderList();
 	}
 	else //do it for the specified one
 	{
@@ -453,6 +863,7 @@ void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, String a_sUniqu
 	if (pTemp)
 	{
 		pTemp->SetPosition(a_v3Position);
+		m_bQueryDirty = true;
 	}
 	return;
 }
@@ -467,6 +878,7 @@ void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, uint a_uIndex)
 		a_uIndex = m_uEntityCount - 1;
 
 	m_mEntityArray[a_uIndex]->SetPosition(a_v3Position);
+	m_bQueryDirty = true;
 
 	return;
 }
@@ -516,4 +928,261 @@ void Simplex::MyEntityManager::UsePhysicsSolver(bool a_bUse, uint a_uIndex)
 		a_uIndex = m_uEntityCount - 1;
 
 	return m_mEntityArray[a_uIndex]->UsePhysicsSolver(a_bUse);
+}
+void Simplex::MyEntityManager::SetStatic(bool a_bStatic, String a_sUniqueID)
+{
+	//Get the entity
+	int nIndex = GetEntityIndex(a_sUniqueID);
+
+	//if the entity does not exists return
+	if (nIndex < 0)
+		return;
+	SetStatic(a_bStatic, (uint)nIndex);
+}
+void Simplex::MyEntityManager::SetStatic(bool a_bStatic, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	MyEntity* pEntity = m_mEntityArray[a_uIndex];
+	//the batches need the meshes of the model
+	if (pEntity->GetMeshCount() == 0 || pEntity->IsStatic() == a_bStatic)
+		return;
+
+	pEntity->SetStatic(a_bStatic);
+	if (a_bStatic)
+		m_staticBatcher.Add(pEntity);
+	else
+		m_staticBatcher.Remove(pEntity);
+}
+bool Simplex::MyEntityManager::SetParent(String a_sParentID, String a_sUniqueID)
+{
+	//Get the entity
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+
+	//if the entity does not exists return
+	if (pTemp == nullptr)
+		return false;
+
+	//an empty ID makes it a root
+	MyEntity* pParent = nullptr;
+	if (a_sParentID != "")
+	{
+		pParent = MyEntity::GetEntity(a_sParentID);
+		if (pParent == nullptr)
+			return false;
+	}
+	return pTemp->SetParent(pParent);
+}
+bool Simplex::MyEntityManager::SetParent(String a_sParentID, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return false;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	return SetParent(a_sParentID, m_mEntityArray[a_uIndex]->GetUniqueID());
+}
+Simplex::MyStaticBatcher* Simplex::MyEntityManager::GetStaticBatcher(void) { return &m_staticBatcher; }
+Simplex::MyAnimationClip* Simplex::MyEntityManager::GetAnimation(String a_sName)
+{
+	auto animation = m_animationMap.find(a_sName);
+	if (animation != m_animationMap.end())
+		return animation->second;
+
+	MyAnimationClip* pClip = new MyAnimationClip();
+	m_animationMap[a_sName] = pClip;
+	return pClip;
+}
+void Simplex::MyEntityManager::SetAnimation(String a_sAnimation, float a_fFramesPerSecond, String a_sUniqueID)
+{
+	//Get the entity
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+
+	//if the entity does not exists return
+	if (pTemp)
+		pTemp->SetAnimation(GetAnimation(a_sAnimation), a_fFramesPerSecond);
+}
+void Simplex::MyEntityManager::SetAnimation(String a_sAnimation, float a_fFramesPerSecond, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	m_mEntityArray[a_uIndex]->SetAnimation(GetAnimation(a_sAnimation), a_fFramesPerSecond);
+}
+Simplex::uint Simplex::MyEntityManager::GetAnimatedCount(void) { return m_animatedList.size(); }
+float Simplex::MyEntityManager::GetAnimationTime(void) { return m_fAnimationTime; }
+Simplex::MyPoseCache* Simplex::MyEntityManager::GetPoseCache(void) { return &m_poseCache; }
+Simplex::MySystemScheduler* Simplex::MyEntityManager::GetUpdateScheduler(void) { return &m_updateScheduler; }
+Simplex::MySystemScheduler* Simplex::MyEntityManager::GetRenderScheduler(void) { return &m_renderScheduler; }
+void Simplex::MyEntityManager::UseConvexHull(bool a_bUse, uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	return m_mEntityArray[a_uIndex]->UseConvexHull(a_bUse);
+}
+//Scene queries
+void Simplex::MyEntityManager::RefreshQueries(void)
+{
+	if (!m_bQueryDirty)
+		return;
+	m_pBroadPhase->Update(m_mEntityArray, m_uEntityCount);
+	m_bQueryDirty = false;
+}
+bool Simplex::MyEntityManager::CastClosest(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius, MyRayHit& a_hit)
+{
+	std::vector<uint>& candidateList = m_queryList[MyJobSystem::GetThreadIndex()];
+	m_pBroadPhase->RayCast(a_v3Origin, a_v3Direction, a_fMaxDistance, a_fRadius, candidateList);
+
+	a_hit = MyRayHit();
+	float fClosest = a_fMaxDistance;
+	for (uint uCandidate = 0; uCandidate < candidateList.size(); ++uCandidate)
+	{
+		uint i = candidateList[uCandidate];
+		MyRigidBody* pRigidBody = m_mEntityArray[i]->GetRigidBody();
+
+		//the OBB grown by the radius is hit first, so it is where the sphere can start moving from
+		float fDistance;
+		vector3 v3Normal;
+		if (!pRigidBody->RayCastOBB(a_v3Origin, a_v3Direction, fClosest, a_fRadius, fDistance, v3Normal))
+			continue;
+
+		vector3 v3Point = a_v3Origin + a_v3Direction * fDistance;
+		if (a_fRadius > 0.0f)
+		{
+			//the grown box has square corners, the sphere advances by its distance to the OBB until it touches it
+			bool bTouching = false;
+			for (uint uStep = 0; uStep < 32 && fDistance <= fClosest; ++uStep)
+			{
+				vector3 v3Center = a_v3Origin + a_v3Direction * fDistance;
+				v3Point = pRigidBody->GetClosestPointOBB(v3Center);
+				float fGap = glm::length(v3Center - v3Point);
+				if (fGap <= a_fRadius + 0.0001f)
+				{
+					if (fGap > FLT_EPSILON)
+						v3Normal = (v3Center - v3Point) / fGap;
+					bTouching = true;
+					break;
+				}
+				fDistance += fGap - a_fRadius;
+			}
+			if (!bTouching || fDistance > fClosest)
+				continue;
+		}
+
+		fClosest = fDistance;
+		a_hit.m_nEntity = static_cast<int>(i);
+		a_hit.m_fDistance = fDistance;
+		a_hit.m_v3Point = v3Point;
+		a_hit.m_v3Normal = v3Normal;
+	}
+	return a_hit.m_nEntity != -1;
+}
+bool Simplex::MyEntityManager::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, MyRayHit& a_hit)
+{
+	a_hit = MyRayHit();
+	if (glm::length(a_v3Direction) < FLT_EPSILON)
+		return false;
+
+	RefreshQueries();
+	return CastClosest(a_v3Origin, glm::normalize(a_v3Direction), a_fMaxDistance, 0.0f, a_hit);
+}
+Simplex::uint Simplex::MyEntityManager::RayCastAll(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, std::vector<MyRayHit>& a_hitList)
+{
+	a_hitList.clear();
+	if (glm::length(a_v3Direction) < FLT_EPSILON)
+		return 0;
+
+	RefreshQueries();
+	vector3 v3Direction = glm::normalize(a_v3Direction);
+	std::vector<uint>& candidateList = m_queryList[MyJobSystem::GetThreadIndex()];
+	m_pBroadPhase->RayCast(a_v3Origin, v3Direction, a_fMaxDistance, 0.0f, candidateList);
+	for (uint uCandidate = 0; uCandidate < candidateList.size(); ++uCandidate)
+	{
+		uint i = candidateList[uCandidate];
+		MyRayHit hit;
+		if (!m_mEntityArray[i]->GetRigidBody()->RayCastOBB(a_v3Origin, v3Direction, a_fMaxDistance, 0.0f, hit.m_fDistance, hit.m_v3Normal))
+			continue;
+		hit.m_nEntity = static_cast<int>(i);
+		hit.m_v3Point = a_v3Origin + v3Direction * hit.m_fDistance;
+		a_hitList.push_back(hit);
+	}
+	std::sort(a_hitList.begin(), a_hitList.end(),
+		[](MyRayHit const& a, MyRayHit const& b) { return a.m_fDistance < b.m_fDistance; });
+	return static_cast<uint>(a_hitList.size());
+}
+void Simplex::MyEntityManager::RayCastBatch(std::vector<MyRay> const& a_rayList, std::vector<MyRayHit>& a_hitList)
+{
+	//the broad phase is updated once, after that the rays only read it
+	RefreshQueries();
+	a_hitList.resize(a_rayList.size());
+	MyJobSystem::GetInstance()->ParallelFor(static_cast<uint>(a_rayList.size()), 64, [this, &a_rayList, &a_hitList](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint uRay = a_uBegin; uRay < a_uEnd; ++uRay)
+		{
+			MyRay const& ray = a_rayList[uRay];
+			a_hitList[uRay] = MyRayHit();
+			if (glm::length(ray.m_v3Direction) < FLT_EPSILON)
+				continue;
+			CastClosest(ray.m_v3Origin, glm::normalize(ray.m_v3Direction), ray.m_fMaxDistance, 0.0f, a_hitList[uRay]);
+		}
+	});
+}
+bool Simplex::MyEntityManager::SweepSphere(vector3 a_v3Origin, vector3 a_v3Direction, float a_fRadius, float a_fMaxDistance, MyRayHit& a_hit)
+{
+	a_hit = MyRayHit();
+	if (glm::length(a_v3Direction) < FLT_EPSILON)
+		return false;
+
+	RefreshQueries();
+	return CastClosest(a_v3Origin, glm::normalize(a_v3Direction), a_fMaxDistance, a_fRadius, a_hit);
+}
+void Simplex::MyEntityManager::OverlapSphere(vector3 a_v3Center, float a_fRadius, std::vector<uint>& a_entityList)
+{
+	RefreshQueries();
+	m_pBroadPhase->QueryAABB(a_v3Center - vector3(a_fRadius), a_v3Center + vector3(a_fRadius), a_entityList);
+
+	//the broad phase only knows the boxes, the candidates outside the sphere are dropped
+	uint uCount = 0;
+	for (uint uCandidate = 0; uCandidate < a_entityList.size(); ++uCandidate)
+	{
+		uint i = a_entityList[uCandidate];
+		vector3 v3Distance = m_mEntityArray[i]->GetRigidBody()->GetClosestPointOBB(a_v3Center) - a_v3Center;
+		if (glm::dot(v3Distance, v3Distance) <= a_fRadius * a_fRadius)
+			a_entityList[uCount++] = i;
+	}
+	a_entityList.resize(uCount);
+}
+void Simplex::MyEntityManager::OverlapBox(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList)
+{
+	RefreshQueries();
+	m_pBroadPhase->QueryAABB(a_v3Min, a_v3Max, a_entityList);
+
+	uint uCount = 0;
+	for (uint uCandidate = 0; uCandidate < a_entityList.size(); ++uCandidate)
+	{
+		uint i = a_entityList[uCandidate];
+		if (m_mEntityArray[i]->GetRigidBody()->IsOverlappingAABB(a_v3Min, a_v3Max))
+			a_entityList[uCount++] = i;
+	}
+	a_entityList.resize(uCount);
 }
\ No newline at end of file
@@ -5,17 +5,76 @@ Date: 2017/07
 #ifndef __MYENTITYMANAGER_H_
 #define __MYENTITYMANAGER_H_
 
-#include "MyEntity.h"
+#include "MyDynamicTree.h"
+#include "MyLinearOctree.h"
+#include "MySpatialHashGrid.h"
+#include "MyContactSolver.h"
+#include "MyStaticBatcher.h"
+#include "MyPoseCache.h"
+#include "MyTimeSystem.h"
+#include "MyVoxelWorld.h"
+#include "MySystemScheduler.h"
+#include <chrono>
 
 namespace Simplex
 {
 
+//Ray of a batch of scene queries
+struct MyRay
+{
+	vector3 m_v3Origin = ZERO_V3; //origin of the ray
+	vector3 m_v3Direction = AXIS_Z; //direction of the ray (does not need to be normalized)
+	float m_fMaxDistance = FLT_MAX; //length of the ray
+};
+
+//Result of a ray cast or a sweep
+struct MyRayHit
+{
+	int m_nEntity = -1; //index of the entity hit, -1 if nothing was hit
+	float m_fDistance = 0.0f; //distance along the unit direction
+	vector3 m_v3Point = ZERO_V3; //point of the hit in global space
+	vector3 m_v3Normal = ZERO_V3; //normal of the surface hit
+};
+
 //System Class
 class MyEntityManager
 {
 	typedef MyEntity* PEntity; //MyEntity Pointer
 	uint m_uEntityCount = 0; //number of elements in the list
 	PEntity* m_mEntityArray = nullptr; //array of MyEntity pointers
+
+	std::vector<uint> m_islandParent; //union-find parent of each entity in the contact graph
+	std::vector<bool> m_wasAsleepList; //sleeping state of each entity at the start of the update
+	std::vector<std::pair<uint, uint>> m_wakeList; //island and index of the entities woken this update, sorted
+	std::vector<bool> m_islandReadyList; //can the island rooted at each entity go to sleep?
+	std::vector<uint> m_islandIDList; //identifier given to the island rooted at each entity when it sleeps
+	uint m_uIslandCount = 0; //island identifiers handed out to sleeping piles
+	uint m_uAsleepCount = 0; //entities sleeping after the last update
+
+	MyBroadPhase* m_pBroadPhase = nullptr; //finds the pairs of entities that might be colliding
+	std::vector<MyBroadPhasePair> m_pairList; //pairs found in the last update
+	MY_BROADPHASE m_eBroadPhase = BROADPHASE_TREE; //type of the broad phase in use
+	float m_fBroadPhaseTime = 0.0f; //milliseconds the broad phase took in the last update
+	float m_fIntegrationTime = 0.0f; //milliseconds the solver pool took to integrate in the last update
+	MySATCache m_satCache; //tests the pairs starting by the axis that separated them the last time
+	std::vector<uint> m_collidingList; //result of each pair of the last update
+	MyContactSolver m_contactSolver; //sequential impulses for the contacts of the colliding pairs
+	MyStaticBatcher m_staticBatcher; //draws the static entities in one call per cluster of space
+
+	std::map<String, MyAnimationClip*> m_animationMap; //clips by name, shared by the entities playing them
+	std::vector<MyAnimationInstance*> m_animatedList; //instances sampled in the last update
+	MyPoseCache m_poseCache; //samples the poses shared by the instances at the same frame once
+	uint m_uAnimationClock = 0; //clock that advances the animations
+	float m_fAnimationTime = 0.0f; //milliseconds the poses took to sample in the last update
+
+	bool m_bQueryDirty = true; //did the entities move since the broad phase was last updated?
+	std::vector<std::vector<uint>> m_queryList; //candidates of the broad phase for each thread
+
+	MySystemScheduler m_updateScheduler; //systems moving the entities after the solver pool integrated
+	MySystemScheduler m_renderScheduler; //systems recording the entities in the command buffers
+	bool m_bDrawRigidBody = false; //do the render systems add the rigid bodies?
+	std::vector<MyArchetypeChunk*> m_chunkList; //chunks of the entities drawn through their model
+
 	static MyEntityManager* m_pInstance; // Singleton pointer
 public:
 	/*
@@ -69,12 +128,73 @@ public:
 	*/
 	MyEntity* GetEntity(uint a_uIndex = -1);
 	/*
-	USAGE: Will update the MyEntity manager
+	USAGE: Will update the MyEntity manager, pairs of sleeping entities are not tested and
+	entities in contact sleep and wake up together as an island
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
+	USAGE: Gets the number of entities sleeping after the last update
+	ARGUMENTS: ---
+	OUTPUT: sleeping count
+	*/
+	uint GetAsleepCount(void);
+	/*
+	USAGE: Sets the broad phase used to find the pairs of entities that might be colliding
+	ARGUMENTS: MY_BROADPHASE a_eBroadPhase -> broad phase to use
+	OUTPUT: ---
+	*/
+	void SetBroadPhase(MY_BROADPHASE a_eBroadPhase);
+	/*
+	USAGE: Gets the broad phase in use
+	ARGUMENTS: ---
+	OUTPUT: broad phase
+	*/
+	MyBroadPhase* GetBroadPhase(void);
+	/*
+	USAGE: Gets the type of the broad phase in use
+	ARGUMENTS: ---
+	OUTPUT: broad phase type
+	*/
+	MY_BROADPHASE GetBroadPhaseType(void);
+	/*
+	USAGE: Gets the milliseconds the broad phase took in the last update
+	ARGUMENTS: ---
+	OUTPUT: time in milliseconds
+	*/
+	float GetBroadPhaseTime(void);
+	/*
+	USAGE: Gets the milliseconds the solver pool took to integrate the solvers in the last update
+	ARGUMENTS: ---
+	OUTPUT: time in milliseconds
+	*/
+	float GetIntegrationTime(void);
+	/*
+	USAGE: Gets the number of pairs the broad phase found in the last update
+	ARGUMENTS: ---
+	OUTPUT: pair count
+	*/
+	uint GetPairCount(void);
+	/*
+	USAGE: Gets the cache of separating axes used to test the pairs
+	ARGUMENTS: ---
+	OUTPUT: SAT cache
+	*/
+	MySATCache* GetSATCache(void);
+	/*
+	USAGE: Gets the collision events of the last update, enter and exit only happen once per contact
+	ARGUMENTS: MY_COLLISION_EVENT a_eEvent -> kind of event
+	OUTPUT: list of events, valid until the next update
+	*/
+	std::vector<MyCollisionEvent>& GetCollisionEventList(MY_COLLISION_EVENT a_eEvent);
+	/*
+	USAGE: Gets the solver of the contacts between entities
+	ARGUMENTS: ---
+	OUTPUT: contact solver
+	*/
+	MyContactSolver* GetContactSolver(void);
+	/*
 	USAGE: Gets the model associated with this entity
 	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
 	OUTPUT: Model
@@ -311,6 +431,175 @@ public:
 	OUTPUT: ---
 	*/
 	void UsePhysicsSolver(bool a_bUse = true, uint a_uIndex = -1);
+	/*
+	USAGE: Marks the specified object as static, its model is merged with the ones of the static
+	entities around it sharing a material (only for entities that know their meshes)
+	ARGUMENTS:
+	-	bool a_bStatic -> is it static?
+	-	String a_sUniqueID -> ID of the MyEntity
+	OUTPUT: ---
+	*/
+	void SetStatic(bool a_bStatic, String a_sUniqueID);
+	/*
+	USAGE: Marks the specified object as static, its model is merged with the ones of the static
+	entities around it sharing a material (only for entities that know their meshes)
+	ARGUMENTS:
+	-	bool a_bStatic = true -> is it static?
+	-	uint a_uIndex = -1 -> ID of the MyEntity if < 0 last object added
+	OUTPUT: ---
+	*/
+	void SetStatic(bool a_bStatic = true, uint a_uIndex = -1);
+	/*
+	USAGE: Makes the specified object move with another one, its model matrix becomes relative to the
+	parent (entities using the physics solver should stay roots)
+	ARGUMENTS:
+	-	String a_sParentID -> ID of the parent MyEntity, an empty String makes it a root
+	-	String a_sUniqueID -> ID of the MyEntity
+	OUTPUT: was it set? (an entity cannot be parented to one of its children)
+	*/
+	bool SetParent(String a_sParentID, String a_sUniqueID);
+	/*
+	USAGE: Makes the specified object move with another one, its model matrix becomes relative to the
+	parent (entities using the physics solver should stay roots)
+	ARGUMENTS:
+	-	String a_sParentID -> ID of the parent MyEntity, an empty String makes it a root
+	-	uint a_uIndex = -1 -> ID of the MyEntity if < 0 last object added
+	OUTPUT: was it set? (an entity cannot be parented to one of its children)
+	*/
+	bool SetParent(String a_sParentID, uint a_uIndex = -1);
+	/*
+	USAGE: Gets the batcher drawing the static entities
+	ARGUMENTS: ---
+	OUTPUT: static batcher
+	*/
+	MyStaticBatcher* GetStaticBatcher(void);
+	/*
+	USAGE: Gets (creating it empty the first time) an animation clip, its tracks are added by the caller
+	ARGUMENTS: String a_sName -> name of the clip
+	OUTPUT: animation clip
+	*/
+	MyAnimationClip* GetAnimation(String a_sName);
+	/*
+	USAGE: Plays an animation clip on the specified object
+	ARGUMENTS:
+	-	String a_sAnimation -> name of the clip
+	-	float a_fFramesPerSecond -> speed of the playback
+	-	String a_sUniqueID -> ID of the MyEntity
+	OUTPUT: ---
+	*/
+	void SetAnimation(String a_sAnimation, float a_fFramesPerSecond, String a_sUniqueID);
+	/*
+	USAGE: Plays an animation clip on the specified object
+	ARGUMENTS:
+	-	String a_sAnimation -> name of the clip
+	-	float a_fFramesPerSecond = 24.0f -> speed of the playback
+	-	uint a_uIndex = -1 -> ID of the MyEntity if < 0 last object added
+	OUTPUT: ---
+	*/
+	void SetAnimation(String a_sAnimation, float a_fFramesPerSecond = 24.0f, uint a_uIndex = -1);
+	/*
+	USAGE: Gets the number of entities animated in the last update
+	ARGUMENTS: ---
+	OUTPUT: animated count
+	*/
+	uint GetAnimatedCount(void);
+	/*
+	USAGE: Gets the milliseconds the poses of the animated entities took to sample in the last update
+	ARGUMENTS: ---
+	OUTPUT: time in milliseconds
+	*/
+	float GetAnimationTime(void);
+	/*
+	USAGE: Gets the cache sharing the poses of the animated entities
+	ARGUMENTS: ---
+	OUTPUT: pose cache
+	*/
+	MyPoseCache* GetPoseCache(void);
+	/*
+	USAGE: Gets the scheduler of the systems run by the update
+	ARGUMENTS: ---
+	OUTPUT: update scheduler
+	*/
+	MySystemScheduler* GetUpdateScheduler(void);
+	/*
+	USAGE: Gets the scheduler of the systems run when all the entities are added to the render list
+	ARGUMENTS: ---
+	OUTPUT: render scheduler
+	*/
+	MySystemScheduler* GetRenderScheduler(void);
+	/*
+	USAGE: Sets the convex hull as collision shape of the specified object
+	ARGUMENTS:
+	-	bool a_bUse = true -> Using the convex hull?
+	-	uint a_uIndex = -1 -> ID of the MyEntity if < 0 last object added
+	OUTPUT: ---
+	*/
+	void UseConvexHull(bool a_bUse = true, uint a_uIndex = -1);
+	/*
+	USAGE: Casts a ray against the OBBs of the entities and finds the closest hit, the broad phase
+	in use picks the candidates
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> direction of the ray (does not need to be normalized)
+	-	float a_fMaxDistance -> length of the ray
+	-	MyRayHit& a_hit -> out: closest hit
+	OUTPUT: was anything hit?
+	*/
+	bool RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, MyRayHit& a_hit);
+	/*
+	USAGE: Casts a ray against the OBBs of the entities and finds all the hits
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> direction of the ray (does not need to be normalized)
+	-	float a_fMaxDistance -> length of the ray
+	-	std::vector<MyRayHit>& a_hitList -> list to fill sorted by distance (will be cleared first)
+	OUTPUT: number of hits
+	*/
+	uint RayCastAll(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, std::vector<MyRayHit>& a_hitList);
+	/*
+	USAGE: Casts many rays at once spread over the threads of the job system
+	ARGUMENTS:
+	-	std::vector<MyRay> const& a_rayList -> rays to cast
+	-	std::vector<MyRayHit>& a_hitList -> out: closest hit of each ray, m_nEntity is -1 for the misses
+	OUTPUT: ---
+	*/
+	void RayCastBatch(std::vector<MyRay> const& a_rayList, std::vector<MyRayHit>& a_hitList);
+	/*
+	USAGE: Moves a sphere along a ray and finds the first OBB it touches
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> center of the sphere at the start
+	-	vector3 a_v3Direction -> direction of the movement (does not need to be normalized)
+	-	float a_fRadius -> radius of the sphere
+	-	float a_fMaxDistance -> length of the movement
+	-	MyRayHit& a_hit -> out: first hit, the point is where the sphere touches the OBB
+	OUTPUT: was anything hit?
+	*/
+	bool SweepSphere(vector3 a_v3Origin, vector3 a_v3Direction, float a_fRadius, float a_fMaxDistance, MyRayHit& a_hit);
+	/*
+	USAGE: Gets the entities whose OBB overlaps a sphere
+	ARGUMENTS:
+	-	vector3 a_v3Center -> center of the sphere
+	-	float a_fRadius -> radius of the sphere
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void OverlapSphere(vector3 a_v3Center, float a_fRadius, std::vector<uint>& a_entityList);
+	/*
+	USAGE: Gets the entities whose OBB overlaps an axis aligned box
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void OverlapBox(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList);
+	/*
+	USAGE: Updates the broad phase for the queries if the entities moved since the last update, call
+	it after moving entities without the entity manager
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void RefreshQueries(void);
 private:
 	/*
 	Usage: constructor
@@ -348,6 +637,45 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	USAGE: Finds the representative of the island of an entity (compressing the path)
+	ARGUMENTS: uint a_uIndex -> index of the entity
+	OUTPUT: index of the representative
+	*/
+	uint FindIsland(uint a_uIndex);
+	/*
+	USAGE: Joins the islands of two entities in contact
+	ARGUMENTS:
+	-	uint a_uIndexA -> index of the first entity
+	-	uint a_uIndexB -> index of the second entity
+	OUTPUT: ---
+	*/
+	void UnionIslands(uint a_uIndexA, uint a_uIndexB);
+	/*
+	USAGE: Wakes the piles touched by awake entities and puts to sleep the islands that are at rest
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateIslands(void);
+	/*
+	USAGE: Adds the systems of the update and the render schedulers, they work on the components of
+	the archetype store and reach the rest of the entity through the pointers of the chunks
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void AddSystems(void);
+	/*
+	USAGE: Casts a ray against the candidates of the broad phase, safe to call from several threads
+	at the same time once the queries are refreshed
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> unit direction of the ray
+	-	float a_fMaxDistance -> length of the ray
+	-	float a_fRadius -> radius of the sphere moved along the ray, 0 for a ray
+	-	MyRayHit& a_hit -> out: closest hit
+	OUTPUT: was anything hit?
+	*/
+	bool CastClosest(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius, MyRayHit& a_hit);
 };//class
 
 } //namespace Simplex
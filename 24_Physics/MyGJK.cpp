@@ -0,0 +1,414 @@
+#include "MyGJK.h"
+using namespace Simplex;
+//Vertex of the Minkowski difference A - B
+struct MySimplexVertex
+{
+	vector3 m_v3Point; //support of A minus support of B
+	uint m_uA; //support vertex of A
+	uint m_uB; //support vertex of B
+};
+//Face of the EPA polytope
+struct MyPolytopeFace
+{
+	uint m_uVertex[3]; //vertices, counter clockwise seen from outside
+	vector3 m_v3Normal; //outward normal
+	float m_fDistance; //distance to the origin
+};
+static MySimplexVertex Support(MyRigidBody* a_pA, MyRigidBody* a_pB, vector3 a_v3Direction)
+{
+	vector3 v3PointA, v3PointB;
+	MySimplexVertex vertex;
+	vertex.m_uA = a_pA->GetSupport(a_v3Direction, v3PointA);
+	vertex.m_uB = a_pB->GetSupport(-a_v3Direction, v3PointB);
+	vertex.m_v3Point = v3PointA - v3PointB;
+	return vertex;
+}
+//closest point of a segment to the origin, the simplex is reduced to the closest feature
+static vector3 SolveSegment(MySimplexVertex* a_pSimplex, uint& a_uCount)
+{
+	vector3 a = a_pSimplex[0].m_v3Point;
+	vector3 ab = a_pSimplex[1].m_v3Point - a;
+	float fLength = glm::dot(ab, ab);
+	float t = fLength > FLT_EPSILON ? -glm::dot(a, ab) / fLength : 0.0f;
+	if (t <= 0.0f)
+	{
+		a_uCount = 1;
+		return a;
+	}
+	if (t >= 1.0f)
+	{
+		a_pSimplex[0] = a_pSimplex[1];
+		a_uCount = 1;
+		return a_pSimplex[0].m_v3Point;
+	}
+	a_uCount = 2;
+	return a + ab * t;
+}
+//closest point of a triangle to the origin (Real-Time Collision Detection 5.1.5)
+static vector3 SolveTriangle(MySimplexVertex* a_pSimplex, uint& a_uCount)
+{
+	vector3 a = a_pSimplex[0].m_v3Point;
+	vector3 b = a_pSimplex[1].m_v3Point;
+	vector3 c = a_pSimplex[2].m_v3Point;
+	vector3 ab = b - a;
+	vector3 ac = c - a;
+
+	float d1 = glm::dot(ab, -a);
+	float d2 = glm::dot(ac, -a);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+	{
+		a_uCount = 1;
+		return a;
+	}
+
+	float d3 = glm::dot(ab, -b);
+	float d4 = glm::dot(ac, -b);
+	if (d3 >= 0.0f && d4 <= d3)
+	{
+		a_pSimplex[0] = a_pSimplex[1];
+		a_uCount = 1;
+		return b;
+	}
+
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		a_uCount = 2;
+		return a + ab * (d1 / (d1 - d3));
+	}
+
+	float d5 = glm::dot(ab, -c);
+	float d6 = glm::dot(ac, -c);
+	if (d6 >= 0.0f && d5 <= d6)
+	{
+		a_pSimplex[0] = a_pSimplex[2];
+		a_uCount = 1;
+		return c;
+	}
+
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		a_pSimplex[1] = a_pSimplex[2];
+		a_uCount = 2;
+		return a + ac * (d2 / (d2 - d6));
+	}
+
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+	{
+		a_pSimplex[0] = a_pSimplex[1];
+		a_pSimplex[1] = a_pSimplex[2];
+		a_uCount = 2;
+		return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+	}
+
+	float fSum = va + vb + vc;
+	if (fSum <= FLT_EPSILON)
+	{
+		//degenerated triangle, use its best edge
+		MySimplexVertex edge[3][2] = { { a_pSimplex[0], a_pSimplex[1] },{ a_pSimplex[1], a_pSimplex[2] },{ a_pSimplex[0], a_pSimplex[2] } };
+		vector3 v3Best;
+		float fBest = FLT_MAX;
+		for (uint i = 0; i < 3; ++i)
+		{
+			uint uCount = 2;
+			vector3 v3Closest = SolveSegment(edge[i], uCount);
+			if (glm::dot(v3Closest, v3Closest) < fBest)
+			{
+				fBest = glm::dot(v3Closest, v3Closest);
+				v3Best = v3Closest;
+				a_uCount = uCount;
+				a_pSimplex[0] = edge[i][0];
+				a_pSimplex[1] = edge[i][1];
+			}
+		}
+		return v3Best;
+	}
+
+	a_uCount = 3;
+	return a + ab * (vb / fSum) + ac * (vc / fSum);
+}
+//closest point of a tetrahedron to the origin, tells if the origin is inside
+static vector3 SolveTetrahedron(MySimplexVertex* a_pSimplex, uint& a_uCount, bool& a_bContains)
+{
+	static const uint uFace[4][4] = { { 0, 1, 2, 3 },{ 0, 1, 3, 2 },{ 0, 2, 3, 1 },{ 1, 2, 3, 0 } };
+	vector3 v3Best = ZERO_V3;
+	float fBest = FLT_MAX;
+	MySimplexVertex best[3];
+	uint uBestCount = 0;
+	//a flat tetrahedron has every face plane on the same side of the origin, it can not contain it
+	vector3 a = a_pSimplex[0].m_v3Point;
+	vector3 ab = a_pSimplex[1].m_v3Point - a;
+	vector3 ac = a_pSimplex[2].m_v3Point - a;
+	vector3 ad = a_pSimplex[3].m_v3Point - a;
+	float fVolume = glm::abs(glm::dot(glm::cross(ab, ac), ad));
+	bool bFlat = fVolume <= 1e-6f * glm::length(ab) * glm::length(ac) * glm::length(ad);
+	a_bContains = !bFlat;
+	for (uint i = 0; i < 4; ++i)
+	{
+		vector3 v3Vertex = a_pSimplex[uFace[i][0]].m_v3Point;
+		vector3 v3Normal = glm::cross(a_pSimplex[uFace[i][1]].m_v3Point - v3Vertex, a_pSimplex[uFace[i][2]].m_v3Point - v3Vertex);
+		float fOrigin = glm::dot(v3Normal, -v3Vertex);
+		float fOpposite = glm::dot(v3Normal, a_pSimplex[uFace[i][3]].m_v3Point - v3Vertex);
+
+		//the origin is inside if it is on the side of the opposite vertex of every face
+		if (!bFlat && fOrigin * fOpposite >= 0.0f)
+			continue;
+		a_bContains = false;
+
+		MySimplexVertex triangle[3] = { a_pSimplex[uFace[i][0]], a_pSimplex[uFace[i][1]], a_pSimplex[uFace[i][2]] };
+		uint uCount = 3;
+		vector3 v3Closest = SolveTriangle(triangle, uCount);
+		if (glm::dot(v3Closest, v3Closest) < fBest)
+		{
+			fBest = glm::dot(v3Closest, v3Closest);
+			v3Best = v3Closest;
+			uBestCount = uCount;
+			for (uint j = 0; j < uCount; ++j)
+				best[j] = triangle[j];
+		}
+	}
+	if (a_bContains)
+		return ZERO_V3;
+
+	a_uCount = uBestCount;
+	for (uint j = 0; j < uBestCount; ++j)
+		a_pSimplex[j] = best[j];
+	return v3Best;
+}
+static void SaveSimplex(MySimplexVertex* a_pSimplex, uint a_uCount, MySimplexCache& a_cache)
+{
+	a_cache.m_uCount = a_uCount;
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		a_cache.m_uIndexA[i] = a_pSimplex[i].m_uA;
+		a_cache.m_uIndexB[i] = a_pSimplex[i].m_uB;
+	}
+}
+//  MyGJK
+bool Simplex::MyGJK::Intersect(MyRigidBody* a_pA, MyRigidBody* a_pB, MySimplexCache& a_cache, uint& a_uIterations)
+{
+	//the vertices of the last simplex are evaluated again with the current transforms
+	MySimplexVertex simplex[4];
+	uint uCount = 0;
+	for (uint i = 0; i < a_cache.m_uCount && i < 4; ++i)
+	{
+		MySimplexVertex vertex;
+		vertex.m_uA = a_cache.m_uIndexA[i];
+		vertex.m_uB = a_cache.m_uIndexB[i];
+		vertex.m_v3Point = a_pA->GetSupportPoint(vertex.m_uA) - a_pB->GetSupportPoint(vertex.m_uB);
+		simplex[uCount++] = vertex;
+	}
+	if (uCount == 0)
+	{
+		vector3 v3Direction = a_pA->GetCenterGlobal() - a_pB->GetCenterGlobal();
+		if (glm::dot(v3Direction, v3Direction) < FLT_EPSILON)
+			v3Direction = AXIS_X;
+		simplex[uCount++] = Support(a_pA, a_pB, v3Direction);
+	}
+
+	a_uIterations = 0;
+	for (uint uIteration = 0; uIteration < 32; ++uIteration)
+	{
+		//closest point of the simplex to the origin
+		bool bContains = false;
+		vector3 v3Closest;
+		switch (uCount)
+		{
+		case 1: v3Closest = simplex[0].m_v3Point; break;
+		case 2: v3Closest = SolveSegment(simplex, uCount); break;
+		case 3: v3Closest = SolveTriangle(simplex, uCount); break;
+		default: v3Closest = SolveTetrahedron(simplex, uCount, bContains); break;
+		}
+		if (bContains || glm::dot(v3Closest, v3Closest) < 1e-10f)
+		{
+			SaveSimplex(simplex, uCount, a_cache);
+			return true;
+		}
+
+		//look for the origin on the other side
+		vector3 v3Direction = -v3Closest;
+		MySimplexVertex vertex = Support(a_pA, a_pB, v3Direction);
+		++a_uIterations;
+		if (glm::dot(vertex.m_v3Point, v3Direction) < 0.0f)
+		{
+			SaveSimplex(simplex, uCount, a_cache);
+			return false;
+		}
+
+		//a vertex we already have means there is no more progress to make
+		for (uint i = 0; i < uCount; ++i)
+		{
+			if (simplex[i].m_uA == vertex.m_uA && simplex[i].m_uB == vertex.m_uB)
+			{
+				SaveSimplex(simplex, uCount, a_cache);
+				return glm::dot(v3Closest, v3Closest) < 1e-6f;
+			}
+		}
+		simplex[uCount++] = vertex;
+	}
+	SaveSimplex(simplex, uCount, a_cache);
+	return false;
+}
+void Simplex::MyGJK::Penetration(MyRigidBody* a_pA, MyRigidBody* a_pB, MySimplexCache const& a_cache, MyContact& a_contact)
+{
+	//touching contacts with no volume to expand fall back to the direction between centers
+	a_contact.m_v3Normal = a_pB->GetCenterGlobal() - a_pA->GetCenterGlobal();
+	a_contact.m_v3Normal = glm::dot(a_contact.m_v3Normal, a_contact.m_v3Normal) > FLT_EPSILON ? glm::normalize(a_contact.m_v3Normal) : AXIS_Y;
+	a_contact.m_fDepth = 0.0f;
+
+	std::vector<MySimplexVertex> vertexList;
+	for (uint i = 0; i < a_cache.m_uCount; ++i)
+	{
+		MySimplexVertex vertex;
+		vertex.m_uA = a_cache.m_uIndexA[i];
+		vertex.m_uB = a_cache.m_uIndexB[i];
+		vertex.m_v3Point = a_pA->GetSupportPoint(vertex.m_uA) - a_pB->GetSupportPoint(vertex.m_uB);
+		vertexList.push_back(vertex);
+	}
+	if (vertexList.size() == 0)
+		return;
+
+	//EPA needs a tetrahedron, GJK stops earlier if the origin is on the simplex
+	vector3 v3Axis[3] = { AXIS_X, AXIS_Y, AXIS_Z };
+	for (uint uTry = 0; uTry < 6 && vertexList.size() < 4; ++uTry)
+	{
+		vector3 a = vertexList[0].m_v3Point;
+		vector3 v3Direction;
+		if (vertexList.size() == 1)
+			v3Direction = v3Axis[uTry / 2];
+		else if (vertexList.size() == 2)
+			v3Direction = glm::cross(vertexList[1].m_v3Point - a, v3Axis[uTry / 2]);
+		else
+			v3Direction = glm::cross(vertexList[1].m_v3Point - a, vertexList[2].m_v3Point - a);
+		if (uTry % 2)
+			v3Direction = -v3Direction;
+		if (glm::dot(v3Direction, v3Direction) < FLT_EPSILON)
+			continue;
+
+		MySimplexVertex vertex = Support(a_pA, a_pB, v3Direction);
+		vector3 v3Offset = vertex.m_v3Point - a;
+		float fGain = 0.0f;
+		if (vertexList.size() == 1)
+			fGain = glm::dot(v3Offset, v3Offset);
+		else if (vertexList.size() == 2)
+			fGain = glm::length(glm::cross(vertexList[1].m_v3Point - a, v3Offset));
+		else
+			fGain = glm::abs(glm::dot(glm::normalize(v3Direction), v3Offset));
+		if (fGain > 1e-5f)
+			vertexList.push_back(vertex);
+	}
+	if (vertexList.size() < 4)
+		return;
+
+	//faces of the tetrahedron facing away from its centroid
+	std::vector<MyPolytopeFace> faceList;
+	vector3 v3Centroid = (vertexList[0].m_v3Point + vertexList[1].m_v3Point + vertexList[2].m_v3Point + vertexList[3].m_v3Point) * 0.25f;
+	uint uTetrahedron[4][3] = { { 0, 1, 2 },{ 0, 3, 1 },{ 0, 2, 3 },{ 1, 3, 2 } };
+	for (uint i = 0; i < 4; ++i)
+	{
+		MyPolytopeFace face;
+		face.m_uVertex[0] = uTetrahedron[i][0];
+		face.m_uVertex[1] = uTetrahedron[i][1];
+		face.m_uVertex[2] = uTetrahedron[i][2];
+		vector3 a = vertexList[face.m_uVertex[0]].m_v3Point;
+		face.m_v3Normal = glm::cross(vertexList[face.m_uVertex[1]].m_v3Point - a, vertexList[face.m_uVertex[2]].m_v3Point - a);
+		if (glm::dot(face.m_v3Normal, v3Centroid - a) > 0.0f)
+		{
+			std::swap(face.m_uVertex[1], face.m_uVertex[2]);
+			face.m_v3Normal = -face.m_v3Normal;
+		}
+		float fLength = glm::length(face.m_v3Normal);
+		if (fLength < FLT_EPSILON)
+			return;
+		face.m_v3Normal /= fLength;
+		face.m_fDistance = glm::dot(face.m_v3Normal, a);
+		faceList.push_back(face);
+	}
+
+	//expand the polytope towards the face closest to the origin until it does not grow
+	std::vector<uint> edgeList;
+	MyPolytopeFace closest = faceList[0];
+	for (uint uIteration = 0; uIteration < 64 && faceList.size() > 0; ++uIteration)
+	{
+		uint uClosest = 0;
+		for (uint i = 1; i < faceList.size(); ++i)
+		{
+			if (faceList[i].m_fDistance < faceList[uClosest].m_fDistance)
+				uClosest = i;
+		}
+		//the polytope only grows, a face closer than the last one was turned inside out by rounding
+		//(a nearly coplanar face kept on the horizon) and the last closest face is the answer
+		if (uIteration > 0 && faceList[uClosest].m_fDistance < closest.m_fDistance - 1e-4f)
+			break;
+		closest = faceList[uClosest];
+		MySimplexVertex vertex = Support(a_pA, a_pB, closest.m_v3Normal);
+		if (glm::dot(vertex.m_v3Point, closest.m_v3Normal) - closest.m_fDistance < 1e-4f)
+			break;
+
+		//rounding can make a vertex of the polytope look ahead of the face, it would open a hole
+		bool bDuplicate = false;
+		for (uint i = 0; i < vertexList.size() && !bDuplicate; ++i)
+			bDuplicate = vertexList[i].m_uA == vertex.m_uA && vertexList[i].m_uB == vertex.m_uB;
+		if (bDuplicate)
+			break;
+
+		//remove the faces that can see the new vertex, their outline is the horizon
+		uint uNew = static_cast<uint>(vertexList.size());
+		vertexList.push_back(vertex);
+		edgeList.clear();
+		for (uint i = 0; i < faceList.size();)
+		{
+			MyPolytopeFace& face = faceList[i];
+			//faces nearly coplanar with the vertex stay, seeing them would break the horizon in pieces
+			if (glm::dot(face.m_v3Normal, vertex.m_v3Point - vertexList[face.m_uVertex[0]].m_v3Point) <= 1e-5f)
+			{
+				++i;
+				continue;
+			}
+			for (uint uEdge = 0; uEdge < 3; ++uEdge)
+			{
+				uint uFrom = face.m_uVertex[uEdge];
+				uint uTo = face.m_uVertex[(uEdge + 1) % 3];
+				bool bShared = false;
+				for (uint j = 0; j < edgeList.size(); j += 2)
+				{
+					if (edgeList[j] == uTo && edgeList[j + 1] == uFrom)
+					{
+						edgeList.erase(edgeList.begin() + j, edgeList.begin() + j + 2);
+						bShared = true;
+						break;
+					}
+				}
+				if (!bShared)
+				{
+					edgeList.push_back(uFrom);
+					edgeList.push_back(uTo);
+				}
+			}
+			faceList[i] = faceList.back();
+			faceList.pop_back();
+		}
+
+		//connect the horizon to the new vertex
+		for (uint j = 0; j < edgeList.size(); j += 2)
+		{
+			MyPolytopeFace face;
+			face.m_uVertex[0] = edgeList[j];
+			face.m_uVertex[1] = edgeList[j + 1];
+			face.m_uVertex[2] = uNew;
+			vector3 a = vertexList[face.m_uVertex[0]].m_v3Point;
+			face.m_v3Normal = glm::cross(vertexList[face.m_uVertex[1]].m_v3Point - a, vertex.m_v3Point - a);
+			float fLength = glm::length(face.m_v3Normal);
+			if (fLength < FLT_EPSILON)
+				continue;
+			face.m_v3Normal /= fLength;
+			face.m_fDistance = glm::dot(face.m_v3Normal, a);
+			faceList.push_back(face);
+		}
+	}
+
+	a_contact.m_v3Normal = closest.m_v3Normal;
+	a_contact.m_fDepth = closest.m_fDistance > 0.0f ? closest.m_fDistance : 0.0f;
+}
\ No newline at end of file
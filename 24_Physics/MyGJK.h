@@ -0,0 +1,63 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYGJK_H_
+#define __MYGJK_H_
+
+#include "MyRigidBody.h"
+
+namespace Simplex
+{
+
+//Support vertices of the last GJK simplex of a pair, used to start the next test
+struct MySimplexCache
+{
+	uint m_uCount = 0; //number of vertices
+	uint m_uIndexA[4]; //support vertex of the first rigid body
+	uint m_uIndexB[4]; //support vertex of the second rigid body
+};
+
+//Penetration of a pair of rigid bodies
+struct MyContact
+{
+	vector3 m_v3Normal = ZERO_V3; //direction from the first rigid body to the second one
+	float m_fDepth = 0.0f; //distance the second one has to move along the normal to separate them
+	float m_fImpulse = 0.0f; //impulse the contact solver applied along the normal, starts the next solve
+};
+
+//GJK intersection test and EPA penetration over the support functions of the rigid bodies
+class MyGJK
+{
+public:
+	/*
+	USAGE: Tests if two rigid bodies intersect, starting from the simplex of the last test
+	ARGUMENTS:
+	-	MyRigidBody* a_pA -> first rigid body
+	-	MyRigidBody* a_pB -> second rigid body
+	-	MySimplexCache& a_cache -> in: last simplex of the pair; out: simplex of this test
+	-	uint& a_uIterations -> out: number of support points evaluated
+	OUTPUT: do they intersect?
+	*/
+	static bool Intersect(MyRigidBody* a_pA, MyRigidBody* a_pB, MySimplexCache& a_cache, uint& a_uIterations);
+	/*
+	USAGE: Finds the penetration of two intersecting rigid bodies with EPA
+	ARGUMENTS:
+	-	MyRigidBody* a_pA -> first rigid body
+	-	MyRigidBody* a_pB -> second rigid body
+	-	MySimplexCache const& a_cache -> simplex of the intersection test that found them intersecting
+	-	MyContact& a_contact -> out: normal and depth
+	OUTPUT: ---
+	*/
+	static void Penetration(MyRigidBody* a_pA, MyRigidBody* a_pB, MySimplexCache const& a_cache, MyContact& a_contact);
+};
+
+} //namespace Simplex
+
+#endif //__MYGJK_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "MyJobSystem.h"
+using namespace Simplex;
+//  MyJobSystem
+Simplex::MyJobSystem* Simplex::MyJobSystem::m_pInstance = nullptr;
+thread_local Simplex::uint Simplex::MyJobSystem::m_uThreadIndex = 0;
+void Simplex::MyJobSystem::Init(void)
+{
+	//one thread per core, the calling thread counts as one of them
+	m_uThreadCount = std::thread::hardware_concurrency();
+	if (m_uThreadCount < 1)
+		m_uThreadCount = 1;
+
+	m_bRunning = true;
+	m_uGeneration = 0;
+	m_uActiveWorkers = 0;
+	m_uJobCount = 0;
+	m_uJobGrain = 1;
+	m_uNext = 0;
+
+	for (uint i = 1; i < m_uThreadCount; ++i)
+	{
+		m_workerList.push_back(std::thread(&MyJobSystem::WorkerLoop, this, i));
+	}
+}
+void Simplex::MyJobSystem::Release(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bRunning = false;
+	}
+	m_cvWork.notify_all();
+	for (uint i = 0; i < m_workerList.size(); ++i)
+	{
+		if (m_workerList[i].joinable())
+			m_workerList[i].join();
+	}
+	m_workerList.clear();
+	m_uThreadCount = 1;
+}
+Simplex::MyJobSystem* Simplex::MyJobSystem::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyJobSystem();
+	}
+	return m_pInstance;
+}
+void Simplex::MyJobSystem::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//Accessors
+Simplex::uint Simplex::MyJobSystem::GetThreadCount(void) { return m_uThreadCount; }
+Simplex::uint Simplex::MyJobSystem::GetThreadIndex(void) { return m_uThreadIndex; }
+//The big 3
+Simplex::MyJobSystem::MyJobSystem() { Init(); }
+Simplex::MyJobSystem::MyJobSystem(MyJobSystem const& a_pOther) { }
+Simplex::MyJobSystem& Simplex::MyJobSystem::operator=(MyJobSystem const& a_pOther) { return *this; }
+Simplex::MyJobSystem::~MyJobSystem() { Release(); };
+// other methods
+void Simplex::MyJobSystem::ParallelFor(uint a_uCount, uint a_uGrain, RangeJob a_job)
+{
+	if (a_uCount == 0)
+		return;
+
+	if (a_uGrain < 1)
+		a_uGrain = 1;
+
+	//if there is nobody to help, the job is small or we are already inside of a job run it here
+	if (m_uThreadCount == 1 || a_uCount <= a_uGrain || m_uThreadIndex != 0)
+	{
+		a_job(0, a_uCount, m_uThreadIndex);
+		return;
+	}
+
+	std::lock_guard<std::mutex> dispatch(m_dispatchMutex);
+
+	//publish the job and wake up the workers
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_job = a_job;
+		m_uJobCount = a_uCount;
+		m_uJobGrain = a_uGrain;
+		m_uNext = 0;
+		m_uActiveWorkers = m_uThreadCount - 1;
+		++m_uGeneration;
+	}
+	m_cvWork.notify_all();
+
+	//the calling thread works too
+	RunRanges(0);
+
+	//wait for the workers to finish their last range
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cvDone.wait(lock, [this] { return m_uActiveWorkers == 0; });
+	m_job = nullptr;
+}
+void Simplex::MyJobSystem::RunRanges(uint a_uThread)
+{
+	uint uBegin = m_uNext.fetch_add(m_uJobGrain);
+	while (uBegin < m_uJobCount)
+	{
+		uint uEnd = uBegin + m_uJobGrain;
+		if (uEnd > m_uJobCount)
+			uEnd = m_uJobCount;
+		m_job(uBegin, uEnd, a_uThread);
+		uBegin = m_uNext.fetch_add(m_uJobGrain);
+	}
+}
+void Simplex::MyJobSystem::WorkerLoop(uint a_uThread)
+{
+	m_uThreadIndex = a_uThread;
+	uint uSeen = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cvWork.wait(lock, [this, uSeen] { return !m_bRunning || m_uGeneration != uSeen; });
+			if (!m_bRunning)
+				return;
+			uSeen = m_uGeneration;
+		}
+
+		RunRanges(a_uThread);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_uActiveWorkers;
+			if (m_uActiveWorkers == 0)
+				m_cvDone.notify_one();
+		}
+	}
+}
\ No newline at end of file
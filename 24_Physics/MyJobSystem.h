@@ -0,0 +1,142 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYJOBSYSTEM_H_
+#define __MYJOBSYSTEM_H_
+
+#include "Simplex\Simplex.h"
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+
+namespace Simplex
+{
+
+//System Class
+class MyJobSystem
+{
+public:
+	typedef std::function<void(uint a_uBegin, uint a_uEnd, uint a_uThread)> RangeJob; //job over [begin, end)
+
+private:
+	uint m_uThreadCount = 1; //number of threads working on a job, the calling thread included
+	std::vector<std::thread> m_workerList; //worker threads (thread index 1 and up)
+
+	std::mutex m_dispatchMutex; //only one ParallelFor can be dispatched at a time
+	std::mutex m_mutex; //guards the job description
+	std::condition_variable m_cvWork; //signals the workers there is a new job
+	std::condition_variable m_cvDone; //signals the caller the workers finished
+
+	bool m_bRunning = false; //are the workers alive?
+	uint m_uGeneration = 0; //incremented on each new job so workers know there is work
+	uint m_uActiveWorkers = 0; //workers still processing the current job
+
+	RangeJob m_job; //current job
+	uint m_uJobCount = 0; //number of elements of the current job
+	uint m_uJobGrain = 1; //number of elements a thread takes at a time
+	std::atomic<uint> m_uNext; //next element to be taken
+
+	static thread_local uint m_uThreadIndex; //index of the thread running the code (0 for non workers)
+	static MyJobSystem* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyJobSystem* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Gets the number of threads that can work on a job (calling thread included)
+	ARGUMENTS: ---
+	OUTPUT: thread count
+	*/
+	uint GetThreadCount(void);
+	/*
+	USAGE: Gets the index of the thread executing this call, 0 for the main thread
+	(or any thread not owned by the job system), 1 to GetThreadCount() - 1 for the workers
+	ARGUMENTS: ---
+	OUTPUT: thread index
+	*/
+	static uint GetThreadIndex(void);
+	/*
+	USAGE: Splits [0, a_uCount) in ranges of a_uGrain elements and runs them on all threads,
+	the calling thread works as well and the call returns once all ranges are done.
+	Calls from inside a job run serially on the calling thread.
+	ARGUMENTS:
+	-	uint a_uCount -> number of elements
+	-	uint a_uGrain -> number of elements per range
+	-	RangeJob a_job -> function to execute for each range
+	OUTPUT: ---
+	*/
+	void ParallelFor(uint a_uCount, uint a_uGrain, RangeJob a_job);
+
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyJobSystem(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyJobSystem(MyJobSystem const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyJobSystem& operator=(MyJobSystem const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyJobSystem(void);
+	/*
+	Usage: stops and joins the workers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton and spawns the workers
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Main loop of the worker threads
+	ARGUMENTS: uint a_uThread -> index of the worker
+	OUTPUT: ---
+	*/
+	void WorkerLoop(uint a_uThread);
+	/*
+	USAGE: Takes ranges of the current job until there are none left
+	ARGUMENTS: uint a_uThread -> index of the thread taking the ranges
+	OUTPUT: ---
+	*/
+	void RunRanges(uint a_uThread);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYJOBSYSTEM_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
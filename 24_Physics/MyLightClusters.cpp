@@ -0,0 +1,429 @@
+#include "MyLightClusters.h"
+#include <immintrin.h>
+using namespace Simplex;
+//  MyLightClusters
+Simplex::MyLightClusters* Simplex::MyLightClusters::m_pInstance = nullptr;
+void Simplex::MyLightClusters::Init(void)
+{
+	SetGrid(m_uTileX, m_uTileY, m_uSliceCount);
+}
+void Simplex::MyLightClusters::Release(void)
+{
+	if (m_uLightBuffer != 0)
+	{
+		glDeleteTextures(1, &m_uLightTexture);
+		glDeleteTextures(1, &m_uClusterTexture);
+		glDeleteTextures(1, &m_uIndexTexture);
+		glDeleteBuffers(1, &m_uLightBuffer);
+		glDeleteBuffers(1, &m_uClusterBuffer);
+		glDeleteBuffers(1, &m_uIndexBuffer);
+		m_uLightBuffer = 0;
+	}
+	m_lightList.clear();
+	m_sliceLightList.clear();
+	m_sliceIndexList.clear();
+	m_scratchList.clear();
+	m_blockList.clear();
+	m_clusterList.clear();
+	m_indexList.clear();
+}
+Simplex::MyLightClusters* Simplex::MyLightClusters::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyLightClusters();
+	}
+	return m_pInstance;
+}
+void Simplex::MyLightClusters::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyLightClusters::MyLightClusters() { Init(); }
+Simplex::MyLightClusters::MyLightClusters(MyLightClusters const& other) { }
+Simplex::MyLightClusters& Simplex::MyLightClusters::operator=(MyLightClusters const& other) { return *this; }
+Simplex::MyLightClusters::~MyLightClusters() { Release(); }
+//Accessors
+Simplex::MyPointLight* Simplex::MyLightClusters::GetLight(uint a_uIndex) { return &m_lightList[a_uIndex]; }
+Simplex::uint Simplex::MyLightClusters::GetLightCount(void) { return m_lightList.size(); }
+void Simplex::MyLightClusters::ClearLights(void) { m_lightList.clear(); }
+Simplex::uint Simplex::MyLightClusters::GetClusterCount(void) { return m_clusterList.size(); }
+Simplex::MyLightCluster Simplex::MyLightClusters::GetCluster(uint a_uIndex) { return m_clusterList[a_uIndex]; }
+std::vector<uint16_t> const& Simplex::MyLightClusters::GetIndexList(void) { return m_indexList; }
+float Simplex::MyLightClusters::GetBinTime(void) { return m_fBinTime; }
+void Simplex::MyLightClusters::SetCutoff(float a_fCutoff) { m_fCutoff = (glm::max)(a_fCutoff, 0.0001f); }
+void Simplex::MyLightClusters::SetGrid(uint a_uTileX, uint a_uTileY, uint a_uSliceCount)
+{
+	m_uTileX = (glm::max)(a_uTileX, 1u);
+	m_uTileY = (glm::max)(a_uTileY, 1u);
+	m_uSliceCount = (glm::max)(a_uSliceCount, 1u);
+	m_clusterList.assign(m_uTileX * m_uTileY * m_uSliceCount, MyLightCluster());
+	m_sliceLightList.resize(m_uSliceCount);
+	m_sliceIndexList.resize(m_uSliceCount);
+}
+//Lights
+Simplex::uint Simplex::MyLightClusters::AddLight(vector3 a_v3Position, vector3 a_v3Color, float a_fIntensity)
+{
+	MyPointLight light;
+	light.m_v3Position = a_v3Position;
+	light.m_v3Color = a_v3Color;
+	light.m_fIntensity = a_fIntensity;
+	//intensity / distance^2 falls under the cutoff past the radius
+	float fPower = a_fIntensity * (glm::max)(a_v3Color.x, (glm::max)(a_v3Color.y, a_v3Color.z));
+	light.m_fRadius = glm::sqrt((glm::max)(fPower, 0.0f) / m_fCutoff);
+	m_lightList.push_back(light);
+	return m_lightList.size() - 1;
+}
+void Simplex::MyLightClusters::AddLightManagerLights(uint a_uFirst, uint a_uCount)
+{
+	LightManager* pLightMngr = LightManager::GetInstance();
+	for (uint i = a_uFirst; i < a_uFirst + a_uCount; ++i)
+	{
+		Light* pLight = pLightMngr->GetLight(i);
+		if (pLight != nullptr)
+			AddLight(pLight->GetPosition(), pLight->GetColor(), pLight->GetIntensity());
+	}
+}
+//Binning
+float Simplex::MyLightClusters::GetSliceDepth(uint a_uSlice)
+{
+	//the first slice starts at the camera and the last one ends at the far plane
+	if (a_uSlice == 0)
+		return 0.0f;
+	if (a_uSlice >= m_uSliceCount)
+		return m_fFar;
+	return m_fNear * glm::exp(a_uSlice / m_fSliceScale);
+}
+int Simplex::MyLightClusters::FindCluster(vector3 a_v3Position)
+{
+	if (!m_bPerspective)
+		return -1;
+
+	vector4 v4View = m_m4View * vector4(a_v3Position, 1.0f);
+	float fDepth = -v4View.z;
+	if (fDepth <= 0.0f || fDepth > m_fFar)
+		return -1;
+
+	//same math as the shader, the screen position from the projection
+	vector4 v4Clip = m_m4Projection * v4View;
+	vector2 v2NDC = vector2(v4Clip) / v4Clip.w;
+	if (glm::abs(v2NDC.x) > 1.0f || glm::abs(v2NDC.y) > 1.0f)
+		return -1;
+
+	uint uX = (glm::min)(static_cast<uint>((v2NDC.x + 1.0f) * 0.5f * m_uTileX), m_uTileX - 1);
+	uint uY = (glm::min)(static_cast<uint>((v2NDC.y + 1.0f) * 0.5f * m_uTileY), m_uTileY - 1);
+	int nSlice = static_cast<int>(glm::floor(glm::log(fDepth / m_fNear) * m_fSliceScale));
+	uint uSlice = static_cast<uint>(glm::clamp(nSlice, 0, static_cast<int>(m_uSliceCount) - 1));
+	return (uSlice * m_uTileY + uY) * m_uTileX + uX;
+}
+void Simplex::MyLightClusters::Bin(matrix4 const& a_m4View, matrix4 const& a_m4Projection)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	m_m4View = a_m4View;
+	m_m4Projection = a_m4Projection;
+	for (uint i = 0; i < m_uSliceCount; ++i)
+	{
+		m_sliceLightList[i].clear();
+		m_sliceIndexList[i].clear();
+	}
+	m_indexList.clear();
+
+	//orthographic cameras have no depth slices to speak of, the shader falls back to the single light
+	m_bPerspective = a_m4Projection[2][3] == -1.0f && a_m4Projection[3][3] == 0.0f;
+	if (!m_bPerspective || m_lightList.size() == 0)
+	{
+		m_clusterList.assign(m_clusterList.size(), MyLightCluster());
+		m_fBinTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return;
+	}
+
+	//near and far planes from the projection, the slices start a bit away from the camera so the
+	//near ones are not too thin
+	float fNear = a_m4Projection[3][2] / (a_m4Projection[2][2] - 1.0f);
+	m_fFar = a_m4Projection[3][2] / (a_m4Projection[2][2] + 1.0f);
+	m_fNear = (glm::max)(fNear, 1.0f);
+	if (m_fNear >= m_fFar)
+		m_fNear = fNear;
+	m_fSliceScale = m_uSliceCount / glm::log(m_fFar / m_fNear);
+
+	//side planes of the frustum in view space (rows of the projection), normalized
+	vector4 v4Plane[4];
+	for (uint i = 0; i < 4; ++i)
+	{
+		uint uRow = i / 2;
+		float fSign = (i % 2 == 0) ? 1.0f : -1.0f;
+		for (uint j = 0; j < 4; ++j)
+		{
+			v4Plane[i][j] = a_m4Projection[j][3] + fSign * a_m4Projection[j][uRow];
+		}
+		v4Plane[i] /= glm::length(vector3(v4Plane[i]));
+	}
+
+	//lights in view space, each one inside the frustum goes to the slices its sphere touches
+	uint uLightCount = (glm::min)(static_cast<uint>(m_lightList.size()), 65536u);
+	m_lightX.resize(uLightCount);
+	m_lightY.resize(uLightCount);
+	m_lightZ.resize(uLightCount);
+	for (uint i = 0; i < uLightCount; ++i)
+	{
+		MyPointLight& light = m_lightList[i];
+		vector4 v4View = a_m4View * vector4(light.m_v3Position, 1.0f);
+		m_lightX[i] = v4View.x;
+		m_lightY[i] = v4View.y;
+		m_lightZ[i] = -v4View.z;
+		if (m_lightZ[i] + light.m_fRadius <= 0.0f || m_lightZ[i] - light.m_fRadius >= m_fFar)
+			continue;
+		bool bOutside = false;
+		for (uint j = 0; j < 4 && !bOutside; ++j)
+		{
+			bOutside = glm::dot(v4Plane[j], v4View) < -light.m_fRadius;
+		}
+		if (bOutside)
+			continue;
+
+		float fClosest = (glm::max)(m_lightZ[i] - light.m_fRadius, m_fNear);
+		float fFarthest = (glm::max)(m_lightZ[i] + light.m_fRadius, m_fNear);
+		int nFirst = static_cast<int>(glm::floor(glm::log(fClosest / m_fNear) * m_fSliceScale));
+		int nLast = static_cast<int>(glm::floor(glm::log(fFarthest / m_fNear) * m_fSliceScale));
+		nFirst = glm::clamp(nFirst, 0, static_cast<int>(m_uSliceCount) - 1);
+		nLast = glm::clamp(nLast, 0, static_cast<int>(m_uSliceCount) - 1);
+		for (int nSlice = nFirst; nSlice <= nLast; ++nSlice)
+		{
+			m_sliceLightList[nSlice].push_back(i);
+		}
+	}
+
+	//each slice is binned on its own
+	MyJobSystem* pJobSystem = MyJobSystem::GetInstance();
+	m_scratchList.resize(pJobSystem->GetThreadCount());
+	m_blockList.resize(pJobSystem->GetThreadCount());
+	pJobSystem->ParallelFor(m_uSliceCount, 1, [this, &a_m4Projection](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			BinSlice(i, a_uThread, a_m4Projection);
+		}
+	});
+
+	//the slice lists go one after the other, the clusters point into the compacted list
+	uint uClustersPerSlice = m_uTileX * m_uTileY;
+	uint uOffset = 0;
+	for (uint i = 0; i < m_uSliceCount; ++i)
+	{
+		for (uint j = i * uClustersPerSlice; j < (i + 1) * uClustersPerSlice; ++j)
+		{
+			m_clusterList[j].m_uOffset += uOffset;
+		}
+		uOffset += m_sliceIndexList[i].size();
+	}
+	m_indexList.resize(uOffset);
+	uOffset = 0;
+	for (uint i = 0; i < m_uSliceCount; ++i)
+	{
+		if (m_sliceIndexList[i].size() > 0)
+			memcpy(&m_indexList[uOffset], m_sliceIndexList[i].data(), sizeof(uint16_t) * m_sliceIndexList[i].size());
+		uOffset += m_sliceIndexList[i].size();
+	}
+	m_fBinTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+void Simplex::MyLightClusters::BinSlice(uint a_uSlice, uint a_uThread, matrix4 const& a_m4Projection)
+{
+	std::vector<uint>& lightList = m_sliceLightList[a_uSlice];
+	std::vector<uint16_t>& indexList = m_sliceIndexList[a_uSlice];
+	MyLightCluster* pCluster = &m_clusterList[a_uSlice * m_uTileX * m_uTileY];
+
+	//the lights of the slice in SoA, padded to a multiple of four with lights that touch nothing
+	uint uCount = lightList.size();
+	uint uPadded = (uCount + 3) & ~3u;
+	std::vector<float>& scratch = m_scratchList[a_uThread];
+	scratch.resize(uPadded * (4 + m_uTileX + m_uTileY));
+	float* pX = scratch.data();
+	float* pY = pX + uPadded;
+	float* pDistanceZ = pY + uPadded;
+	float* pRadius = pDistanceZ + uPadded;
+	float* pDistanceX = pRadius + uPadded; //squared distance of each light to each column
+	float* pDistanceY = pDistanceX + uPadded * m_uTileX; //squared distance of each light to each row
+
+	//squared distance to the depth range is the same for all the clusters of the slice
+	float fStart = GetSliceDepth(a_uSlice);
+	float fEnd = GetSliceDepth(a_uSlice + 1);
+	for (uint i = 0; i < uPadded; ++i)
+	{
+		if (i >= uCount)
+		{
+			pX[i] = pY[i] = pDistanceZ[i] = 0.0f;
+			pRadius[i] = -1.0f;
+			continue;
+		}
+		uint uLight = lightList[i];
+		float fZ = m_lightZ[uLight];
+		float fDistance = (glm::max)(0.0f, (glm::max)(fStart - fZ, fZ - fEnd));
+		pX[i] = m_lightX[uLight];
+		pY[i] = m_lightY[uLight];
+		pDistanceZ[i] = fDistance * fDistance;
+		pRadius[i] = m_lightList[uLight].m_fRadius * m_lightList[uLight].m_fRadius;
+	}
+
+	//the box of a cluster is the same along a column (or row) of the slice, so the distances on x and y
+	//are found once per column and row; a screen edge in view space is x = (ndc + p20) * depth / p00
+	__m128 zero = _mm_setzero_ps();
+	for (uint uAxis = 0; uAxis < 2; ++uAxis)
+	{
+		uint uTiles = uAxis == 0 ? m_uTileX : m_uTileY;
+		float fScale = a_m4Projection[uAxis][uAxis];
+		float fShift = a_m4Projection[2][uAxis];
+		float* pPosition = uAxis == 0 ? pX : pY;
+		float* pDistance = uAxis == 0 ? pDistanceX : pDistanceY;
+		for (uint uTile = 0; uTile < uTiles; ++uTile)
+		{
+			float fLow = ((-1.0f + 2.0f * uTile / uTiles) + fShift) / fScale;
+			float fHigh = ((-1.0f + 2.0f * (uTile + 1) / uTiles) + fShift) / fScale;
+			__m128 min = _mm_set1_ps((glm::min)(fLow * fStart, fLow * fEnd));
+			__m128 max = _mm_set1_ps((glm::max)(fHigh * fStart, fHigh * fEnd));
+			float* pOut = pDistance + uTile * uPadded;
+			for (uint i = 0; i < uPadded; i += 4)
+			{
+				__m128 position = _mm_loadu_ps(pPosition + i);
+				__m128 distance = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(min, position), _mm_sub_ps(position, max)));
+				_mm_storeu_ps(pOut + i, _mm_mul_ps(distance, distance));
+			}
+		}
+	}
+
+	//sphere against box, four lights at a time; the groups of four that miss a whole row are skipped
+	//for all the clusters of the row
+	std::vector<uint>& blockList = m_blockList[a_uThread];
+	for (uint uRow = 0; uRow < m_uTileY; ++uRow)
+	{
+		float* pRow = pDistanceY + uRow * uPadded;
+		blockList.clear();
+		for (uint i = 0; i < uPadded; i += 4)
+		{
+			__m128 distance = _mm_add_ps(_mm_loadu_ps(pRow + i), _mm_loadu_ps(pDistanceZ + i));
+			_mm_storeu_ps(pRow + i, distance);
+			if (_mm_movemask_ps(_mm_cmple_ps(distance, _mm_loadu_ps(pRadius + i))) != 0)
+				blockList.push_back(i);
+		}
+		for (uint uColumn = 0; uColumn < m_uTileX; ++uColumn)
+		{
+			float* pColumn = pDistanceX + uColumn * uPadded;
+			MyLightCluster& cluster = pCluster[uRow * m_uTileX + uColumn];
+			cluster.m_uOffset = indexList.size();
+			for (uint uBlock = 0; uBlock < blockList.size(); ++uBlock)
+			{
+				uint i = blockList[uBlock];
+				__m128 distance = _mm_add_ps(_mm_loadu_ps(pColumn + i), _mm_loadu_ps(pRow + i));
+				int nMask = _mm_movemask_ps(_mm_cmple_ps(distance, _mm_loadu_ps(pRadius + i)));
+				while (nMask != 0)
+				{
+					uint uLane = 0;
+					while ((nMask & (1 << uLane)) == 0)
+						++uLane;
+					nMask &= nMask - 1;
+					indexList.push_back(static_cast<uint16_t>(lightList[i + uLane]));
+				}
+			}
+			cluster.m_uCount = indexList.size() - cluster.m_uOffset;
+		}
+	}
+}
+//Rendering
+void Simplex::MyLightClusters::CreateDeviceObjects(void)
+{
+	GLuint uBuffer[3];
+	GLuint uTexture[3];
+	GLenum format[3] = { GL_RGBA32F, GL_RG32UI, GL_R16UI };
+	glGenBuffers(3, uBuffer);
+	glGenTextures(3, uTexture);
+	for (uint i = 0; i < 3; ++i)
+	{
+		//the texture keeps looking at the buffer when its storage is replaced
+		glBindBuffer(GL_TEXTURE_BUFFER, uBuffer[i]);
+		glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW);
+		glBindTexture(GL_TEXTURE_BUFFER, uTexture[i]);
+		glTexBuffer(GL_TEXTURE_BUFFER, format[i], uBuffer[i]);
+	}
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	m_uLightBuffer = uBuffer[0];
+	m_uClusterBuffer = uBuffer[1];
+	m_uIndexBuffer = uBuffer[2];
+	m_uLightTexture = uTexture[0];
+	m_uClusterTexture = uTexture[1];
+	m_uIndexTexture = uTexture[2];
+}
+void Simplex::MyLightClusters::Publish(MyLightFrame& a_frame)
+{
+	a_frame.m_bPerspective = m_bPerspective;
+	a_frame.m_m4View = m_m4View;
+	a_frame.m_fNear = m_fNear;
+	a_frame.m_fSliceScale = m_fSliceScale;
+	a_frame.m_uTileX = m_uTileX;
+	a_frame.m_uTileY = m_uTileY;
+	a_frame.m_uSliceCount = m_uSliceCount;
+	a_frame.m_uLightCount = m_lightList.size();
+
+	//two texels per light: position and radius, color times intensity
+	a_frame.m_lightData.resize(m_lightList.size() * 2 + 2);
+	for (uint i = 0; i < m_lightList.size(); ++i)
+	{
+		MyPointLight& light = m_lightList[i];
+		a_frame.m_lightData[i * 2] = vector4(light.m_v3Position, light.m_fRadius);
+		a_frame.m_lightData[i * 2 + 1] = vector4(light.m_v3Color * light.m_fIntensity, 0.0f);
+	}
+	a_frame.m_clusterList.assign(m_clusterList.begin(), m_clusterList.end());
+	a_frame.m_indexList.assign(m_indexList.begin(), m_indexList.end());
+}
+void Simplex::MyLightClusters::Upload(MyLightFrame const& a_frame)
+{
+	GLuint uShader = ShaderManager::GetInstance()->GetShaderID("Simplex");
+	if (uShader == 0)
+		return;
+	if (m_uLightBuffer == 0)
+		CreateDeviceObjects();
+
+	glBindBuffer(GL_TEXTURE_BUFFER, m_uLightBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, sizeof(vector4) * a_frame.m_lightData.size(), a_frame.m_lightData.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_uClusterBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, sizeof(MyLightCluster) * a_frame.m_clusterList.size(), a_frame.m_clusterList.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_uIndexBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, sizeof(uint16_t) * (a_frame.m_indexList.size() + 1), nullptr, GL_STREAM_DRAW);
+	if (a_frame.m_indexList.size() > 0)
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, sizeof(uint16_t) * a_frame.m_indexList.size(), a_frame.m_indexList.data());
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	// Backup GL state
+	GLint last_program, last_active_texture;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
+	glGetIntegerv(GL_ACTIVE_TEXTURE, &last_active_texture);
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	//the uniforms stay in the program for all the meshes the MeshManager draws with it, the meshes
+	//use the first texture units so the lists go after them
+	glUseProgram(uShader);
+	glUniform1i(glGetUniformLocation(uShader, "nClusterLights"), a_frame.m_bPerspective ? a_frame.m_uLightCount : 0);
+	glUniform3i(glGetUniformLocation(uShader, "ClusterGrid"), a_frame.m_uTileX, a_frame.m_uTileY, a_frame.m_uSliceCount);
+	glUniform4f(glGetUniformLocation(uShader, "ClusterScreen"), static_cast<float>(viewport[0]), static_cast<float>(viewport[1]),
+		static_cast<float>(viewport[2]) / a_frame.m_uTileX, static_cast<float>(viewport[3]) / a_frame.m_uTileY);
+	glUniform2f(glGetUniformLocation(uShader, "ClusterDepth"), a_frame.m_fNear, a_frame.m_fSliceScale);
+	glUniformMatrix4fv(glGetUniformLocation(uShader, "ClusterView"), 1, GL_FALSE, glm::value_ptr(a_frame.m_m4View));
+	glUniform1i(glGetUniformLocation(uShader, "LightData"), 3);
+	glUniform1i(glGetUniformLocation(uShader, "ClusterData"), 4);
+	glUniform1i(glGetUniformLocation(uShader, "ClusterIndex"), 5);
+	glActiveTexture(GL_TEXTURE3);
+	glBindTexture(GL_TEXTURE_BUFFER, m_uLightTexture);
+	glActiveTexture(GL_TEXTURE4);
+	glBindTexture(GL_TEXTURE_BUFFER, m_uClusterTexture);
+	glActiveTexture(GL_TEXTURE5);
+	glBindTexture(GL_TEXTURE_BUFFER, m_uIndexTexture);
+
+	// Restore modified GL state
+	glActiveTexture(last_active_texture);
+	glUseProgram(last_program);
+}
\ No newline at end of file
@@ -0,0 +1,269 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYLIGHTCLUSTERS_H_
+#define __MYLIGHTCLUSTERS_H_
+
+#include "MyJobSystem.h"
+#include <chrono>
+
+namespace Simplex
+{
+
+//Point light drawn by the clusters, its light reaches zero at the radius
+struct MyPointLight
+{
+	vector3 m_v3Position = ZERO_V3; //position in world space
+	float m_fRadius = 1.0f; //distance past which the light is ignored
+	vector3 m_v3Color = vector3(1.0f); //color of the light
+	float m_fIntensity = 1.0f; //power of the light, attenuated with the square of the distance
+};
+
+//Lights of one cluster, a range of the index list
+struct MyLightCluster
+{
+	uint m_uOffset = 0; //first entry of the cluster in the index list
+	uint m_uCount = 0; //lights touching the cluster
+};
+
+//Binned lights of a frame, handed from the thread that bins them to the one that draws with them
+struct MyLightFrame
+{
+	bool m_bPerspective = false; //was the projection binned a perspective one? (no lights are drawn if not)
+	matrix4 m_m4View = IDENTITY_M4; //view matrix the clusters were binned with
+	float m_fNear = 1.0f; //depth the slices start at
+	float m_fSliceScale = 1.0f; //slices per unit of log(depth / near)
+	uint m_uTileX = 16; //clusters across the screen
+	uint m_uTileY = 9; //clusters down the screen
+	uint m_uSliceCount = 24; //clusters along the depth
+	uint m_uLightCount = 0; //lights binned
+	std::vector<vector4> m_lightData; //two texels per light: position and radius, color times intensity
+	std::vector<MyLightCluster> m_clusterList; //range of the index list of each cluster
+	std::vector<uint16_t> m_indexList; //lights of all the clusters
+};
+
+//System Class, splits the view frustum in a grid of clusters (screen tiles times exponential depth
+//slices) and bins the point lights into them on the CPU; the fragment shader only loops over the lights
+//of the cluster its fragment falls in. The binning does not touch OpenGL, only Upload does
+class MyLightClusters
+{
+	uint m_uTileX = 16; //clusters across the screen
+	uint m_uTileY = 9; //clusters down the screen
+	uint m_uSliceCount = 24; //clusters along the depth
+	float m_fCutoff = 0.02f; //attenuated intensity the radius of the added lights is found with
+
+	std::vector<MyPointLight> m_lightList; //lights to bin
+
+	bool m_bPerspective = false; //was the last projection binned a perspective one?
+	matrix4 m_m4View = IDENTITY_M4; //view matrix of the last binning
+	matrix4 m_m4Projection = IDENTITY_M4; //projection matrix of the last binning
+	float m_fNear = 1.0f; //depth the slices start at, the first slice goes all the way to the camera
+	float m_fFar = 1000.0f; //depth of the far plane
+	float m_fSliceScale = 1.0f; //slices per unit of log(depth / near)
+
+	std::vector<float> m_lightX; //position of each light in view space (z is the depth, positive)
+	std::vector<float> m_lightY;
+	std::vector<float> m_lightZ;
+	std::vector<std::vector<uint>> m_sliceLightList; //lights touching each slice
+	std::vector<std::vector<uint16_t>> m_sliceIndexList; //lights of the clusters of each slice, in cluster order
+	std::vector<std::vector<float>> m_scratchList; //per thread SoA of the lights of a slice and their distances
+	std::vector<std::vector<uint>> m_blockList; //per thread groups of four lights touching a row of a slice
+	std::vector<MyLightCluster> m_clusterList; //range of the index list of each cluster
+	std::vector<uint16_t> m_indexList; //lights of all the clusters, compacted (16 bit, so up to 65536 lights are binned)
+	float m_fBinTime = 0.0f; //milliseconds of the last binning
+
+	GLuint m_uLightBuffer = 0; //texture buffer with two texels per light
+	GLuint m_uLightTexture = 0;
+	GLuint m_uClusterBuffer = 0; //texture buffer with the range of each cluster
+	GLuint m_uClusterTexture = 0;
+	GLuint m_uIndexBuffer = 0; //texture buffer with the index list
+	GLuint m_uIndexTexture = 0;
+
+	static MyLightClusters* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyLightClusters* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds a point light, its radius is where its attenuated intensity drops under the cutoff
+	ARGUMENTS:
+	-	vector3 a_v3Position -> position in world space
+	-	vector3 a_v3Color = vector3(1.0f) -> color of the light
+	-	float a_fIntensity = 1.0f -> power of the light
+	OUTPUT: index of the light
+	*/
+	uint AddLight(vector3 a_v3Position, vector3 a_v3Color = vector3(1.0f), float a_fIntensity = 1.0f);
+	/*
+	USAGE: Adds lights of the LightManager, it cannot report how many it has so the range is given
+	(0 is the ambient light and 1 is already drawn by the meshes)
+	ARGUMENTS:
+	-	uint a_uFirst -> first light of the LightManager to add
+	-	uint a_uCount -> lights to add
+	OUTPUT: ---
+	*/
+	void AddLightManagerLights(uint a_uFirst, uint a_uCount);
+	/*
+	USAGE: Gets a light to move or change it, the change is seen on the next binning
+	ARGUMENTS: uint a_uIndex -> index of the light
+	OUTPUT: light
+	*/
+	MyPointLight* GetLight(uint a_uIndex);
+	/*
+	USAGE: Gets the number of lights
+	ARGUMENTS: ---
+	OUTPUT: light count
+	*/
+	uint GetLightCount(void);
+	/*
+	USAGE: Removes all the lights
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ClearLights(void);
+	/*
+	USAGE: Sets the number of clusters along each axis of the view frustum
+	ARGUMENTS:
+	-	uint a_uTileX -> clusters across the screen
+	-	uint a_uTileY -> clusters down the screen
+	-	uint a_uSliceCount -> clusters along the depth
+	OUTPUT: ---
+	*/
+	void SetGrid(uint a_uTileX, uint a_uTileY, uint a_uSliceCount);
+	/*
+	USAGE: Sets the attenuated intensity the radius of the lights added afterwards is found with
+	ARGUMENTS: float a_fCutoff -> intensity at the radius
+	OUTPUT: ---
+	*/
+	void SetCutoff(float a_fCutoff);
+	/*
+	USAGE: Bins the lights into the clusters of a view frustum, the slices are binned in parallel (only
+	perspective projections are clustered)
+	ARGUMENTS:
+	-	matrix4 const& a_m4View -> view matrix
+	-	matrix4 const& a_m4Projection -> projection matrix
+	OUTPUT: ---
+	*/
+	void Bin(matrix4 const& a_m4View, matrix4 const& a_m4Projection);
+	/*
+	USAGE: Copies the result of the last binning to a frame drawn by another thread, the lists of the frame
+	keep their memory from frame to frame
+	ARGUMENTS: MyLightFrame& a_frame -> frame to fill
+	OUTPUT: ---
+	*/
+	void Publish(MyLightFrame& a_frame);
+	/*
+	USAGE: Uploads the lists of a frame and hands them to the Simplex shader, needs to be called from the
+	thread with the context before the MeshManager renders
+	ARGUMENTS: MyLightFrame const& a_frame -> binned lights
+	OUTPUT: ---
+	*/
+	void Upload(MyLightFrame const& a_frame);
+	/*
+	USAGE: Gets the index of the cluster a point falls in, as of the last binning
+	ARGUMENTS: vector3 a_v3Position -> point in world space
+	OUTPUT: cluster index, -1 if the point is not inside the view frustum
+	*/
+	int FindCluster(vector3 a_v3Position);
+	/*
+	USAGE: Gets the number of clusters
+	ARGUMENTS: ---
+	OUTPUT: cluster count
+	*/
+	uint GetClusterCount(void);
+	/*
+	USAGE: Gets the range of the index list of a cluster
+	ARGUMENTS: uint a_uIndex -> cluster index
+	OUTPUT: cluster
+	*/
+	MyLightCluster GetCluster(uint a_uIndex);
+	/*
+	USAGE: Gets the lights of all the clusters, each cluster has a range of it
+	ARGUMENTS: ---
+	OUTPUT: index list
+	*/
+	std::vector<uint16_t> const& GetIndexList(void);
+	/*
+	USAGE: Gets the milliseconds the last binning took
+	ARGUMENTS: ---
+	OUTPUT: bin time
+	*/
+	float GetBinTime(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyLightClusters(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyLightClusters(MyLightClusters const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyLightClusters& operator=(MyLightClusters const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyLightClusters(void);
+	/*
+	Usage: releases the lists and the buffers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Gets the depth a slice starts at
+	ARGUMENTS: uint a_uSlice -> slice index, the slice count gives the far plane
+	OUTPUT: depth
+	*/
+	float GetSliceDepth(uint a_uSlice);
+	/*
+	USAGE: Bins the lights touching a slice into its clusters
+	ARGUMENTS:
+	-	uint a_uSlice -> slice to bin
+	-	uint a_uThread -> thread running the job, owner of the scratch lists
+	-	matrix4 const& a_m4Projection -> projection matrix
+	OUTPUT: ---
+	*/
+	void BinSlice(uint a_uSlice, uint a_uThread, matrix4 const& a_m4Projection);
+	/*
+	USAGE: Creates the texture buffers the first time they are needed
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void CreateDeviceObjects(void);
+};
+
+} //namespace Simplex
+
+#endif //__MYLIGHTCLUSTERS_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
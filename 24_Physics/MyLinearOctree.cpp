@@ -0,0 +1,433 @@
+#include "MyLinearOctree.h"
+using namespace Simplex;
+//helpers (parenthesis keep the min/max macros of windows.h away)
+static vector3 MinV3(vector3 a_v3A, vector3 a_v3B) { return (glm::min)(a_v3A, a_v3B); }
+static vector3 MaxV3(vector3 a_v3A, vector3 a_v3B) { return (glm::max)(a_v3A, a_v3B); }
+static bool Overlap(vector3 a_v3MinA, vector3 a_v3MaxA, vector3 a_v3MinB, vector3 a_v3MaxB)
+{
+	if (a_v3MaxA.x < a_v3MinB.x || a_v3MinA.x > a_v3MaxB.x)
+		return false;
+	if (a_v3MaxA.y < a_v3MinB.y || a_v3MinA.y > a_v3MaxB.y)
+		return false;
+	if (a_v3MaxA.z < a_v3MinB.z || a_v3MinA.z > a_v3MaxB.z)
+		return false;
+	return true;
+}
+static uint CountBits(uint a_uValue)
+{
+	uint uCount = 0;
+	for (; a_uValue; a_uValue &= a_uValue - 1)
+		++uCount;
+	return uCount;
+}
+//  MyLinearOctree
+Simplex::MyLinearOctree::MyLinearOctree(void)
+{
+	//a complete octree has 8^level octants on each level
+	m_uLevelOffset[0] = 0;
+	for (uint i = 1; i <= m_uMortonLevels; ++i)
+		m_uLevelOffset[i] = m_uLevelOffset[i - 1] * 8 + 1;
+
+	m_threadPairList.resize(MyJobSystem::GetInstance()->GetThreadCount());
+}
+Simplex::MyLinearOctree::MyLinearOctree(MyLinearOctree const& other) { }
+Simplex::MyLinearOctree& Simplex::MyLinearOctree::operator=(MyLinearOctree const& other) { return *this; }
+Simplex::MyLinearOctree::~MyLinearOctree(void)
+{
+	m_pEntityArray = nullptr;
+	m_uEntityCount = 0;
+}
+//Accessors
+Simplex::String Simplex::MyLinearOctree::GetName(void) { return "Linear Octree"; }
+Simplex::uint Simplex::MyLinearOctree::GetOctantCount(void) { return static_cast<uint>(m_octantList.size()); }
+void Simplex::MyLinearOctree::SetMaxLevel(uint a_uMaxLevel)
+{
+	if (a_uMaxLevel > m_uMortonLevels)
+		a_uMaxLevel = m_uMortonLevels;
+	m_uMaxLevel = a_uMaxLevel;
+}
+void Simplex::MyLinearOctree::SetIdealEntityCount(uint a_uIdealEntityCount) { m_uIdealEntityCount = a_uIdealEntityCount; }
+Simplex::uint Simplex::MyLinearOctree::GetID(uint a_uLevel, uint a_uCode) { return m_uLevelOffset[a_uLevel] + a_uCode; }
+Simplex::uint Simplex::MyLinearOctree::ExpandBits(uint a_uValue)
+{
+	a_uValue = (a_uValue | (a_uValue << 16)) & 0x030000FF;
+	a_uValue = (a_uValue | (a_uValue << 8)) & 0x0300F00F;
+	a_uValue = (a_uValue | (a_uValue << 4)) & 0x030C30C3;
+	a_uValue = (a_uValue | (a_uValue << 2)) & 0x09249249;
+	return a_uValue;
+}
+//Construction
+void Simplex::MyLinearOctree::Update(PEntity* a_pEntityArray, uint a_uEntityCount)
+{
+	m_pEntityArray = a_pEntityArray;
+	m_uEntityCount = a_uEntityCount;
+	m_octantList.clear();
+	if (m_uEntityCount == 0)
+		return;
+
+	//the lists only grow, after the first frames there are no allocations
+	m_minList.resize(m_uEntityCount);
+	m_maxList.resize(m_uEntityCount);
+	m_codeList.resize(m_uEntityCount);
+	m_indexList.resize(m_uEntityCount);
+	m_codeTemp.resize(m_uEntityCount);
+	m_indexTemp.resize(m_uEntityCount);
+
+	//split the list in a few blocks per thread, small lists are a single block
+	MyJobSystem* pJobSystem = MyJobSystem::GetInstance();
+	uint uBlockCount = pJobSystem->GetThreadCount() * 4;
+	uint uMaxBlockCount = (m_uEntityCount + 2047) / 2048;
+	if (uBlockCount > uMaxBlockCount)
+		uBlockCount = uMaxBlockCount;
+	uint uBlockSize = (m_uEntityCount + uBlockCount - 1) / uBlockCount;
+	m_blockMin.resize(uBlockCount);
+	m_blockMax.resize(uBlockCount);
+	m_histogram.resize(uBlockCount * 256);
+
+	//gather the ARBBs and the bounds of each block
+	pJobSystem->ParallelFor(uBlockCount, 1, [this, uBlockSize](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint uBlock = a_uBegin; uBlock < a_uEnd; ++uBlock)
+		{
+			uint uFirst = uBlock * uBlockSize;
+			uint uLast = uFirst + uBlockSize < m_uEntityCount ? uFirst + uBlockSize : m_uEntityCount;
+			vector3 v3Min = vector3(FLT_MAX);
+			vector3 v3Max = vector3(-FLT_MAX);
+			for (uint i = uFirst; i < uLast; ++i)
+			{
+				MyRigidBody* pRigidBody = m_pEntityArray[i]->GetRigidBody();
+				m_minList[i] = pRigidBody->GetMinGlobal();
+				m_maxList[i] = pRigidBody->GetMaxGlobal();
+				v3Min = MinV3(v3Min, m_minList[i]);
+				v3Max = MaxV3(v3Max, m_maxList[i]);
+			}
+			m_blockMin[uBlock] = v3Min;
+			m_blockMax[uBlock] = v3Max;
+		}
+	});
+
+	//the root is the cube that contains every ARBB
+	vector3 v3Min = m_blockMin[0];
+	vector3 v3Max = m_blockMax[0];
+	for (uint uBlock = 1; uBlock < uBlockCount; ++uBlock)
+	{
+		v3Min = MinV3(v3Min, m_blockMin[uBlock]);
+		v3Max = MaxV3(v3Max, m_blockMax[uBlock]);
+	}
+	vector3 v3Size = v3Max - v3Min;
+	m_fSize = v3Size.x;
+	if (m_fSize < v3Size.y)
+		m_fSize = v3Size.y;
+	if (m_fSize < v3Size.z)
+		m_fSize = v3Size.z;
+	m_fSize += 0.001f;
+	m_v3Min = v3Min;
+
+	//morton code of the center of each entity
+	float fScale = 1024.0f / m_fSize;
+	pJobSystem->ParallelFor(m_uEntityCount, 1024, [this, fScale](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			vector3 v3Cell = ((m_minList[i] + m_maxList[i]) * 0.5f - m_v3Min) * fScale;
+			uint uX = v3Cell.x < 1023.0f ? static_cast<uint>(v3Cell.x) : 1023;
+			uint uY = v3Cell.y < 1023.0f ? static_cast<uint>(v3Cell.y) : 1023;
+			uint uZ = v3Cell.z < 1023.0f ? static_cast<uint>(v3Cell.z) : 1023;
+			m_codeList[i] = (ExpandBits(uX) << 2) | (ExpandBits(uY) << 1) | ExpandBits(uZ);
+			m_indexList[i] = i;
+		}
+	});
+
+	RadixSort(uBlockCount);
+	ConstructTree();
+}
+void Simplex::MyLinearOctree::RadixSort(uint a_uBlockCount)
+{
+	MyJobSystem* pJobSystem = MyJobSystem::GetInstance();
+	uint uBlockSize = (m_uEntityCount + a_uBlockCount - 1) / a_uBlockCount;
+
+	//8 bits per pass, the sort is stable so each pass keeps the order of the previous ones
+	for (uint uShift = 0; uShift < 32; uShift += 8)
+	{
+		//count the digits of each block
+		pJobSystem->ParallelFor(a_uBlockCount, 1, [this, uBlockSize, uShift](uint a_uBegin, uint a_uEnd, uint a_uThread)
+		{
+			for (uint uBlock = a_uBegin; uBlock < a_uEnd; ++uBlock)
+			{
+				uint* pCount = &m_histogram[uBlock * 256];
+				memset(pCount, 0, sizeof(uint) * 256);
+				uint uFirst = uBlock * uBlockSize;
+				uint uLast = uFirst + uBlockSize < m_uEntityCount ? uFirst + uBlockSize : m_uEntityCount;
+				for (uint i = uFirst; i < uLast; ++i)
+					++pCount[(m_codeList[i] >> uShift) & 255];
+			}
+		});
+
+		//turn the counts into where each block writes each digit
+		bool bSorted = false;
+		uint uSum = 0;
+		for (uint uDigit = 0; uDigit < 256; ++uDigit)
+		{
+			uint uDigitCount = 0;
+			for (uint uBlock = 0; uBlock < a_uBlockCount; ++uBlock)
+			{
+				uint uCount = m_histogram[uBlock * 256 + uDigit];
+				m_histogram[uBlock * 256 + uDigit] = uSum;
+				uSum += uCount;
+				uDigitCount += uCount;
+			}
+			//every code has the same digit, this pass would not move anything
+			if (uDigitCount == m_uEntityCount)
+				bSorted = true;
+		}
+		if (bSorted)
+			continue;
+
+		//scatter
+		pJobSystem->ParallelFor(a_uBlockCount, 1, [this, uBlockSize, uShift](uint a_uBegin, uint a_uEnd, uint a_uThread)
+		{
+			for (uint uBlock = a_uBegin; uBlock < a_uEnd; ++uBlock)
+			{
+				uint* pOffset = &m_histogram[uBlock * 256];
+				uint uFirst = uBlock * uBlockSize;
+				uint uLast = uFirst + uBlockSize < m_uEntityCount ? uFirst + uBlockSize : m_uEntityCount;
+				for (uint i = uFirst; i < uLast; ++i)
+				{
+					uint uTarget = pOffset[(m_codeList[i] >> uShift) & 255]++;
+					m_codeTemp[uTarget] = m_codeList[i];
+					m_indexTemp[uTarget] = m_indexList[i];
+				}
+			}
+		});
+		std::swap(m_codeList, m_codeTemp);
+		std::swap(m_indexList, m_indexTemp);
+	}
+}
+void Simplex::MyLinearOctree::ConstructTree(void)
+{
+	MyLinearOctant root;
+	root.m_uLevel = 0;
+	root.m_uCode = 0;
+	root.m_uBegin = 0;
+	root.m_uEnd = m_uEntityCount;
+	root.m_uFirstChild = 0;
+	root.m_uChildMask = 0;
+	m_octantList.push_back(root);
+
+	//breadth first, the children of an octant are the ranges of the sorted codes that share the next 3 bits
+	for (uint uOctant = 0; uOctant < m_octantList.size(); ++uOctant)
+	{
+		MyLinearOctant octant = m_octantList[uOctant];
+		if (octant.m_uEnd - octant.m_uBegin <= m_uIdealEntityCount || octant.m_uLevel >= m_uMaxLevel)
+			continue;
+
+		uint uShift = 3 * (m_uMortonLevels - octant.m_uLevel - 1);
+		uint uFirstChild = static_cast<uint>(m_octantList.size());
+		uint uChildMask = 0;
+		uint uBegin = octant.m_uBegin;
+		for (uint uChild = 0; uChild < 8 && uBegin < octant.m_uEnd; ++uChild)
+		{
+			uint uCode = (octant.m_uCode << 3) | uChild;
+			uint* pEnd = std::partition_point(&m_codeList[0] + uBegin, &m_codeList[0] + octant.m_uEnd,
+				[uShift, uCode](uint a_uCode) { return (a_uCode >> uShift) <= uCode; });
+			uint uEnd = static_cast<uint>(pEnd - &m_codeList[0]);
+			if (uEnd == uBegin)
+				continue;
+
+			MyLinearOctant child;
+			child.m_uLevel = octant.m_uLevel + 1;
+			child.m_uCode = uCode;
+			child.m_uBegin = uBegin;
+			child.m_uEnd = uEnd;
+			child.m_uFirstChild = 0;
+			child.m_uChildMask = 0;
+			m_octantList.push_back(child);
+			uChildMask |= 1 << uChild;
+			uBegin = uEnd;
+		}
+		m_octantList[uOctant].m_uFirstChild = uFirstChild;
+		m_octantList[uOctant].m_uChildMask = uChildMask;
+	}
+
+	//bounds from the bottom up, children are always after their parent
+	for (uint uOctant = static_cast<uint>(m_octantList.size()); uOctant-- > 0;)
+	{
+		MyLinearOctant& octant = m_octantList[uOctant];
+		octant.m_v3Min = vector3(FLT_MAX);
+		octant.m_v3Max = vector3(-FLT_MAX);
+		if (octant.m_uChildMask == 0)
+		{
+			for (uint i = octant.m_uBegin; i < octant.m_uEnd; ++i)
+			{
+				octant.m_v3Min = MinV3(octant.m_v3Min, m_minList[m_indexList[i]]);
+				octant.m_v3Max = MaxV3(octant.m_v3Max, m_maxList[m_indexList[i]]);
+			}
+			continue;
+		}
+		uint uChildCount = CountBits(octant.m_uChildMask);
+		for (uint uChild = 0; uChild < uChildCount; ++uChild)
+		{
+			octant.m_v3Min = MinV3(octant.m_v3Min, m_octantList[octant.m_uFirstChild + uChild].m_v3Min);
+			octant.m_v3Max = MaxV3(octant.m_v3Max, m_octantList[octant.m_uFirstChild + uChild].m_v3Max);
+		}
+	}
+}
+//Broad phase
+void Simplex::MyLinearOctree::GetPairs(std::vector<MyBroadPhasePair>& a_pairList)
+{
+	a_pairList.clear();
+	if (m_octantList.size() == 0)
+		return;
+
+	for (uint i = 0; i < m_threadPairList.size(); ++i)
+		m_threadPairList[i].clear();
+
+	MyJobSystem::GetInstance()->ParallelFor(m_uEntityCount, 64, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		std::vector<MyBroadPhasePair>& pairList = m_threadPairList[a_uThread];
+		uint uStack[8 * m_uMortonLevels + 1]; //the octree is shallow, the stack fits here
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			//sleeping entities do not look for pairs, the awake ones find them
+			if (m_pEntityArray[i]->IsAsleep())
+				continue;
+
+			vector3 v3Min = m_minList[i];
+			vector3 v3Max = m_maxList[i];
+			uint uStackSize = 0;
+			uStack[uStackSize++] = 0;
+			while (uStackSize > 0)
+			{
+				MyLinearOctant& octant = m_octantList[uStack[--uStackSize]];
+				if (!Overlap(v3Min, v3Max, octant.m_v3Min, octant.m_v3Max))
+					continue;
+
+				if (octant.m_uChildMask != 0)
+				{
+					uint uChildCount = CountBits(octant.m_uChildMask);
+					for (uint uChild = 0; uChild < uChildCount; ++uChild)
+						uStack[uStackSize++] = octant.m_uFirstChild + uChild;
+					continue;
+				}
+
+				for (uint uEntry = octant.m_uBegin; uEntry < octant.m_uEnd; ++uEntry)
+				{
+					//each pair of awake entities is reported once, by the one with the lower index
+					uint j = m_indexList[uEntry];
+					if (j == i || !Overlap(v3Min, v3Max, m_minList[j], m_maxList[j]))
+						continue;
+					if (j < i && !m_pEntityArray[j]->IsAsleep())
+						continue;
+
+					MyBroadPhasePair pair;
+					pair.m_uA = i < j ? i : j;
+					pair.m_uB = i < j ? j : i;
+					pairList.push_back(pair);
+				}
+			}
+		}
+	});
+
+	for (uint i = 0; i < m_threadPairList.size(); ++i)
+		a_pairList.insert(a_pairList.end(), m_threadPairList[i].begin(), m_threadPairList[i].end());
+}
+//Queries
+void Simplex::MyLinearOctree::QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	if (m_octantList.size() == 0)
+		return;
+
+	uint uStack[8 * m_uMortonLevels + 1];
+	uint uStackSize = 0;
+	uStack[uStackSize++] = 0;
+	while (uStackSize > 0)
+	{
+		MyLinearOctant& octant = m_octantList[uStack[--uStackSize]];
+		if (!Overlap(a_v3Min, a_v3Max, octant.m_v3Min, octant.m_v3Max))
+			continue;
+
+		if (octant.m_uChildMask != 0)
+		{
+			uint uChildCount = CountBits(octant.m_uChildMask);
+			for (uint uChild = 0; uChild < uChildCount; ++uChild)
+				uStack[uStackSize++] = octant.m_uFirstChild + uChild;
+			continue;
+		}
+
+		for (uint uEntry = octant.m_uBegin; uEntry < octant.m_uEnd; ++uEntry)
+		{
+			uint i = m_indexList[uEntry];
+			if (Overlap(a_v3Min, a_v3Max, m_minList[i], m_maxList[i]))
+				a_entityList.push_back(i);
+		}
+	}
+}
+void Simplex::MyLinearOctree::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+	std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	if (m_octantList.size() == 0)
+		return;
+
+	vector3 v3Radius = vector3(a_fRadius);
+	float fEnter, fExit;
+	uint uStack[8 * m_uMortonLevels + 1];
+	uint uStackSize = 0;
+	uStack[uStackSize++] = 0;
+	while (uStackSize > 0)
+	{
+		MyLinearOctant& octant = m_octantList[uStack[--uStackSize]];
+		if (!IntersectRayAABB(a_v3Origin, a_v3Direction, a_fMaxDistance, octant.m_v3Min - v3Radius, octant.m_v3Max + v3Radius, fEnter, fExit))
+			continue;
+
+		if (octant.m_uChildMask != 0)
+		{
+			uint uChildCount = CountBits(octant.m_uChildMask);
+			for (uint uChild = 0; uChild < uChildCount; ++uChild)
+				uStack[uStackSize++] = octant.m_uFirstChild + uChild;
+			continue;
+		}
+
+		for (uint uEntry = octant.m_uBegin; uEntry < octant.m_uEnd; ++uEntry)
+		{
+			uint i = m_indexList[uEntry];
+			if (IntersectRayAABB(a_v3Origin, a_v3Direction, a_fMaxDistance, m_minList[i] - v3Radius, m_maxList[i] + v3Radius, fEnter, fExit))
+				a_entityList.push_back(i);
+		}
+	}
+}
+//Dimensions
+void Simplex::MyLinearOctree::AssignDimensions(void)
+{
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		m_pEntityArray[i]->ClearDimensionSet();
+		if (m_octantList.size() > 0)
+			AssignIDtoEntity(i, 0, 0, 0, m_v3Min, m_fSize);
+	}
+}
+void Simplex::MyLinearOctree::AssignIDtoEntity(uint a_uEntity, int a_nOctant, uint a_uLevel, uint a_uCode, vector3 a_v3Min, float a_fSize)
+{
+	//leaves and empty octants are the dimensions
+	if (a_nOctant < 0 || m_octantList[a_nOctant].m_uChildMask == 0)
+	{
+		m_pEntityArray[a_uEntity]->AddDimension(GetID(a_uLevel, a_uCode));
+		return;
+	}
+
+	MyLinearOctant& octant = m_octantList[a_nOctant];
+	float fHalf = a_fSize * 0.5f;
+	for (uint uChild = 0; uChild < 8; ++uChild)
+	{
+		//the child bits are x, y, z from the highest to the lowest
+		vector3 v3Min = a_v3Min + fHalf * vector3((uChild >> 2) & 1, (uChild >> 1) & 1, uChild & 1);
+		if (!Overlap(m_minList[a_uEntity], m_maxList[a_uEntity], v3Min, v3Min + vector3(fHalf)))
+			continue;
+
+		int nChild = -1;
+		if (octant.m_uChildMask & (1 << uChild))
+			nChild = octant.m_uFirstChild + CountBits(octant.m_uChildMask & ((1 << uChild) - 1));
+		AssignIDtoEntity(a_uEntity, nChild, a_uLevel + 1, (a_uCode << 3) | uChild, v3Min, fHalf);
+	}
+}
\ No newline at end of file
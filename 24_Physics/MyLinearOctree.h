@@ -0,0 +1,194 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYLINEAROCTREE_H_
+#define __MYLINEAROCTREE_H_
+
+#include "MyBroadPhase.h"
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+//Node of the linear octree, its entities are a contiguous range of the sorted list
+struct MyLinearOctant
+{
+	uint m_uLevel; //depth of the octant, 0 for the root
+	uint m_uCode; //morton code prefix of the octant (3 bits per level)
+	uint m_uBegin; //first entry of the sorted list in the octant
+	uint m_uEnd; //one past the last entry of the sorted list in the octant
+	uint m_uFirstChild; //index of the first child, the children are contiguous
+	uint m_uChildMask; //bit i is set if child i has entities, 0 for leaves
+	vector3 m_v3Min; //minimum corner of the ARBBs of the octant entities
+	vector3 m_v3Max; //maximum corner of the ARBBs of the octant entities
+};
+
+//Octree built from the morton codes of the entity centers
+class MyLinearOctree : public MyBroadPhase
+{
+	static const uint m_uMortonLevels = 10; //levels the 30 bit morton codes can describe
+
+	PEntity* m_pEntityArray = nullptr; //list of entities of the last update
+	uint m_uEntityCount = 0; //number of entities of the last update
+
+	uint m_uMaxLevel = m_uMortonLevels; //maximum depth of the octree
+	uint m_uIdealEntityCount = 8; //octants with this many entities or less are not subdivided
+	uint m_uLevelOffset[m_uMortonLevels + 1]; //first implicit id of each level
+
+	vector3 m_v3Min = ZERO_V3; //minimum corner of the root octant
+	float m_fSize = 0.0f; //size of the root octant
+
+	//the lists keep their memory between updates so rebuilding does not allocate
+	std::vector<vector3> m_minList; //minimum corner of the ARBB of each entity
+	std::vector<vector3> m_maxList; //maximum corner of the ARBB of each entity
+	std::vector<uint> m_codeList; //sorted morton codes
+	std::vector<uint> m_indexList; //entity of each sorted morton code
+	std::vector<uint> m_codeTemp; //scratch list for the radix sort
+	std::vector<uint> m_indexTemp; //scratch list for the radix sort
+	std::vector<uint> m_histogram; //digit count of each block of the radix sort
+	std::vector<vector3> m_blockMin; //minimum corner of the entities of each block
+	std::vector<vector3> m_blockMax; //maximum corner of the entities of each block
+	std::vector<MyLinearOctant> m_octantList; //octants in breadth first order
+	std::vector<std::vector<MyBroadPhasePair>> m_threadPairList; //pairs found by each thread
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object instance
+	*/
+	MyLinearOctree(void);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyLinearOctree(void);
+	/*
+	USAGE: Rebuilds the octree, sorting the morton codes of the entity centers in parallel
+	ARGUMENTS:
+	-	PEntity* a_pEntityArray -> list of entities
+	-	uint a_uEntityCount -> number of entities in the list
+	OUTPUT: ---
+	*/
+	void Update(PEntity* a_pEntityArray, uint a_uEntityCount) override;
+	/*
+	USAGE: Gets the pairs of entities whose ARBBs overlap, queries only from the awake entities
+	ARGUMENTS: std::vector<MyBroadPhasePair>& a_pairList -> list to fill (will be cleared first)
+	OUTPUT: ---
+	*/
+	void GetPairs(std::vector<MyBroadPhasePair>& a_pairList) override;
+	/*
+	USAGE: Gets the name of the broad phase
+	ARGUMENTS: ---
+	OUTPUT: name
+	*/
+	String GetName(void) override;
+	/*
+	USAGE: Gets the entities whose ARBB overlaps an AABB
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList) override;
+	/*
+	USAGE: Gets the entities whose ARBB, grown by a radius, is hit by a ray
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> direction of the ray (does not need to be normalized)
+	-	float a_fMaxDistance -> length of the ray in units of the direction
+	-	float a_fRadius -> how much the boxes grow
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+		std::vector<uint>& a_entityList) override;
+	/*
+	USAGE: Replaces the dimensions of every entity with the ids of the leaves its ARBB overlaps,
+	empty octants get an id too so overlapping entities always share one
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void AssignDimensions(void);
+	/*
+	USAGE: Gets the number of octants of the last update
+	ARGUMENTS: ---
+	OUTPUT: octant count
+	*/
+	uint GetOctantCount(void);
+	/*
+	USAGE: Sets the maximum depth of the octree
+	ARGUMENTS: uint a_uMaxLevel -> maximum level (10 at most)
+	OUTPUT: ---
+	*/
+	void SetMaxLevel(uint a_uMaxLevel);
+	/*
+	USAGE: Sets the number of entities under which octants are not subdivided
+	ARGUMENTS: uint a_uIdealEntityCount -> ideal count
+	OUTPUT: ---
+	*/
+	void SetIdealEntityCount(uint a_uIdealEntityCount);
+private:
+	/*
+	USAGE: copy constructor, octrees are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyLinearOctree(MyLinearOctree const& other);
+	/*
+	USAGE: copy assignment operator, octrees are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyLinearOctree& operator=(MyLinearOctree const& other);
+	/*
+	USAGE: Sorts the morton codes (and their entities) with a parallel LSD radix sort
+	ARGUMENTS: uint a_uBlockCount -> number of blocks the list is split in
+	OUTPUT: ---
+	*/
+	void RadixSort(uint a_uBlockCount);
+	/*
+	USAGE: Derives the octants from the ranges of the sorted morton codes
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ConstructTree(void);
+	/*
+	USAGE: Adds the ids of the octants overlapped by the ARBB of an entity to its dimensions
+	ARGUMENTS:
+	-	uint a_uEntity -> index of the entity
+	-	int a_nOctant -> index of the octant, -1 for an empty octant
+	-	uint a_uLevel -> level of the octant
+	-	uint a_uCode -> morton code prefix of the octant
+	-	vector3 a_v3Min -> minimum corner of the octant
+	-	float a_fSize -> size of the octant
+	OUTPUT: ---
+	*/
+	void AssignIDtoEntity(uint a_uEntity, int a_nOctant, uint a_uLevel, uint a_uCode, vector3 a_v3Min, float a_fSize);
+	/*
+	USAGE: Gets the implicit id of an octant
+	ARGUMENTS:
+	-	uint a_uLevel -> level of the octant
+	-	uint a_uCode -> morton code prefix of the octant
+	OUTPUT: id
+	*/
+	uint GetID(uint a_uLevel, uint a_uCode);
+	/*
+	USAGE: Spreads the 10 lower bits of a number so there are two zeros between each of them
+	ARGUMENTS: uint a_uValue -> value to spread
+	OUTPUT: spread value
+	*/
+	static uint ExpandBits(uint a_uValue);
+};
+
+} //namespace Simplex
+
+#endif //__MYLINEAROCTREE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,455 @@
+#include "MyOcclusionCuller.h"
+#include "MyRenderQueue.h"
+#include <immintrin.h>
+using namespace Simplex;
+//selects a where the mask is set and b everywhere else
+static __m128 Select(__m128 a_mask, __m128 a_a, __m128 a_b) { return _mm_or_ps(_mm_and_ps(a_mask, a_a), _mm_andnot_ps(a_mask, a_b)); }
+//depth kept in the buffer, smaller is nearer and it is linear on the screen: -1/w with a perspective
+//projection (much more precise than z/w far from the camera) and z/w with an orthographic one
+static float ToDepth(vector4 const& a_v4Clip, bool a_bPerspective) { return a_bPerspective ? -1.0f / a_v4Clip.w : a_v4Clip.z / a_v4Clip.w; }
+//  MyOcclusionCuller
+MyOcclusionCuller::MyOcclusionCuller(uint a_uWidth, uint a_uHeight)
+{
+	//whole tiles only, so the rows of a tile are always four pixel aligned
+	m_uTileCountX = (a_uWidth + m_uTileSize - 1) / m_uTileSize;
+	m_uTileCountY = (a_uHeight + m_uTileSize - 1) / m_uTileSize;
+	if (m_uTileCountX < 1)
+		m_uTileCountX = 1;
+	if (m_uTileCountY < 1)
+		m_uTileCountY = 1;
+	m_uWidth = m_uTileCountX * m_uTileSize;
+	m_uHeight = m_uTileCountY * m_uTileSize;
+	m_uBlockCountX = m_uWidth / m_uBlockSize;
+	m_uBlockCountY = m_uHeight / m_uBlockSize;
+
+	m_pDepth = static_cast<float*>(_mm_malloc(sizeof(float) * m_uWidth * m_uHeight, 16));
+	m_pBlockMin = new float[m_uBlockCountX * m_uBlockCountY];
+	m_pBlockMax = new float[m_uBlockCountX * m_uBlockCountY];
+	std::fill(m_pDepth, m_pDepth + m_uWidth * m_uHeight, FLT_MAX);
+	std::fill(m_pBlockMin, m_pBlockMin + m_uBlockCountX * m_uBlockCountY, FLT_MAX);
+	std::fill(m_pBlockMax, m_pBlockMax + m_uBlockCountX * m_uBlockCountY, FLT_MAX);
+	m_tileList.resize(m_uTileCountX * m_uTileCountY);
+}
+MyOcclusionCuller::MyOcclusionCuller(MyOcclusionCuller const& other) { }
+MyOcclusionCuller& MyOcclusionCuller::operator=(MyOcclusionCuller const& other) { return *this; }
+MyOcclusionCuller::~MyOcclusionCuller(void)
+{
+	if (m_pDepth)
+	{
+		_mm_free(m_pDepth);
+		m_pDepth = nullptr;
+	}
+	if (m_pBlockMin)
+	{
+		delete[] m_pBlockMin;
+		m_pBlockMin = nullptr;
+	}
+	if (m_pBlockMax)
+	{
+		delete[] m_pBlockMax;
+		m_pBlockMax = nullptr;
+	}
+	m_meshList.clear();
+	m_tileList.clear();
+}
+//Accessors
+void MyOcclusionCuller::SetEnabled(bool a_bEnabled) { m_bEnabled = a_bEnabled; }
+bool MyOcclusionCuller::IsEnabled(void) { return m_bEnabled; }
+uint MyOcclusionCuller::GetOccludedCount(void) { return m_uOccludedCount; }
+uint MyOcclusionCuller::GetOccluderCount(void) { return static_cast<uint>(m_occluderList.size()); }
+uint MyOcclusionCuller::GetTriangleCount(void) { return m_uTriangleCount; }
+bool MyOcclusionCuller::HasMesh(uint a_uMeshIndex) { return a_uMeshIndex < m_meshList.size() && m_meshList[a_uMeshIndex].m_bKnown; }
+void MyOcclusionCuller::ForgetMesh(uint a_uMeshIndex)
+{
+	if (a_uMeshIndex >= m_meshList.size())
+		return;
+	m_meshList[a_uMeshIndex].m_bKnown = false;
+	m_meshList[a_uMeshIndex].m_triangleList.clear();
+}
+void MyOcclusionCuller::SetMesh(uint a_uMeshIndex, std::vector<vector3> const& a_vertexList, bool a_bOccluder)
+{
+	if (a_uMeshIndex >= m_meshList.size())
+		m_meshList.resize(a_uMeshIndex + 1);
+
+	MyOcclusionMesh& mesh = m_meshList[a_uMeshIndex];
+	mesh.m_bKnown = true;
+	mesh.m_triangleList.clear();
+	if (a_vertexList.size() == 0)
+	{
+		mesh.m_v3Min = mesh.m_v3Max = ZERO_V3;
+		return;
+	}
+
+	mesh.m_v3Min = mesh.m_v3Max = a_vertexList[0];
+	for (uint i = 1; i < a_vertexList.size(); ++i)
+	{
+		mesh.m_v3Min = (glm::min)(mesh.m_v3Min, a_vertexList[i]);
+		mesh.m_v3Max = (glm::max)(mesh.m_v3Max, a_vertexList[i]);
+	}
+	if (a_bOccluder && a_vertexList.size() % 3 == 0)
+		mesh.m_triangleList = a_vertexList;
+}
+//Methods
+MyScreenBounds MyOcclusionCuller::Project(vector3 a_v3Min, vector3 a_v3Max, matrix4 const& a_m4ToClip)
+{
+	MyScreenBounds bounds;
+	vector3 v3Min = vector3(FLT_MAX);
+	vector3 v3Max = vector3(-FLT_MAX);
+	float fMinDepth = FLT_MAX;
+	for (uint i = 0; i < 8; ++i)
+	{
+		vector3 v3Corner = vector3(i & 1 ? a_v3Max.x : a_v3Min.x, i & 2 ? a_v3Max.y : a_v3Min.y, i & 4 ? a_v3Max.z : a_v3Min.z);
+		vector4 v4Clip = a_m4ToClip * vector4(v3Corner, 1.0f);
+		//bounds crossing the camera plane cover the whole screen, they are always drawn
+		if (v4Clip.w <= 0.0001f)
+			return bounds;
+		vector3 v3Device = vector3(v4Clip) / v4Clip.w;
+		float fDepth = ToDepth(v4Clip, m_bPerspective);
+		fMinDepth = fDepth < fMinDepth ? fDepth : fMinDepth;
+		v3Min = (glm::min)(v3Min, v3Device);
+		v3Max = (glm::max)(v3Max, v3Device);
+	}
+	//the nearest depth is only right if all the corners are past the near plane
+	if (v3Min.z < -1.0f)
+		return bounds;
+
+	float fMinX = (v3Min.x * 0.5f + 0.5f) * m_uWidth;
+	float fMaxX = (v3Max.x * 0.5f + 0.5f) * m_uWidth;
+	float fMinY = (v3Min.y * 0.5f + 0.5f) * m_uHeight;
+	float fMaxY = (v3Max.y * 0.5f + 0.5f) * m_uHeight;
+	//off the screen, the GPU will clip it
+	if (fMaxX < 0.0f || fMaxY < 0.0f || fMinX >= m_uWidth || fMinY >= m_uHeight)
+		return bounds;
+
+	//every pixel the bounds touch
+	bounds.m_nMinX = fMinX < 0.0f ? 0 : static_cast<int>(fMinX);
+	bounds.m_nMinY = fMinY < 0.0f ? 0 : static_cast<int>(fMinY);
+	bounds.m_nMaxX = fMaxX >= m_uWidth ? m_uWidth - 1 : static_cast<int>(fMaxX);
+	bounds.m_nMaxY = fMaxY >= m_uHeight ? m_uHeight - 1 : static_cast<int>(fMaxY);
+	//pulled a little towards the camera so a surface does not hide the bounds it lies on
+	bounds.m_fMinDepth = fMinDepth - (glm::abs(fMinDepth) * 0.0001f + 0.000001f);
+	bounds.m_fArea = (bounds.m_nMaxX - bounds.m_nMinX + 1.0f) * (bounds.m_nMaxY - bounds.m_nMinY + 1.0f);
+	bounds.m_bValid = true;
+	return bounds;
+}
+void MyOcclusionCuller::SetupTriangles(uint a_uOccluder, MyRenderCommand* a_pCommand)
+{
+	MyRenderCommand& command = a_pCommand[m_occluderList[a_uOccluder]];
+	std::vector<vector3>& vertexList = m_meshList[command.m_uMeshIndex].m_triangleList;
+	matrix4 m4ToClip = m_m4ViewProjection * command.m_m4ToWorld;
+	uint uOffset = m_triangleOffset[a_uOccluder];
+	uint uTriangleCount = static_cast<uint>(vertexList.size() / 3);
+
+	for (uint t = 0; t < uTriangleCount; ++t)
+	{
+		MyOcclusionTriangle& triangle = m_triangleList[uOffset + t];
+		triangle.m_nMinX = triangle.m_nMinY = 0;
+		triangle.m_nMaxX = triangle.m_nMaxY = -1;
+
+		//screen position and depth of the vertices
+		vector3 v3Screen[3];
+		bool bVisible = true;
+		for (uint k = 0; k < 3 && bVisible; ++k)
+		{
+			vector4 v4Clip = m4ToClip * vector4(vertexList[t * 3 + k], 1.0f);
+			if (v4Clip.w <= 0.0001f || v4Clip.z < -v4Clip.w)
+			{
+				bVisible = false;
+				break;
+			}
+			v3Screen[k] = vector3((v4Clip.x / v4Clip.w * 0.5f + 0.5f) * m_uWidth,
+				(v4Clip.y / v4Clip.w * 0.5f + 0.5f) * m_uHeight,
+				ToDepth(v4Clip, m_bPerspective));
+		}
+		if (!bVisible)
+			continue;
+
+		//back faces and degenerate triangles
+		float fArea = (v3Screen[1].x - v3Screen[0].x) * (v3Screen[2].y - v3Screen[0].y) -
+			(v3Screen[2].x - v3Screen[0].x) * (v3Screen[1].y - v3Screen[0].y);
+		if (fArea <= 0.0f)
+			continue;
+
+		//pixels whose center might be inside
+		vector3 v3Min = (glm::min)(v3Screen[0], (glm::min)(v3Screen[1], v3Screen[2]));
+		vector3 v3Max = (glm::max)(v3Screen[0], (glm::max)(v3Screen[1], v3Screen[2]));
+		int nMinX = static_cast<int>(glm::ceil(v3Min.x - 0.5f));
+		int nMinY = static_cast<int>(glm::ceil(v3Min.y - 0.5f));
+		int nMaxX = static_cast<int>(glm::floor(v3Max.x - 0.5f));
+		int nMaxY = static_cast<int>(glm::floor(v3Max.y - 0.5f));
+		nMinX = nMinX < 0 ? 0 : nMinX;
+		nMinY = nMinY < 0 ? 0 : nMinY;
+		nMaxX = nMaxX >= static_cast<int>(m_uWidth) ? m_uWidth - 1 : nMaxX;
+		nMaxY = nMaxY >= static_cast<int>(m_uHeight) ? m_uHeight - 1 : nMaxY;
+		if (nMinX > nMaxX || nMinY > nMaxY)
+			continue;
+
+		//edge e goes from vertex e to the next one, positive on the inside
+		for (uint e = 0; e < 3; ++e)
+		{
+			vector3& v3A = v3Screen[e];
+			vector3& v3B = v3Screen[(e + 1) % 3];
+			triangle.m_fA[e] = v3A.y - v3B.y;
+			triangle.m_fB[e] = v3B.x - v3A.x;
+			triangle.m_fC[e] = -(triangle.m_fA[e] * v3A.x + triangle.m_fB[e] * v3A.y);
+		}
+
+		//the weight of a vertex is the edge in front of it over the area
+		float fDepth1 = (v3Screen[1].z - v3Screen[0].z) / fArea;
+		float fDepth2 = (v3Screen[2].z - v3Screen[0].z) / fArea;
+		triangle.m_fDepthX = triangle.m_fA[2] * fDepth1 + triangle.m_fA[0] * fDepth2;
+		triangle.m_fDepthY = triangle.m_fB[2] * fDepth1 + triangle.m_fB[0] * fDepth2;
+		triangle.m_fDepth = v3Screen[0].z + triangle.m_fC[2] * fDepth1 + triangle.m_fC[0] * fDepth2;
+
+		triangle.m_nMinX = nMinX;
+		triangle.m_nMinY = nMinY;
+		triangle.m_nMaxX = nMaxX;
+		triangle.m_nMaxY = nMaxY;
+	}
+}
+void MyOcclusionCuller::RasterizeTile(uint a_uTile)
+{
+	int nTileMinX = (a_uTile % m_uTileCountX) * m_uTileSize;
+	int nTileMinY = (a_uTile / m_uTileCountX) * m_uTileSize;
+	int nTileMaxX = nTileMinX + m_uTileSize - 1;
+	int nTileMaxY = nTileMinY + m_uTileSize - 1;
+
+	//clear to infinitely far
+	__m128 farDepth = _mm_set1_ps(FLT_MAX);
+	for (int y = nTileMinY; y <= nTileMaxY; ++y)
+	{
+		float* pRow = m_pDepth + y * m_uWidth;
+		for (int x = nTileMinX; x <= nTileMaxX; x += 4)
+			_mm_store_ps(pRow + x, farDepth);
+	}
+
+	__m128 zero = _mm_setzero_ps();
+	__m128 center = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	std::vector<uint>& tile = m_tileList[a_uTile];
+	for (uint i = 0; i < tile.size(); ++i)
+	{
+		MyOcclusionTriangle& triangle = m_triangleList[tile[i]];
+		//the start is aligned to four pixels, the lanes outside the triangle fail the edge test
+		int nMinX = (triangle.m_nMinX > nTileMinX ? triangle.m_nMinX : nTileMinX) & ~3;
+		int nMaxX = triangle.m_nMaxX < nTileMaxX ? triangle.m_nMaxX : nTileMaxX;
+		int nMinY = triangle.m_nMinY > nTileMinY ? triangle.m_nMinY : nTileMinY;
+		int nMaxY = triangle.m_nMaxY < nTileMaxY ? triangle.m_nMaxY : nTileMaxY;
+
+		__m128 edgeA0 = _mm_set1_ps(triangle.m_fA[0]);
+		__m128 edgeA1 = _mm_set1_ps(triangle.m_fA[1]);
+		__m128 edgeA2 = _mm_set1_ps(triangle.m_fA[2]);
+		__m128 depthX = _mm_set1_ps(triangle.m_fDepthX);
+		for (int y = nMinY; y <= nMaxY; ++y)
+		{
+			float fY = y + 0.5f;
+			__m128 row0 = _mm_set1_ps(triangle.m_fB[0] * fY + triangle.m_fC[0]);
+			__m128 row1 = _mm_set1_ps(triangle.m_fB[1] * fY + triangle.m_fC[1]);
+			__m128 row2 = _mm_set1_ps(triangle.m_fB[2] * fY + triangle.m_fC[2]);
+			__m128 rowDepth = _mm_set1_ps(triangle.m_fDepthY * fY + triangle.m_fDepth);
+			float* pRow = m_pDepth + y * m_uWidth;
+			for (int x = nMinX; x <= nMaxX; x += 4)
+			{
+				__m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), center);
+				__m128 edge0 = _mm_add_ps(_mm_mul_ps(edgeA0, pixelX), row0);
+				__m128 edge1 = _mm_add_ps(_mm_mul_ps(edgeA1, pixelX), row1);
+				__m128 edge2 = _mm_add_ps(_mm_mul_ps(edgeA2, pixelX), row2);
+				__m128 inside = _mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_and_ps(_mm_cmpge_ps(edge1, zero), _mm_cmpge_ps(edge2, zero)));
+				if (_mm_movemask_ps(inside) == 0)
+					continue;
+
+				__m128 depth = _mm_add_ps(_mm_mul_ps(depthX, pixelX), rowDepth);
+				__m128 buffer = _mm_load_ps(pRow + x);
+				_mm_store_ps(pRow + x, Select(inside, _mm_min_ps(buffer, depth), buffer));
+			}
+		}
+	}
+
+	//nearest and farthest depth of each block of the tile
+	for (int nBlockY = nTileMinY; nBlockY <= nTileMaxY; nBlockY += m_uBlockSize)
+	{
+		for (int nBlockX = nTileMinX; nBlockX <= nTileMaxX; nBlockX += m_uBlockSize)
+		{
+			__m128 blockMin = farDepth;
+			__m128 blockMax = _mm_set1_ps(-FLT_MAX);
+			for (uint y = 0; y < m_uBlockSize; ++y)
+			{
+				float* pRow = m_pDepth + (nBlockY + y) * m_uWidth + nBlockX;
+				for (uint x = 0; x < m_uBlockSize; x += 4)
+				{
+					__m128 depth = _mm_load_ps(pRow + x);
+					blockMin = _mm_min_ps(blockMin, depth);
+					blockMax = _mm_max_ps(blockMax, depth);
+				}
+			}
+			float fMin[4], fMax[4];
+			_mm_storeu_ps(fMin, blockMin);
+			_mm_storeu_ps(fMax, blockMax);
+			uint uBlock = (nBlockY / m_uBlockSize) * m_uBlockCountX + nBlockX / m_uBlockSize;
+			m_pBlockMin[uBlock] = (glm::min)((glm::min)(fMin[0], fMin[1]), (glm::min)(fMin[2], fMin[3]));
+			m_pBlockMax[uBlock] = (glm::max)((glm::max)(fMax[0], fMax[1]), (glm::max)(fMax[2], fMax[3]));
+		}
+	}
+}
+bool MyOcclusionCuller::IsOccluded(MyScreenBounds const& a_bounds)
+{
+	float fDepth = a_bounds.m_fMinDepth;
+	int nBlockMinX = a_bounds.m_nMinX / m_uBlockSize;
+	int nBlockMinY = a_bounds.m_nMinY / m_uBlockSize;
+	int nBlockMaxX = a_bounds.m_nMaxX / m_uBlockSize;
+	int nBlockMaxY = a_bounds.m_nMaxY / m_uBlockSize;
+	for (int nBlockY = nBlockMinY; nBlockY <= nBlockMaxY; ++nBlockY)
+	{
+		for (int nBlockX = nBlockMinX; nBlockX <= nBlockMaxX; ++nBlockX)
+		{
+			uint uBlock = nBlockY * m_uBlockCountX + nBlockX;
+			//the whole block is in front
+			if (fDepth > m_pBlockMax[uBlock])
+				continue;
+			//nothing in the block is in front
+			if (fDepth <= m_pBlockMin[uBlock])
+				return false;
+
+			//some pixels are, check the ones under the bounds
+			int nMinX = nBlockX * m_uBlockSize, nMaxX = nMinX + m_uBlockSize - 1;
+			int nMinY = nBlockY * m_uBlockSize, nMaxY = nMinY + m_uBlockSize - 1;
+			nMinX = nMinX > a_bounds.m_nMinX ? nMinX : a_bounds.m_nMinX;
+			nMinY = nMinY > a_bounds.m_nMinY ? nMinY : a_bounds.m_nMinY;
+			nMaxX = nMaxX < a_bounds.m_nMaxX ? nMaxX : a_bounds.m_nMaxX;
+			nMaxY = nMaxY < a_bounds.m_nMaxY ? nMaxY : a_bounds.m_nMaxY;
+			for (int y = nMinY; y <= nMaxY; ++y)
+			{
+				float* pRow = m_pDepth + y * m_uWidth;
+				for (int x = nMinX; x <= nMaxX; ++x)
+				{
+					if (pRow[x] >= fDepth)
+						return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+bool MyOcclusionCuller::IsOccluded(vector3 a_v3Min, vector3 a_v3Max, matrix4 const& a_m4ToWorld)
+{
+	MyScreenBounds bounds = Project(a_v3Min, a_v3Max, m_m4ViewProjection * a_m4ToWorld);
+	return bounds.m_bValid && IsOccluded(bounds);
+}
+uint MyOcclusionCuller::Cull(MyRenderCommand* a_pCommand, uint a_uCount, matrix4 const& a_m4ViewProjection)
+{
+	MyJobSystem* pJobSystem = MyJobSystem::GetInstance();
+	m_m4ViewProjection = a_m4ViewProjection;
+	//the w of the clip position only changes with a perspective projection
+	m_bPerspective = a_m4ViewProjection[0][3] != 0.0f || a_m4ViewProjection[1][3] != 0.0f || a_m4ViewProjection[2][3] != 0.0f;
+	m_occluderList.clear();
+	m_uOccludedCount = 0;
+	m_uTriangleCount = 0;
+	if (!m_bEnabled || a_uCount == 0)
+	{
+		//nothing hides anything
+		std::fill(m_pDepth, m_pDepth + m_uWidth * m_uHeight, FLT_MAX);
+		std::fill(m_pBlockMin, m_pBlockMin + m_uBlockCountX * m_uBlockCountY, FLT_MAX);
+		std::fill(m_pBlockMax, m_pBlockMax + m_uBlockCountX * m_uBlockCountY, FLT_MAX);
+		return a_uCount;
+	}
+	if (m_boundsList.size() < a_uCount)
+	{
+		m_boundsList.resize(a_uCount);
+		m_visibleList.resize(a_uCount);
+	}
+
+	//screen bounds of every command
+	pJobSystem->ParallelFor(a_uCount, 256, [this, a_pCommand](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			MyRenderCommand& command = a_pCommand[i];
+			if (HasMesh(command.m_uMeshIndex))
+			{
+				MyOcclusionMesh& mesh = m_meshList[command.m_uMeshIndex];
+				m_boundsList[i] = Project(mesh.m_v3Min, mesh.m_v3Max, m_m4ViewProjection * command.m_m4ToWorld);
+			}
+			else
+				m_boundsList[i] = MyScreenBounds();
+		}
+	});
+
+	//the occluders are the front-most commands big enough on screen to hide something
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		MyScreenBounds& bounds = m_boundsList[i];
+		if (bounds.m_bValid && bounds.m_fArea >= m_fMinOccluderArea && m_meshList[a_pCommand[i].m_uMeshIndex].m_triangleList.size() > 0)
+			m_occluderList.push_back(i);
+	}
+	std::sort(m_occluderList.begin(), m_occluderList.end(),
+		[this](uint a_uA, uint a_uB) { return m_boundsList[a_uA].m_fMinDepth < m_boundsList[a_uB].m_fMinDepth; });
+	//as many as the triangle budget allows
+	uint uOccluderCount = 0;
+	uint uBudget = 0;
+	while (uOccluderCount < m_occluderList.size())
+	{
+		uint uTriangles = static_cast<uint>(m_meshList[a_pCommand[m_occluderList[uOccluderCount]].m_uMeshIndex].m_triangleList.size() / 3);
+		if (uBudget + uTriangles > m_uMaxOccluderTriangles)
+			break;
+		uBudget += uTriangles;
+		++uOccluderCount;
+	}
+	m_occluderList.resize(uOccluderCount);
+
+	//each occluder sets up its triangles in its own range
+	m_triangleOffset.resize(uOccluderCount + 1);
+	m_triangleOffset[0] = 0;
+	for (uint i = 0; i < uOccluderCount; ++i)
+	{
+		uint uMesh = a_pCommand[m_occluderList[i]].m_uMeshIndex;
+		m_triangleOffset[i + 1] = m_triangleOffset[i] + static_cast<uint>(m_meshList[uMesh].m_triangleList.size() / 3);
+	}
+	m_triangleList.resize(m_triangleOffset[uOccluderCount]);
+	pJobSystem->ParallelFor(uOccluderCount, 4, [this, a_pCommand](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+			SetupTriangles(i, a_pCommand);
+	});
+
+	//bin the triangles into the tiles they touch
+	for (uint i = 0; i < m_tileList.size(); ++i)
+		m_tileList[i].clear();
+	for (uint i = 0; i < m_triangleList.size(); ++i)
+	{
+		MyOcclusionTriangle& triangle = m_triangleList[i];
+		if (triangle.m_nMaxX < triangle.m_nMinX)
+			continue;
+		++m_uTriangleCount;
+		for (uint y = triangle.m_nMinY / m_uTileSize; y <= triangle.m_nMaxY / m_uTileSize; ++y)
+		{
+			for (uint x = triangle.m_nMinX / m_uTileSize; x <= triangle.m_nMaxX / m_uTileSize; ++x)
+				m_tileList[y * m_uTileCountX + x].push_back(i);
+		}
+	}
+
+	//tiles do not share pixels, each job owns the ones it rasterizes
+	pJobSystem->ParallelFor(static_cast<uint>(m_tileList.size()), 1, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+			RasterizeTile(i);
+	});
+
+	//test every command, the ones we could not project are kept
+	pJobSystem->ParallelFor(a_uCount, 256, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+			m_visibleList[i] = !(m_boundsList[i].m_bValid && IsOccluded(m_boundsList[i]));
+	});
+
+	//compact the visible ones keeping their order
+	uint uVisible = 0;
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		if (!m_visibleList[i])
+			continue;
+		if (uVisible != i)
+			a_pCommand[uVisible] = a_pCommand[i];
+		++uVisible;
+	}
+	m_uOccludedCount = a_uCount - uVisible;
+	return uVisible;
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYOCCLUSIONCULLER_H_
+#define __MYOCCLUSIONCULLER_H_
+
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+struct MyRenderCommand;
+
+//Bounds and (for occluders) triangles of a mesh in model space
+struct MyOcclusionMesh
+{
+	bool m_bKnown = false; //was the mesh given to the culler?
+	vector3 m_v3Min = ZERO_V3; //minimum corner of the bounds
+	vector3 m_v3Max = ZERO_V3; //maximum corner of the bounds
+	std::vector<vector3> m_triangleList; //three vertices per triangle, empty if not an occluder
+};
+
+//Screen space bounds of a render command
+struct MyScreenBounds
+{
+	bool m_bValid = false; //false if the bounds cross the near plane or fall off the screen
+	int m_nMinX = 0; //first pixel covered
+	int m_nMinY = 0;
+	int m_nMaxX = -1; //last pixel covered
+	int m_nMaxY = -1;
+	float m_fMinDepth = 0.0f; //depth of the nearest corner of the bounds
+	float m_fArea = 0.0f; //pixels covered, small commands are not worth rasterizing as occluders
+};
+
+//Triangle set up for half-space rasterization, edge functions are positive inside
+struct MyOcclusionTriangle
+{
+	float m_fA[3]; //x coefficient of each edge
+	float m_fB[3]; //y coefficient of each edge
+	float m_fC[3]; //constant of each edge
+	float m_fDepthX = 0.0f; //depth plane, depth = x * m_fDepthX + y * m_fDepthY + m_fDepth
+	float m_fDepthY = 0.0f;
+	float m_fDepth = 0.0f;
+	int m_nMinX = 0; //pixels whose center might be covered
+	int m_nMinY = 0;
+	int m_nMaxX = -1; //empty bounds for triangles that were culled
+	int m_nMaxY = -1;
+};
+
+//Software occlusion culling, the biggest occluders of the frame are rasterized into a low resolution
+//depth buffer on the CPU and every command is tested against it before being sent to the MeshManager
+class MyOcclusionCuller
+{
+	uint m_uWidth = 0; //resolution of the depth buffer, multiple of the tile size
+	uint m_uHeight = 0;
+	uint m_uTileSize = 32; //pixels per side of the tiles rasterized by each job
+	uint m_uBlockSize = 8; //pixels per side of the blocks of the depth hierarchy
+	uint m_uTileCountX = 0; //tiles per row
+	uint m_uTileCountY = 0; //tiles per column
+	uint m_uBlockCountX = 0; //blocks per row
+	uint m_uBlockCountY = 0; //blocks per column
+	float* m_pDepth = nullptr; //depth of the nearest occluder of each pixel (smaller is nearer), 16 byte aligned
+	float* m_pBlockMin = nullptr; //nearest depth of each block
+	float* m_pBlockMax = nullptr; //farthest depth of each block
+
+	bool m_bEnabled = true; //are the commands being culled?
+	uint m_uMaxOccluderTriangles = 8192; //most occluder triangles rasterized each frame
+	float m_fMinOccluderArea = 64.0f; //pixels an occluder needs to cover to be rasterized
+	matrix4 m_m4ViewProjection = IDENTITY_M4; //camera used in the last cull
+	bool m_bPerspective = true; //does the camera use a perspective projection?
+
+	std::vector<MyOcclusionMesh> m_meshList; //data of each mesh by mesh index
+	std::vector<MyScreenBounds> m_boundsList; //bounds of each command of the frame
+	std::vector<uint> m_occluderList; //commands rasterized this frame
+	std::vector<uint> m_triangleOffset; //first triangle of each occluder
+	std::vector<MyOcclusionTriangle> m_triangleList; //triangles of the occluders of the frame
+	std::vector<std::vector<uint>> m_tileList; //triangles touching each tile
+	std::vector<uint> m_visibleList; //1 for the commands that survived the cull
+
+	uint m_uOccludedCount = 0; //commands culled by the last call
+	uint m_uTriangleCount = 0; //triangles rasterized by the last call
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS:
+	-	uint a_uWidth = 256 -> width of the depth buffer (rounded up to the tile size)
+	-	uint a_uHeight = 128 -> height of the depth buffer (rounded up to the tile size)
+	OUTPUT: class object instance
+	*/
+	MyOcclusionCuller(uint a_uWidth = 256, uint a_uHeight = 128);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyOcclusionCuller(void);
+	/*
+	USAGE: Gives the culler the vertices of a mesh so it knows its bounds
+	ARGUMENTS:
+	-	uint a_uMeshIndex -> index of the mesh in the MeshManager
+	-	std::vector<vector3> const& a_vertexList -> vertices of the mesh, three per triangle
+	-	bool a_bOccluder -> can the mesh hide others? (closed triangle meshes only)
+	OUTPUT: ---
+	*/
+	void SetMesh(uint a_uMeshIndex, std::vector<vector3> const& a_vertexList, bool a_bOccluder);
+	/*
+	USAGE: Asks if the culler was given the data of a mesh
+	ARGUMENTS: uint a_uMeshIndex -> index of the mesh in the MeshManager
+	OUTPUT: is it known?
+	*/
+	bool HasMesh(uint a_uMeshIndex);
+	/*
+	USAGE: Forgets the data of a mesh whose vertices changed, it is given again the next time it is drawn
+	ARGUMENTS: uint a_uMeshIndex -> index of the mesh in the MeshManager
+	OUTPUT: ---
+	*/
+	void ForgetMesh(uint a_uMeshIndex);
+	/*
+	USAGE: Rasterizes the biggest occluders of the commands and removes the commands hidden behind them,
+	commands of unknown meshes are always kept
+	ARGUMENTS:
+	-	MyRenderCommand* a_pCommand -> commands to cull, the visible ones are compacted in order
+	-	uint a_uCount -> number of commands
+	-	matrix4 const& a_m4ViewProjection -> projection times view matrix of the camera
+	OUTPUT: number of visible commands
+	*/
+	uint Cull(MyRenderCommand* a_pCommand, uint a_uCount, matrix4 const& a_m4ViewProjection);
+	/*
+	USAGE: Tests bounds against the depth buffer of the last cull
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner in model space
+	-	vector3 a_v3Max -> maximum corner in model space
+	-	matrix4 const& a_m4ToWorld -> model to world matrix
+	OUTPUT: are the bounds hidden?
+	*/
+	bool IsOccluded(vector3 a_v3Min, vector3 a_v3Max, matrix4 const& a_m4ToWorld);
+	/*
+	USAGE: Sets if the commands are culled, disabled the culler keeps all of them
+	ARGUMENTS: bool a_bEnabled -> enable?
+	OUTPUT: ---
+	*/
+	void SetEnabled(bool a_bEnabled);
+	/*
+	USAGE: Asks if the commands are culled
+	ARGUMENTS: ---
+	OUTPUT: is it enabled?
+	*/
+	bool IsEnabled(void);
+	/*
+	USAGE: Gets the number of commands culled by the last call
+	ARGUMENTS: ---
+	OUTPUT: occluded count
+	*/
+	uint GetOccludedCount(void);
+	/*
+	USAGE: Gets the number of occluders rasterized by the last call
+	ARGUMENTS: ---
+	OUTPUT: occluder count
+	*/
+	uint GetOccluderCount(void);
+	/*
+	USAGE: Gets the number of triangles rasterized by the last call
+	ARGUMENTS: ---
+	OUTPUT: triangle count
+	*/
+	uint GetTriangleCount(void);
+private:
+	/*
+	USAGE: copy constructor, culling buffers are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyOcclusionCuller(MyOcclusionCuller const& other);
+	/*
+	USAGE: copy assignment operator, culling buffers are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyOcclusionCuller& operator=(MyOcclusionCuller const& other);
+	/*
+	USAGE: Projects bounds into the depth buffer
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner in model space
+	-	vector3 a_v3Max -> maximum corner in model space
+	-	matrix4 const& a_m4ToClip -> model to clip space matrix
+	OUTPUT: screen bounds
+	*/
+	MyScreenBounds Project(vector3 a_v3Min, vector3 a_v3Max, matrix4 const& a_m4ToClip);
+	/*
+	USAGE: Sets up the triangles of an occluder for the rasterizer, back faces and triangles crossing
+	the near plane are dropped (the buffer only loses coverage so it stays conservative)
+	ARGUMENTS:
+	-	uint a_uOccluder -> index in the occluder list
+	-	MyRenderCommand* a_pCommand -> commands of the frame
+	OUTPUT: ---
+	*/
+	void SetupTriangles(uint a_uOccluder, MyRenderCommand* a_pCommand);
+	/*
+	USAGE: Rasterizes the triangles of a tile four pixels at a time and builds the depth hierarchy of its blocks
+	ARGUMENTS: uint a_uTile -> tile index
+	OUTPUT: ---
+	*/
+	void RasterizeTile(uint a_uTile);
+	/*
+	USAGE: Tests screen bounds against the depth buffer, using the hierarchy to skip whole blocks
+	ARGUMENTS: MyScreenBounds const& a_bounds -> bounds to test
+	OUTPUT: are the bounds hidden?
+	*/
+	bool IsOccluded(MyScreenBounds const& a_bounds);
+};
+
+} //namespace Simplex
+
+#endif //__MYOCCLUSIONCULLER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "MyPairCache.h"
+using namespace Simplex;
+//mixes the addresses of both entities so consecutive allocations do not land on consecutive slots
+static uint HashPair(MyEntity* a_pA, MyEntity* a_pB)
+{
+	unsigned long long uHash = static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(a_pA)) * 0x9E3779B97F4A7C15ULL;
+	uHash ^= static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(a_pB)) + (uHash << 6) + (uHash >> 2);
+	uHash ^= uHash >> 31;
+	uHash *= 0xBF58476D1CE4E5B9ULL;
+	uHash ^= uHash >> 29;
+	return static_cast<uint>(uHash);
+}
+//  MyPairCache
+Simplex::MyPairCache::MyPairCache(void) { }
+Simplex::MyPairCache::MyPairCache(MyPairCache const& other) { }
+Simplex::MyPairCache& Simplex::MyPairCache::operator=(MyPairCache const& other) { return *this; }
+Simplex::MyPairCache::~MyPairCache(void) { Clear(); }
+//Accessors
+Simplex::MyPair& Simplex::MyPairCache::GetPair(uint a_uSlot) { return m_pairTable[a_uSlot]; }
+Simplex::uint Simplex::MyPairCache::GetPairCount(void) { return m_uPairCount; }
+std::vector<Simplex::MyCollisionEvent>& Simplex::MyPairCache::GetEventList(MY_COLLISION_EVENT a_eEvent) { return m_eventList[a_eEvent]; }
+void Simplex::MyPairCache::Clear(void)
+{
+	m_pairTable.clear();
+	m_uPairCount = 0;
+	for (uint i = 0; i < COLLISION_EVENT_COUNT; ++i)
+		m_eventList[i].clear();
+}
+//Table
+Simplex::uint Simplex::MyPairCache::FindSlot(MyEntity* a_pA, MyEntity* a_pB)
+{
+	uint uMask = static_cast<uint>(m_pairTable.size()) - 1;
+	uint uSlot = HashPair(a_pA, a_pB) & uMask;
+	while (m_pairTable[uSlot].m_pA != nullptr && (m_pairTable[uSlot].m_pA != a_pA || m_pairTable[uSlot].m_pB != a_pB))
+		uSlot = (uSlot + 1) & uMask;
+	return uSlot;
+}
+Simplex::MyPair* Simplex::MyPairCache::Find(MyEntity* a_pA, MyEntity* a_pB)
+{
+	if (m_pairTable.size() == 0)
+		return nullptr;
+	if (a_pB < a_pA)
+		std::swap(a_pA, a_pB);
+	MyPair& pair = m_pairTable[FindSlot(a_pA, a_pB)];
+	return pair.m_pA != nullptr ? &pair : nullptr;
+}
+void Simplex::MyPairCache::EraseSlot(uint a_uSlot)
+{
+	uint uMask = static_cast<uint>(m_pairTable.size()) - 1;
+	uint uHole = a_uSlot;
+	uint uSlot = a_uSlot;
+	while (true)
+	{
+		uSlot = (uSlot + 1) & uMask;
+		if (m_pairTable[uSlot].m_pA == nullptr)
+			break;
+
+		//a pair can fill the hole if the hole is between its home slot and where it is now
+		uint uHome = HashPair(m_pairTable[uSlot].m_pA, m_pairTable[uSlot].m_pB) & uMask;
+		if (((uSlot - uHome) & uMask) >= ((uSlot - uHole) & uMask))
+		{
+			m_pairTable[uHole] = m_pairTable[uSlot];
+			uHole = uSlot;
+		}
+	}
+	m_pairTable[uHole] = MyPair();
+	--m_uPairCount;
+}
+void Simplex::MyPairCache::Grow(void)
+{
+	std::vector<MyPair> oldTable;
+	oldTable.swap(m_pairTable);
+	m_pairTable.resize(oldTable.size() > 0 ? oldTable.size() * 2 : 64);
+	for (uint i = 0; i < oldTable.size(); ++i)
+	{
+		if (oldTable[i].m_pA != nullptr)
+			m_pairTable[FindSlot(oldTable[i].m_pA, oldTable[i].m_pB)] = oldTable[i];
+	}
+}
+//Updates
+void Simplex::MyPairCache::Begin(uint a_uPairCount)
+{
+	++m_uFrame;
+	for (uint i = 0; i < COLLISION_EVENT_COUNT; ++i)
+		m_eventList[i].clear();
+
+	//at most half full even if all the pairs are new
+	while ((m_uPairCount + a_uPairCount) * 2 >= m_pairTable.size())
+		Grow();
+}
+Simplex::uint Simplex::MyPairCache::Report(MyEntity* a_pA, MyEntity* a_pB)
+{
+	if (a_pB < a_pA)
+		std::swap(a_pA, a_pB);
+
+	if ((m_uPairCount + 1) * 2 >= m_pairTable.size())
+		Grow();
+
+	uint uSlot = FindSlot(a_pA, a_pB);
+	MyPair& pair = m_pairTable[uSlot];
+	if (pair.m_pA == nullptr)
+	{
+		pair.m_pA = a_pA;
+		pair.m_pB = a_pB;
+		++m_uPairCount;
+	}
+	pair.m_uFrame = m_uFrame;
+	return uSlot;
+}
+void Simplex::MyPairCache::SetColliding(uint a_uSlot, bool a_bColliding)
+{
+	MyPair& pair = m_pairTable[a_uSlot];
+	MyCollisionEvent event;
+	event.m_pA = pair.m_pA;
+	event.m_pB = pair.m_pB;
+	if (a_bColliding)
+		m_eventList[pair.m_bColliding ? COLLISION_STAY : COLLISION_ENTER].push_back(event);
+	else if (pair.m_bColliding)
+		m_eventList[COLLISION_EXIT].push_back(event);
+	pair.m_bColliding = a_bColliding;
+}
+void Simplex::MyPairCache::End(void)
+{
+	//the slot is checked again after an erase, a pair further along might have moved into it
+	for (uint uSlot = 0; uSlot < m_pairTable.size();)
+	{
+		MyPair& pair = m_pairTable[uSlot];
+		if (pair.m_pA == nullptr || pair.m_uFrame == m_uFrame)
+		{
+			++uSlot;
+			continue;
+		}
+
+		//sleeping piles are not reported by the broad phase but their contacts are still there
+		if (pair.m_pA->IsAsleep() && pair.m_pB->IsAsleep())
+		{
+			++uSlot;
+			continue;
+		}
+
+		if (pair.m_bColliding)
+		{
+			MyCollisionEvent event;
+			event.m_pA = pair.m_pA;
+			event.m_pB = pair.m_pB;
+			m_eventList[COLLISION_EXIT].push_back(event);
+		}
+		EraseSlot(uSlot);
+	}
+}
+void Simplex::MyPairCache::Remove(MyEntity* a_pEntity)
+{
+	for (uint uSlot = 0; uSlot < m_pairTable.size();)
+	{
+		MyPair& pair = m_pairTable[uSlot];
+		if (pair.m_pA != a_pEntity && pair.m_pB != a_pEntity)
+		{
+			++uSlot;
+			continue;
+		}
+
+		if (pair.m_bColliding)
+		{
+			pair.m_pA->GetRigidBody()->RemoveCollisionWith(pair.m_pB->GetRigidBody());
+			pair.m_pB->GetRigidBody()->RemoveCollisionWith(pair.m_pA->GetRigidBody());
+		}
+		EraseSlot(uSlot);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYPAIRCACHE_H_
+#define __MYPAIRCACHE_H_
+
+#include "MyEntity.h"
+#include "MyGJK.h"
+
+namespace Simplex
+{
+
+//Kind of collision event
+enum MY_COLLISION_EVENT
+{
+	COLLISION_ENTER = 0, //the pair started colliding in this update
+	COLLISION_STAY, //the pair was colliding already
+	COLLISION_EXIT, //the pair stopped colliding in this update
+	COLLISION_EVENT_COUNT
+};
+
+//Collision event between two entities, only valid until the next update
+struct MyCollisionEvent
+{
+	MyEntity* m_pA = nullptr; //first entity
+	MyEntity* m_pB = nullptr; //second entity
+};
+
+//Data kept for a pair of entities while the broad phase keeps reporting it
+struct MyPair
+{
+	MyEntity* m_pA = nullptr; //entity with the lower address, nullptr for empty slots
+	MyEntity* m_pB = nullptr; //entity with the higher address
+	uint m_uFrame = 0; //update in which the pair was last reported
+	bool m_bColliding = false; //were they colliding on the last test?
+	uint m_uAxis = SAT_NONE; //eSATResults of the last test, SAT_NONE if they were colliding
+	MySimplexCache m_simplex; //last GJK simplex, for pairs with a convex hull
+	MyContact m_contact; //contact of the last test, from the first entity to the second one
+};
+
+//Persistent pairs of entities in an open addressing hash table, turns the colliding state of each
+//update into enter/stay/exit events
+class MyPairCache
+{
+	std::vector<MyPair> m_pairTable; //slots of the table, linear probing, size is a power of two
+	uint m_uPairCount = 0; //slots in use
+	uint m_uFrame = 0; //number of updates
+	std::vector<MyCollisionEvent> m_eventList[COLLISION_EVENT_COUNT]; //events of the last update
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object instance
+	*/
+	MyPairCache(void);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyPairCache(void);
+	/*
+	USAGE: Starts an update, the events of the last one are cleared and the table makes room so the
+	slots do not move while the pairs are reported
+	ARGUMENTS: uint a_uPairCount -> number of pairs that will be reported
+	OUTPUT: ---
+	*/
+	void Begin(uint a_uPairCount);
+	/*
+	USAGE: Reports a pair found by the broad phase in this update, adding it if it is new; the order of
+	the entities does not matter
+	ARGUMENTS:
+	-	MyEntity* a_pA -> first entity
+	-	MyEntity* a_pB -> second entity
+	OUTPUT: slot of the pair, valid until the update ends
+	*/
+	uint Report(MyEntity* a_pA, MyEntity* a_pB);
+	/*
+	USAGE: Gets the data of a pair
+	ARGUMENTS: uint a_uSlot -> slot returned by Report
+	OUTPUT: pair
+	*/
+	MyPair& GetPair(uint a_uSlot);
+	/*
+	USAGE: Looks for a pair, the order of the entities does not matter
+	ARGUMENTS:
+	-	MyEntity* a_pA -> first entity
+	-	MyEntity* a_pB -> second entity
+	OUTPUT: pair, nullptr if it is not in the cache
+	*/
+	MyPair* Find(MyEntity* a_pA, MyEntity* a_pB);
+	/*
+	USAGE: Sets the colliding state of a reported pair, generating its enter or stay event
+	ARGUMENTS:
+	-	uint a_uSlot -> slot returned by Report
+	-	bool a_bColliding -> are they colliding?
+	OUTPUT: ---
+	*/
+	void SetColliding(uint a_uSlot, bool a_bColliding);
+	/*
+	USAGE: Ends an update, the pairs that were not reported are removed (exit events for the colliding
+	ones) unless both entities are asleep
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void End(void);
+	/*
+	USAGE: Removes all the pairs of an entity without events, the other entities stop colliding with it
+	ARGUMENTS: MyEntity* a_pEntity -> entity leaving the simulation
+	OUTPUT: ---
+	*/
+	void Remove(MyEntity* a_pEntity);
+	/*
+	USAGE: Removes all the pairs
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the events of a kind generated by the last update
+	ARGUMENTS: MY_COLLISION_EVENT a_eEvent -> kind of event
+	OUTPUT: list of events
+	*/
+	std::vector<MyCollisionEvent>& GetEventList(MY_COLLISION_EVENT a_eEvent);
+	/*
+	USAGE: Gets the number of pairs in the cache
+	ARGUMENTS: ---
+	OUTPUT: pair count
+	*/
+	uint GetPairCount(void);
+private:
+	/*
+	USAGE: copy constructor, caches are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyPairCache(MyPairCache const& other);
+	/*
+	USAGE: copy assignment operator, caches are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyPairCache& operator=(MyPairCache const& other);
+	/*
+	USAGE: Finds the slot of a pair, or the empty slot where it would go
+	ARGUMENTS:
+	-	MyEntity* a_pA -> entity with the lower address
+	-	MyEntity* a_pB -> entity with the higher address
+	OUTPUT: slot
+	*/
+	uint FindSlot(MyEntity* a_pA, MyEntity* a_pB);
+	/*
+	USAGE: Empties a slot moving back the pairs that probed past it, so lookups never need tombstones
+	ARGUMENTS: uint a_uSlot -> slot to empty
+	OUTPUT: ---
+	*/
+	void EraseSlot(uint a_uSlot);
+	/*
+	USAGE: Doubles the size of the table and adds the pairs again
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Grow(void);
+};
+
+} //namespace Simplex
+
+#endif //__MYPAIRCACHE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,621 @@
+#include "MyParticleSystem.h"
+#include "MySolverPool.h"
+#include "MyEntityManager.h"
+#include <immintrin.h>
+using namespace Simplex;
+//visual studio compiles the AVX2 intrinsics on any target, other compilers need -mavx2
+#if defined(_MSC_VER) || defined(__AVX2__)
+#define MYPARTICLESYSTEM_AVX2
+#endif
+//helpers
+//reallocates an aligned array keeping its first values and zeroing the rest
+template <class T> static void Reallocate(T*& a_pArray, uint a_uCount, uint a_uCapacity)
+{
+	T* pTemp = static_cast<T*>(_mm_malloc(sizeof(T) * a_uCapacity, 32));
+	if (a_pArray)
+		memcpy(pTemp, a_pArray, sizeof(T) * a_uCount);
+	memset(pTemp + a_uCount, 0, sizeof(T) * (a_uCapacity - a_uCount));
+	_mm_free(a_pArray);
+	a_pArray = pTemp;
+}
+//packs four colors from 0 to 255 into RGBA bytes
+static __m128i PackColor(__m128 a_r, __m128 a_g, __m128 a_b, __m128 a_a)
+{
+	__m128i color = _mm_cvtps_epi32(a_r);
+	color = _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(a_g), 8));
+	color = _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(a_b), 16));
+	return _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(a_a), 24));
+}
+//  MyParticleSystem
+Simplex::MyParticleSystem* Simplex::MyParticleSystem::m_pInstance = nullptr;
+void Simplex::MyParticleSystem::Init(void)
+{
+	//the solver pool already asked the processor what it can run
+	m_bAVX2 = MySolverPool::GetInstance()->IsUsingAVX2();
+	m_uRandom = 2463534242u;
+	m_uParticleCount = 0;
+	m_fUpdateTime = 0.0f;
+
+	//OpenGL objects are created on the first render
+	m_uShader = 0;
+	m_uVAO = 0;
+	m_uVBO = 0;
+	m_uVBOCapacity = 0;
+	m_nVP = -1;
+	m_nRight = -1;
+	m_nUp = -1;
+}
+void Simplex::MyParticleSystem::Release(void)
+{
+	for (uint i = 0; i < m_poolList.size(); ++i)
+	{
+		MyParticlePool& pool = m_poolList[i];
+		_mm_free(pool.m_pPositionX);
+		_mm_free(pool.m_pPositionY);
+		_mm_free(pool.m_pPositionZ);
+		_mm_free(pool.m_pVelocityX);
+		_mm_free(pool.m_pVelocityY);
+		_mm_free(pool.m_pVelocityZ);
+		_mm_free(pool.m_pAge);
+		_mm_free(pool.m_pInverseLife);
+		_mm_free(pool.m_pSize);
+		_mm_free(pool.m_pColor);
+	}
+	m_poolList.clear();
+	m_emitterList.clear();
+	m_entityList.clear();
+	m_boxList.clear();
+	m_uParticleCount = 0;
+
+	if (m_uVBO)
+		glDeleteBuffers(1, &m_uVBO);
+	if (m_uVAO)
+		glDeleteVertexArrays(1, &m_uVAO);
+	if (m_uShader)
+		glDeleteProgram(m_uShader);
+	m_uVBO = 0;
+	m_uVAO = 0;
+	m_uShader = 0;
+	m_uVBOCapacity = 0;
+}
+Simplex::MyParticleSystem* Simplex::MyParticleSystem::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyParticleSystem();
+	}
+	return m_pInstance;
+}
+void Simplex::MyParticleSystem::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyParticleSystem::MyParticleSystem() { Init(); }
+Simplex::MyParticleSystem::MyParticleSystem(MyParticleSystem const& other) { }
+Simplex::MyParticleSystem& Simplex::MyParticleSystem::operator=(MyParticleSystem const& other) { return *this; }
+Simplex::MyParticleSystem::~MyParticleSystem() { Release(); }
+//Accessors
+Simplex::MyParticleEmitter* Simplex::MyParticleSystem::GetEmitter(uint a_uEmitter)
+{
+	if (a_uEmitter >= m_emitterList.size())
+		return nullptr;
+	return &m_emitterList[a_uEmitter];
+}
+Simplex::uint Simplex::MyParticleSystem::GetEmitterCount(void) { return m_emitterList.size(); }
+Simplex::uint Simplex::MyParticleSystem::GetParticleCount(void) { return m_uParticleCount; }
+float Simplex::MyParticleSystem::GetUpdateTime(void) { return m_fUpdateTime; }
+bool Simplex::MyParticleSystem::IsUsingAVX2(void) { return m_bAVX2; }
+//Emitters
+Simplex::uint Simplex::MyParticleSystem::AddEmitter(MyParticleEmitter const& a_emitter)
+{
+	m_emitterList.push_back(a_emitter);
+	m_poolList.push_back(MyParticlePool());
+	Grow(m_poolList.back(), 1024);
+	return m_emitterList.size() - 1;
+}
+void Simplex::MyParticleSystem::Burst(uint a_uEmitter, uint a_uCount)
+{
+	if (a_uEmitter >= m_emitterList.size())
+		return;
+	Spawn(a_uEmitter, a_uCount);
+}
+void Simplex::MyParticleSystem::Clear(uint a_uEmitter)
+{
+	if (a_uEmitter >= m_poolList.size())
+		return;
+	m_poolList[a_uEmitter].m_uCount = 0;
+	m_poolList[a_uEmitter].m_fSpawn = 0.0f;
+}
+float Simplex::MyParticleSystem::Random(void)
+{
+	//xorshift, the top 24 bits fit a float exactly
+	m_uRandom ^= m_uRandom << 13;
+	m_uRandom ^= m_uRandom >> 17;
+	m_uRandom ^= m_uRandom << 5;
+	return static_cast<float>(m_uRandom >> 8) / 16777216.0f;
+}
+Simplex::vector3 Simplex::MyParticleSystem::RandomInSphere(float a_fRadius)
+{
+	if (a_fRadius <= 0.0f)
+		return ZERO_V3;
+	vector3 v3Point;
+	do
+	{
+		v3Point = vector3(Random(), Random(), Random()) * 2.0f - vector3(1.0f);
+	} while (glm::dot(v3Point, v3Point) > 1.0f);
+	return v3Point * a_fRadius;
+}
+//Pools
+void Simplex::MyParticleSystem::Grow(MyParticlePool& a_pool, uint a_uCapacity)
+{
+	//the particles past the count are updated with the rest so they need to be valid numbers
+	uint uCount = a_pool.m_uCapacity;
+	Reallocate(a_pool.m_pPositionX, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pPositionY, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pPositionZ, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pVelocityX, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pVelocityY, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pVelocityZ, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pAge, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pInverseLife, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pSize, uCount, a_uCapacity);
+	Reallocate(a_pool.m_pColor, uCount, a_uCapacity);
+	a_pool.m_uCapacity = a_uCapacity;
+}
+void Simplex::MyParticleSystem::Spawn(uint a_uEmitter, uint a_uCount)
+{
+	MyParticleEmitter const& emitter = m_emitterList[a_uEmitter];
+	MyParticlePool& pool = m_poolList[a_uEmitter];
+	if (pool.m_uCount >= emitter.m_uMaxCount)
+		return;
+	a_uCount = (std::min)(a_uCount, emitter.m_uMaxCount - pool.m_uCount);
+	if (a_uCount == 0)
+		return;
+
+	uint uNeeded = pool.m_uCount + a_uCount;
+	if (uNeeded > pool.m_uCapacity)
+	{
+		uint uCapacity = pool.m_uCapacity;
+		while (uCapacity < uNeeded)
+			uCapacity *= 2;
+		Grow(pool, uCapacity);
+	}
+
+	for (uint i = pool.m_uCount; i < uNeeded; ++i)
+	{
+		vector3 v3Position = emitter.m_v3Position + RandomInSphere(emitter.m_fRadius);
+		vector3 v3Velocity = emitter.m_v3Velocity + RandomInSphere(emitter.m_fSpread);
+		pool.m_pPositionX[i] = v3Position.x;
+		pool.m_pPositionY[i] = v3Position.y;
+		pool.m_pPositionZ[i] = v3Position.z;
+		pool.m_pVelocityX[i] = v3Velocity.x;
+		pool.m_pVelocityY[i] = v3Velocity.y;
+		pool.m_pVelocityZ[i] = v3Velocity.z;
+		pool.m_pAge[i] = 0.0f;
+		float fLife = emitter.m_fLife * (1.0f + emitter.m_fLifeVariance * (Random() * 2.0f - 1.0f));
+		pool.m_pInverseLife[i] = 1.0f / (std::max)(fLife, 0.001f);
+	}
+	pool.m_uCount = uNeeded;
+}
+void Simplex::MyParticleSystem::Compact(MyParticlePool& a_pool)
+{
+	uint i = 0;
+	while (i < a_pool.m_uCount)
+	{
+		if (a_pool.m_pAge[i] * a_pool.m_pInverseLife[i] < 1.0f)
+		{
+			++i;
+			continue;
+		}
+
+		//the last one takes the place of the dead one and is checked next
+		uint uLast = --a_pool.m_uCount;
+		a_pool.m_pPositionX[i] = a_pool.m_pPositionX[uLast];
+		a_pool.m_pPositionY[i] = a_pool.m_pPositionY[uLast];
+		a_pool.m_pPositionZ[i] = a_pool.m_pPositionZ[uLast];
+		a_pool.m_pVelocityX[i] = a_pool.m_pVelocityX[uLast];
+		a_pool.m_pVelocityY[i] = a_pool.m_pVelocityY[uLast];
+		a_pool.m_pVelocityZ[i] = a_pool.m_pVelocityZ[uLast];
+		a_pool.m_pAge[i] = a_pool.m_pAge[uLast];
+		a_pool.m_pInverseLife[i] = a_pool.m_pInverseLife[uLast];
+		a_pool.m_pSize[i] = a_pool.m_pSize[uLast];
+		a_pool.m_pColor[i] = a_pool.m_pColor[uLast];
+	}
+}
+void Simplex::MyParticleSystem::CollideEntities(uint a_uEmitter)
+{
+	MyParticleEmitter const& emitter = m_emitterList[a_uEmitter];
+	MyParticlePool& pool = m_poolList[a_uEmitter];
+	if (pool.m_uCount == 0)
+		return;
+
+	//the broad phase gives the entities inside the bounds of the whole pool
+	vector3 v3Min = vector3(pool.m_pPositionX[0], pool.m_pPositionY[0], pool.m_pPositionZ[0]);
+	vector3 v3Max = v3Min;
+	for (uint i = 1; i < pool.m_uCount; ++i)
+	{
+		vector3 v3Position(pool.m_pPositionX[i], pool.m_pPositionY[i], pool.m_pPositionZ[i]);
+		v3Min = (glm::min)(v3Min, v3Position);
+		v3Max = (glm::max)(v3Max, v3Position);
+	}
+	MyEntityManager* pEntityMngr = MyEntityManager::GetInstance();
+	pEntityMngr->OverlapBox(v3Min, v3Max, m_entityList);
+	if (m_entityList.size() == 0)
+		return;
+
+	//their boxes are copied so the jobs do not touch the entities
+	m_boxList.resize(m_entityList.size() * 2);
+	for (uint i = 0; i < m_entityList.size(); ++i)
+	{
+		MyRigidBody* pRigidBody = pEntityMngr->GetEntity(m_entityList[i])->GetRigidBody();
+		m_boxList[i * 2] = pRigidBody->GetMinGlobal();
+		m_boxList[i * 2 + 1] = pRigidBody->GetMaxGlobal();
+	}
+
+	uint uBoxCount = m_entityList.size();
+	MyJobSystem::GetInstance()->ParallelFor(pool.m_uCount, 4096, [this, &pool, &emitter, uBoxCount](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		float* pPosition[3] = { pool.m_pPositionX, pool.m_pPositionY, pool.m_pPositionZ };
+		float* pVelocity[3] = { pool.m_pVelocityX, pool.m_pVelocityY, pool.m_pVelocityZ };
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			vector3 v3Position(pool.m_pPositionX[i], pool.m_pPositionY[i], pool.m_pPositionZ[i]);
+			for (uint uBox = 0; uBox < uBoxCount; ++uBox)
+			{
+				vector3 v3BoxMin = m_boxList[uBox * 2];
+				vector3 v3BoxMax = m_boxList[uBox * 2 + 1];
+				if (glm::any(glm::lessThan(v3Position, v3BoxMin)) || glm::any(glm::greaterThan(v3Position, v3BoxMax)))
+					continue;
+
+				//out through the closest face, bouncing along its normal
+				uint uAxis = 0;
+				float fDepth = FLT_MAX;
+				float fFace = 0.0f;
+				for (uint uDim = 0; uDim < 3; ++uDim)
+				{
+					float fLow = v3Position[uDim] - v3BoxMin[uDim];
+					float fHigh = v3BoxMax[uDim] - v3Position[uDim];
+					if (fLow < fDepth)
+					{
+						fDepth = fLow;
+						uAxis = uDim;
+						fFace = v3BoxMin[uDim];
+					}
+					if (fHigh < fDepth)
+					{
+						fDepth = fHigh;
+						uAxis = uDim;
+						fFace = v3BoxMax[uDim];
+					}
+				}
+				v3Position[uAxis] = fFace;
+				pPosition[uAxis][i] = fFace;
+				for (uint uDim = 0; uDim < 3; ++uDim)
+				{
+					if (uDim == uAxis)
+						pVelocity[uDim][i] *= -emitter.m_fBounce;
+					else
+						pVelocity[uDim][i] *= emitter.m_fFriction;
+				}
+			}
+		}
+	});
+}
+//Update
+void Simplex::MyParticleSystem::Update(float a_fDeltaTime)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	//a long frame (a hitch or a breakpoint) does not throw the particles around
+	a_fDeltaTime = glm::clamp(a_fDeltaTime, 0.0f, 0.1f);
+
+	m_uParticleCount = 0;
+	for (uint uEmitter = 0; uEmitter < m_emitterList.size(); ++uEmitter)
+	{
+		MyParticleEmitter const& emitter = m_emitterList[uEmitter];
+		MyParticlePool& pool = m_poolList[uEmitter];
+
+		pool.m_fSpawn += (std::max)(emitter.m_fRate, 0.0f) * a_fDeltaTime;
+		uint uSpawn = static_cast<uint>(pool.m_fSpawn);
+		pool.m_fSpawn -= uSpawn;
+		Spawn(uEmitter, uSpawn);
+
+		//the capacity is a multiple of eight, the particles past the count are updated but never read
+		uint uBlockCount = (pool.m_uCount + 7) / 8;
+		MyJobSystem::GetInstance()->ParallelFor(uBlockCount, 512, [this, &pool, &emitter, a_fDeltaTime](uint a_uBegin, uint a_uEnd, uint a_uThread)
+		{
+			if (m_bAVX2)
+				UpdateAVX2(pool, emitter, a_fDeltaTime, a_uBegin * 8, a_uEnd * 8);
+			else
+				UpdateSSE(pool, emitter, a_fDeltaTime, a_uBegin * 8, a_uEnd * 8);
+		});
+
+		Compact(pool);
+		if (emitter.m_bEntities)
+			CollideEntities(uEmitter);
+		m_uParticleCount += pool.m_uCount;
+	}
+
+	m_fUpdateTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+void Simplex::MyParticleSystem::UpdateSSE(MyParticlePool& a_pool, MyParticleEmitter const& a_emitter, float a_fDeltaTime, uint a_uBegin, uint a_uEnd)
+{
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 deltaTime = _mm_set1_ps(a_fDeltaTime);
+	__m128 accelerationX = _mm_set1_ps(a_emitter.m_v3Acceleration.x * a_fDeltaTime);
+	__m128 accelerationY = _mm_set1_ps(a_emitter.m_v3Acceleration.y * a_fDeltaTime);
+	__m128 accelerationZ = _mm_set1_ps(a_emitter.m_v3Acceleration.z * a_fDeltaTime);
+	__m128 drag = _mm_set1_ps((std::max)(1.0f - a_emitter.m_fDrag * a_fDeltaTime, 0.0f));
+	__m128 groundMask = a_emitter.m_bGround ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+	__m128 bounce = _mm_set1_ps(-a_emitter.m_fBounce);
+	__m128 friction = _mm_set1_ps(a_emitter.m_fFriction);
+	__m128 sizeStart = _mm_set1_ps(a_emitter.m_fSizeStart);
+	__m128 sizeChange = _mm_set1_ps(a_emitter.m_fSizeEnd - a_emitter.m_fSizeStart);
+
+	//colors go from 0 to 255 so they convert straight to bytes
+	vector4 v4Start = glm::clamp(a_emitter.m_v4ColorStart, 0.0f, 1.0f) * 255.0f;
+	vector4 v4Change = glm::clamp(a_emitter.m_v4ColorEnd, 0.0f, 1.0f) * 255.0f - v4Start;
+	__m128 colorStart[4] = { _mm_set1_ps(v4Start.r), _mm_set1_ps(v4Start.g), _mm_set1_ps(v4Start.b), _mm_set1_ps(v4Start.a) };
+	__m128 colorChange[4] = { _mm_set1_ps(v4Change.r), _mm_set1_ps(v4Change.g), _mm_set1_ps(v4Change.b), _mm_set1_ps(v4Change.a) };
+
+	for (uint i = a_uBegin; i < a_uEnd; i += 4)
+	{
+		//gravity first, then the drag
+		__m128 velocityX = _mm_mul_ps(_mm_add_ps(_mm_load_ps(a_pool.m_pVelocityX + i), accelerationX), drag);
+		__m128 velocityY = _mm_mul_ps(_mm_add_ps(_mm_load_ps(a_pool.m_pVelocityY + i), accelerationY), drag);
+		__m128 velocityZ = _mm_mul_ps(_mm_add_ps(_mm_load_ps(a_pool.m_pVelocityZ + i), accelerationZ), drag);
+		__m128 positionX = _mm_add_ps(_mm_load_ps(a_pool.m_pPositionX + i), _mm_mul_ps(velocityX, deltaTime));
+		__m128 positionY = _mm_add_ps(_mm_load_ps(a_pool.m_pPositionY + i), _mm_mul_ps(velocityY, deltaTime));
+		__m128 positionZ = _mm_add_ps(_mm_load_ps(a_pool.m_pPositionZ + i), _mm_mul_ps(velocityZ, deltaTime));
+
+		//the ones under the ground go back to it bouncing
+		__m128 ground = _mm_and_ps(groundMask, _mm_cmplt_ps(positionY, zero));
+		__m128 slide = _mm_or_ps(_mm_and_ps(ground, friction), _mm_andnot_ps(ground, one));
+		positionY = _mm_andnot_ps(ground, positionY);
+		velocityY = _mm_mul_ps(velocityY, _mm_or_ps(_mm_and_ps(ground, bounce), _mm_andnot_ps(ground, one)));
+		velocityX = _mm_mul_ps(velocityX, slide);
+		velocityZ = _mm_mul_ps(velocityZ, slide);
+
+		_mm_store_ps(a_pool.m_pPositionX + i, positionX);
+		_mm_store_ps(a_pool.m_pPositionY + i, positionY);
+		_mm_store_ps(a_pool.m_pPositionZ + i, positionZ);
+		_mm_store_ps(a_pool.m_pVelocityX + i, velocityX);
+		_mm_store_ps(a_pool.m_pVelocityY + i, velocityY);
+		_mm_store_ps(a_pool.m_pVelocityZ + i, velocityZ);
+
+		//size and color follow the fraction of the life lived
+		__m128 age = _mm_add_ps(_mm_load_ps(a_pool.m_pAge + i), deltaTime);
+		_mm_store_ps(a_pool.m_pAge + i, age);
+		__m128 lived = _mm_min_ps(_mm_mul_ps(age, _mm_load_ps(a_pool.m_pInverseLife + i)), one);
+		_mm_store_ps(a_pool.m_pSize + i, _mm_add_ps(sizeStart, _mm_mul_ps(sizeChange, lived)));
+		__m128i color = PackColor(
+			_mm_add_ps(colorStart[0], _mm_mul_ps(colorChange[0], lived)),
+			_mm_add_ps(colorStart[1], _mm_mul_ps(colorChange[1], lived)),
+			_mm_add_ps(colorStart[2], _mm_mul_ps(colorChange[2], lived)),
+			_mm_add_ps(colorStart[3], _mm_mul_ps(colorChange[3], lived)));
+		_mm_store_si128(reinterpret_cast<__m128i*>(a_pool.m_pColor + i), color);
+	}
+}
+#ifdef MYPARTICLESYSTEM_AVX2
+void Simplex::MyParticleSystem::UpdateAVX2(MyParticlePool& a_pool, MyParticleEmitter const& a_emitter, float a_fDeltaTime, uint a_uBegin, uint a_uEnd)
+{
+	__m256 zero = _mm256_setzero_ps();
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 deltaTime = _mm256_set1_ps(a_fDeltaTime);
+	__m256 accelerationX = _mm256_set1_ps(a_emitter.m_v3Acceleration.x * a_fDeltaTime);
+	__m256 accelerationY = _mm256_set1_ps(a_emitter.m_v3Acceleration.y * a_fDeltaTime);
+	__m256 accelerationZ = _mm256_set1_ps(a_emitter.m_v3Acceleration.z * a_fDeltaTime);
+	__m256 drag = _mm256_set1_ps((std::max)(1.0f - a_emitter.m_fDrag * a_fDeltaTime, 0.0f));
+	__m256 groundMask = a_emitter.m_bGround ? _mm256_castsi256_ps(_mm256_set1_epi32(-1)) : zero;
+	__m256 bounce = _mm256_set1_ps(-a_emitter.m_fBounce);
+	__m256 friction = _mm256_set1_ps(a_emitter.m_fFriction);
+	__m256 sizeStart = _mm256_set1_ps(a_emitter.m_fSizeStart);
+	__m256 sizeChange = _mm256_set1_ps(a_emitter.m_fSizeEnd - a_emitter.m_fSizeStart);
+
+	vector4 v4Start = glm::clamp(a_emitter.m_v4ColorStart, 0.0f, 1.0f) * 255.0f;
+	vector4 v4Change = glm::clamp(a_emitter.m_v4ColorEnd, 0.0f, 1.0f) * 255.0f - v4Start;
+	__m256 colorStart[4] = { _mm256_set1_ps(v4Start.r), _mm256_set1_ps(v4Start.g), _mm256_set1_ps(v4Start.b), _mm256_set1_ps(v4Start.a) };
+	__m256 colorChange[4] = { _mm256_set1_ps(v4Change.r), _mm256_set1_ps(v4Change.g), _mm256_set1_ps(v4Change.b), _mm256_set1_ps(v4Change.a) };
+
+	for (uint i = a_uBegin; i < a_uEnd; i += 8)
+	{
+		__m256 velocityX = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(a_pool.m_pVelocityX + i), accelerationX), drag);
+		__m256 velocityY = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(a_pool.m_pVelocityY + i), accelerationY), drag);
+		__m256 velocityZ = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(a_pool.m_pVelocityZ + i), accelerationZ), drag);
+		__m256 positionX = _mm256_add_ps(_mm256_load_ps(a_pool.m_pPositionX + i), _mm256_mul_ps(velocityX, deltaTime));
+		__m256 positionY = _mm256_add_ps(_mm256_load_ps(a_pool.m_pPositionY + i), _mm256_mul_ps(velocityY, deltaTime));
+		__m256 positionZ = _mm256_add_ps(_mm256_load_ps(a_pool.m_pPositionZ + i), _mm256_mul_ps(velocityZ, deltaTime));
+
+		__m256 ground = _mm256_and_ps(groundMask, _mm256_cmp_ps(positionY, zero, _CMP_LT_OQ));
+		__m256 slide = _mm256_blendv_ps(one, friction, ground);
+		positionY = _mm256_andnot_ps(ground, positionY);
+		velocityY = _mm256_mul_ps(velocityY, _mm256_blendv_ps(one, bounce, ground));
+		velocityX = _mm256_mul_ps(velocityX, slide);
+		velocityZ = _mm256_mul_ps(velocityZ, slide);
+
+		_mm256_store_ps(a_pool.m_pPositionX + i, positionX);
+		_mm256_store_ps(a_pool.m_pPositionY + i, positionY);
+		_mm256_store_ps(a_pool.m_pPositionZ + i, positionZ);
+		_mm256_store_ps(a_pool.m_pVelocityX + i, velocityX);
+		_mm256_store_ps(a_pool.m_pVelocityY + i, velocityY);
+		_mm256_store_ps(a_pool.m_pVelocityZ + i, velocityZ);
+
+		__m256 age = _mm256_add_ps(_mm256_load_ps(a_pool.m_pAge + i), deltaTime);
+		_mm256_store_ps(a_pool.m_pAge + i, age);
+		__m256 lived = _mm256_min_ps(_mm256_mul_ps(age, _mm256_load_ps(a_pool.m_pInverseLife + i)), one);
+		_mm256_store_ps(a_pool.m_pSize + i, _mm256_add_ps(sizeStart, _mm256_mul_ps(sizeChange, lived)));
+		__m256i color = _mm256_cvtps_epi32(_mm256_add_ps(colorStart[0], _mm256_mul_ps(colorChange[0], lived)));
+		color = _mm256_or_si256(color, _mm256_slli_epi32(_mm256_cvtps_epi32(_mm256_add_ps(colorStart[1], _mm256_mul_ps(colorChange[1], lived))), 8));
+		color = _mm256_or_si256(color, _mm256_slli_epi32(_mm256_cvtps_epi32(_mm256_add_ps(colorStart[2], _mm256_mul_ps(colorChange[2], lived))), 16));
+		color = _mm256_or_si256(color, _mm256_slli_epi32(_mm256_cvtps_epi32(_mm256_add_ps(colorStart[3], _mm256_mul_ps(colorChange[3], lived))), 24));
+		_mm256_store_si256(reinterpret_cast<__m256i*>(a_pool.m_pColor + i), color);
+	}
+}
+#else
+//without AVX2 support in the compiler the wide path runs the SSE one
+void Simplex::MyParticleSystem::UpdateAVX2(MyParticlePool& a_pool, MyParticleEmitter const& a_emitter, float a_fDeltaTime, uint a_uBegin, uint a_uEnd)
+{
+	UpdateSSE(a_pool, a_emitter, a_fDeltaTime, a_uBegin, a_uEnd);
+}
+#endif //MYPARTICLESYSTEM_AVX2
+//Rendering
+void Simplex::MyParticleSystem::Publish(std::vector<MyParticleInstance>& a_particleList)
+{
+	//bursts and clears after the update change the counts
+	uint uCount = 0;
+	for (uint uEmitter = 0; uEmitter < m_poolList.size(); ++uEmitter)
+	{
+		uCount += m_poolList[uEmitter].m_uCount;
+	}
+	a_particleList.resize(uCount);
+
+	//the arrays of each pool are interleaved into the list on the job system
+	uint uOffset = 0;
+	for (uint uEmitter = 0; uEmitter < m_poolList.size(); ++uEmitter)
+	{
+		MyParticlePool const& pool = m_poolList[uEmitter];
+		MyParticleInstance* pInstance = a_particleList.data() + uOffset;
+		MyJobSystem::GetInstance()->ParallelFor(pool.m_uCount, 4096, [&pool, pInstance](uint a_uBegin, uint a_uEnd, uint a_uThread)
+		{
+			for (uint i = a_uBegin; i < a_uEnd; ++i)
+			{
+				pInstance[i].m_v3Position = vector3(pool.m_pPositionX[i], pool.m_pPositionY[i], pool.m_pPositionZ[i]);
+				pInstance[i].m_fSize = pool.m_pSize[i];
+				pInstance[i].m_uColor = pool.m_pColor[i];
+			}
+		});
+		uOffset += pool.m_uCount;
+	}
+}
+void Simplex::MyParticleSystem::CreateDeviceObjects(void)
+{
+	//the four corners of the quad come from the vertex index, only the instances have attributes
+	const GLchar *vertex_shader =
+		"#version 330\n"
+		"uniform mat4 VP;\n"
+		"uniform vec3 Right;\n"
+		"uniform vec3 Up;\n"
+		"in vec4 Instance;\n"
+		"in vec4 Color;\n"
+		"out vec4 Frag_Color;\n"
+		"out vec2 Frag_UV;\n"
+		"void main()\n"
+		"{\n"
+		"	Frag_UV = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+		"	Frag_Color = Color;\n"
+		"	vec3 Position = Instance.xyz + (Right * (Frag_UV.x - 0.5) + Up * (Frag_UV.y - 0.5)) * Instance.w;\n"
+		"	gl_Position = VP * vec4(Position, 1);\n"
+		"}\n";
+
+	//round particles with soft edges
+	const GLchar* fragment_shader =
+		"#version 330\n"
+		"in vec4 Frag_Color;\n"
+		"in vec2 Frag_UV;\n"
+		"out vec4 Out_Color;\n"
+		"void main()\n"
+		"{\n"
+		"	float Alpha = Frag_Color.a * (1 - smoothstep(0.6, 1.0, length(Frag_UV * 2 - 1)));\n"
+		"	if (Alpha < 0.01)\n"
+		"		discard;\n"
+		"	Out_Color = vec4(Frag_Color.rgb, Alpha);\n"
+		"}\n";
+
+	m_uShader = glCreateProgram();
+	GLuint uVertHandle = glCreateShader(GL_VERTEX_SHADER);
+	GLuint uFragHandle = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(uVertHandle, 1, &vertex_shader, 0);
+	glShaderSource(uFragHandle, 1, &fragment_shader, 0);
+	glCompileShader(uVertHandle);
+	glCompileShader(uFragHandle);
+	glAttachShader(m_uShader, uVertHandle);
+	glAttachShader(m_uShader, uFragHandle);
+	glLinkProgram(m_uShader);
+	//the program keeps them alive
+	glDeleteShader(uVertHandle);
+	glDeleteShader(uFragHandle);
+
+	m_nVP = glGetUniformLocation(m_uShader, "VP");
+	m_nRight = glGetUniformLocation(m_uShader, "Right");
+	m_nUp = glGetUniformLocation(m_uShader, "Up");
+	GLint nInstance = glGetAttribLocation(m_uShader, "Instance");
+	GLint nColor = glGetAttribLocation(m_uShader, "Color");
+
+	//one element of each attribute per instance instead of per vertex
+	glGenBuffers(1, &m_uVBO);
+	glGenVertexArrays(1, &m_uVAO);
+	glBindVertexArray(m_uVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+	glEnableVertexAttribArray(nInstance);
+	glEnableVertexAttribArray(nColor);
+	glVertexAttribPointer(nInstance, 4, GL_FLOAT, GL_FALSE, sizeof(MyParticleInstance), (GLvoid*)offsetof(MyParticleInstance, m_v3Position));
+	glVertexAttribPointer(nColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(MyParticleInstance), (GLvoid*)offsetof(MyParticleInstance, m_uColor));
+	glVertexAttribDivisor(nInstance, 1);
+	glVertexAttribDivisor(nColor, 1);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+void Simplex::MyParticleSystem::Render(std::vector<MyParticleInstance> const& a_particleList, matrix4 const& a_m4View, matrix4 const& a_m4Projection)
+{
+	uint uCount = a_particleList.size();
+	if (uCount == 0)
+		return;
+
+	if (m_uShader == 0)
+		CreateDeviceObjects();
+
+	// Backup GL state
+	GLint last_program, last_array_buffer, last_vertex_array, last_blend_src, last_blend_dst;
+	GLboolean last_depth_mask;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+	glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
+	glGetIntegerv(GL_BLEND_SRC_ALPHA, &last_blend_src);
+	glGetIntegerv(GL_BLEND_DST_ALPHA, &last_blend_dst);
+	glGetBooleanv(GL_DEPTH_WRITEMASK, &last_depth_mask);
+	GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
+	GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
+	GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+
+	glBindVertexArray(m_uVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+
+	//orphan the buffer so we do not wait for the previous frame, grow it only if needed
+	if (uCount > m_uVBOCapacity)
+		m_uVBOCapacity = uCount * 2;
+	glBufferData(GL_ARRAY_BUFFER, sizeof(MyParticleInstance) * m_uVBOCapacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(MyParticleInstance) * uCount, a_particleList.data());
+
+	//the axes of the camera are the rows of the view matrix
+	vector3 v3Right(a_m4View[0][0], a_m4View[1][0], a_m4View[2][0]);
+	vector3 v3Up(a_m4View[0][1], a_m4View[1][1], a_m4View[2][1]);
+	matrix4 m4ViewProjection = a_m4Projection * a_m4View;
+	glUseProgram(m_uShader);
+	glUniformMatrix4fv(m_nVP, 1, GL_FALSE, glm::value_ptr(m4ViewProjection));
+	glUniform3fv(m_nRight, 1, glm::value_ptr(v3Right));
+	glUniform3fv(m_nUp, 1, glm::value_ptr(v3Up));
+
+	//hidden by the scene but not by each other, they are not sorted
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_FALSE);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glDisable(GL_CULL_FACE);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, uCount);
+
+	// Restore modified GL state
+	glUseProgram(last_program);
+	glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+	glBindVertexArray(last_vertex_array);
+	glDepthMask(last_depth_mask);
+	glBlendFunc(last_blend_src, last_blend_dst);
+	if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+	if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
+	if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+}
\ No newline at end of file
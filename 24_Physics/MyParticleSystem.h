@@ -0,0 +1,288 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYPARTICLESYSTEM_H_
+#define __MYPARTICLESYSTEM_H_
+
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+//Particle as the render thread gets it, the vertex shader builds the quad facing the camera around it
+struct MyParticleInstance
+{
+	vector3 m_v3Position; //center in world space
+	float m_fSize; //side of the quad
+	uint m_uColor; //RGBA, one byte per channel with red in the lowest one
+};
+
+//Settings of an emitter, they can be changed while it runs through GetEmitter
+struct MyParticleEmitter
+{
+	vector3 m_v3Position = ZERO_V3; //center of the particles spawned
+	float m_fRadius = 0.0f; //particles spawn anywhere inside this sphere around the position
+	vector3 m_v3Velocity = AXIS_Y; //velocity of the particles spawned
+	float m_fSpread = 0.0f; //length of the random velocity added to each one
+	float m_fRate = 0.0f; //particles spawned per second
+	float m_fLife = 1.0f; //seconds each particle lives
+	float m_fLifeVariance = 0.0f; //fraction of the life a particle can live less or more
+	vector3 m_v3Acceleration = vector3(0.0f, -9.8f, 0.0f); //gravity (and wind) in units per second squared
+	float m_fDrag = 0.0f; //fraction of the velocity lost each second
+	vector4 m_v4ColorStart = vector4(1.0f); //color when born, each channel from 0 to 1
+	vector4 m_v4ColorEnd = vector4(1.0f, 1.0f, 1.0f, 0.0f); //color when it dies
+	float m_fSizeStart = 0.1f; //size when born
+	float m_fSizeEnd = 0.1f; //size when it dies
+	bool m_bGround = true; //do the particles bounce on the ground (y = 0)?
+	bool m_bEntities = false; //do the particles bounce on the boxes of the entities (found with the broad phase)?
+	float m_fBounce = 0.5f; //fraction of the velocity kept along the normal of a bounce
+	float m_fFriction = 0.8f; //fraction of the velocity kept along the surface of a bounce
+	uint m_uMaxCount = 1 << 20; //live particles, spawning stops while the emitter has this many
+};
+
+//System Class, the particles of each emitter live in an aligned structure of arrays that is updated
+//eight at a time with AVX2 (four with SSE) on the job system; the dead ones are replaced by the last
+//so the arrays have no holes, and they are drawn in one instanced call that only uploads the position,
+//size and color of each particle
+class MyParticleSystem
+{
+	//particles of one emitter, 32 byte aligned and with a capacity that is a multiple of eight
+	struct MyParticlePool
+	{
+		uint m_uCount = 0; //live particles
+		uint m_uCapacity = 0; //particles allocated
+		float m_fSpawn = 0.0f; //fraction of a particle left to spawn from the last update
+		float* m_pPositionX = nullptr; //position of each particle
+		float* m_pPositionY = nullptr;
+		float* m_pPositionZ = nullptr;
+		float* m_pVelocityX = nullptr; //velocity of each particle
+		float* m_pVelocityY = nullptr;
+		float* m_pVelocityZ = nullptr;
+		float* m_pAge = nullptr; //seconds since it was born
+		float* m_pInverseLife = nullptr; //one over the seconds it lives
+		float* m_pSize = nullptr; //size for its age, written by the update
+		uint* m_pColor = nullptr; //packed color for its age, written by the update
+	};
+
+	std::vector<MyParticleEmitter> m_emitterList; //settings of each emitter
+	std::vector<MyParticlePool> m_poolList; //particles of each emitter
+	bool m_bAVX2 = false; //can this machine run the AVX2 path?
+	uint m_uRandom = 1; //state of the generator used to spawn
+	uint m_uParticleCount = 0; //live particles after the last update
+	float m_fUpdateTime = 0.0f; //milliseconds the last update took
+
+	std::vector<uint> m_entityList; //entities a pool can hit this update
+	std::vector<vector3> m_boxList; //minimum and maximum of the box of each of them
+
+	GLuint m_uShader = 0; //shader program
+	GLuint m_uVAO = 0; //vertex array object
+	GLuint m_uVBO = 0; //streaming instance buffer
+	uint m_uVBOCapacity = 0; //instances that fit in the buffer
+	GLint m_nVP = -1; //location of the view projection uniform
+	GLint m_nRight = -1; //location of the right vector of the camera
+	GLint m_nUp = -1; //location of the up vector of the camera
+
+	static MyParticleSystem* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyParticleSystem* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds an emitter
+	ARGUMENTS: MyParticleEmitter const& a_emitter -> settings of the emitter
+	OUTPUT: index of the emitter
+	*/
+	uint AddEmitter(MyParticleEmitter const& a_emitter);
+	/*
+	USAGE: Gets the settings of an emitter so they can be changed
+	ARGUMENTS: uint a_uEmitter -> index of the emitter
+	OUTPUT: settings, nullptr if it does not exist
+	*/
+	MyParticleEmitter* GetEmitter(uint a_uEmitter);
+	/*
+	USAGE: Gets the number of emitters
+	ARGUMENTS: ---
+	OUTPUT: emitter count
+	*/
+	uint GetEmitterCount(void);
+	/*
+	USAGE: Spawns particles on an emitter at once, on top of its rate
+	ARGUMENTS:
+	-	uint a_uEmitter -> index of the emitter
+	-	uint a_uCount -> particles to spawn (the ones over the maximum of the emitter are not)
+	OUTPUT: ---
+	*/
+	void Burst(uint a_uEmitter, uint a_uCount);
+	/*
+	USAGE: Kills all the particles of an emitter
+	ARGUMENTS: uint a_uEmitter -> index of the emitter
+	OUTPUT: ---
+	*/
+	void Clear(uint a_uEmitter);
+	/*
+	USAGE: Spawns, moves, ages and kills the particles of all the emitters; needs to be called from the
+	simulation thread once per frame, after the entities moved
+	ARGUMENTS: float a_fDeltaTime -> seconds since the last update
+	OUTPUT: ---
+	*/
+	void Update(float a_fDeltaTime);
+	/*
+	USAGE: Copies the particles into a list for the render thread
+	ARGUMENTS: std::vector<MyParticleInstance>& a_particleList -> list to fill (its memory is kept)
+	OUTPUT: ---
+	*/
+	void Publish(std::vector<MyParticleInstance>& a_particleList);
+	/*
+	USAGE: Draws the particles of a list as quads facing the camera, blended over the scene without writing
+	the depth; needs to be called from the thread that owns the OpenGL context
+	ARGUMENTS:
+	-	std::vector<MyParticleInstance> const& a_particleList -> particles to draw
+	-	matrix4 const& a_m4View -> view matrix of the camera
+	-	matrix4 const& a_m4Projection -> projection matrix of the camera
+	OUTPUT: ---
+	*/
+	void Render(std::vector<MyParticleInstance> const& a_particleList, matrix4 const& a_m4View, matrix4 const& a_m4Projection);
+	/*
+	USAGE: Gets the number of live particles after the last update
+	ARGUMENTS: ---
+	OUTPUT: particle count
+	*/
+	uint GetParticleCount(void);
+	/*
+	USAGE: Gets the milliseconds the last update took
+	ARGUMENTS: ---
+	OUTPUT: update time
+	*/
+	float GetUpdateTime(void);
+	/*
+	USAGE: Asks if the particles are updated with AVX2 (SSE otherwise)
+	ARGUMENTS: ---
+	OUTPUT: is AVX2 in use?
+	*/
+	bool IsUsingAVX2(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyParticleSystem(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyParticleSystem(MyParticleSystem const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyParticleSystem& operator=(MyParticleSystem const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyParticleSystem(void);
+	/*
+	Usage: releases the pools and the OpenGL objects
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Gets a random number
+	ARGUMENTS: ---
+	OUTPUT: number from 0 to 1
+	*/
+	float Random(void);
+	/*
+	USAGE: Gets a random point inside a sphere
+	ARGUMENTS: float a_fRadius -> radius of the sphere, centered on the origin
+	OUTPUT: point
+	*/
+	vector3 RandomInSphere(float a_fRadius);
+	/*
+	USAGE: Reallocates the arrays of a pool keeping its particles
+	ARGUMENTS:
+	-	MyParticlePool& a_pool -> pool to grow
+	-	uint a_uCapacity -> particles it can hold, a multiple of eight
+	OUTPUT: ---
+	*/
+	void Grow(MyParticlePool& a_pool, uint a_uCapacity);
+	/*
+	USAGE: Adds particles at the end of the pool of an emitter
+	ARGUMENTS:
+	-	uint a_uEmitter -> index of the emitter
+	-	uint a_uCount -> particles to spawn
+	OUTPUT: ---
+	*/
+	void Spawn(uint a_uEmitter, uint a_uCount);
+	/*
+	USAGE: Moves the last particles over the dead ones and shortens the pool
+	ARGUMENTS: MyParticlePool& a_pool -> pool to compact
+	OUTPUT: ---
+	*/
+	void Compact(MyParticlePool& a_pool);
+	/*
+	USAGE: Bounces the particles of a pool on the boxes of the entities they overlap
+	ARGUMENTS: uint a_uEmitter -> index of the emitter
+	OUTPUT: ---
+	*/
+	void CollideEntities(uint a_uEmitter);
+	/*
+	USAGE: Moves, ages and colors a range of particles four at a time
+	ARGUMENTS:
+	-	MyParticlePool& a_pool -> pool to update
+	-	MyParticleEmitter const& a_emitter -> settings of the pool
+	-	float a_fDeltaTime -> seconds to move
+	-	uint a_uBegin -> first particle, multiple of eight
+	-	uint a_uEnd -> one past the last particle, multiple of eight
+	OUTPUT: ---
+	*/
+	void UpdateSSE(MyParticlePool& a_pool, MyParticleEmitter const& a_emitter, float a_fDeltaTime, uint a_uBegin, uint a_uEnd);
+	/*
+	USAGE: Moves, ages and colors a range of particles eight at a time
+	ARGUMENTS:
+	-	MyParticlePool& a_pool -> pool to update
+	-	MyParticleEmitter const& a_emitter -> settings of the pool
+	-	float a_fDeltaTime -> seconds to move
+	-	uint a_uBegin -> first particle, multiple of eight
+	-	uint a_uEnd -> one past the last particle, multiple of eight
+	OUTPUT: ---
+	*/
+	void UpdateAVX2(MyParticlePool& a_pool, MyParticleEmitter const& a_emitter, float a_fDeltaTime, uint a_uBegin, uint a_uEnd);
+	/*
+	USAGE: Creates the shader and the buffers, called on the first render
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void CreateDeviceObjects(void);
+};
+
+} //namespace Simplex
+
+#endif //__MYPARTICLESYSTEM_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
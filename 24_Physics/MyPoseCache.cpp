@@ -0,0 +1,108 @@
+#include "MyPoseCache.h"
+using namespace Simplex;
+static uint HashPose(MyAnimationClip* a_pClip, float a_fFrame)
+{
+	uint uFrame = 0;
+	memcpy(&uFrame, &a_fFrame, sizeof(uint));
+	unsigned long long uHash = static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(a_pClip)) * 0x9E3779B97F4A7C15ULL;
+	uHash ^= static_cast<unsigned long long>(uFrame) + (uHash << 6) + (uHash >> 2);
+	uHash ^= uHash >> 31;
+	uHash *= 0xBF58476D1CE4E5B9ULL;
+	uHash ^= uHash >> 29;
+	return static_cast<uint>(uHash);
+}
+//  MyPoseCache
+MyPoseCache::MyPoseCache(float a_fQuantization) { SetQuantization(a_fQuantization); }
+MyPoseCache::MyPoseCache(MyPoseCache const& other) {}
+MyPoseCache& MyPoseCache::operator=(MyPoseCache const& other) { return *this; }
+MyPoseCache::~MyPoseCache(void) { Clear(); }
+void MyPoseCache::SetQuantization(float a_fQuantization) { m_fQuantization = a_fQuantization > 0.0f ? a_fQuantization : 0.0f; }
+float MyPoseCache::GetQuantization(void) { return m_fQuantization; }
+uint MyPoseCache::GetPoseCount(void) { return m_poseList.size(); }
+uint MyPoseCache::GetLookupCount(void) { return m_uLookupCount; }
+float MyPoseCache::GetHitRate(void)
+{
+	if (m_uLookupCount == 0)
+		return 0.0f;
+	return static_cast<float>(m_uLookupCount - m_poseList.size()) / m_uLookupCount;
+}
+void MyPoseCache::Clear(void)
+{
+	m_keyTable.clear();
+	m_poseList.clear();
+	m_offsetList.clear();
+	m_matrixList.clear();
+	m_instancePoseList.clear();
+	m_uLookupCount = 0;
+}
+uint MyPoseCache::FindPose(MyAnimationClip* a_pClip, float a_fFrame)
+{
+	uint uMask = static_cast<uint>(m_keyTable.size()) - 1;
+	uint uSlot = HashPose(a_pClip, a_fFrame) & uMask;
+	while (m_keyTable[uSlot].m_pClip != nullptr)
+	{
+		MyPoseKey& key = m_keyTable[uSlot];
+		if (key.m_pClip == a_pClip && key.m_fFrame == a_fFrame)
+			return key.m_uPose;
+		uSlot = (uSlot + 1) & uMask;
+	}
+
+	MyPoseKey& key = m_keyTable[uSlot];
+	key.m_pClip = a_pClip;
+	key.m_fFrame = a_fFrame;
+	key.m_uPose = m_poseList.size();
+	m_poseList.push_back(key);
+	return key.m_uPose;
+}
+void MyPoseCache::Update(MyAnimationInstance** a_pInstance, uint a_uCount)
+{
+	//the table is rebuilt every update with room for twice the instances
+	uint uTableSize = 64;
+	while (uTableSize < a_uCount * 2)
+		uTableSize *= 2;
+	m_keyTable.assign(uTableSize, MyPoseKey());
+	m_poseList.clear();
+	m_instancePoseList.resize(a_uCount);
+	m_uLookupCount = 0;
+
+	//distinct poses, in the order they are first asked for
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		MyAnimationInstance* pInstance = a_pInstance[i];
+		if (pInstance->m_pClip == nullptr || pInstance->m_pClip->GetTrackCount() == 0)
+			continue;
+		float fFrame = pInstance->m_fFrame;
+		if (m_fQuantization > 0.0f)
+			fFrame = glm::floor(fFrame / m_fQuantization + 0.5f) * m_fQuantization;
+		m_instancePoseList[i] = FindPose(pInstance->m_pClip, fFrame);
+		++m_uLookupCount;
+	}
+
+	//storage for all of them, the pointers handed out are only taken after this
+	m_offsetList.resize(m_poseList.size());
+	uint uMatrixCount = 0;
+	for (uint i = 0; i < m_poseList.size(); ++i)
+	{
+		m_offsetList[i] = uMatrixCount;
+		uMatrixCount += m_poseList[i].m_pClip->GetTrackCount();
+	}
+	if (m_matrixList.size() < uMatrixCount)
+		m_matrixList.resize(uMatrixCount);
+
+	//each distinct pose is sampled once
+	MyJobSystem::GetInstance()->ParallelFor(m_poseList.size(), 4, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			m_poseList[i].m_pClip->Sample(m_poseList[i].m_fFrame, &m_matrixList[m_offsetList[i]]);
+		}
+	});
+
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		MyAnimationInstance* pInstance = a_pInstance[i];
+		if (pInstance->m_pClip == nullptr || pInstance->m_pClip->GetTrackCount() == 0)
+			continue;
+		pInstance->m_pPose = &m_matrixList[m_offsetList[m_instancePoseList[i]]];
+	}
+}
\ No newline at end of file
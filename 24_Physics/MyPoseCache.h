@@ -0,0 +1,121 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYPOSECACHE_H_
+#define __MYPOSECACHE_H_
+
+#include "MyAnimationClip.h"
+
+namespace Simplex
+{
+
+//Distinct pose of an update, a clip sampled at a frame
+struct MyPoseKey
+{
+	MyAnimationClip* m_pClip = nullptr; //clip sampled, nullptr for empty slots
+	float m_fFrame = 0.0f; //frame sampled (after quantization)
+	uint m_uPose = 0; //index of the pose in the cache
+};
+
+//Shares the poses of the instances playing the same clip at the same (quantized) frame, each distinct
+//pose is sampled once per update and handed to all of its instances as a read-only matrix array
+class MyPoseCache
+{
+	float m_fQuantization = 0.0f; //frames the instances are snapped to, 0 only shares the exact same frame
+	std::vector<MyPoseKey> m_keyTable; //slots of the table, linear probing, size is a power of two
+	std::vector<MyPoseKey> m_poseList; //distinct poses of the last update
+	std::vector<uint> m_offsetList; //first matrix of each pose
+	std::vector<matrix4> m_matrixList; //matrices of all the poses, valid until the next update
+	std::vector<uint> m_instancePoseList; //pose of each instance of the update
+	uint m_uLookupCount = 0; //instances sampled in the last update
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: float a_fQuantization = 0.0f -> frames the instances are snapped to
+	OUTPUT: class object instance
+	*/
+	MyPoseCache(float a_fQuantization = 0.0f);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyPoseCache(void);
+	/*
+	USAGE: Finds the distinct poses of the instances, samples each one once in parallel and points every
+	instance to its pose; the poses are valid until the next call
+	ARGUMENTS:
+	-	MyAnimationInstance** a_pInstance -> instances to sample, the ones without clip are skipped
+	-	uint a_uCount -> number of instances
+	OUTPUT: ---
+	*/
+	void Update(MyAnimationInstance** a_pInstance, uint a_uCount);
+	/*
+	USAGE: Sets the frames the instances are snapped to, bigger steps share more poses but look choppier
+	ARGUMENTS: float a_fQuantization -> frames between the poses, 0 only shares the exact same frame
+	OUTPUT: ---
+	*/
+	void SetQuantization(float a_fQuantization);
+	/*
+	USAGE: Gets the frames the instances are snapped to
+	ARGUMENTS: ---
+	OUTPUT: quantization
+	*/
+	float GetQuantization(void);
+	/*
+	USAGE: Gets the number of poses sampled in the last update
+	ARGUMENTS: ---
+	OUTPUT: pose count
+	*/
+	uint GetPoseCount(void);
+	/*
+	USAGE: Gets the number of instances that asked for a pose in the last update
+	ARGUMENTS: ---
+	OUTPUT: lookup count
+	*/
+	uint GetLookupCount(void);
+	/*
+	USAGE: Gets the fraction of the instances of the last update that found their pose already sampled
+	ARGUMENTS: ---
+	OUTPUT: hit rate, 0 to 1
+	*/
+	float GetHitRate(void);
+	/*
+	USAGE: Forgets all the poses, the instances need to be updated before they are drawn again
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+private:
+	/*
+	USAGE: copy constructor, poses are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyPoseCache(MyPoseCache const& other);
+	/*
+	USAGE: copy assignment operator, poses are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyPoseCache& operator=(MyPoseCache const& other);
+	/*
+	USAGE: Finds the pose of a clip at a frame, adding it if it is not in the table
+	ARGUMENTS:
+	-	MyAnimationClip* a_pClip -> clip sampled
+	-	float a_fFrame -> frame sampled
+	OUTPUT: index of the pose
+	*/
+	uint FindPose(MyAnimationClip* a_pClip, float a_fFrame);
+};
+
+} //namespace Simplex
+
+#endif //__MYPOSECACHE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
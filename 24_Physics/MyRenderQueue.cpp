@@ -0,0 +1,275 @@
+#include "MyRenderQueue.h"
+#include "MyRenderThread.h"
+using namespace Simplex;
+//  MyCommandBuffer
+MyCommandBuffer::MyCommandBuffer(uint a_uCapacity)
+{
+	if (a_uCapacity < 1)
+		a_uCapacity = 1;
+	m_uCount = 0;
+	m_uCapacity = a_uCapacity;
+	m_pCommand = new MyRenderCommand[m_uCapacity];
+}
+MyCommandBuffer::MyCommandBuffer(MyCommandBuffer const& other) { }
+MyCommandBuffer& MyCommandBuffer::operator=(MyCommandBuffer const& other) { return *this; }
+MyCommandBuffer::~MyCommandBuffer(void)
+{
+	if (m_pCommand)
+	{
+		delete[] m_pCommand;
+		m_pCommand = nullptr;
+	}
+	m_uCount = 0;
+	m_uCapacity = 0;
+}
+void MyCommandBuffer::Grow(void)
+{
+	MyRenderCommand* pTemp = new MyRenderCommand[m_uCapacity * 2];
+	memcpy(pTemp, m_pCommand, sizeof(MyRenderCommand) * m_uCount);
+	delete[] m_pCommand;
+	m_pCommand = pTemp;
+	m_uCapacity *= 2;
+}
+void MyCommandBuffer::Push(uint a_uMeshIndex, int a_nRender, matrix4 const& a_m4ToWorld)
+{
+	if (m_uCount == m_uCapacity)
+		Grow();
+
+	MyRenderCommand& command = m_pCommand[m_uCount];
+	command.m_uMeshIndex = a_uMeshIndex;
+	command.m_nRender = a_nRender;
+	command.m_m4ToWorld = a_m4ToWorld;
+	++m_uCount;
+}
+void MyCommandBuffer::Reset(void) { m_uCount = 0; }
+uint MyCommandBuffer::GetCount(void) { return m_uCount; }
+MyRenderCommand* MyCommandBuffer::GetCommands(void) { return m_pCommand; }
+//  MyRenderQueue
+Simplex::MyRenderQueue* Simplex::MyRenderQueue::m_pInstance = nullptr;
+void Simplex::MyRenderQueue::Init(void)
+{
+	m_pMeshMngr = MeshManager::GetInstance();
+	m_pJobSystem = MyJobSystem::GetInstance();
+
+	//one buffer per thread, each one separately allocated so they do not share cache lines
+	m_uBufferCount = m_pJobSystem->GetThreadCount();
+	m_pBuffer = new MyCommandBuffer*[m_uBufferCount];
+	for (uint i = 0; i < m_uBufferCount; ++i)
+	{
+		m_pBuffer[i] = new MyCommandBuffer();
+	}
+	m_pOffset = new uint[m_uBufferCount + 1];
+
+	m_uMergedCount = 0;
+	m_uMergedCapacity = 0;
+	m_pMerged = nullptr;
+
+	//axis meshes are shared by all the entities
+	MyRenderThread::GetInstance()->Invoke([this]()
+	{
+		m_nAxis[0] = m_pMeshMngr->GenerateLine(ZERO_V3, AXIS_X, C_RED, C_RED);
+		m_nAxis[1] = m_pMeshMngr->GenerateLine(ZERO_V3, AXIS_Y, C_GREEN, C_GREEN);
+		m_nAxis[2] = m_pMeshMngr->GenerateLine(ZERO_V3, AXIS_Z, C_BLUE, C_BLUE);
+	});
+}
+void Simplex::MyRenderQueue::Release(void)
+{
+	for (uint i = 0; i < m_uBufferCount; ++i)
+	{
+		SafeDelete(m_pBuffer[i]);
+	}
+	if (m_pBuffer)
+	{
+		delete[] m_pBuffer;
+		m_pBuffer = nullptr;
+	}
+	if (m_pOffset)
+	{
+		delete[] m_pOffset;
+		m_pOffset = nullptr;
+	}
+	if (m_pMerged)
+	{
+		delete[] m_pMerged;
+		m_pMerged = nullptr;
+	}
+	m_uBufferCount = 0;
+	m_uMergedCount = 0;
+	m_uMergedCapacity = 0;
+	m_modelList.clear();
+	m_wireCubeMap.clear();
+	m_wireSphereMap.clear();
+	m_occluderSet.clear();
+	//the meshes themselves belong to the MeshManager
+	m_pMeshMngr = nullptr;
+	m_pJobSystem = nullptr;
+}
+Simplex::MyRenderQueue* Simplex::MyRenderQueue::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyRenderQueue();
+	}
+	return m_pInstance;
+}
+void Simplex::MyRenderQueue::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//Accessors
+Simplex::MyCommandBuffer* Simplex::MyRenderQueue::GetBuffer(void) { return GetBuffer(MyJobSystem::GetThreadIndex()); }
+Simplex::MyCommandBuffer* Simplex::MyRenderQueue::GetBuffer(uint a_uThread)
+{
+	//threads not owned by the job system share the main buffer
+	if (a_uThread >= m_uBufferCount)
+		a_uThread = 0;
+	return m_pBuffer[a_uThread];
+}
+Simplex::uint Simplex::MyRenderQueue::GetCommandCount(void) { return m_uMergedCount; }
+void Simplex::MyRenderQueue::SetViewProjection(matrix4 const& a_m4ViewProjection) { m_m4ViewProjection = a_m4ViewProjection; }
+Simplex::matrix4 Simplex::MyRenderQueue::GetViewProjection(void) { return m_m4ViewProjection; }
+Simplex::MyOcclusionCuller* Simplex::MyRenderQueue::GetOcclusionCuller(void) { return &m_occlusionCuller; }
+//The big 3
+Simplex::MyRenderQueue::MyRenderQueue() { Init(); }
+Simplex::MyRenderQueue::MyRenderQueue(MyRenderQueue const& a_pOther) { }
+Simplex::MyRenderQueue& Simplex::MyRenderQueue::operator=(MyRenderQueue const& a_pOther) { return *this; }
+Simplex::MyRenderQueue::~MyRenderQueue() { Release(); };
+// other methods
+Simplex::uint Simplex::MyRenderQueue::PackColor(vector3 a_v3Color)
+{
+	vector3 v3Color = glm::clamp(a_v3Color, 0.0f, 1.0f) * 255.0f;
+	return (static_cast<uint>(v3Color.r) << 16) | (static_cast<uint>(v3Color.g) << 8) | static_cast<uint>(v3Color.b);
+}
+int Simplex::MyRenderQueue::GetWireCube(vector3 a_v3Color)
+{
+	uint uKey = PackColor(a_v3Color);
+	auto shape = m_wireCubeMap.find(uKey);
+	if (shape != m_wireCubeMap.end())
+		return shape->second;
+
+	int nMesh = -1;
+	MyRenderThread::GetInstance()->Invoke([this, &nMesh, a_v3Color]() { nMesh = m_pMeshMngr->GenerateWireCube(1.0f, a_v3Color); });
+	m_wireCubeMap[uKey] = nMesh;
+	return nMesh;
+}
+int Simplex::MyRenderQueue::GetWireSphere(vector3 a_v3Color)
+{
+	uint uKey = PackColor(a_v3Color);
+	auto shape = m_wireSphereMap.find(uKey);
+	if (shape != m_wireSphereMap.end())
+		return shape->second;
+
+	int nMesh = -1;
+	MyRenderThread::GetInstance()->Invoke([this, &nMesh, a_v3Color]() { nMesh = m_pMeshMngr->GenerateWireSphere(1.0f, a_v3Color); });
+	m_wireSphereMap[uKey] = nMesh;
+	return nMesh;
+}
+void Simplex::MyRenderQueue::AddAxis(matrix4 const& a_m4ToWorld)
+{
+	MyCommandBuffer* pBuffer = GetBuffer();
+	for (uint i = 0; i < 3; ++i)
+	{
+		pBuffer->Push(m_nAxis[i], RENDER_SOLID, a_m4ToWorld);
+	}
+}
+void Simplex::MyRenderQueue::AddModel(Model* a_pModel, matrix4 const& a_m4ToWorld)
+{
+	MyModelCommand command;
+	command.m_pModel = a_pModel;
+	command.m_m4ToWorld = a_m4ToWorld;
+	m_modelList.push_back(command);
+}
+void Simplex::MyRenderQueue::AddOccluder(uint a_uMeshIndex) { m_occluderSet.insert(a_uMeshIndex); }
+Simplex::uint Simplex::MyRenderQueue::Flush(std::vector<MyRenderCommand>& a_commandList, std::vector<MyModelCommand>& a_modelList)
+{
+	//the models go as they are, the list of the snapshot keeps its memory
+	a_modelList.assign(m_modelList.begin(), m_modelList.end());
+	m_modelList.clear();
+
+	//prefix sum of the counts, each buffer knows where to start writing
+	m_pOffset[0] = 0;
+	for (uint i = 0; i < m_uBufferCount; ++i)
+	{
+		m_pOffset[i + 1] = m_pOffset[i] + m_pBuffer[i]->GetCount();
+	}
+	m_uMergedCount = m_pOffset[m_uBufferCount];
+
+	//grow the merged list only if this frame needs more than ever before
+	if (m_uMergedCount > m_uMergedCapacity)
+	{
+		if (m_pMerged)
+		{
+			delete[] m_pMerged;
+			m_pMerged = nullptr;
+		}
+		m_uMergedCapacity = m_uMergedCount * 2;
+		m_pMerged = new MyRenderCommand[m_uMergedCapacity];
+	}
+
+	//each buffer copies to its own range so there is no need to lock
+	m_pJobSystem->ParallelFor(m_uBufferCount, 1, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			uint uCount = m_pBuffer[i]->GetCount();
+			if (uCount > 0)
+				memcpy(m_pMerged + m_pOffset[i], m_pBuffer[i]->GetCommands(), sizeof(MyRenderCommand) * uCount);
+			m_pBuffer[i]->Reset();
+		}
+	});
+
+	//meshes seen for the first time give the culler their bounds (and their triangles if they hide others)
+	for (uint i = 0; i < m_uMergedCount; ++i)
+	{
+		uint uMesh = m_pMerged[i].m_uMeshIndex;
+		if (m_occlusionCuller.HasMesh(uMesh))
+			continue;
+		Mesh* pMesh = m_pMeshMngr->GetMesh(uMesh);
+		if (pMesh)
+			m_occlusionCuller.SetMesh(uMesh, pMesh->GetVertexList(), m_occluderSet.count(uMesh) > 0);
+	}
+	m_uMergedCount = m_occlusionCuller.Cull(m_pMerged, m_uMergedCount, m_m4ViewProjection);
+
+	//meshes with their texture in the atlas are drawn with the copy using the page material, so meshes
+	//of different materials share the draw; the list only grows if this frame needs more than ever before
+	MyTextureAtlas* pAtlas = MyTextureAtlas::GetInstance();
+	bool bAtlas = pAtlas->GetPageCount() > 0;
+	a_commandList.resize(m_uMergedCount);
+	for (uint i = 0; i < m_uMergedCount; ++i)
+	{
+		MyRenderCommand& command = a_commandList[i];
+		command = m_pMerged[i];
+		if (bAtlas && (command.m_nRender & RENDER_WIRE) == 0)
+		{
+			int nCopy = pAtlas->GetMesh(command.m_uMeshIndex);
+			if (nCopy >= 0)
+			{
+				MyTextureAtlas::PackRect(command.m_m4ToWorld, pAtlas->GetMeshRect(command.m_uMeshIndex));
+				command.m_uMeshIndex = nCopy;
+			}
+		}
+	}
+
+	return m_uMergedCount;
+}
+void Simplex::MyRenderQueue::Submit(std::vector<MyRenderCommand> const& a_commandList, std::vector<MyModelCommand> const& a_modelList)
+{
+	//the MeshManager is not thread safe, submission happens on the thread that renders
+	for (uint i = 0; i < a_commandList.size(); ++i)
+	{
+		MyRenderCommand const& command = a_commandList[i];
+		m_pMeshMngr->AddMeshToRenderList(command.m_uMeshIndex, command.m_m4ToWorld, command.m_nRender);
+	}
+
+	//models that share a Model draw one after the other, only this thread sets their matrix
+	for (uint i = 0; i < a_modelList.size(); ++i)
+	{
+		MyModelCommand const& command = a_modelList[i];
+		command.m_pModel->SetModelMatrix(command.m_m4ToWorld);
+		command.m_pModel->AddToRenderList();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYRENDERQUEUE_H_
+#define __MYRENDERQUEUE_H_
+
+#include "MyOcclusionCuller.h"
+#include "MyTextureAtlas.h"
+
+namespace Simplex
+{
+
+//Single render request, what MeshManager::AddMeshToRenderList needs
+struct MyRenderCommand
+{
+	uint m_uMeshIndex; //index of the mesh in the MeshManager
+	int m_nRender; //BTO_RENDER option
+	matrix4 m_m4ToWorld; //model to world matrix of the instance
+};
+
+//Model drawn as a whole, for the ones that do not know the indices of their meshes
+struct MyModelCommand
+{
+	Model* m_pModel; //model to draw, it belongs to the MeshManager
+	matrix4 m_m4ToWorld; //model to world matrix of the instance
+};
+
+//Linear allocator of render commands owned by a single thread
+class MyCommandBuffer
+{
+	uint m_uCount = 0; //commands recorded this frame
+	uint m_uCapacity = 0; //commands that fit before we need to grow
+	MyRenderCommand* m_pCommand = nullptr; //command storage
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: uint a_uCapacity = 1024 -> initial number of commands
+	OUTPUT: class object instance
+	*/
+	MyCommandBuffer(uint a_uCapacity = 1024);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyCommandBuffer(void);
+	/*
+	USAGE: Records a command, storage only grows when the frame needs more than ever before
+	ARGUMENTS:
+	-	uint a_uMeshIndex -> index of the mesh in the MeshManager
+	-	int a_nRender -> BTO_RENDER option
+	-	matrix4 const& a_m4ToWorld -> model to world matrix
+	OUTPUT: ---
+	*/
+	void Push(uint a_uMeshIndex, int a_nRender, matrix4 const& a_m4ToWorld);
+	/*
+	USAGE: Forgets the recorded commands, keeps the storage
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Reset(void);
+	/*
+	USAGE: Gets the number of commands recorded
+	ARGUMENTS: ---
+	OUTPUT: command count
+	*/
+	uint GetCount(void);
+	/*
+	USAGE: Gets the recorded commands
+	ARGUMENTS: ---
+	OUTPUT: command array
+	*/
+	MyRenderCommand* GetCommands(void);
+private:
+	/*
+	USAGE: copy constructor, buffers are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyCommandBuffer(MyCommandBuffer const& other);
+	/*
+	USAGE: copy assignment operator, buffers are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyCommandBuffer& operator=(MyCommandBuffer const& other);
+	/*
+	USAGE: Doubles the capacity keeping the recorded commands
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Grow(void);
+};
+
+//System Class
+class MyRenderQueue
+{
+	uint m_uBufferCount = 0; //one buffer per thread of the job system
+	MyCommandBuffer** m_pBuffer = nullptr; //per thread buffers
+	uint* m_pOffset = nullptr; //prefix sum of the buffer counts
+
+	uint m_uMergedCount = 0; //commands in the merged list
+	uint m_uMergedCapacity = 0; //size of the merged list
+	MyRenderCommand* m_pMerged = nullptr; //merged list of all buffers
+	std::vector<MyModelCommand> m_modelList; //models recorded this frame
+
+	std::map<uint, int> m_wireCubeMap; //generated wire cubes by packed color
+	std::map<uint, int> m_wireSphereMap; //generated wire spheres by packed color
+	int m_nAxis[3]; //line meshes used to draw an axis
+
+	MyOcclusionCuller m_occlusionCuller; //removes the commands hidden behind the biggest occluders
+	std::set<uint> m_occluderSet; //meshes that can hide others
+	matrix4 m_m4ViewProjection = IDENTITY_M4; //camera the commands are recorded for
+
+	MeshManager* m_pMeshMngr = nullptr; //Mesh Manager singleton
+	MyJobSystem* m_pJobSystem = nullptr; //Job System singleton
+	static MyRenderQueue* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyRenderQueue* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Gets the command buffer of the thread executing this call
+	ARGUMENTS: ---
+	OUTPUT: command buffer of the calling thread
+	*/
+	MyCommandBuffer* GetBuffer(void);
+	/*
+	USAGE: Gets the command buffer of the specified thread
+	ARGUMENTS: uint a_uThread -> thread index (as given by the job system)
+	OUTPUT: command buffer
+	*/
+	MyCommandBuffer* GetBuffer(uint a_uThread);
+	/*
+	USAGE: Gets (generating it the first time) the index of a unit wire cube of the specified color,
+	needs to be called from the simulation thread, the mesh is created by the render thread
+	ARGUMENTS: vector3 a_v3Color -> color of the cube
+	OUTPUT: index of the mesh in the MeshManager
+	*/
+	int GetWireCube(vector3 a_v3Color);
+	/*
+	USAGE: Gets (generating it the first time) the index of a unit wire sphere of the specified color,
+	needs to be called from the simulation thread, the mesh is created by the render thread
+	ARGUMENTS: vector3 a_v3Color -> color of the sphere
+	OUTPUT: index of the mesh in the MeshManager
+	*/
+	int GetWireSphere(vector3 a_v3Color);
+	/*
+	USAGE: Records an axis in the buffer of the calling thread
+	ARGUMENTS: matrix4 const& a_m4ToWorld -> model to world matrix of the axis
+	OUTPUT: ---
+	*/
+	void AddAxis(matrix4 const& a_m4ToWorld);
+	/*
+	USAGE: Records a model to be drawn whole with the snapshot, needs to be called from the simulation thread
+	ARGUMENTS:
+	-	Model* a_pModel -> model to draw
+	-	matrix4 const& a_m4ToWorld -> model to world matrix
+	OUTPUT: ---
+	*/
+	void AddModel(Model* a_pModel, matrix4 const& a_m4ToWorld);
+	/*
+	USAGE: Marks a mesh as a closed triangle mesh that can hide the ones behind it
+	ARGUMENTS: uint a_uMeshIndex -> index of the mesh in the MeshManager
+	OUTPUT: ---
+	*/
+	void AddOccluder(uint a_uMeshIndex);
+	/*
+	USAGE: Gets the occlusion culler the merged commands go through
+	ARGUMENTS: ---
+	OUTPUT: occlusion culler
+	*/
+	MyOcclusionCuller* GetOcclusionCuller(void);
+	/*
+	USAGE: Sets the camera the commands of this frame are recorded for, the static batches and the
+	occlusion culler cull against it
+	ARGUMENTS: matrix4 const& a_m4ViewProjection -> view projection matrix of the camera
+	OUTPUT: ---
+	*/
+	void SetViewProjection(matrix4 const& a_m4ViewProjection);
+	/*
+	USAGE: Gets the camera the commands of this frame are recorded for
+	ARGUMENTS: ---
+	OUTPUT: view projection matrix
+	*/
+	matrix4 GetViewProjection(void);
+	/*
+	USAGE: Merges the buffers of all threads (prefix sum of their counts gives each one
+	its offset in the merged list), removes the occluded commands, writes the rest to a list
+	for the render thread and resets the buffers; meshes with their texture in the atlas are
+	swapped for the copy using the page material; the recorded models go to their own list
+	ARGUMENTS:
+	-	std::vector<MyRenderCommand>& a_commandList -> gets the commands, keeps its memory
+	-	std::vector<MyModelCommand>& a_modelList -> gets the models, keeps its memory
+	OUTPUT: number of commands written
+	*/
+	uint Flush(std::vector<MyRenderCommand>& a_commandList, std::vector<MyModelCommand>& a_modelList);
+	/*
+	USAGE: Adds a list of commands and a list of models to the render list of the MeshManager, needs to
+	be called from the thread with the context
+	ARGUMENTS:
+	-	std::vector<MyRenderCommand> const& a_commandList -> commands to submit
+	-	std::vector<MyModelCommand> const& a_modelList -> models to submit
+	OUTPUT: ---
+	*/
+	void Submit(std::vector<MyRenderCommand> const& a_commandList, std::vector<MyModelCommand> const& a_modelList);
+	/*
+	USAGE: Gets the number of commands written on the last Flush call
+	ARGUMENTS: ---
+	OUTPUT: command count
+	*/
+	uint GetCommandCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyRenderQueue(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyRenderQueue(MyRenderQueue const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyRenderQueue& operator=(MyRenderQueue const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyRenderQueue(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton, generates meshes so it needs an OpenGL context
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Packs a color into a key
+	ARGUMENTS: vector3 a_v3Color -> color to pack
+	OUTPUT: packed color
+	*/
+	uint PackColor(vector3 a_v3Color);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYRENDERQUEUE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
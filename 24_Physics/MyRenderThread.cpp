@@ -0,0 +1,215 @@
+#include "MyRenderThread.h"
+using namespace Simplex;
+//  MyRenderThread
+Simplex::MyRenderThread* Simplex::MyRenderThread::m_pInstance = nullptr;
+void Simplex::MyRenderThread::Init(void)
+{
+	m_uWrite = 0;
+	m_uRead = 1;
+	m_uReady = 2;
+	m_uFrameCount = 0;
+	m_bRunning = false;
+	m_uTaskCount = 0;
+	m_uTaskDone = 0;
+	m_fSimulationTime = 0.0f;
+	m_fRenderTime = 0.0f;
+	m_fPresentTime = 0.0f;
+	m_fFrameTime = 0.0f;
+	m_uDrawCount = 0;
+	m_uRenderedCount = 0;
+	m_uDroppedCount = 0;
+	m_simulationStart = std::chrono::high_resolution_clock::now();
+
+	//the render thread draws with a camera of its own so the simulation can keep moving the active one,
+	//adding it does not change which one is active
+	CameraManager* pCameraMngr = CameraManager::GetInstance();
+	m_uSimulationCamera = pCameraMngr->GetActiveCamera();
+	m_uCamera = pCameraMngr->AddCamera(vector3(0.0f, 0.0f, 5.0f), ZERO_V3, AXIS_Y);
+	pCameraMngr->SetActiveCamera(m_uSimulationCamera);
+}
+void Simplex::MyRenderThread::Release(void)
+{
+	Stop();
+	m_job = nullptr;
+	m_pWindow = nullptr;
+	m_taskList.clear();
+	m_runList.clear();
+}
+Simplex::MyRenderThread* Simplex::MyRenderThread::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyRenderThread();
+	}
+	return m_pInstance;
+}
+void Simplex::MyRenderThread::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyRenderThread::MyRenderThread() { Init(); }
+Simplex::MyRenderThread::MyRenderThread(MyRenderThread const& other) { }
+Simplex::MyRenderThread& Simplex::MyRenderThread::operator=(MyRenderThread const& other) { return *this; }
+Simplex::MyRenderThread::~MyRenderThread() { Release(); }
+//Accessors
+bool Simplex::MyRenderThread::IsRunning(void) { return m_bRunning; }
+Simplex::MyFrameSnapshot* Simplex::MyRenderThread::GetWriteFrame(void) { return &m_frame[m_uWrite]; }
+Simplex::uint Simplex::MyRenderThread::GetCamera(void) { return m_uCamera; }
+float Simplex::MyRenderThread::GetSimulationTime(void) { return m_fSimulationTime; }
+float Simplex::MyRenderThread::GetRenderTime(void) { return m_fRenderTime; }
+float Simplex::MyRenderThread::GetPresentTime(void) { return m_fPresentTime; }
+float Simplex::MyRenderThread::GetFrameTime(void) { return m_fFrameTime; }
+Simplex::uint Simplex::MyRenderThread::GetDrawCount(void) { return m_uDrawCount; }
+Simplex::uint Simplex::MyRenderThread::GetRenderedCount(void) { return m_uRenderedCount; }
+Simplex::uint Simplex::MyRenderThread::GetDroppedCount(void) { return m_uDroppedCount; }
+//Thread
+void Simplex::MyRenderThread::Start(sf::Window* a_pWindow, RenderJob a_job)
+{
+	if (m_bRunning)
+		return;
+
+	m_pWindow = a_pWindow;
+	m_job = a_job;
+
+	//from now on the MeshManager draws with the camera of the render thread
+	CameraManager* pCameraMngr = CameraManager::GetInstance();
+	m_uSimulationCamera = pCameraMngr->GetActiveCamera();
+	pCameraMngr->SetActiveCamera(m_uCamera);
+
+	//a context can only be active in one thread, the render thread takes it when it starts
+	m_pWindow->setActive(false);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_bRunning = true;
+	m_thread = std::thread(&MyRenderThread::Run, this);
+	m_renderID = m_thread.get_id();
+}
+void Simplex::MyRenderThread::Stop(void)
+{
+	if (!m_bRunning)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bRunning = false;
+	}
+	m_wakeCondition.notify_one();
+	m_thread.join();
+
+	//the context comes back so the singletons can release their objects, tasks that came late run here
+	m_pWindow->setActive(true);
+	RunTasks();
+	CameraManager::GetInstance()->SetActiveCamera(m_uSimulationCamera);
+}
+void Simplex::MyRenderThread::Run(void)
+{
+	//wait for Start to be done with the members
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+	}
+	m_pWindow->setActive(true);
+
+	CameraManager* pCameraMngr = CameraManager::GetInstance();
+	std::chrono::high_resolution_clock::time_point lastPresent = std::chrono::high_resolution_clock::now();
+	while (true)
+	{
+		//sleep until there is a new snapshot, a task or we are asked to stop
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeCondition.wait(lock, [this] { return !m_bRunning || m_taskList.size() > 0 || (m_uReady & m_uFresh) != 0; });
+		}
+		RunTasks();
+		if (!m_bRunning)
+			break;
+		if ((m_uReady & m_uFresh) == 0)
+			continue;
+
+		//take the latest snapshot and give back the one drawn last, it is never the one being written
+		m_uRead = m_uReady.exchange(m_uRead) & ~m_uFresh;
+		MyFrameSnapshot& frame = m_frame[m_uRead];
+
+		//our camera looks through the simulation camera of the snapshot
+		pCameraMngr->SetPosition(frame.m_v3CameraPosition, m_uCamera);
+		pCameraMngr->SetViewMatrix(frame.m_m4View, m_uCamera);
+		pCameraMngr->SetProjectionMatrix(frame.m_m4Projection, m_uCamera);
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		m_uDrawCount = m_job(frame);
+		std::chrono::high_resolution_clock::time_point drawn = std::chrono::high_resolution_clock::now();
+		m_pWindow->display();
+		std::chrono::high_resolution_clock::time_point presented = std::chrono::high_resolution_clock::now();
+
+		m_fRenderTime = std::chrono::duration<float, std::milli>(drawn - start).count();
+		m_fPresentTime = std::chrono::duration<float, std::milli>(presented - drawn).count();
+		m_fFrameTime = std::chrono::duration<float, std::milli>(presented - lastPresent).count();
+		lastPresent = presented;
+		++m_uRenderedCount;
+	}
+
+	m_pWindow->setActive(false);
+}
+void Simplex::MyRenderThread::RunTasks(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_taskList.size() == 0)
+			return;
+		std::swap(m_taskList, m_runList);
+	}
+
+	//they run in the order they were queued, so the done count tells each thread if its task ran
+	for (uint i = 0; i < m_runList.size(); ++i)
+	{
+		(*m_runList[i])();
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_uTaskDone += m_runList.size();
+	}
+	m_runList.clear();
+	m_doneCondition.notify_all();
+}
+void Simplex::MyRenderThread::Invoke(Task a_task)
+{
+	if (!m_bRunning || std::this_thread::get_id() == m_renderID)
+	{
+		a_task();
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_taskList.push_back(&a_task);
+	uint uTicket = ++m_uTaskCount;
+	m_wakeCondition.notify_one();
+	m_doneCondition.wait(lock, [this, uTicket] { return m_uTaskDone >= uTicket; });
+}
+//Snapshots
+Simplex::MyFrameSnapshot* Simplex::MyRenderThread::BeginFrame(void)
+{
+	m_simulationStart = std::chrono::high_resolution_clock::now();
+	return &m_frame[m_uWrite];
+}
+void Simplex::MyRenderThread::Publish(void)
+{
+	m_frame[m_uWrite].m_uFrame = ++m_uFrameCount;
+
+	//the written slot becomes the ready one and the old ready one is written next, if the render thread
+	//did not take it the simulation was faster and that snapshot is never drawn
+	uint uLast = m_uReady.exchange(m_uWrite | m_uFresh);
+	if ((uLast & m_uFresh) != 0)
+		++m_uDroppedCount;
+	m_uWrite = uLast & ~m_uFresh;
+
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	m_fSimulationTime = std::chrono::duration<float, std::milli>(end - m_simulationStart).count();
+
+	//the lock makes sure the render thread is either asleep or has not checked for the snapshot yet
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+	}
+	m_wakeCondition.notify_one();
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYRENDERTHREAD_H_
+#define __MYRENDERTHREAD_H_
+
+#include "MyRenderQueue.h"
+#include "MyDebugDraw.h"
+#include "MyText.h"
+#include "MyLightClusters.h"
+#include "MyParticleSystem.h"
+#include "SFML\Window.hpp"
+#include <chrono>
+
+namespace Simplex
+{
+
+//Input of the GUI, kept by the simulation (that gets the events) and copied into each snapshot
+struct MyGUIInput
+{
+	vector2 m_v2Mouse = vector2(0.0f); //position of the mouse in the window
+	bool m_bMouseDown[3] = { false, false, false }; //left, right and middle buttons
+	float m_fMouseWheel = 0.0f; //scroll since the last snapshot
+	bool m_bKeyDown[512] = {}; //state of each key, indexed by its SFML code
+	bool m_bControl = false; //is control pressed?
+	bool m_bShift = false; //is shift pressed?
+	uint m_uCharacterCount = 0; //characters typed since the last snapshot
+	unsigned short m_character[16]; //characters typed, the ones past the array are lost
+};
+
+//Everything the render thread needs to draw a frame; the simulation writes it and does not touch it
+//again until it comes back to it two snapshots later, the lists keep their memory from frame to frame
+struct MyFrameSnapshot
+{
+	uint m_uFrame = 0; //simulation frame that wrote it
+	uint m_uWidth = 0; //size of the window
+	uint m_uHeight = 0;
+	vector4 m_v4ClearColor = vector4(0.0f); //color of the background
+	matrix4 m_m4View = IDENTITY_M4; //view matrix of the simulation camera
+	matrix4 m_m4Projection = IDENTITY_M4; //projection matrix of the simulation camera
+	vector3 m_v3CameraPosition = ZERO_V3; //position of the simulation camera
+	std::vector<MyRenderCommand> m_commandList; //instances to draw, the transform of each mesh instance
+	std::vector<MyModelCommand> m_modelList; //models to draw whole, the ones that do not know their meshes
+	std::vector<MyDebugVertex> m_depthLineList; //debug lines hidden behind geometry
+	std::vector<MyDebugVertex> m_overlayLineList; //debug lines drawn on top of everything
+	std::vector<MyParticleInstance> m_particleList; //particles to draw
+	MyLightFrame m_light; //point lights binned into the clusters of the camera
+	MyTextFrame m_text; //lines of text printed
+	MyGUIInput m_gui; //input of the GUI
+};
+
+//System Class, the render thread owns the OpenGL context and draws the latest snapshot the simulation
+//published; the snapshots go through a triple buffer so neither side ever waits for the other
+class MyRenderThread
+{
+public:
+	typedef std::function<uint(MyFrameSnapshot const& a_frame)> RenderJob; //draws a snapshot, returns the draw calls
+	typedef std::function<void(void)> Task; //work that needs the OpenGL context
+
+private:
+	static const uint m_uFresh = 4; //flag of the ready slot, set when the render thread did not take it yet
+
+	MyFrameSnapshot m_frame[3]; //snapshots being written, ready and being drawn
+	uint m_uWrite = 0; //slot the simulation writes (only the simulation touches it)
+	uint m_uRead = 1; //slot the render thread draws (only the render thread touches it)
+	std::atomic<uint> m_uReady; //slot last published, the fresh flag tells if it is new
+	uint m_uFrameCount = 0; //snapshots published
+
+	sf::Window* m_pWindow = nullptr; //window whose context the render thread owns
+	RenderJob m_job; //draws each snapshot
+	std::thread m_thread; //render thread
+	std::thread::id m_renderID; //identifier of the render thread
+	std::atomic<bool> m_bRunning; //is the render thread running?
+
+	std::mutex m_mutex; //guards the task list and the sleep of the render thread
+	std::condition_variable m_wakeCondition; //wakes the render thread on a new snapshot, a task or the stop
+	std::condition_variable m_doneCondition; //wakes the threads waiting for their task
+	std::vector<Task*> m_taskList; //tasks waiting for the render thread
+	std::vector<Task*> m_runList; //tasks being run (swapped with the list so it does not allocate)
+	uint m_uTaskCount = 0; //tasks queued so far, the count when a task is queued is its ticket
+	uint m_uTaskDone = 0; //tasks run so far, a waiting thread knows its task ran when this passes its ticket
+
+	uint m_uCamera = 0; //camera of the CameraManager the render thread sets from each snapshot
+	uint m_uSimulationCamera = 0; //camera that was active when the render thread started
+
+	std::chrono::high_resolution_clock::time_point m_simulationStart; //start of the frame being written
+	std::atomic<float> m_fSimulationTime; //milliseconds of the last simulation frame
+	std::atomic<float> m_fRenderTime; //milliseconds the last snapshot took to draw (without the present)
+	std::atomic<float> m_fPresentTime; //milliseconds the last present took
+	std::atomic<float> m_fFrameTime; //milliseconds between the last two presents
+	std::atomic<uint> m_uDrawCount; //draw calls of the last snapshot
+	std::atomic<uint> m_uRenderedCount; //snapshots drawn
+	uint m_uDroppedCount = 0; //snapshots replaced before the render thread took them
+
+	static MyRenderThread* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyRenderThread* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Starts the render thread, the context of the window goes with it and its camera becomes
+	the active one of the CameraManager
+	ARGUMENTS:
+	-	sf::Window* a_pWindow -> window to draw in and present
+	-	RenderJob a_job -> draws a snapshot (the render thread presents it afterwards)
+	OUTPUT: ---
+	*/
+	void Start(sf::Window* a_pWindow, RenderJob a_job);
+	/*
+	USAGE: Stops the render thread after the snapshot it is drawing, the context comes back to the calling
+	thread and so does the active camera
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Stop(void);
+	/*
+	USAGE: Asks if the render thread is running
+	ARGUMENTS: ---
+	OUTPUT: is it running?
+	*/
+	bool IsRunning(void);
+	/*
+	USAGE: Starts a simulation frame, its time is measured until the snapshot is published
+	ARGUMENTS: ---
+	OUTPUT: snapshot to write, it belongs to the simulation until Publish
+	*/
+	MyFrameSnapshot* BeginFrame(void);
+	/*
+	USAGE: Gets the snapshot being written
+	ARGUMENTS: ---
+	OUTPUT: snapshot
+	*/
+	MyFrameSnapshot* GetWriteFrame(void);
+	/*
+	USAGE: Hands the snapshot being written to the render thread, if it did not take the previous one yet
+	that one is dropped; the simulation gets a free snapshot back without waiting
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Publish(void);
+	/*
+	USAGE: Runs work that needs the OpenGL context (creating meshes or textures) on the render thread between
+	two snapshots and waits for it; it runs right away if the render thread is not running or is the caller
+	ARGUMENTS: Task a_task -> work to run
+	OUTPUT: ---
+	*/
+	void Invoke(Task a_task);
+	/*
+	USAGE: Gets the camera the render thread draws with
+	ARGUMENTS: ---
+	OUTPUT: index of the camera in the CameraManager
+	*/
+	uint GetCamera(void);
+	/*
+	USAGE: Gets the milliseconds the last simulation frame took
+	ARGUMENTS: ---
+	OUTPUT: simulation time
+	*/
+	float GetSimulationTime(void);
+	/*
+	USAGE: Gets the milliseconds the render thread took to draw the last snapshot, without the present
+	ARGUMENTS: ---
+	OUTPUT: render time
+	*/
+	float GetRenderTime(void);
+	/*
+	USAGE: Gets the milliseconds the last present took (waiting for the vertical sync included)
+	ARGUMENTS: ---
+	OUTPUT: present time
+	*/
+	float GetPresentTime(void);
+	/*
+	USAGE: Gets the milliseconds between the last two presents
+	ARGUMENTS: ---
+	OUTPUT: frame time
+	*/
+	float GetFrameTime(void);
+	/*
+	USAGE: Gets the draw calls of the last snapshot drawn
+	ARGUMENTS: ---
+	OUTPUT: draw call count
+	*/
+	uint GetDrawCount(void);
+	/*
+	USAGE: Gets the number of snapshots drawn
+	ARGUMENTS: ---
+	OUTPUT: rendered count
+	*/
+	uint GetRenderedCount(void);
+	/*
+	USAGE: Gets the number of snapshots the simulation replaced before the render thread took them
+	ARGUMENTS: ---
+	OUTPUT: dropped count
+	*/
+	uint GetDroppedCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyRenderThread(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyRenderThread(MyRenderThread const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyRenderThread& operator=(MyRenderThread const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyRenderThread(void);
+	/*
+	Usage: stops the thread and releases the snapshots
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton, adds the camera of the render thread
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Loop of the render thread, sleeps until there is a new snapshot or a task
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Run(void);
+	/*
+	USAGE: Runs the tasks waiting for the render thread and wakes their threads
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void RunTasks(void);
+};
+
+} //namespace Simplex
+
+#endif //__MYRENDERTHREAD_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -13,6 +13,13 @@ void MyRigidBody::Init(void)
 	m_v3ColorColliding = C_RED;
 	m_v3ColorNotColliding = C_WHITE;
 
+	//the shapes are generated once and shared by all rigid bodies
+	MyRenderQueue* pRenderQueue = MyRenderQueue::GetInstance();
+	m_nMeshColliding = pRenderQueue->GetWireCube(m_v3ColorColliding);
+	m_nMeshNotColliding = pRenderQueue->GetWireCube(m_v3ColorNotColliding);
+	m_nMeshARBB = pRenderQueue->GetWireCube(C_YELLOW);
+	m_nMeshBS = pRenderQueue->GetWireSphere(C_BLUE_CORNFLOWER);
+
 	m_v3CenterL = ZERO_V3;
 	m_v3CenterG = ZERO_V3;
 	m_v3MinL = ZERO_V3;
@@ -26,6 +33,13 @@ void MyRigidBody::Init(void)
 
 	m_m4ToWorld = IDENTITY_M4;
 
+	m_v3AxisG[0] = AXIS_X;
+	m_v3AxisG[1] = AXIS_Y;
+	m_v3AxisG[2] = AXIS_Z;
+	m_v3HalfWidthG = ZERO_V3;
+
+	m_pConvexHull = nullptr;
+
 	m_uCollidingCount = 0;
 	m_CollidingArray = nullptr;
 }
@@ -41,6 +55,11 @@ void MyRigidBody::Swap(MyRigidBody& other)
 	std::swap(m_v3ColorColliding, other.m_v3ColorColliding);
 	std::swap(m_v3ColorNotColliding, other.m_v3ColorNotColliding);
 
+	std::swap(m_nMeshColliding, other.m_nMeshColliding);
+	std::swap(m_nMeshNotColliding, other.m_nMeshNotColliding);
+	std::swap(m_nMeshARBB, other.m_nMeshARBB);
+	std::swap(m_nMeshBS, other.m_nMeshBS);
+
 	std::swap(m_v3CenterL, other.m_v3CenterL);
 	std::swap(m_v3CenterG, other.m_v3CenterG);
 	std::swap(m_v3MinL, other.m_v3MinL);
@@ -54,6 +73,11 @@ void MyRigidBody::Swap(MyRigidBody& other)
 
 	std::swap(m_m4ToWorld, other.m_m4ToWorld);
 
+	std::swap(m_v3AxisG, other.m_v3AxisG);
+	std::swap(m_v3HalfWidthG, other.m_v3HalfWidthG);
+
+	std::swap(m_pConvexHull, other.m_pConvexHull);
+
 	std::swap(m_uCollidingCount, other.m_uCollidingCount);
 	std::swap(m_CollidingArray, other.m_CollidingArray);
 }
@@ -72,8 +96,16 @@ void MyRigidBody::SetVisibleARBB(bool a_bVisible) { m_bVisibleARBB = a_bVisible;
 float MyRigidBody::GetRadius(void) { return m_fRadius; }
 vector3 MyRigidBody::GetColorColliding(void) { return m_v3ColorColliding; }
 vector3 MyRigidBody::GetColorNotColliding(void) { return m_v3ColorNotColliding; }
-void MyRigidBody::SetColorColliding(vector3 a_v3Color) { m_v3ColorColliding = a_v3Color; }
-void MyRigidBody::SetColorNotColliding(vector3 a_v3Color) { m_v3ColorNotColliding = a_v3Color; }
+void MyRigidBody::SetColorColliding(vector3 a_v3Color)
+{
+	m_v3ColorColliding = a_v3Color;
+	m_nMeshColliding = MyRenderQueue::GetInstance()->GetWireCube(m_v3ColorColliding);
+}
+void MyRigidBody::SetColorNotColliding(vector3 a_v3Color)
+{
+	m_v3ColorNotColliding = a_v3Color;
+	m_nMeshNotColliding = MyRenderQueue::GetInstance()->GetWireCube(m_v3ColorNotColliding);
+}
 vector3 MyRigidBody::GetCenterLocal(void) { return m_v3CenterL; }
 vector3 MyRigidBody::GetMinLocal(void) { return m_v3MinL; }
 vector3 MyRigidBody::GetMaxLocal(void) { return m_v3MaxL; }
@@ -81,6 +113,10 @@ vector3 MyRigidBody::GetCenterGlobal(void){ return m_v3CenterG; }
 vector3 MyRigidBody::GetMinGlobal(void) { return m_v3MinG; }
 vector3 MyRigidBody::GetMaxGlobal(void) { return m_v3MaxG; }
 vector3 MyRigidBody::GetHalfWidth(void) { return m_v3HalfWidth; }
+vector3 MyRigidBody::GetHalfWidthGlobal(void) { return m_v3HalfWidthG; }
+vector3 MyRigidBody::GetAxisGlobal(uint a_uAxis) { return m_v3AxisG[a_uAxis % 3]; }
+MyConvexHull* MyRigidBody::GetConvexHull(void) { return m_pConvexHull; }
+void MyRigidBody::SetConvexHull(MyConvexHull* a_pConvexHull) { m_pConvexHull = a_pConvexHull; }
 matrix4 MyRigidBody::GetModelMatrix(void) { return m_m4ToWorld; }
 MyRigidBody::PRigidBody* MyRigidBody::GetColliderArray(void) { return m_CollidingArray; }
 uint MyRigidBody::GetCollidingCount(void) { return m_uCollidingCount; }
@@ -95,6 +131,16 @@ void MyRigidBody::SetModelMatrix(matrix4 a_m4ModelMatrix)
 
 	m_v3CenterG = vector3(m_m4ToWorld * vector4(m_v3CenterL, 1.0f));
 
+	//the OBB only changes with the transform, the SAT uses it as is
+	for (uint i = 0; i < 3; ++i)
+	{
+		vector3 v3Axis = vector3(m_m4ToWorld[i]);
+		float fScale = glm::length(v3Axis);
+		if (fScale > FLT_EPSILON)
+			m_v3AxisG[i] = v3Axis / fScale;
+		m_v3HalfWidthG[i] = m_v3HalfWidth[i] * fScale;
+	}
+
 	//Calculate the 8 corners of the cube
 	vector3 v3Corner[8];
 	//Back square
@@ -167,9 +213,12 @@ MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
 
 	//with the max and the min we calculate the center
 	m_v3CenterL = (m_v3MaxL + m_v3MinL) / 2.0f;
+	m_v3CenterG = m_v3CenterL;
 
 	//we calculate the distance between min and max vectors
 	m_v3HalfWidth = (m_v3MaxL - m_v3MinL) / 2.0f;
+	m_v3HalfWidthG = m_v3HalfWidth;
+	m_v3ARBBSize = m_v3MaxG - m_v3MinG;
 
 	//Get the distance between the center and either the min or the max
 	m_fRadius = glm::distance(m_v3CenterL, m_v3MinL);
@@ -187,6 +236,11 @@ MyRigidBody::MyRigidBody(MyRigidBody const& other)
 	m_v3ColorColliding = other.m_v3ColorColliding;
 	m_v3ColorNotColliding = other.m_v3ColorNotColliding;
 
+	m_nMeshColliding = other.m_nMeshColliding;
+	m_nMeshNotColliding = other.m_nMeshNotColliding;
+	m_nMeshARBB = other.m_nMeshARBB;
+	m_nMeshBS = other.m_nMeshBS;
+
 	m_v3CenterL = other.m_v3CenterL;
 	m_v3CenterG = other.m_v3CenterG;
 	m_v3MinL = other.m_v3MinL;
@@ -200,6 +254,12 @@ MyRigidBody::MyRigidBody(MyRigidBody const& other)
 
 	m_m4ToWorld = other.m_m4ToWorld;
 
+	for (uint i = 0; i < 3; ++i)
+		m_v3AxisG[i] = other.m_v3AxisG[i];
+	m_v3HalfWidthG = other.m_v3HalfWidthG;
+
+	m_pConvexHull = other.m_pConvexHull;
+
 	m_uCollidingCount = other.m_uCollidingCount;
 	m_CollidingArray = other.m_CollidingArray;
 }
@@ -277,49 +337,234 @@ void MyRigidBody::ClearCollidingList(void)
 		m_CollidingArray = nullptr;
 	}
 }
-uint MyRigidBody::SAT(MyRigidBody* const a_pOther)
+uint MyRigidBody::SAT(MyRigidBody* const a_pOther, uint a_uFirstAxis)
 {
+	//the OBBs are cached in global space, everything is expressed in the frame of this one
+	const vector3* a = m_v3AxisG;
+	const vector3* b = a_pOther->m_v3AxisG;
+	vector3 ea = m_v3HalfWidthG;
+	vector3 eb = a_pOther->m_v3HalfWidthG;
+
+	//rotation of the other OBB into this frame, epsilon keeps parallel edges from giving zero axes
+	float R[3][3];
+	float AbsR[3][3];
+	for (uint i = 0; i < 3; ++i)
+	{
+		for (uint j = 0; j < 3; ++j)
+		{
+			R[i][j] = glm::dot(a[i], b[j]);
+			AbsR[i][j] = glm::abs(R[i][j]) + FLT_EPSILON;
+		}
+	}
+
+	//translation between centers in this frame
+	vector3 v3Distance = a_pOther->m_v3CenterG - m_v3CenterG;
+	float t[3] = { glm::dot(v3Distance, a[0]), glm::dot(v3Distance, a[1]), glm::dot(v3Distance, a[2]) };
+
+	//the axis that separated the pair the last time is tested first, usually it still does
+	bool bFirstAxis = a_uFirstAxis > SAT_NONE && a_uFirstAxis <= SAT_AZxBZ;
+	for (uint uTest = 0; uTest < 15; ++uTest)
+	{
+		uint uAxis = uTest + 1;
+		if (bFirstAxis)
+		{
+			if (uTest == 0)
+				uAxis = a_uFirstAxis;
+			else if (uTest < a_uFirstAxis)
+				uAxis = uTest;
+		}
+
+		float ra, rb, fDistance;
+		switch (uAxis)
+		{
+		case SAT_AX: case SAT_AY: case SAT_AZ:
+		{
+			uint i = uAxis - SAT_AX;
+			ra = ea[i];
+			rb = eb[0] * AbsR[i][0] + eb[1] * AbsR[i][1] + eb[2] * AbsR[i][2];
+			fDistance = t[i];
+			break;
+		}
+		case SAT_BX: case SAT_BY: case SAT_BZ:
+		{
+			uint j = uAxis - SAT_BX;
+			ra = ea[0] * AbsR[0][j] + ea[1] * AbsR[1][j] + ea[2] * AbsR[2][j];
+			rb = eb[j];
+			fDistance = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+			break;
+		}
+		default:
+		{
+			//cross products, i is the axis of this one and j the axis of the other one
+			uint i = (uAxis - SAT_AXxBX) / 3;
+			uint j = (uAxis - SAT_AXxBX) % 3;
+			uint i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+			uint j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+			ra = ea[i1] * AbsR[i2][j] + ea[i2] * AbsR[i1][j];
+			rb = eb[j1] * AbsR[i][j2] + eb[j2] * AbsR[i][j1];
+			fDistance = t[i2] * R[i1][j] - t[i1] * R[i2][j];
+			break;
+		}
+		}
+
+		if (glm::abs(fDistance) > ra + rb)
+			return uAxis;
+	}
+
 	// Since no separating axis found, the OBBs must be intersecting
-	/*
-	This is not complete as this is the solution of an assignment
-	*/
-	return 0;
+	return SAT_NONE;
 }
-bool MyRigidBody::IsColliding(MyRigidBody* const other)
+bool MyRigidBody::IsCollidingOBB(MyRigidBody* const a_pOther, uint& a_uSeparatingAxis)
 {
-	//check if spheres are colliding
-	bool bColliding = true;
-	//bColliding = (glm::distance(GetCenterGlobal(), other->GetCenterGlobal()) < m_fRadius + other->m_fRadius);
-	//if they are check the Axis Aligned Bounding Box
-	if (bColliding) //they are colliding with bounding sphere
+	//the Axis (Re)Aligned Bounding Boxes are cheaper, if they do not overlap the OBBs do not either
+	if (this->m_v3MaxG.x < a_pOther->m_v3MinG.x || this->m_v3MinG.x > a_pOther->m_v3MaxG.x)
+		return false;
+	if (this->m_v3MaxG.y < a_pOther->m_v3MinG.y || this->m_v3MinG.y > a_pOther->m_v3MaxG.y)
+		return false;
+	if (this->m_v3MaxG.z < a_pOther->m_v3MinG.z || this->m_v3MinG.z > a_pOther->m_v3MaxG.z)
+		return false;
+
+	a_uSeparatingAxis = SAT(a_pOther, a_uSeparatingAxis);
+	return a_uSeparatingAxis == SAT_NONE;
+}
+uint MyRigidBody::GetSupport(vector3 a_v3Direction, vector3& a_v3Point)
+{
+	uint uIndex = 0;
+	if (m_pConvexHull)
 	{
-		if (this->m_v3MaxG.x < other->m_v3MinG.x) //this to the right of other
-			bColliding = false;
-		if (this->m_v3MinG.x > other->m_v3MaxG.x) //this to the left of other
-			bColliding = false;
-
-		if (this->m_v3MaxG.y < other->m_v3MinG.y) //this below of other
-			bColliding = false;
-		if (this->m_v3MinG.y > other->m_v3MaxG.y) //this above of other
-			bColliding = false;
-
-		if (this->m_v3MaxG.z < other->m_v3MinG.z) //this behind of other
-			bColliding = false;
-		if (this->m_v3MinG.z > other->m_v3MaxG.z) //this in front of other
-			bColliding = false;
-
-		if (bColliding) //they are colliding with bounding box also
+		//directions are covectors, they go to local space with the transpose
+		vector3 v3Local = glm::transpose(matrix3(m_m4ToWorld)) * a_v3Direction;
+		uIndex = m_pConvexHull->GetSupport(v3Local);
+	}
+	else
+	{
+		//corner of the OBB, one bit per axis telling which side it is on
+		for (uint i = 0; i < 3; ++i)
 		{
-			this->AddCollisionWith(other);
-			other->AddCollisionWith(this);
+			if (glm::dot(m_v3AxisG[i], a_v3Direction) > 0.0f)
+				uIndex |= 1 << i;
 		}
-		else //they are not colliding with bounding box
+	}
+	a_v3Point = GetSupportPoint(uIndex);
+	return uIndex;
+}
+vector3 MyRigidBody::GetSupportPoint(uint a_uIndex)
+{
+	//indices cached before the shape changed could be out of range, they only need to be valid points
+	if (m_pConvexHull)
+		return vector3(m_m4ToWorld * vector4(m_pConvexHull->GetPoint(a_uIndex % m_pConvexHull->GetPointCount()), 1.0f));
+
+	vector3 v3Point = m_v3CenterG;
+	for (uint i = 0; i < 3; ++i)
+	{
+		if (a_uIndex & (1 << i))
+			v3Point += m_v3AxisG[i] * m_v3HalfWidthG[i];
+		else
+			v3Point -= m_v3AxisG[i] * m_v3HalfWidthG[i];
+	}
+	return v3Point;
+}
+bool MyRigidBody::RayCastOBB(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fGrow,
+	float& a_fDistance, vector3& a_v3Normal)
+{
+	//slab test in the frame of the OBB, the normal is the face of the last slab the ray enters
+	vector3 v3Distance = m_v3CenterG - a_v3Origin;
+	float fEnter = 0.0f;
+	float fExit = a_fMaxDistance;
+	int nEnterAxis = -1;
+	float fEnterSign = 1.0f;
+	for (uint i = 0; i < 3; ++i)
+	{
+		float fHalf = m_v3HalfWidthG[i] + a_fGrow;
+		float fCenter = glm::dot(m_v3AxisG[i], v3Distance);
+		float fDirection = glm::dot(m_v3AxisG[i], a_v3Direction);
+		if (glm::abs(fDirection) < FLT_EPSILON)
 		{
-			this->RemoveCollisionWith(other);
-			other->RemoveCollisionWith(this);
+			//parallel to the slab, it needs to start inside of it
+			if (fCenter - fHalf > 0.0f || fCenter + fHalf < 0.0f)
+				return false;
+			continue;
 		}
+		float fT1 = (fCenter - fHalf) / fDirection;
+		float fT2 = (fCenter + fHalf) / fDirection;
+		//the near side faces against the direction
+		float fSign = fDirection > 0.0f ? -1.0f : 1.0f;
+		if (fT1 > fT2)
+			std::swap(fT1, fT2);
+		if (fT1 > fEnter)
+		{
+			fEnter = fT1;
+			nEnterAxis = static_cast<int>(i);
+			fEnterSign = fSign;
+		}
+		if (fT2 < fExit)
+			fExit = fT2;
+		if (fEnter > fExit)
+			return false;
 	}
-	else //they are not colliding with bounding sphere
+
+	a_fDistance = fEnter;
+	a_v3Normal = nEnterAxis < 0 ? -a_v3Direction : m_v3AxisG[nEnterAxis] * fEnterSign;
+	return true;
+}
+vector3 MyRigidBody::GetClosestPointOBB(vector3 a_v3Point)
+{
+	vector3 v3Distance = a_v3Point - m_v3CenterG;
+	vector3 v3Closest = m_v3CenterG;
+	for (uint i = 0; i < 3; ++i)
+	{
+		float fProjection = glm::clamp(glm::dot(v3Distance, m_v3AxisG[i]), -m_v3HalfWidthG[i], m_v3HalfWidthG[i]);
+		v3Closest += m_v3AxisG[i] * fProjection;
+	}
+	return v3Closest;
+}
+bool MyRigidBody::IsOverlappingAABB(vector3 a_v3Min, vector3 a_v3Max)
+{
+	//the ARBB is cheaper, if it does not overlap the OBB does not either
+	if (m_v3MaxG.x < a_v3Min.x || m_v3MinG.x > a_v3Max.x)
+		return false;
+	if (m_v3MaxG.y < a_v3Min.y || m_v3MinG.y > a_v3Max.y)
+		return false;
+	if (m_v3MaxG.z < a_v3Min.z || m_v3MinG.z > a_v3Max.z)
+		return false;
+
+	//the world axes were just tested, what is left are the axes of the OBB and the cross products
+	vector3 v3HalfBox = (a_v3Max - a_v3Min) * 0.5f;
+	vector3 v3Distance = m_v3CenterG - (a_v3Max + a_v3Min) * 0.5f;
+	vector3 v3Axis[12];
+	for (uint i = 0; i < 3; ++i)
+	{
+		v3Axis[i] = m_v3AxisG[i];
+		v3Axis[3 + i * 3 + 0] = glm::cross(m_v3AxisG[i], AXIS_X);
+		v3Axis[3 + i * 3 + 1] = glm::cross(m_v3AxisG[i], AXIS_Y);
+		v3Axis[3 + i * 3 + 2] = glm::cross(m_v3AxisG[i], AXIS_Z);
+	}
+	for (uint uAxis = 0; uAxis < 12; ++uAxis)
+	{
+		vector3 v3L = v3Axis[uAxis];
+		//parallel edges give no axis
+		if (glm::dot(v3L, v3L) < FLT_EPSILON)
+			continue;
+		float ra = v3HalfBox.x * glm::abs(v3L.x) + v3HalfBox.y * glm::abs(v3L.y) + v3HalfBox.z * glm::abs(v3L.z);
+		float rb = m_v3HalfWidthG.x * glm::abs(glm::dot(v3L, m_v3AxisG[0])) +
+			m_v3HalfWidthG.y * glm::abs(glm::dot(v3L, m_v3AxisG[1])) +
+			m_v3HalfWidthG.z * glm::abs(glm::dot(v3L, m_v3AxisG[2]));
+		if (glm::abs(glm::dot(v3L, v3Distance)) > ra + rb)
+			return false;
+	}
+	return true;
+}
+bool MyRigidBody::IsColliding(MyRigidBody* const other)
+{
+	uint uSeparatingAxis = SAT_NONE;
+	bool bColliding = IsCollidingOBB(other, uSeparatingAxis);
+
+	if (bColliding) //they are colliding with bounding box also
+	{
+		this->AddCollisionWith(other);
+		other->AddCollisionWith(this);
+	}
+	else //they are not colliding with bounding box
 	{
 		this->RemoveCollisionWith(other);
 		other->RemoveCollisionWith(this);
@@ -329,27 +574,50 @@ bool MyRigidBody::IsColliding(MyRigidBody* const other)
 
 void MyRigidBody::AddToRenderList(void)
 {
+#ifdef MYDEBUGDRAW
+	//debug builds batch all the bodies in the line buffer of the debug draw
+	MyDebugDraw* pDebugDraw = MyDebugDraw::GetInstance();
 	if (m_bVisibleBS)
 	{
-		if (m_uCollidingCount > 0)
-			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
-		else
-			m_pMeshMngr->AddWireSphereToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
+		pDebugDraw->AddSphere(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)), C_BLUE_CORNFLOWER);
 	}
 	if (m_bVisibleOBB)
 	{
-		if (m_uCollidingCount > 0)
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorColliding);
-		else
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f), m_v3ColorNotColliding);
+		pDebugDraw->AddBox(glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f),
+			m_uCollidingCount > 0 ? m_v3ColorColliding : m_v3ColorNotColliding);
+		if (m_pConvexHull)
+		{
+			std::vector<uint>& edgeList = m_pConvexHull->GetEdgeList();
+			for (uint i = 0; i < edgeList.size(); i += 2)
+			{
+				pDebugDraw->AddLine(GetSupportPoint(edgeList[i]), GetSupportPoint(edgeList[i + 1]),
+					m_uCollidingCount > 0 ? m_v3ColorColliding : m_v3ColorNotColliding);
+			}
+		}
 	}
 	if (m_bVisibleARBB)
+	{
+		pDebugDraw->AddBox(m_v3MinG, m_v3MaxG, C_YELLOW);
+	}
+#else
+	//record in the buffer of the calling thread, it can be called from any job
+	MyCommandBuffer* pBuffer = MyRenderQueue::GetInstance()->GetBuffer();
+	if (m_bVisibleBS)
+	{
+		pBuffer->Push(m_nMeshBS, RENDER_SOLID, glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(vector3(m_fRadius)));
+	}
+	if (m_bVisibleOBB)
 	{
 		if (m_uCollidingCount > 0)
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize), C_YELLOW);
+			pBuffer->Push(m_nMeshColliding, RENDER_SOLID, glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f));
 		else
-			m_pMeshMngr->AddWireCubeToRenderList(glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize), C_YELLOW);
+			pBuffer->Push(m_nMeshNotColliding, RENDER_SOLID, glm::translate(m_m4ToWorld, m_v3CenterL) * glm::scale(m_v3HalfWidth * 2.0f));
+	}
+	if (m_bVisibleARBB)
+	{
+		pBuffer->Push(m_nMeshARBB, RENDER_SOLID, glm::translate(m_v3CenterG) * glm::scale(m_v3ARBBSize));
 	}
+#endif //MYDEBUGDRAW
 }
 bool MyRigidBody::IsInCollidingArray(MyRigidBody* a_pEntry)
 {
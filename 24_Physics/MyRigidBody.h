@@ -5,7 +5,9 @@ Date: 2017/06
 #ifndef __MYRIGIDBODY_H_
 #define __MYRIGIDBODY_H_
 
-#include "Simplex\Mesh\Model.h"
+#include "MyRenderQueue.h"
+#include "MyDebugDraw.h"
+#include "MyConvexHull.h"
 
 namespace Simplex
 {
@@ -28,6 +30,11 @@ protected:
 	vector3 m_v3ColorColliding = C_RED; //Color when colliding
 	vector3 m_v3ColorNotColliding = C_WHITE; //Color when not colliding
 
+	int m_nMeshColliding = -1; //wire cube mesh used when colliding
+	int m_nMeshNotColliding = -1; //wire cube mesh used when not colliding
+	int m_nMeshARBB = -1; //wire cube mesh used for the ARBB
+	int m_nMeshBS = -1; //wire sphere mesh used for the BS
+
 	vector3 m_v3CenterL = ZERO_V3; //center point in local space
 	vector3 m_v3CenterG = ZERO_V3; //center point in global space
 
@@ -42,6 +49,11 @@ protected:
 
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Matrix that will take us from local to world coordinate
 
+	vector3 m_v3AxisG[3] = { AXIS_X, AXIS_Y, AXIS_Z }; //unit axes of the OBB in global space
+	vector3 m_v3HalfWidthG = ZERO_V3; //half the size of the OBB in global space (scale included)
+
+	MyConvexHull* m_pConvexHull = nullptr; //collision shape instead of the OBB, shared by the model (not owned)
+
 	uint m_uCollidingCount = 0; //size of the colliding set
 	PRigidBody* m_CollidingArray = nullptr; //array of rigid bodies this one is colliding with
 
@@ -111,6 +123,57 @@ public:
 	OUTPUT: are they colliding?
 	*/
 	bool IsColliding(MyRigidBody* const other);
+	/*
+	USAGE: Tests the OBBs of both rigid bodies without marking the collision, safe to call from
+	several threads at the same time
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> inspected rigid body
+	-	uint& a_uSeparatingAxis -> in: axis to test first (eSATResults); out: separating axis found,
+	unchanged if the ARBBs are not overlapping and SAT_NONE if colliding
+	OUTPUT: are they colliding?
+	*/
+	bool IsCollidingOBB(MyRigidBody* const a_pOther, uint& a_uSeparatingAxis);
+	/*
+	USAGE: Gets the point of the collision shape (convex hull, or OBB without one) furthest along a direction
+	ARGUMENTS:
+	-	vector3 a_v3Direction -> direction in global space
+	-	vector3& a_v3Point -> out: support point in global space
+	OUTPUT: index of the support point, see GetSupportPoint
+	*/
+	uint GetSupport(vector3 a_v3Direction, vector3& a_v3Point);
+	/*
+	USAGE: Gets a support point of the collision shape with the current transform
+	ARGUMENTS: uint a_uIndex -> index returned by GetSupport
+	OUTPUT: support point in global space
+	*/
+	vector3 GetSupportPoint(uint a_uIndex);
+	/*
+	USAGE: Casts a ray against the OBB, safe to call from several threads at the same time
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray in global space
+	-	vector3 a_v3Direction -> unit direction of the ray
+	-	float a_fMaxDistance -> length of the ray
+	-	float a_fGrow -> added to the half width on each axis (0 for the OBB itself)
+	-	float& a_fDistance -> out: distance to the hit, 0 if the ray starts inside
+	-	vector3& a_v3Normal -> out: normal of the face hit, the opposite of the direction if it starts inside
+	OUTPUT: was the OBB hit?
+	*/
+	bool RayCastOBB(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fGrow,
+		float& a_fDistance, vector3& a_v3Normal);
+	/*
+	USAGE: Gets the point of the OBB closest to a point
+	ARGUMENTS: vector3 a_v3Point -> point in global space
+	OUTPUT: closest point in global space, the point itself if it is inside
+	*/
+	vector3 GetClosestPointOBB(vector3 a_v3Point);
+	/*
+	USAGE: Tests the OBB against an axis aligned box with the 15 axes of the SAT
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner of the box
+	-	vector3 a_v3Max -> maximum corner of the box
+	OUTPUT: do they overlap?
+	*/
+	bool IsOverlappingAABB(vector3 a_v3Min, vector3 a_v3Max);
 #pragma region Accessors
 	/*
 	Usage: Gets visibility of bounding sphere
@@ -221,6 +284,30 @@ public:
 	*/
 	vector3 GetHalfWidth(void);
 	/*
+	Usage: Gets the size of the OBB divided by 2 in global space
+	Arguments: ---
+	Output: halfwidth vector
+	*/
+	vector3 GetHalfWidthGlobal(void);
+	/*
+	Usage: Gets an axis of the OBB in global space
+	Arguments: uint a_uAxis -> 0 for x, 1 for y and 2 for z
+	Output: unit axis
+	*/
+	vector3 GetAxisGlobal(uint a_uAxis);
+	/*
+	Usage: Gets the convex hull used as collision shape
+	Arguments: ---
+	Output: convex hull, nullptr if it uses the OBB
+	*/
+	MyConvexHull* GetConvexHull(void);
+	/*
+	Usage: Sets the convex hull used as collision shape, the rigid body does not own it
+	Arguments: MyConvexHull* a_pConvexHull -> convex hull, nullptr to use the OBB
+	Output: ---
+	*/
+	void SetConvexHull(MyConvexHull* a_pConvexHull);
+	/*
 	Usage: Gets Model to World matrix
 	Arguments: ---
 	Output: model to world matrix
@@ -267,10 +354,12 @@ private:
 	void Init(void);
 	/*
 	USAGE: This will apply the Separation Axis Test
-	ARGUMENTS: MyRigidBody* const a_pOther -> other rigid body to test against
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> other rigid body to test against
+	-	uint a_uFirstAxis = SAT_NONE -> axis to test before the others (usually the last one that separated them)
 	OUTPUT: 0 for colliding, all other first axis that succeeds test
 	*/
-	uint SAT(MyRigidBody* const a_pOther);
+	uint SAT(MyRigidBody* const a_pOther, uint a_uFirstAxis = SAT_NONE);
 };//class
 
 } //namespace Simplex
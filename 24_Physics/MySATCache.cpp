@@ -0,0 +1,140 @@
+#include "MySATCache.h"
+using namespace Simplex;
+//do the Axis (Re)Aligned Bounding Boxes overlap?
+static bool Overlap(MyRigidBody* a_pA, MyRigidBody* a_pB)
+{
+	vector3 v3MinA = a_pA->GetMinGlobal(), v3MaxA = a_pA->GetMaxGlobal();
+	vector3 v3MinB = a_pB->GetMinGlobal(), v3MaxB = a_pB->GetMaxGlobal();
+	return v3MaxA.x >= v3MinB.x && v3MinA.x <= v3MaxB.x &&
+		v3MaxA.y >= v3MinB.y && v3MinA.y <= v3MaxB.y &&
+		v3MaxA.z >= v3MinB.z && v3MinA.z <= v3MaxB.z;
+}
+//  MySATCache
+Simplex::MySATCache::MySATCache(void) { }
+Simplex::MySATCache::MySATCache(MySATCache const& other) { }
+Simplex::MySATCache& Simplex::MySATCache::operator=(MySATCache const& other) { return *this; }
+Simplex::MySATCache::~MySATCache(void) { Clear(); }
+//Accessors
+Simplex::uint Simplex::MySATCache::GetSeparatedCount(void) { return m_uSeparatedCount; }
+Simplex::uint Simplex::MySATCache::GetFirstAxisCount(void) { return m_uFirstAxisCount; }
+Simplex::uint Simplex::MySATCache::GetGJKCount(void) { return m_uGJKCount; }
+Simplex::uint Simplex::MySATCache::GetGJKIterationCount(void) { return m_uGJKIterationCount; }
+Simplex::MyPairCache* Simplex::MySATCache::GetPairCache(void) { return &m_pairCache; }
+Simplex::MyContact Simplex::MySATCache::GetContact(uint a_uPair)
+{
+	if (a_uPair >= m_contactList.size())
+		return MyContact();
+	return m_contactList[a_uPair];
+}
+void Simplex::MySATCache::Clear(void)
+{
+	m_pairCache.Clear();
+	m_uSeparatedCount = 0;
+	m_uFirstAxisCount = 0;
+	m_uGJKCount = 0;
+	m_uGJKIterationCount = 0;
+}
+void Simplex::MySATCache::TestPairs(PEntity* a_pEntityArray, std::vector<MyBroadPhasePair> const& a_pairList, std::vector<uint>& a_collidingList)
+{
+	uint uPairCount = static_cast<uint>(a_pairList.size());
+	a_collidingList.resize(uPairCount);
+	m_slotList.resize(uPairCount);
+	m_axisList.resize(uPairCount);
+	m_contactList.resize(uPairCount);
+	m_iterationList.resize(uPairCount);
+
+	//find the slot of each pair first, the table does not change while the jobs run
+	m_pairCache.Begin(uPairCount);
+	for (uint uPair = 0; uPair < uPairCount; ++uPair)
+		m_slotList[uPair] = m_pairCache.Report(a_pEntityArray[a_pairList[uPair].m_uA], a_pEntityArray[a_pairList[uPair].m_uB]);
+
+	//each job only writes the slots of its own pairs
+	MyJobSystem* pJobSystem = MyJobSystem::GetInstance();
+	pJobSystem->ParallelFor(uPairCount, 64, [this, &a_collidingList](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint uPair = a_uBegin; uPair < a_uEnd; ++uPair)
+		{
+			//pairs are always tested in the order of the cache so the cached data means the same
+			MyPair& pair = m_pairCache.GetPair(m_slotList[uPair]);
+			MyEntity* pEntityA = pair.m_pA;
+			MyEntity* pEntityB = pair.m_pB;
+			MyRigidBody* pRigidBodyA = pEntityA->GetRigidBody();
+			MyRigidBody* pRigidBodyB = pEntityB->GetRigidBody();
+			float fImpulse = pair.m_contact.m_fImpulse;
+			pair.m_contact = MyContact();
+
+			//convex hulls go through GJK, the simplex of the last test is usually close to the answer
+			if (pRigidBodyA->GetConvexHull() || pRigidBodyB->GetConvexHull())
+			{
+				uint uIterations = 0;
+				bool bColliding = pEntityA->SharesDimension(pEntityB) && Overlap(pRigidBodyA, pRigidBodyB) &&
+					MyGJK::Intersect(pRigidBodyA, pRigidBodyB, pair.m_simplex, uIterations);
+				if (bColliding)
+				{
+					MyGJK::Penetration(pRigidBodyA, pRigidBodyB, pair.m_simplex, pair.m_contact);
+					pair.m_contact.m_fImpulse = fImpulse;
+				}
+				a_collidingList[uPair] = bColliding ? 1 : 0;
+				pair.m_uAxis = SAT_NONE;
+				m_axisList[uPair] = SAT_NONE;
+				m_iterationList[uPair] = uIterations;
+				continue;
+			}
+			m_iterationList[uPair] = static_cast<uint>(-1);
+
+			uint uAxis = pair.m_uAxis;
+			uint uFirstAxis = uAxis;
+
+			//pairs rejected by the dimensions or the ARBBs keep the cached axis without running SAT
+			bool bTested = pEntityA->SharesDimension(pEntityB) && Overlap(pRigidBodyA, pRigidBodyB);
+			bool bColliding = bTested && pRigidBodyA->IsCollidingOBB(pRigidBodyB, uAxis);
+			a_collidingList[uPair] = bColliding ? 1 : 0;
+			pair.m_uAxis = uAxis;
+
+			//the contact solver needs the normal and depth of the boxes too, GJK on their corners gives them
+			uint uIterations = 0;
+			if (bColliding && MyGJK::Intersect(pRigidBodyA, pRigidBodyB, pair.m_simplex, uIterations))
+			{
+				MyGJK::Penetration(pRigidBodyA, pRigidBodyB, pair.m_simplex, pair.m_contact);
+				pair.m_contact.m_fImpulse = fImpulse;
+			}
+
+			//remember if the cached axis was enough with the high bit, only when SAT looked at it
+			m_axisList[uPair] = uAxis | (bTested && uAxis != SAT_NONE && uAxis == uFirstAxis ? 0x80000000 : 0);
+		}
+	});
+
+	//events and statistics of the batch
+	m_uSeparatedCount = 0;
+	m_uFirstAxisCount = 0;
+	m_uGJKCount = 0;
+	m_uGJKIterationCount = 0;
+	for (uint uPair = 0; uPair < uPairCount; ++uPair)
+	{
+		m_pairCache.SetColliding(m_slotList[uPair], a_collidingList[uPair] != 0);
+
+		//the contact goes from the first entity of the broad phase pair to the second one
+		MyPair& pair = m_pairCache.GetPair(m_slotList[uPair]);
+		m_contactList[uPair] = pair.m_contact;
+		if (pair.m_pA != a_pEntityArray[a_pairList[uPair].m_uA])
+			m_contactList[uPair].m_v3Normal = -m_contactList[uPair].m_v3Normal;
+
+		if (m_iterationList[uPair] != static_cast<uint>(-1))
+		{
+			++m_uGJKCount;
+			m_uGJKIterationCount += m_iterationList[uPair];
+			continue;
+		}
+
+		uint uAxis = m_axisList[uPair] & 0x7FFFFFFF;
+		if (uAxis != SAT_NONE)
+		{
+			++m_uSeparatedCount;
+			if (m_axisList[uPair] & 0x80000000)
+				++m_uFirstAxisCount;
+		}
+	}
+
+	//the pairs the broad phase stopped reporting leave the cache
+	m_pairCache.End();
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYSATCACHE_H_
+#define __MYSATCACHE_H_
+
+#include "MyBroadPhase.h"
+#include "MyJobSystem.h"
+#include "MyPairCache.h"
+
+namespace Simplex
+{
+
+//Narrow phase of the broad phase pairs, remembers the axis that separated each pair so it is tested first,
+//pairs with a convex hull use GJK starting from the last simplex instead and EPA for their contact;
+//the data of each pair lives in the pair cache
+class MySATCache
+{
+	typedef MyEntity* PEntity; //MyEntity Pointer
+
+	MyPairCache m_pairCache; //persistent data of each pair of entities
+	std::vector<uint> m_slotList; //slot in the pair cache of each pair of the current batch
+	std::vector<uint> m_axisList; //axis of each pair of the current batch
+	std::vector<MyContact> m_contactList; //contact of each pair of the current batch
+	std::vector<uint> m_iterationList; //GJK iterations of each pair of the current batch, -1 if it used SAT
+
+	uint m_uSeparatedCount = 0; //pairs of the last batch separated by SAT
+	uint m_uFirstAxisCount = 0; //pairs of the last batch separated by the cached axis
+	uint m_uGJKCount = 0; //pairs of the last batch tested with GJK
+	uint m_uGJKIterationCount = 0; //GJK iterations of the last batch
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object instance
+	*/
+	MySATCache(void);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MySATCache(void);
+	/*
+	USAGE: Tests a batch of pairs in parallel (dimensions, ARBB and SAT starting by the cached axis or
+	GJK starting by the cached simplex), the collisions are not marked in the rigid bodies but the pair
+	cache generates the events
+	ARGUMENTS:
+	-	PEntity* a_pEntityArray -> list of entities
+	-	std::vector<MyBroadPhasePair> const& a_pairList -> pairs to test
+	-	std::vector<uint>& a_collidingList -> 1 for each colliding pair and 0 for the others
+	OUTPUT: ---
+	*/
+	void TestPairs(PEntity* a_pEntityArray, std::vector<MyBroadPhasePair> const& a_pairList, std::vector<uint>& a_collidingList);
+	/*
+	USAGE: Forgets all the pairs
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the number of pairs of the last batch separated by SAT
+	ARGUMENTS: ---
+	OUTPUT: separated count
+	*/
+	uint GetSeparatedCount(void);
+	/*
+	USAGE: Gets the number of pairs of the last batch that went through SAT and were separated by the first axis tested
+	ARGUMENTS: ---
+	OUTPUT: count
+	*/
+	uint GetFirstAxisCount(void);
+	/*
+	USAGE: Gets the contact of a colliding pair of the last batch, only pairs with a convex hull have one
+	ARGUMENTS: uint a_uPair -> index of the pair in the batch
+	OUTPUT: contact, zero depth if there is none
+	*/
+	MyContact GetContact(uint a_uPair);
+	/*
+	USAGE: Gets the number of pairs of the last batch tested with GJK
+	ARGUMENTS: ---
+	OUTPUT: count
+	*/
+	uint GetGJKCount(void);
+	/*
+	USAGE: Gets the number of GJK iterations of the last batch
+	ARGUMENTS: ---
+	OUTPUT: count
+	*/
+	uint GetGJKIterationCount(void);
+	/*
+	USAGE: Gets the persistent pairs and the collision events of the last batch
+	ARGUMENTS: ---
+	OUTPUT: pair cache
+	*/
+	MyPairCache* GetPairCache(void);
+private:
+	/*
+	USAGE: copy constructor, caches are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MySATCache(MySATCache const& other);
+	/*
+	USAGE: copy assignment operator, caches are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MySATCache& operator=(MySATCache const& other);
+};
+
+} //namespace Simplex
+
+#endif //__MYSATCACHE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -3,27 +3,45 @@ using namespace Simplex;
 //  MySolver
 void MySolver::Init(void)
 {
-	m_v3Acceleration = ZERO_V3;
-	m_v3Position = ZERO_V3;
-	m_v3Velocity = ZERO_V3;
-	m_fMass = 1.0f;
+	m_uSlot = MySolverPool::GetInstance()->Allocate();
+	m_bSimulated = false;
+
+	m_bAsleep = false;
+	m_uIsland = 0;
+	m_uSleepFrames = 30;
 }
 void MySolver::Swap(MySolver& other)
 {
-	std::swap(m_v3Acceleration, other.m_v3Acceleration);
-	std::swap(m_v3Velocity, other.m_v3Velocity);
-	std::swap(m_v3Position, other.m_v3Position);
-	std::swap(m_fMass, other.m_fMass);
+	std::swap(m_uSlot, other.m_uSlot);
+	std::swap(m_bSimulated, other.m_bSimulated);
+
+	std::swap(m_bAsleep, other.m_bAsleep);
+	std::swap(m_uIsland, other.m_uIsland);
+	std::swap(m_uSleepFrames, other.m_uSleepFrames);
+}
+void MySolver::Release(void)
+{
+	MySolverPool::GetInstance()->Free(m_uSlot);
 }
-void MySolver::Release(void){/*nothing to deallocate*/ }
 //The big 3
 MySolver::MySolver(void){ Init(); }
 MySolver::MySolver(MySolver const& other)
 {
-	m_v3Acceleration = other.m_v3Acceleration;
-	m_v3Velocity = other.m_v3Velocity;
-	m_v3Position = other.m_v3Position;
-	m_fMass = other.m_fMass;
+	//the copy gets its own slot with the same content
+	MySolverPool* pPool = MySolverPool::GetInstance();
+	m_uSlot = pPool->Allocate();
+	pPool->SetPosition(m_uSlot, pPool->GetPosition(other.m_uSlot));
+	pPool->SetVelocity(m_uSlot, pPool->GetVelocity(other.m_uSlot));
+	pPool->SetForce(m_uSlot, pPool->GetForce(other.m_uSlot));
+	pPool->SetInverseMass(m_uSlot, pPool->GetInverseMass(other.m_uSlot));
+	pPool->SetSleepVelocity(m_uSlot, pPool->GetSleepVelocity(other.m_uSlot));
+	pPool->SetRestFrames(m_uSlot, pPool->GetRestFrames(other.m_uSlot));
+	m_bSimulated = other.m_bSimulated;
+
+	m_bAsleep = other.m_bAsleep;
+	m_uIsland = other.m_uIsland;
+	m_uSleepFrames = other.m_uSleepFrames;
+	UpdateActive();
 }
 MySolver& MySolver::operator=(MySolver const& other)
 {
@@ -39,91 +57,108 @@ MySolver& MySolver::operator=(MySolver const& other)
 MySolver::~MySolver() { Release(); }
 
 //Accessors
-void MySolver::SetPosition(vector3 a_v3Position) { m_v3Position = a_v3Position; }
-vector3 MySolver::GetPosition(void) { return m_v3Position; }
+void MySolver::SetPosition(vector3 a_v3Position) { MySolverPool::GetInstance()->SetPosition(m_uSlot, a_v3Position); }
+vector3 MySolver::GetPosition(void) { return MySolverPool::GetInstance()->GetPosition(m_uSlot); }
 
-void MySolver::SetVelocity(vector3 a_v3Velocity) { m_v3Velocity = a_v3Velocity; }
-vector3 MySolver::GetVelocity(void) { return m_v3Velocity; }
+void MySolver::SetVelocity(vector3 a_v3Velocity)
+{
+	MySolverPool::GetInstance()->SetVelocity(m_uSlot, a_v3Velocity);
+	Wake();
+}
+vector3 MySolver::GetVelocity(void) { return MySolverPool::GetInstance()->GetVelocity(m_uSlot); }
+
+void MySolver::SetMass(float a_fMass)
+{
+	//check minimum mass
+	if (a_fMass < 0.01f)
+		a_fMass = 0.01f;
+	MySolverPool::GetInstance()->SetInverseMass(m_uSlot, 1.0f / a_fMass);
+}
+float MySolver::GetMass(void) { return 1.0f / MySolverPool::GetInstance()->GetInverseMass(m_uSlot); }
 
-void MySolver::SetMass(float a_fMass) { m_fMass = a_fMass; }
-float MySolver::GetMass(void) { return m_fMass; }
+bool MySolver::IsAsleep(void) { return m_bAsleep; }
+bool MySolver::IsReadyToSleep(void) { return MySolverPool::GetInstance()->GetRestFrames(m_uSlot) >= m_uSleepFrames; }
+uint MySolver::GetIsland(void) { return m_uIsland; }
+void MySolver::SetSleepThreshold(float a_fVelocity, uint a_uFrames)
+{
+	MySolverPool::GetInstance()->SetSleepVelocity(m_uSlot, a_fVelocity);
+	m_uSleepFrames = a_uFrames;
+}
+bool MySolver::IsSimulated(void) { return m_bSimulated; }
+void MySolver::SetSimulated(bool a_bSimulated)
+{
+	m_bSimulated = a_bSimulated;
+	UpdateActive();
+}
 
 //Methods
+void MySolver::UpdateActive(void)
+{
+	MySolverPool::GetInstance()->SetActive(m_uSlot, m_bSimulated && !m_bAsleep);
+}
 void MySolver::ApplyFriction(float a_fFriction)
 {
 	if (a_fFriction < 0.01f)
 		a_fFriction = 0.01f;
 	
-	m_v3Velocity *= 1.0f - a_fFriction;
+	vector3 v3Velocity = GetVelocity() * (1.0f - a_fFriction);
 
 	//if velocity is really small make it zero
-	if (glm::length(m_v3Velocity) < 0.01f)
-		m_v3Velocity = ZERO_V3;
+	if (glm::length(v3Velocity) < 0.01f)
+		v3Velocity = ZERO_V3;
+	MySolverPool::GetInstance()->SetVelocity(m_uSlot, v3Velocity);
+}
+void MySolver::Sleep(uint a_uIsland)
+{
+	m_bAsleep = true;
+	m_uIsland = a_uIsland;
+	MySolverPool* pPool = MySolverPool::GetInstance();
+	pPool->SetVelocity(m_uSlot, ZERO_V3);
+	pPool->SetForce(m_uSlot, ZERO_V3);
+	UpdateActive();
+}
+void MySolver::Wake(void)
+{
+	m_bAsleep = false;
+	MySolverPool::GetInstance()->SetRestFrames(m_uSlot, 0);
+	UpdateActive();
 }
 void MySolver::ApplyForce(vector3 a_v3Force)
 {
-	//check minimum mass
-	if (m_fMass < 0.01f)
-		m_fMass = 0.01f;
-	//f = m * a -> a = f / m
-	m_v3Acceleration += a_v3Force / m_fMass;
+	//forces from outside wake the solver
+	Wake();
+	AccumulateForce(a_v3Force);
 }
-vector3 CalculateMaxVelocity(vector3 a_v3Velocity, float maxVelocity)
+void MySolver::ApplyContactVelocity(vector3 a_v3Velocity)
 {
-	if (glm::length(a_v3Velocity) > maxVelocity)
-	{
-		a_v3Velocity = glm::normalize(a_v3Velocity);
-		a_v3Velocity *= maxVelocity;
-	}
-	return a_v3Velocity;
+	MySolverPool* pPool = MySolverPool::GetInstance();
+	pPool->SetVelocity(m_uSlot, pPool->GetVelocity(m_uSlot) + a_v3Velocity);
 }
-vector3 RoundSmallVelocity(vector3 a_v3Velocity, float minVelocity = 0.01f)
+void MySolver::AccumulateForce(vector3 a_v3Force)
 {
-	if (glm::length(a_v3Velocity) < minVelocity)
-	{
-		a_v3Velocity = ZERO_V3;
-	}
-	return a_v3Velocity;
+	//divided by the mass when the velocity is integrated
+	MySolverPool* pPool = MySolverPool::GetInstance();
+	pPool->SetForce(m_uSlot, pPool->GetForce(m_uSlot) + a_v3Force);
 }
-void MySolver::Update(void)
+void MySolver::IntegrateVelocity(void)
 {
-	ApplyForce(vector3(0.0f, -0.035f, 0.0f));
-
-	m_v3Velocity += m_v3Acceleration;
-	
-	float fMaxVelocity = 5.0f;
-	m_v3Velocity = CalculateMaxVelocity(m_v3Velocity, fMaxVelocity);
-
-	ApplyFriction(0.1f);
-	m_v3Velocity = RoundSmallVelocity(m_v3Velocity, 0.028f);
+	//sleeping solvers do not move
+	if (m_bAsleep)
+		return;
 
-	m_v3Position += m_v3Velocity;
-			
-	if (m_v3Position.y <= 0)
-	{
-		m_v3Position.y = 0;
-		m_v3Velocity.y = 0;
-	}
-
-	m_v3Acceleration = ZERO_V3;
+	//gravity, clamping, friction and rounding are done by the pool (same steps as the batch)
+	MySolverPool::GetInstance()->IntegrateVelocity(m_uSlot);
 }
-void MySolver::ResolveCollision(MySolver* a_pOther)
+void MySolver::IntegratePosition(void)
 {
-	float fMagThis = glm::length(m_v3Velocity);
-	float fMagOther = glm::length(m_v3Velocity);
+	//sleeping solvers do not move
+	if (m_bAsleep)
+		return;
 
-	if (fMagThis > 0.015f || fMagOther > 0.015f)
-	{
-		//a_pOther->ApplyForce(GetVelocity());
-		ApplyForce(-m_v3Velocity);
-		a_pOther->ApplyForce(m_v3Velocity);
-	}
-	else
-	{
-		vector3 v3Direction = m_v3Position - a_pOther->m_v3Position;
-		v3Direction = glm::normalize(v3Direction);
-		v3Direction *= 0.04f;
-		ApplyForce(v3Direction);
-		a_pOther->ApplyForce(-v3Direction);
-	}
+	MySolverPool::GetInstance()->IntegratePosition(m_uSlot);
+}
+void MySolver::Update(void)
+{
+	IntegrateVelocity();
+	IntegratePosition();
 }
\ No newline at end of file
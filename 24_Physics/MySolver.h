@@ -6,16 +6,20 @@ Date: 2017/07
 #define __MYSOLVER_H_
 
 #include "MyRigidBody.h"
+#include "MySolverPool.h"
 
 namespace Simplex
 {
 
+//View of one slot of MySolverPool, the pool integrates all the simulated solvers in batch
 class MySolver
 {
-	vector3 m_v3Acceleration = ZERO_V3; //Acceleration of the MySolver
-	vector3 m_v3Position = ZERO_V3; //Position of the MySolver
-	vector3 m_v3Velocity = ZERO_V3; //Velocity of the MySolver
-	float m_fMass = 1.0f; //Mass of the solver
+	uint m_uSlot = 0; //slot of the pool holding the position, velocity, forces and mass
+	bool m_bSimulated = false; //is the solver integrated by the pool batch?
+
+	bool m_bAsleep = false; //is the solver sleeping (not integrated)?
+	uint m_uIsland = 0; //island the solver went to sleep with, 0 if none
+	uint m_uSleepFrames = 30; //frames at rest before the solver is ready to sleep
 public:
 	/*
 	USAGE: Constructor
@@ -87,6 +91,58 @@ public:
 	*/
 	float GetMass(void);
 
+	/*
+	USAGE: Asks if the solver is sleeping
+	ARGUMENTS: ---
+	OUTPUT: is it sleeping?
+	*/
+	bool IsAsleep(void);
+	/*
+	USAGE: Asks if the solver has been at rest long enough to go to sleep
+	ARGUMENTS: ---
+	OUTPUT: ready to sleep?
+	*/
+	bool IsReadyToSleep(void);
+	/*
+	USAGE: Gets the island the solver went to sleep with
+	ARGUMENTS: ---
+	OUTPUT: island identifier, 0 if none
+	*/
+	uint GetIsland(void);
+	/*
+	USAGE: Puts the solver to sleep, velocity and acceleration are discarded
+	ARGUMENTS: uint a_uIsland = 0 -> island it sleeps with (all wake up together)
+	OUTPUT: ---
+	*/
+	void Sleep(uint a_uIsland = 0);
+	/*
+	USAGE: Wakes the solver up, it will need to be at rest again before sleeping
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Wake(void);
+	/*
+	USAGE: Sets when the solver is considered at rest
+	ARGUMENTS:
+	-	float a_fVelocity -> velocity under which the solver is at rest
+	-	uint a_uFrames -> frames at rest before being ready to sleep
+	OUTPUT: ---
+	*/
+	void SetSleepThreshold(float a_fVelocity, uint a_uFrames);
+	/*
+	USAGE: Asks if the solver is integrated by the pool batch
+	ARGUMENTS: ---
+	OUTPUT: is it simulated?
+	*/
+	bool IsSimulated(void);
+	/*
+	USAGE: Sets if the solver is integrated by the pool batch, solvers that are not can still be
+	updated on their own
+	ARGUMENTS: bool a_bSimulated -> is it simulated?
+	OUTPUT: ---
+	*/
+	void SetSimulated(bool a_bSimulated);
+
 	/*
 	USAGE: Applies friction to the movement
 	ARGUMENTS: float a_fFriction = 0.1f -> friction to apply negative friction gets minimized to 0.01f
@@ -94,24 +150,49 @@ public:
 	*/
 	void ApplyFriction(float a_fFriction = 0.1f);
 	/*
-	USAGE: Applies a force to the solver
+	USAGE: Applies a force to the solver, waking it up
 	ARGUMENTS: vector3 a_v3Force -> Force to apply
 	OUTPUT: ---
 	*/
 	void ApplyForce(vector3 a_v3Force);
 	/*
-	USAGE: Updates the MySolver
+	USAGE: Adds the change of velocity found by the contact solver, unlike forces it does not wake the
+	solver so resting piles can still go to sleep
+	ARGUMENTS: vector3 a_v3Velocity -> change of velocity
+	OUTPUT: ---
+	*/
+	void ApplyContactVelocity(vector3 a_v3Velocity);
+	/*
+	USAGE: Updates the MySolver, sleeping solvers are not integrated
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
-	USAGE: Resolve the collision between two solvers
-	ARGUMENTS: MySolver* a_pOther -> other solver to resolve collision with
+	USAGE: First half of the update, forces go into the velocity (the contacts are solved after this)
+	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
-	void ResolveCollision(MySolver* a_pOther);
+	void IntegrateVelocity(void);
+	/*
+	USAGE: Second half of the update, the velocity moves the solver and the rest frames are counted
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void IntegratePosition(void);
 private:
+	/*
+	USAGE: Adds a force to the ones accumulated by the slot without waking the solver
+	ARGUMENTS: vector3 a_v3Force -> Force to apply
+	OUTPUT: ---
+	*/
+	void AccumulateForce(vector3 a_v3Force);
+	/*
+	USAGE: Tells the pool if the batch should integrate the slot (simulated and awake)
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateActive(void);
 	/*
 	Usage: Deallocates member fields
 	Arguments: ---
@@ -0,0 +1,399 @@
+#include "MySolverPool.h"
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+using namespace Simplex;
+//visual studio compiles the AVX2 intrinsics on any target, other compilers need -mavx2
+#if defined(_MSC_VER) || defined(__AVX2__)
+#define MYSOLVERPOOL_AVX2
+#endif
+//helpers
+static bool HasAVX2(void)
+{
+#if defined(_MSC_VER)
+	int nInfo[4];
+	__cpuid(nInfo, 0);
+	if (nInfo[0] < 7)
+		return false;
+	//AVX and the operating system saving the ymm registers
+	__cpuid(nInfo, 1);
+	if ((nInfo[2] & (1 << 27)) == 0 || (nInfo[2] & (1 << 28)) == 0)
+		return false;
+	if ((_xgetbv(0) & 6) != 6)
+		return false;
+	__cpuidex(nInfo, 7, 0);
+	return (nInfo[1] & (1 << 5)) != 0;
+#elif defined(MYSOLVERPOOL_AVX2)
+	return __builtin_cpu_supports("avx2") != 0;
+#else
+	return false;
+#endif
+}
+static float* AllocateFloats(uint a_uCount) { return static_cast<float*>(_mm_malloc(sizeof(float) * a_uCount, 32)); }
+//selects a where the mask is set and b everywhere else
+static __m128 Select(__m128 a_mask, __m128 a_a, __m128 a_b) { return _mm_or_ps(_mm_and_ps(a_mask, a_a), _mm_andnot_ps(a_mask, a_b)); }
+//  MySolverPool
+Simplex::MySolverPool* Simplex::MySolverPool::m_pInstance = nullptr;
+void Simplex::MySolverPool::Init(void)
+{
+	m_uCapacity = 0;
+	m_uSlotCount = 0;
+	m_bAVX2 = HasAVX2();
+	Grow(64);
+}
+void Simplex::MySolverPool::Release(void)
+{
+	_mm_free(m_pPositionX);
+	_mm_free(m_pPositionY);
+	_mm_free(m_pPositionZ);
+	_mm_free(m_pVelocityX);
+	_mm_free(m_pVelocityY);
+	_mm_free(m_pVelocityZ);
+	_mm_free(m_pForceX);
+	_mm_free(m_pForceY);
+	_mm_free(m_pForceZ);
+	_mm_free(m_pInverseMass);
+	_mm_free(m_pSleepVelocity);
+	_mm_free(m_pActive);
+	_mm_free(m_pRestFrames);
+	m_pPositionX = m_pPositionY = m_pPositionZ = nullptr;
+	m_pVelocityX = m_pVelocityY = m_pVelocityZ = nullptr;
+	m_pForceX = m_pForceY = m_pForceZ = nullptr;
+	m_pInverseMass = m_pSleepVelocity = m_pActive = nullptr;
+	m_pRestFrames = nullptr;
+	m_uCapacity = 0;
+	m_uSlotCount = 0;
+	m_freeList.clear();
+}
+Simplex::MySolverPool* Simplex::MySolverPool::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MySolverPool();
+	}
+	return m_pInstance;
+}
+void Simplex::MySolverPool::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MySolverPool::MySolverPool() { Init(); }
+Simplex::MySolverPool::MySolverPool(MySolverPool const& other) { }
+Simplex::MySolverPool& Simplex::MySolverPool::operator=(MySolverPool const& other) { return *this; }
+Simplex::MySolverPool::~MySolverPool() { Release(); }
+//Accessors
+Simplex::vector3 Simplex::MySolverPool::GetPosition(uint a_uSlot) { return vector3(m_pPositionX[a_uSlot], m_pPositionY[a_uSlot], m_pPositionZ[a_uSlot]); }
+void Simplex::MySolverPool::SetPosition(uint a_uSlot, vector3 a_v3Position)
+{
+	m_pPositionX[a_uSlot] = a_v3Position.x;
+	m_pPositionY[a_uSlot] = a_v3Position.y;
+	m_pPositionZ[a_uSlot] = a_v3Position.z;
+}
+Simplex::vector3 Simplex::MySolverPool::GetVelocity(uint a_uSlot) { return vector3(m_pVelocityX[a_uSlot], m_pVelocityY[a_uSlot], m_pVelocityZ[a_uSlot]); }
+void Simplex::MySolverPool::SetVelocity(uint a_uSlot, vector3 a_v3Velocity)
+{
+	m_pVelocityX[a_uSlot] = a_v3Velocity.x;
+	m_pVelocityY[a_uSlot] = a_v3Velocity.y;
+	m_pVelocityZ[a_uSlot] = a_v3Velocity.z;
+}
+Simplex::vector3 Simplex::MySolverPool::GetForce(uint a_uSlot) { return vector3(m_pForceX[a_uSlot], m_pForceY[a_uSlot], m_pForceZ[a_uSlot]); }
+void Simplex::MySolverPool::SetForce(uint a_uSlot, vector3 a_v3Force)
+{
+	m_pForceX[a_uSlot] = a_v3Force.x;
+	m_pForceY[a_uSlot] = a_v3Force.y;
+	m_pForceZ[a_uSlot] = a_v3Force.z;
+}
+float Simplex::MySolverPool::GetInverseMass(uint a_uSlot) { return m_pInverseMass[a_uSlot]; }
+void Simplex::MySolverPool::SetInverseMass(uint a_uSlot, float a_fInverseMass) { m_pInverseMass[a_uSlot] = a_fInverseMass; }
+float Simplex::MySolverPool::GetSleepVelocity(uint a_uSlot) { return glm::sqrt(m_pSleepVelocity[a_uSlot]); }
+void Simplex::MySolverPool::SetSleepVelocity(uint a_uSlot, float a_fVelocity) { m_pSleepVelocity[a_uSlot] = a_fVelocity * a_fVelocity; }
+Simplex::uint Simplex::MySolverPool::GetRestFrames(uint a_uSlot) { return static_cast<uint>(m_pRestFrames[a_uSlot]); }
+void Simplex::MySolverPool::SetRestFrames(uint a_uSlot, uint a_uFrames) { m_pRestFrames[a_uSlot] = static_cast<int>(a_uFrames); }
+bool Simplex::MySolverPool::IsActive(uint a_uSlot) { return m_pActive[a_uSlot] > 0.0f; }
+void Simplex::MySolverPool::SetActive(uint a_uSlot, bool a_bActive) { m_pActive[a_uSlot] = a_bActive ? 1.0f : 0.0f; }
+bool Simplex::MySolverPool::IsUsingAVX2(void) { return m_bAVX2; }
+Simplex::uint Simplex::MySolverPool::GetActiveCount(void)
+{
+	uint uCount = 0;
+	for (uint i = 0; i < m_uSlotCount; ++i)
+	{
+		if (m_pActive[i] > 0.0f)
+			++uCount;
+	}
+	return uCount;
+}
+//Slots
+void Simplex::MySolverPool::Grow(uint a_uCapacity)
+{
+	float** pFloatArray[] = { &m_pPositionX, &m_pPositionY, &m_pPositionZ, &m_pVelocityX, &m_pVelocityY, &m_pVelocityZ,
+		&m_pForceX, &m_pForceY, &m_pForceZ, &m_pInverseMass, &m_pSleepVelocity, &m_pActive };
+	for (uint uArray = 0; uArray < sizeof(pFloatArray) / sizeof(pFloatArray[0]); ++uArray)
+	{
+		float* pTemp = AllocateFloats(a_uCapacity);
+		if (*pFloatArray[uArray])
+			memcpy(pTemp, *pFloatArray[uArray], sizeof(float) * m_uCapacity);
+		//the new slots are inactive and at rest so the batch can run over them
+		memset(pTemp + m_uCapacity, 0, sizeof(float) * (a_uCapacity - m_uCapacity));
+		_mm_free(*pFloatArray[uArray]);
+		*pFloatArray[uArray] = pTemp;
+	}
+	int* pTemp = static_cast<int*>(_mm_malloc(sizeof(int) * a_uCapacity, 32));
+	if (m_pRestFrames)
+		memcpy(pTemp, m_pRestFrames, sizeof(int) * m_uCapacity);
+	memset(pTemp + m_uCapacity, 0, sizeof(int) * (a_uCapacity - m_uCapacity));
+	_mm_free(m_pRestFrames);
+	m_pRestFrames = pTemp;
+
+	m_uCapacity = a_uCapacity;
+}
+Simplex::uint Simplex::MySolverPool::Allocate(void)
+{
+	uint uSlot;
+	if (m_freeList.size() > 0)
+	{
+		uSlot = m_freeList.back();
+		m_freeList.pop_back();
+	}
+	else
+	{
+		if (m_uSlotCount == m_uCapacity)
+			Grow(m_uCapacity * 2);
+		uSlot = m_uSlotCount++;
+	}
+
+	SetPosition(uSlot, ZERO_V3);
+	SetVelocity(uSlot, ZERO_V3);
+	SetForce(uSlot, ZERO_V3);
+	SetInverseMass(uSlot, 1.0f);
+	SetSleepVelocity(uSlot, 0.05f);
+	SetRestFrames(uSlot, 0);
+	SetActive(uSlot, false);
+	return uSlot;
+}
+void Simplex::MySolverPool::Free(uint a_uSlot)
+{
+	if (a_uSlot >= m_uSlotCount)
+		return;
+	SetActive(a_uSlot, false);
+	m_freeList.push_back(a_uSlot);
+}
+//Integration
+void Simplex::MySolverPool::IntegrateVelocity(void)
+{
+	//the capacity is a multiple of eight, the slots past the count are inactive
+	uint uBlockCount = (m_uSlotCount + 7) / 8;
+	MyJobSystem::GetInstance()->ParallelFor(uBlockCount, 512, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		if (m_bAVX2)
+			IntegrateVelocityAVX2(a_uBegin * 8, a_uEnd * 8);
+		else
+			IntegrateVelocitySSE(a_uBegin * 8, a_uEnd * 8);
+	});
+}
+void Simplex::MySolverPool::IntegratePosition(void)
+{
+	uint uBlockCount = (m_uSlotCount + 7) / 8;
+	MyJobSystem::GetInstance()->ParallelFor(uBlockCount, 512, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		if (m_bAVX2)
+			IntegratePositionAVX2(a_uBegin * 8, a_uEnd * 8);
+		else
+			IntegratePositionSSE(a_uBegin * 8, a_uEnd * 8);
+	});
+}
+void Simplex::MySolverPool::IntegrateVelocity(uint a_uSlot)
+{
+	//same steps as the batch, for one slot
+	vector3 v3Velocity = GetVelocity(a_uSlot) + (GetForce(a_uSlot) + vector3(0.0f, m_fGravity, 0.0f)) * m_pInverseMass[a_uSlot];
+	float fLength = glm::length(v3Velocity);
+	if (fLength > m_fMaxVelocity)
+	{
+		v3Velocity *= m_fMaxVelocity / fLength;
+		fLength = m_fMaxVelocity;
+	}
+	v3Velocity *= 1.0f - m_fFriction;
+	if (fLength * (1.0f - m_fFriction) < m_fMinVelocity)
+		v3Velocity = ZERO_V3;
+	SetVelocity(a_uSlot, v3Velocity);
+	SetForce(a_uSlot, ZERO_V3);
+}
+void Simplex::MySolverPool::IntegratePosition(uint a_uSlot)
+{
+	vector3 v3Position = GetPosition(a_uSlot) + GetVelocity(a_uSlot);
+	if (v3Position.y <= 0.0f)
+	{
+		v3Position.y = 0.0f;
+		m_pVelocityY[a_uSlot] = 0.0f;
+	}
+	SetPosition(a_uSlot, v3Position);
+
+	//count how long the slot has been at rest
+	vector3 v3Velocity = GetVelocity(a_uSlot);
+	if (glm::dot(v3Velocity, v3Velocity) < m_pSleepVelocity[a_uSlot])
+		++m_pRestFrames[a_uSlot];
+	else
+		m_pRestFrames[a_uSlot] = 0;
+}
+void Simplex::MySolverPool::IntegrateVelocitySSE(uint a_uBegin, uint a_uEnd)
+{
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 gravity = _mm_set1_ps(m_fGravity);
+	__m128 maxVelocity = _mm_set1_ps(m_fMaxVelocity);
+	__m128 maxVelocity2 = _mm_set1_ps(m_fMaxVelocity * m_fMaxVelocity);
+	__m128 minVelocity2 = _mm_set1_ps(m_fMinVelocity * m_fMinVelocity);
+	__m128 friction = _mm_set1_ps(1.0f - m_fFriction);
+	for (uint i = a_uBegin; i < a_uEnd; i += 4)
+	{
+		__m128 active = _mm_cmpgt_ps(_mm_load_ps(m_pActive + i), zero);
+		__m128 inverseMass = _mm_load_ps(m_pInverseMass + i);
+		__m128 forceX = _mm_load_ps(m_pForceX + i);
+		__m128 forceY = _mm_load_ps(m_pForceY + i);
+		__m128 forceZ = _mm_load_ps(m_pForceZ + i);
+		__m128 oldX = _mm_load_ps(m_pVelocityX + i);
+		__m128 oldY = _mm_load_ps(m_pVelocityY + i);
+		__m128 oldZ = _mm_load_ps(m_pVelocityZ + i);
+
+		//f = m * a -> a = f / m, gravity is one more force
+		__m128 velocityX = _mm_add_ps(oldX, _mm_mul_ps(forceX, inverseMass));
+		__m128 velocityY = _mm_add_ps(oldY, _mm_mul_ps(_mm_add_ps(forceY, gravity), inverseMass));
+		__m128 velocityZ = _mm_add_ps(oldZ, _mm_mul_ps(forceZ, inverseMass));
+
+		//one scale does the clamp, the friction and the rounding of small velocities
+		__m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityY, velocityY)), _mm_mul_ps(velocityZ, velocityZ));
+		__m128 clamp = _mm_cmpgt_ps(length2, maxVelocity2);
+		__m128 scale = Select(clamp, _mm_div_ps(maxVelocity, _mm_sqrt_ps(length2)), one);
+		scale = _mm_mul_ps(scale, friction);
+		__m128 keep = _mm_cmpge_ps(_mm_mul_ps(length2, _mm_mul_ps(scale, scale)), minVelocity2);
+		scale = _mm_and_ps(scale, keep);
+
+		//the inactive slots keep their state
+		_mm_store_ps(m_pVelocityX + i, Select(active, _mm_mul_ps(velocityX, scale), oldX));
+		_mm_store_ps(m_pVelocityY + i, Select(active, _mm_mul_ps(velocityY, scale), oldY));
+		_mm_store_ps(m_pVelocityZ + i, Select(active, _mm_mul_ps(velocityZ, scale), oldZ));
+		_mm_store_ps(m_pForceX + i, _mm_andnot_ps(active, forceX));
+		_mm_store_ps(m_pForceY + i, _mm_andnot_ps(active, forceY));
+		_mm_store_ps(m_pForceZ + i, _mm_andnot_ps(active, forceZ));
+	}
+}
+void Simplex::MySolverPool::IntegratePositionSSE(uint a_uBegin, uint a_uEnd)
+{
+	__m128 zero = _mm_setzero_ps();
+	__m128i oneFrame = _mm_set1_epi32(1);
+	for (uint i = a_uBegin; i < a_uEnd; i += 4)
+	{
+		__m128 active = _mm_cmpgt_ps(_mm_load_ps(m_pActive + i), zero);
+		__m128 velocityX = _mm_load_ps(m_pVelocityX + i);
+		__m128 velocityY = _mm_load_ps(m_pVelocityY + i);
+		__m128 velocityZ = _mm_load_ps(m_pVelocityZ + i);
+		__m128 positionX = _mm_load_ps(m_pPositionX + i);
+		__m128 positionY = _mm_load_ps(m_pPositionY + i);
+		__m128 positionZ = _mm_load_ps(m_pPositionZ + i);
+
+		//only the active slots move
+		positionX = _mm_add_ps(positionX, _mm_and_ps(active, velocityX));
+		positionY = _mm_add_ps(positionY, _mm_and_ps(active, velocityY));
+		positionZ = _mm_add_ps(positionZ, _mm_and_ps(active, velocityZ));
+
+		//the ground stops them
+		__m128 ground = _mm_and_ps(active, _mm_cmple_ps(positionY, zero));
+		positionY = _mm_andnot_ps(ground, positionY);
+		velocityY = _mm_andnot_ps(ground, velocityY);
+
+		_mm_store_ps(m_pPositionX + i, positionX);
+		_mm_store_ps(m_pPositionY + i, positionY);
+		_mm_store_ps(m_pPositionZ + i, positionZ);
+		_mm_store_ps(m_pVelocityY + i, velocityY);
+
+		//frames at rest go up by one or back to zero
+		__m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityY, velocityY)), _mm_mul_ps(velocityZ, velocityZ));
+		__m128i rest = _mm_castps_si128(_mm_cmplt_ps(length2, _mm_load_ps(m_pSleepVelocity + i)));
+		__m128i activeMask = _mm_castps_si128(active);
+		__m128i frames = _mm_load_si128(reinterpret_cast<__m128i*>(m_pRestFrames + i));
+		__m128i counted = _mm_and_si128(rest, _mm_add_epi32(frames, oneFrame));
+		frames = _mm_or_si128(_mm_and_si128(activeMask, counted), _mm_andnot_si128(activeMask, frames));
+		_mm_store_si128(reinterpret_cast<__m128i*>(m_pRestFrames + i), frames);
+	}
+}
+#ifdef MYSOLVERPOOL_AVX2
+void Simplex::MySolverPool::IntegrateVelocityAVX2(uint a_uBegin, uint a_uEnd)
+{
+	__m256 zero = _mm256_setzero_ps();
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 gravity = _mm256_set1_ps(m_fGravity);
+	__m256 maxVelocity = _mm256_set1_ps(m_fMaxVelocity);
+	__m256 maxVelocity2 = _mm256_set1_ps(m_fMaxVelocity * m_fMaxVelocity);
+	__m256 minVelocity2 = _mm256_set1_ps(m_fMinVelocity * m_fMinVelocity);
+	__m256 friction = _mm256_set1_ps(1.0f - m_fFriction);
+	for (uint i = a_uBegin; i < a_uEnd; i += 8)
+	{
+		__m256 active = _mm256_cmp_ps(_mm256_load_ps(m_pActive + i), zero, _CMP_GT_OQ);
+		__m256 inverseMass = _mm256_load_ps(m_pInverseMass + i);
+		__m256 forceX = _mm256_load_ps(m_pForceX + i);
+		__m256 forceY = _mm256_load_ps(m_pForceY + i);
+		__m256 forceZ = _mm256_load_ps(m_pForceZ + i);
+		__m256 oldX = _mm256_load_ps(m_pVelocityX + i);
+		__m256 oldY = _mm256_load_ps(m_pVelocityY + i);
+		__m256 oldZ = _mm256_load_ps(m_pVelocityZ + i);
+
+		__m256 velocityX = _mm256_add_ps(oldX, _mm256_mul_ps(forceX, inverseMass));
+		__m256 velocityY = _mm256_add_ps(oldY, _mm256_mul_ps(_mm256_add_ps(forceY, gravity), inverseMass));
+		__m256 velocityZ = _mm256_add_ps(oldZ, _mm256_mul_ps(forceZ, inverseMass));
+
+		__m256 length2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(velocityX, velocityX), _mm256_mul_ps(velocityY, velocityY)), _mm256_mul_ps(velocityZ, velocityZ));
+		__m256 clamp = _mm256_cmp_ps(length2, maxVelocity2, _CMP_GT_OQ);
+		__m256 scale = _mm256_blendv_ps(one, _mm256_div_ps(maxVelocity, _mm256_sqrt_ps(length2)), clamp);
+		scale = _mm256_mul_ps(scale, friction);
+		__m256 keep = _mm256_cmp_ps(_mm256_mul_ps(length2, _mm256_mul_ps(scale, scale)), minVelocity2, _CMP_GE_OQ);
+		scale = _mm256_and_ps(scale, keep);
+
+		_mm256_store_ps(m_pVelocityX + i, _mm256_blendv_ps(oldX, _mm256_mul_ps(velocityX, scale), active));
+		_mm256_store_ps(m_pVelocityY + i, _mm256_blendv_ps(oldY, _mm256_mul_ps(velocityY, scale), active));
+		_mm256_store_ps(m_pVelocityZ + i, _mm256_blendv_ps(oldZ, _mm256_mul_ps(velocityZ, scale), active));
+		_mm256_store_ps(m_pForceX + i, _mm256_andnot_ps(active, forceX));
+		_mm256_store_ps(m_pForceY + i, _mm256_andnot_ps(active, forceY));
+		_mm256_store_ps(m_pForceZ + i, _mm256_andnot_ps(active, forceZ));
+	}
+}
+void Simplex::MySolverPool::IntegratePositionAVX2(uint a_uBegin, uint a_uEnd)
+{
+	__m256 zero = _mm256_setzero_ps();
+	__m256i oneFrame = _mm256_set1_epi32(1);
+	for (uint i = a_uBegin; i < a_uEnd; i += 8)
+	{
+		__m256 active = _mm256_cmp_ps(_mm256_load_ps(m_pActive + i), zero, _CMP_GT_OQ);
+		__m256 velocityX = _mm256_load_ps(m_pVelocityX + i);
+		__m256 velocityY = _mm256_load_ps(m_pVelocityY + i);
+		__m256 velocityZ = _mm256_load_ps(m_pVelocityZ + i);
+		__m256 positionX = _mm256_add_ps(_mm256_load_ps(m_pPositionX + i), _mm256_and_ps(active, velocityX));
+		__m256 positionY = _mm256_add_ps(_mm256_load_ps(m_pPositionY + i), _mm256_and_ps(active, velocityY));
+		__m256 positionZ = _mm256_add_ps(_mm256_load_ps(m_pPositionZ + i), _mm256_and_ps(active, velocityZ));
+
+		__m256 ground = _mm256_and_ps(active, _mm256_cmp_ps(positionY, zero, _CMP_LE_OQ));
+		positionY = _mm256_andnot_ps(ground, positionY);
+		velocityY = _mm256_andnot_ps(ground, velocityY);
+
+		_mm256_store_ps(m_pPositionX + i, positionX);
+		_mm256_store_ps(m_pPositionY + i, positionY);
+		_mm256_store_ps(m_pPositionZ + i, positionZ);
+		_mm256_store_ps(m_pVelocityY + i, velocityY);
+
+		__m256 length2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(velocityX, velocityX), _mm256_mul_ps(velocityY, velocityY)), _mm256_mul_ps(velocityZ, velocityZ));
+		__m256i rest = _mm256_castps_si256(_mm256_cmp_ps(length2, _mm256_load_ps(m_pSleepVelocity + i), _CMP_LT_OQ));
+		__m256i frames = _mm256_load_si256(reinterpret_cast<__m256i*>(m_pRestFrames + i));
+		__m256i counted = _mm256_and_si256(rest, _mm256_add_epi32(frames, oneFrame));
+		frames = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(frames), _mm256_castsi256_ps(counted), active));
+		_mm256_store_si256(reinterpret_cast<__m256i*>(m_pRestFrames + i), frames);
+	}
+}
+#else
+//without AVX2 support in the compiler the wide path runs the SSE one
+void Simplex::MySolverPool::IntegrateVelocityAVX2(uint a_uBegin, uint a_uEnd) { IntegrateVelocitySSE(a_uBegin, a_uEnd); }
+void Simplex::MySolverPool::IntegratePositionAVX2(uint a_uBegin, uint a_uEnd) { IntegratePositionSSE(a_uBegin, a_uEnd); }
+#endif //MYSOLVERPOOL_AVX2
\ No newline at end of file
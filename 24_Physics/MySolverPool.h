@@ -0,0 +1,292 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYSOLVERPOOL_H_
+#define __MYSOLVERPOOL_H_
+
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+//System Class, the state of all the solvers in aligned structure of arrays so they are integrated
+//eight at a time with AVX2 (four with SSE on machines without it), MySolver is a view of one slot
+class MySolverPool
+{
+	uint m_uCapacity = 0; //slots allocated, always a multiple of eight
+	uint m_uSlotCount = 0; //slots handed out, free ones included
+	std::vector<uint> m_freeList; //slots returned to the pool
+	bool m_bAVX2 = false; //can this machine run the AVX2 path?
+
+	//integrated in batch, 32 byte aligned
+	float* m_pPositionX = nullptr; //position of each slot
+	float* m_pPositionY = nullptr;
+	float* m_pPositionZ = nullptr;
+	float* m_pVelocityX = nullptr; //velocity of each slot
+	float* m_pVelocityY = nullptr;
+	float* m_pVelocityZ = nullptr;
+	float* m_pForceX = nullptr; //forces accumulated since the last update
+	float* m_pForceY = nullptr;
+	float* m_pForceZ = nullptr;
+	float* m_pInverseMass = nullptr; //one over the mass of each slot
+	float* m_pSleepVelocity = nullptr; //squared velocity under which each slot is at rest
+	float* m_pActive = nullptr; //1 for the slots integrated by the batch, 0 for the rest
+	int* m_pRestFrames = nullptr; //consecutive frames each slot has been at rest
+
+	float m_fGravity = -0.035f; //force pulling every slot down each update
+	float m_fMaxVelocity = 5.0f; //velocities are clamped to this length
+	float m_fFriction = 0.1f; //fraction of the velocity lost each update
+	float m_fMinVelocity = 0.028f; //velocities shorter than this are rounded to zero
+
+	static MySolverPool* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MySolverPool* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Takes a slot from the pool, growing it if needed; the slot starts at the origin with
+	mass 1 and is not integrated by the batch
+	ARGUMENTS: ---
+	OUTPUT: slot
+	*/
+	uint Allocate(void);
+	/*
+	USAGE: Returns a slot to the pool
+	ARGUMENTS: uint a_uSlot -> slot to free
+	OUTPUT: ---
+	*/
+	void Free(uint a_uSlot);
+	/*
+	USAGE: First half of the update for all the active slots, gravity and the forces go into the
+	velocity which is then clamped, slowed by friction and rounded to zero if it is small
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void IntegrateVelocity(void);
+	/*
+	USAGE: Second half of the update for all the active slots, the velocity moves them, the ground
+	stops them and the frames at rest are counted
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void IntegratePosition(void);
+	/*
+	USAGE: Runs the first half of the update on one slot, for solvers updated on their own
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: ---
+	*/
+	void IntegrateVelocity(uint a_uSlot);
+	/*
+	USAGE: Runs the second half of the update on one slot, for solvers updated on their own
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: ---
+	*/
+	void IntegratePosition(uint a_uSlot);
+	/*
+	USAGE: Gets the number of active slots
+	ARGUMENTS: ---
+	OUTPUT: active count
+	*/
+	uint GetActiveCount(void);
+	/*
+	USAGE: Tells if the batch runs eight slots at a time
+	ARGUMENTS: ---
+	OUTPUT: is AVX2 in use?
+	*/
+	bool IsUsingAVX2(void);
+#pragma region Accessors
+	/*
+	USAGE: Gets the position of a slot
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: position
+	*/
+	vector3 GetPosition(uint a_uSlot);
+	/*
+	USAGE: Sets the position of a slot
+	ARGUMENTS:
+	-	uint a_uSlot -> slot
+	-	vector3 a_v3Position -> position to set
+	OUTPUT: ---
+	*/
+	void SetPosition(uint a_uSlot, vector3 a_v3Position);
+	/*
+	USAGE: Gets the velocity of a slot
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: velocity
+	*/
+	vector3 GetVelocity(uint a_uSlot);
+	/*
+	USAGE: Sets the velocity of a slot
+	ARGUMENTS:
+	-	uint a_uSlot -> slot
+	-	vector3 a_v3Velocity -> velocity to set
+	OUTPUT: ---
+	*/
+	void SetVelocity(uint a_uSlot, vector3 a_v3Velocity);
+	/*
+	USAGE: Gets the forces a slot accumulated since the last update
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: accumulated forces
+	*/
+	vector3 GetForce(uint a_uSlot);
+	/*
+	USAGE: Sets the forces a slot accumulated since the last update
+	ARGUMENTS:
+	-	uint a_uSlot -> slot
+	-	vector3 a_v3Force -> forces to set
+	OUTPUT: ---
+	*/
+	void SetForce(uint a_uSlot, vector3 a_v3Force);
+	/*
+	USAGE: Gets one over the mass of a slot
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: one over the mass
+	*/
+	float GetInverseMass(uint a_uSlot);
+	/*
+	USAGE: Sets one over the mass of a slot
+	ARGUMENTS:
+	-	uint a_uSlot -> slot
+	-	float a_fInverseMass -> one over the mass to set
+	OUTPUT: ---
+	*/
+	void SetInverseMass(uint a_uSlot, float a_fInverseMass);
+	/*
+	USAGE: Gets the velocity under which a slot is at rest
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: sleep velocity
+	*/
+	float GetSleepVelocity(uint a_uSlot);
+	/*
+	USAGE: Sets the velocity under which a slot is at rest
+	ARGUMENTS:
+	-	uint a_uSlot -> slot
+	-	float a_fVelocity -> velocity to set
+	OUTPUT: ---
+	*/
+	void SetSleepVelocity(uint a_uSlot, float a_fVelocity);
+	/*
+	USAGE: Gets the consecutive frames a slot has been at rest
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: frames at rest
+	*/
+	uint GetRestFrames(uint a_uSlot);
+	/*
+	USAGE: Sets the consecutive frames a slot has been at rest
+	ARGUMENTS:
+	-	uint a_uSlot -> slot
+	-	uint a_uFrames -> frames to set
+	OUTPUT: ---
+	*/
+	void SetRestFrames(uint a_uSlot, uint a_uFrames);
+	/*
+	USAGE: Tells if a slot is integrated by the batch
+	ARGUMENTS: uint a_uSlot -> slot
+	OUTPUT: is it active?
+	*/
+	bool IsActive(uint a_uSlot);
+	/*
+	USAGE: Sets if a slot is integrated by the batch
+	ARGUMENTS:
+	-	uint a_uSlot -> slot
+	-	bool a_bActive -> is it active?
+	OUTPUT: ---
+	*/
+	void SetActive(uint a_uSlot, bool a_bActive);
+#pragma endregion
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MySolverPool(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MySolverPool(MySolverPool const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MySolverPool& operator=(MySolverPool const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MySolverPool(void);
+	/*
+	Usage: releases the allocated member pointers
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Reallocates all the arrays with a new capacity keeping their content
+	ARGUMENTS: uint a_uCapacity -> new capacity (multiple of eight)
+	OUTPUT: ---
+	*/
+	void Grow(uint a_uCapacity);
+	/*
+	USAGE: Integrates the velocity of a range of slots, eight at a time
+	ARGUMENTS:
+	-	uint a_uBegin -> first slot (multiple of eight)
+	-	uint a_uEnd -> one past the last slot (multiple of eight)
+	OUTPUT: ---
+	*/
+	void IntegrateVelocityAVX2(uint a_uBegin, uint a_uEnd);
+	/*
+	USAGE: Integrates the velocity of a range of slots, four at a time
+	ARGUMENTS:
+	-	uint a_uBegin -> first slot (multiple of four)
+	-	uint a_uEnd -> one past the last slot (multiple of four)
+	OUTPUT: ---
+	*/
+	void IntegrateVelocitySSE(uint a_uBegin, uint a_uEnd);
+	/*
+	USAGE: Integrates the position of a range of slots, eight at a time
+	ARGUMENTS:
+	-	uint a_uBegin -> first slot (multiple of eight)
+	-	uint a_uEnd -> one past the last slot (multiple of eight)
+	OUTPUT: ---
+	*/
+	void IntegratePositionAVX2(uint a_uBegin, uint a_uEnd);
+	/*
+	USAGE: Integrates the position of a range of slots, four at a time
+	ARGUMENTS:
+	-	uint a_uBegin -> first slot (multiple of four)
+	-	uint a_uEnd -> one past the last slot (multiple of four)
+	OUTPUT: ---
+	*/
+	void IntegratePositionSSE(uint a_uBegin, uint a_uEnd);
+};
+
+} //namespace Simplex
+
+#endif //__MYSOLVERPOOL_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,432 @@
+#include "MySpatialHashGrid.h"
+using namespace Simplex;
+//helpers
+static bool Overlap(vector3 a_v3MinA, vector3 a_v3MaxA, vector3 a_v3MinB, vector3 a_v3MaxB)
+{
+	if (a_v3MaxA.x < a_v3MinB.x || a_v3MinA.x > a_v3MaxB.x)
+		return false;
+	if (a_v3MaxA.y < a_v3MinB.y || a_v3MinA.y > a_v3MaxB.y)
+		return false;
+	if (a_v3MaxA.z < a_v3MinB.z || a_v3MinA.z > a_v3MaxB.z)
+		return false;
+	return true;
+}
+static int Greater(int a_nA, int a_nB) { return a_nA > a_nB ? a_nA : a_nB; }
+static uint HashCell(int a_nX, int a_nY, int a_nZ)
+{
+	return static_cast<uint>(a_nX) * 73856093u ^ static_cast<uint>(a_nY) * 19349663u ^ static_cast<uint>(a_nZ) * 83492791u;
+}
+//  MySpatialHashGrid
+Simplex::MySpatialHashGrid::MySpatialHashGrid(void)
+{
+	m_cellTable.resize(64);
+	for (uint i = 0; i < m_cellTable.size(); ++i)
+		m_cellTable[i].m_uStamp = 0;
+	m_threadPairList.resize(MyJobSystem::GetInstance()->GetThreadCount());
+}
+Simplex::MySpatialHashGrid::MySpatialHashGrid(MySpatialHashGrid const& other) { }
+Simplex::MySpatialHashGrid& Simplex::MySpatialHashGrid::operator=(MySpatialHashGrid const& other) { return *this; }
+Simplex::MySpatialHashGrid::~MySpatialHashGrid(void)
+{
+	m_pEntityArray = nullptr;
+	m_uEntityCount = 0;
+}
+//Accessors
+Simplex::String Simplex::MySpatialHashGrid::GetName(void) { return "Spatial Hash Grid"; }
+float Simplex::MySpatialHashGrid::GetCellSize(void) { return m_fCellSize; }
+Simplex::uint Simplex::MySpatialHashGrid::GetCellCount(void) { return static_cast<uint>(m_usedCellList.size()); }
+//Grid
+Simplex::uint Simplex::MySpatialHashGrid::FindCell(int a_nX, int a_nY, int a_nZ)
+{
+	uint uMask = static_cast<uint>(m_cellTable.size()) - 1;
+	uint uBucket = HashCell(a_nX, a_nY, a_nZ) & uMask;
+
+	//linear probing, buckets stamped with an older update are empty
+	while (m_cellTable[uBucket].m_uStamp == m_uStamp)
+	{
+		MyGridCell& cell = m_cellTable[uBucket];
+		if (cell.m_nX == a_nX && cell.m_nY == a_nY && cell.m_nZ == a_nZ)
+			return uBucket;
+		uBucket = (uBucket + 1) & uMask;
+	}
+
+	MyGridCell& cell = m_cellTable[uBucket];
+	cell.m_nX = a_nX;
+	cell.m_nY = a_nY;
+	cell.m_nZ = a_nZ;
+	cell.m_uStamp = m_uStamp;
+	cell.m_uStart = 0;
+	cell.m_uCount = 0;
+	m_usedCellList.push_back(uBucket);
+	return uBucket;
+}
+int Simplex::MySpatialHashGrid::LookupCell(int a_nX, int a_nY, int a_nZ)
+{
+	uint uMask = static_cast<uint>(m_cellTable.size()) - 1;
+	uint uBucket = HashCell(a_nX, a_nY, a_nZ) & uMask;
+	while (m_cellTable[uBucket].m_uStamp == m_uStamp)
+	{
+		MyGridCell& cell = m_cellTable[uBucket];
+		if (cell.m_nX == a_nX && cell.m_nY == a_nY && cell.m_nZ == a_nZ)
+			return static_cast<int>(uBucket);
+		uBucket = (uBucket + 1) & uMask;
+	}
+	return -1;
+}
+void Simplex::MySpatialHashGrid::Update(PEntity* a_pEntityArray, uint a_uEntityCount)
+{
+	m_pEntityArray = a_pEntityArray;
+	m_uEntityCount = a_uEntityCount;
+	m_usedCellList.clear();
+	m_insertList.clear();
+	m_largeList.clear();
+	if (m_uEntityCount == 0)
+		return;
+
+	m_minList.resize(m_uEntityCount);
+	m_maxList.resize(m_uEntityCount);
+	m_cellMinList.resize(m_uEntityCount);
+	m_cellMaxList.resize(m_uEntityCount);
+	m_extentList.resize(m_uEntityCount);
+
+	//gather the ARBBs and their largest extent
+	MyJobSystem* pJobSystem = MyJobSystem::GetInstance();
+	pJobSystem->ParallelFor(m_uEntityCount, 256, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		for (uint i = a_uBegin; i < a_uEnd; ++i)
+		{
+			MyRigidBody* pRigidBody = m_pEntityArray[i]->GetRigidBody();
+			m_minList[i] = pRigidBody->GetMinGlobal();
+			m_maxList[i] = pRigidBody->GetMaxGlobal();
+			vector3 v3Size = m_maxList[i] - m_minList[i];
+			float fExtent = v3Size.x;
+			if (fExtent < v3Size.y)
+				fExtent = v3Size.y;
+			if (fExtent < v3Size.z)
+				fExtent = v3Size.z;
+			m_extentList[i] = fExtent;
+		}
+	});
+
+	//the cells are as big as the median entity so most entities cover 8 cells at most
+	std::nth_element(m_extentList.begin(), m_extentList.begin() + m_uEntityCount / 2, m_extentList.end());
+	m_fCellSize = m_extentList[m_uEntityCount / 2];
+	if (m_fCellSize < 0.01f)
+		m_fCellSize = 0.01f;
+
+	//cells covered by each entity
+	float fInvCellSize = 1.0f / m_fCellSize;
+	uint uInsertCount = 0;
+	m_v3Min = m_minList[0];
+	m_v3Max = m_maxList[0];
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		m_v3Min = (glm::min)(m_v3Min, m_minList[i]);
+		m_v3Max = (glm::max)(m_v3Max, m_maxList[i]);
+		vector3 v3Min = glm::floor(m_minList[i] * fInvCellSize);
+		vector3 v3Max = glm::floor(m_maxList[i] * fInvCellSize);
+		m_cellMinList[i] = glm::ivec3(v3Min);
+		m_cellMaxList[i] = glm::ivec3(v3Max);
+		vector3 v3Count = v3Max - v3Min + vector3(1.0f);
+		float fCount = v3Count.x * v3Count.y * v3Count.z;
+		if (fCount > static_cast<float>(m_uMaxCellsPerEntity))
+			m_largeList.push_back(i);
+		else
+			uInsertCount += static_cast<uint>(fCount);
+	}
+
+	//keep the table at most half full, it only grows
+	uint uTableSize = static_cast<uint>(m_cellTable.size());
+	if (uTableSize < uInsertCount * 2)
+	{
+		while (uTableSize < uInsertCount * 2)
+			uTableSize *= 2;
+		m_cellTable.resize(uTableSize);
+		for (uint i = 0; i < uTableSize; ++i)
+			m_cellTable[i].m_uStamp = 0;
+		m_uStamp = 0;
+	}
+	//a new stamp empties the table without touching it
+	++m_uStamp;
+	if (m_uStamp == 0)
+	{
+		for (uint i = 0; i < uTableSize; ++i)
+			m_cellTable[i].m_uStamp = 0;
+		m_uStamp = 1;
+	}
+
+	//counting sort, first count the entries of each cell
+	uint uLarge = 0;
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		if (uLarge < m_largeList.size() && m_largeList[uLarge] == i)
+		{
+			++uLarge;
+			continue;
+		}
+		glm::ivec3 v3CellMin = m_cellMinList[i];
+		glm::ivec3 v3CellMax = m_cellMaxList[i];
+		for (int x = v3CellMin.x; x <= v3CellMax.x; ++x)
+		{
+			for (int y = v3CellMin.y; y <= v3CellMax.y; ++y)
+			{
+				for (int z = v3CellMin.z; z <= v3CellMax.z; ++z)
+				{
+					uint uBucket = FindCell(x, y, z);
+					++m_cellTable[uBucket].m_uCount;
+					m_insertList.push_back(uBucket);
+				}
+			}
+		}
+	}
+
+	//then where each cell starts
+	uint uSum = 0;
+	for (uint i = 0; i < m_usedCellList.size(); ++i)
+	{
+		MyGridCell& cell = m_cellTable[m_usedCellList[i]];
+		cell.m_uStart = uSum;
+		uSum += cell.m_uCount;
+		cell.m_uCount = 0;
+	}
+
+	//and place the entities, in order so each cell lists them sorted
+	m_entryList.resize(uSum);
+	uint uInsert = 0;
+	uLarge = 0;
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		if (uLarge < m_largeList.size() && m_largeList[uLarge] == i)
+		{
+			++uLarge;
+			continue;
+		}
+		glm::ivec3 v3Count = m_cellMaxList[i] - m_cellMinList[i] + glm::ivec3(1);
+		uint uCellCount = static_cast<uint>(v3Count.x * v3Count.y * v3Count.z);
+		for (uint uCell = 0; uCell < uCellCount; ++uCell)
+		{
+			MyGridCell& cell = m_cellTable[m_insertList[uInsert++]];
+			m_entryList[cell.m_uStart + cell.m_uCount++] = i;
+		}
+	}
+}
+//Broad phase
+void Simplex::MySpatialHashGrid::GetPairs(std::vector<MyBroadPhasePair>& a_pairList)
+{
+	a_pairList.clear();
+	for (uint i = 0; i < m_threadPairList.size(); ++i)
+		m_threadPairList[i].clear();
+
+	MyJobSystem* pJobSystem = MyJobSystem::GetInstance();
+	pJobSystem->ParallelFor(static_cast<uint>(m_usedCellList.size()), 32, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		std::vector<MyBroadPhasePair>& pairList = m_threadPairList[a_uThread];
+		for (uint uCell = a_uBegin; uCell < a_uEnd; ++uCell)
+		{
+			MyGridCell& cell = m_cellTable[m_usedCellList[uCell]];
+			uint uEnd = cell.m_uStart + cell.m_uCount;
+			for (uint uA = cell.m_uStart; uA < uEnd; ++uA)
+			{
+				uint i = m_entryList[uA];
+				bool bAsleep = m_pEntityArray[i]->IsAsleep();
+				for (uint uB = uA + 1; uB < uEnd; ++uB)
+				{
+					uint j = m_entryList[uB];
+
+					//only the first cell both entities cover reports the pair
+					if (Greater(m_cellMinList[i].x, m_cellMinList[j].x) != cell.m_nX ||
+						Greater(m_cellMinList[i].y, m_cellMinList[j].y) != cell.m_nY ||
+						Greater(m_cellMinList[i].z, m_cellMinList[j].z) != cell.m_nZ)
+						continue;
+
+					//two sleeping entities cannot change each other
+					if (bAsleep && m_pEntityArray[j]->IsAsleep())
+						continue;
+
+					if (!Overlap(m_minList[i], m_maxList[i], m_minList[j], m_maxList[j]))
+						continue;
+
+					MyBroadPhasePair pair;
+					pair.m_uA = i;
+					pair.m_uB = j;
+					pairList.push_back(pair);
+				}
+			}
+		}
+	});
+
+	//the large entities are tested against everybody
+	pJobSystem->ParallelFor(static_cast<uint>(m_largeList.size()), 1, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+	{
+		std::vector<MyBroadPhasePair>& pairList = m_threadPairList[a_uThread];
+		for (uint uLarge = a_uBegin; uLarge < a_uEnd; ++uLarge)
+		{
+			uint i = m_largeList[uLarge];
+			bool bAsleep = m_pEntityArray[i]->IsAsleep();
+			for (uint j = 0; j < m_uEntityCount; ++j)
+			{
+				if (j == i)
+					continue;
+				//pairs of large entities are reported by the first one
+				glm::ivec3 v3Count = m_cellMaxList[j] - m_cellMinList[j] + glm::ivec3(1);
+				if (static_cast<float>(v3Count.x) * v3Count.y * v3Count.z > static_cast<float>(m_uMaxCellsPerEntity) && j < i)
+					continue;
+				if (bAsleep && m_pEntityArray[j]->IsAsleep())
+					continue;
+				if (!Overlap(m_minList[i], m_maxList[i], m_minList[j], m_maxList[j]))
+					continue;
+
+				MyBroadPhasePair pair;
+				pair.m_uA = i < j ? i : j;
+				pair.m_uB = i < j ? j : i;
+				pairList.push_back(pair);
+			}
+		}
+	});
+
+	for (uint i = 0; i < m_threadPairList.size(); ++i)
+		a_pairList.insert(a_pairList.end(), m_threadPairList[i].begin(), m_threadPairList[i].end());
+}
+//Queries
+void Simplex::MySpatialHashGrid::QueryCell(int a_nX, int a_nY, int a_nZ, vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList)
+{
+	int nBucket = LookupCell(a_nX, a_nY, a_nZ);
+	if (nBucket < 0)
+		return;
+
+	MyGridCell& cell = m_cellTable[nBucket];
+	uint uEnd = cell.m_uStart + cell.m_uCount;
+	for (uint uEntry = cell.m_uStart; uEntry < uEnd; ++uEntry)
+	{
+		uint i = m_entryList[uEntry];
+		if (Overlap(a_v3Min, a_v3Max, m_minList[i], m_maxList[i]))
+			a_entityList.push_back(i);
+	}
+}
+void Simplex::MySpatialHashGrid::QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	if (m_uEntityCount == 0 || !Overlap(a_v3Min, a_v3Max, m_v3Min, m_v3Max))
+		return;
+
+	//only the part of the box inside the grid has cells
+	float fInvCellSize = 1.0f / m_fCellSize;
+	glm::ivec3 v3CellMin = glm::ivec3(glm::floor((glm::max)(a_v3Min, m_v3Min) * fInvCellSize));
+	glm::ivec3 v3CellMax = glm::ivec3(glm::floor((glm::min)(a_v3Max, m_v3Max) * fInvCellSize));
+	glm::vec3 v3Count = glm::vec3(v3CellMax - v3CellMin + glm::ivec3(1));
+	if (v3Count.x * v3Count.y * v3Count.z > static_cast<float>(m_usedCellList.size()))
+	{
+		//boxes bigger than the grid are cheaper to test against every used cell
+		for (uint uCell = 0; uCell < m_usedCellList.size(); ++uCell)
+		{
+			MyGridCell& cell = m_cellTable[m_usedCellList[uCell]];
+			if (cell.m_nX >= v3CellMin.x && cell.m_nX <= v3CellMax.x &&
+				cell.m_nY >= v3CellMin.y && cell.m_nY <= v3CellMax.y &&
+				cell.m_nZ >= v3CellMin.z && cell.m_nZ <= v3CellMax.z)
+				QueryCell(cell.m_nX, cell.m_nY, cell.m_nZ, a_v3Min, a_v3Max, a_entityList);
+		}
+	}
+	else
+	{
+		for (int x = v3CellMin.x; x <= v3CellMax.x; ++x)
+			for (int y = v3CellMin.y; y <= v3CellMax.y; ++y)
+				for (int z = v3CellMin.z; z <= v3CellMax.z; ++z)
+					QueryCell(x, y, z, a_v3Min, a_v3Max, a_entityList);
+	}
+
+	for (uint uLarge = 0; uLarge < m_largeList.size(); ++uLarge)
+	{
+		uint i = m_largeList[uLarge];
+		if (Overlap(a_v3Min, a_v3Max, m_minList[i], m_maxList[i]))
+			a_entityList.push_back(i);
+	}
+
+	//entities covering several cells are found once per cell
+	std::sort(a_entityList.begin(), a_entityList.end());
+	a_entityList.erase(std::unique(a_entityList.begin(), a_entityList.end()), a_entityList.end());
+}
+void Simplex::MySpatialHashGrid::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+	std::vector<uint>& a_entityList)
+{
+	a_entityList.clear();
+	if (m_uEntityCount == 0)
+		return;
+
+	//only the part of the ray inside the grid has cells to visit
+	vector3 v3Radius = vector3(a_fRadius);
+	float fEnter, fExit;
+	if (!IntersectRayAABB(a_v3Origin, a_v3Direction, a_fMaxDistance, m_v3Min - v3Radius, m_v3Max + v3Radius, fEnter, fExit))
+		return;
+
+	//the boxes grown by the radius can reach this many cells away from the ones they cover
+	float fInvCellSize = 1.0f / m_fCellSize;
+	int nReach = static_cast<int>(glm::ceil(a_fRadius * fInvCellSize));
+
+	//first cell and where the ray crosses the next cell boundary in each axis
+	glm::ivec3 v3Cell = glm::ivec3(glm::floor((a_v3Origin + a_v3Direction * fEnter) * fInvCellSize));
+	glm::ivec3 v3Step;
+	vector3 v3Next;
+	vector3 v3Delta;
+	for (uint uAxis = 0; uAxis < 3; ++uAxis)
+	{
+		float fDirection = a_v3Direction[uAxis];
+		if (fDirection == 0.0f)
+		{
+			v3Step[uAxis] = 0;
+			v3Next[uAxis] = FLT_MAX;
+			v3Delta[uAxis] = FLT_MAX;
+			continue;
+		}
+		v3Step[uAxis] = fDirection > 0.0f ? 1 : -1;
+		float fBoundary = (v3Cell[uAxis] + (fDirection > 0.0f ? 1 : 0)) * m_fCellSize;
+		v3Next[uAxis] = (fBoundary - a_v3Origin[uAxis]) / fDirection;
+		v3Delta[uAxis] = m_fCellSize / glm::abs(fDirection);
+	}
+
+	//the cells along the ray, and their neighbors when the boxes are grown
+	float fT = fEnter;
+	while (fT <= fExit)
+	{
+		for (int x = v3Cell.x - nReach; x <= v3Cell.x + nReach; ++x)
+		{
+			for (int y = v3Cell.y - nReach; y <= v3Cell.y + nReach; ++y)
+			{
+				for (int z = v3Cell.z - nReach; z <= v3Cell.z + nReach; ++z)
+				{
+					int nBucket = LookupCell(x, y, z);
+					if (nBucket < 0)
+						continue;
+					MyGridCell& cell = m_cellTable[nBucket];
+					uint uEnd = cell.m_uStart + cell.m_uCount;
+					for (uint uEntry = cell.m_uStart; uEntry < uEnd; ++uEntry)
+					{
+						uint i = m_entryList[uEntry];
+						float fEnterBox, fExitBox;
+						if (IntersectRayAABB(a_v3Origin, a_v3Direction, a_fMaxDistance, m_minList[i] - v3Radius, m_maxList[i] + v3Radius, fEnterBox, fExitBox))
+							a_entityList.push_back(i);
+					}
+				}
+			}
+		}
+
+		uint uAxis = 0;
+		if (v3Next[1] < v3Next[uAxis])
+			uAxis = 1;
+		if (v3Next[2] < v3Next[uAxis])
+			uAxis = 2;
+		fT = v3Next[uAxis];
+		v3Cell[uAxis] += v3Step[uAxis];
+		v3Next[uAxis] += v3Delta[uAxis];
+	}
+
+	for (uint uLarge = 0; uLarge < m_largeList.size(); ++uLarge)
+	{
+		uint i = m_largeList[uLarge];
+		if (IntersectRayAABB(a_v3Origin, a_v3Direction, a_fMaxDistance, m_minList[i] - v3Radius, m_maxList[i] + v3Radius, fEnter, fExit))
+			a_entityList.push_back(i);
+	}
+
+	//entities covering several cells are found once per cell
+	std::sort(a_entityList.begin(), a_entityList.end());
+	a_entityList.erase(std::unique(a_entityList.begin(), a_entityList.end()), a_entityList.end());
+}
\ No newline at end of file
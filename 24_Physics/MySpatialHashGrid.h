@@ -0,0 +1,170 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYSPATIALHASHGRID_H_
+#define __MYSPATIALHASHGRID_H_
+
+#include "MyBroadPhase.h"
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+//Bucket of the hash table, its entities are a contiguous range of the entry list
+struct MyGridCell
+{
+	int m_nX; //cell coordinate in x
+	int m_nY; //cell coordinate in y
+	int m_nZ; //cell coordinate in z
+	uint m_uStamp; //update in which the bucket was used, older buckets are empty
+	uint m_uStart; //first entry of the entry list in the cell
+	uint m_uCount; //number of entries in the cell
+};
+
+//Uniform grid stored in an open addressing hash table, rebuilt every update
+class MySpatialHashGrid : public MyBroadPhase
+{
+	PEntity* m_pEntityArray = nullptr; //list of entities of the last update
+	uint m_uEntityCount = 0; //number of entities of the last update
+
+	float m_fCellSize = 1.0f; //size of the cells, the median extent of the entities
+	vector3 m_v3Min = ZERO_V3; //minimum corner of the ARBBs of all the entities
+	vector3 m_v3Max = ZERO_V3; //maximum corner of the ARBBs of all the entities
+	uint m_uMaxCellsPerEntity = 64; //entities covering more cells than this are tested on their own
+
+	//the lists keep their memory between updates so rebuilding does not allocate
+	std::vector<MyGridCell> m_cellTable; //hash table of cells (power of two size)
+	uint m_uStamp = 0; //stamp of the current update
+	std::vector<uint> m_usedCellList; //buckets used in this update
+	std::vector<vector3> m_minList; //minimum corner of the ARBB of each entity
+	std::vector<vector3> m_maxList; //maximum corner of the ARBB of each entity
+	std::vector<glm::ivec3> m_cellMinList; //first cell covered by each entity
+	std::vector<glm::ivec3> m_cellMaxList; //last cell covered by each entity
+	std::vector<float> m_extentList; //scratch list to find the median extent
+	std::vector<uint> m_insertList; //bucket of each insertion, in the order of the entities
+	std::vector<uint> m_entryList; //entities sorted by cell
+	std::vector<uint> m_largeList; //entities covering too many cells
+	std::vector<std::vector<MyBroadPhasePair>> m_threadPairList; //pairs found by each thread
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object instance
+	*/
+	MySpatialHashGrid(void);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MySpatialHashGrid(void);
+	/*
+	USAGE: Rebuilds the grid, the entities are bucketed by cell with a counting sort
+	ARGUMENTS:
+	-	PEntity* a_pEntityArray -> list of entities
+	-	uint a_uEntityCount -> number of entities in the list
+	OUTPUT: ---
+	*/
+	void Update(PEntity* a_pEntityArray, uint a_uEntityCount) override;
+	/*
+	USAGE: Gets the pairs of entities whose ARBBs overlap, each pair is only reported by the
+	first cell both entities share
+	ARGUMENTS: std::vector<MyBroadPhasePair>& a_pairList -> list to fill (will be cleared first)
+	OUTPUT: ---
+	*/
+	void GetPairs(std::vector<MyBroadPhasePair>& a_pairList) override;
+	/*
+	USAGE: Gets the name of the broad phase
+	ARGUMENTS: ---
+	OUTPUT: name
+	*/
+	String GetName(void) override;
+	/*
+	USAGE: Gets the size of the cells of the last update
+	ARGUMENTS: ---
+	OUTPUT: cell size
+	*/
+	float GetCellSize(void);
+	/*
+	USAGE: Gets the number of cells used in the last update
+	ARGUMENTS: ---
+	OUTPUT: cell count
+	*/
+	uint GetCellCount(void);
+	/*
+	USAGE: Gets the entities whose ARBB overlaps an AABB, only the cells covered by the AABB are visited
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void QueryAABB(vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList) override;
+	/*
+	USAGE: Gets the entities whose ARBB, grown by a radius, is hit by a ray, the cells are visited
+	in order along the ray (3D DDA)
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> origin of the ray
+	-	vector3 a_v3Direction -> direction of the ray (does not need to be normalized)
+	-	float a_fMaxDistance -> length of the ray in units of the direction
+	-	float a_fRadius -> how much the boxes grow
+	-	std::vector<uint>& a_entityList -> list to fill with entity indices (will be cleared first)
+	OUTPUT: ---
+	*/
+	void RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float a_fMaxDistance, float a_fRadius,
+		std::vector<uint>& a_entityList) override;
+private:
+	/*
+	USAGE: copy constructor, grids are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MySpatialHashGrid(MySpatialHashGrid const& other);
+	/*
+	USAGE: copy assignment operator, grids are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MySpatialHashGrid& operator=(MySpatialHashGrid const& other);
+	/*
+	USAGE: Finds the bucket of a cell, claiming an empty one if the cell is not in the table
+	ARGUMENTS:
+	-	int a_nX -> cell coordinate in x
+	-	int a_nY -> cell coordinate in y
+	-	int a_nZ -> cell coordinate in z
+	OUTPUT: index of the bucket
+	*/
+	uint FindCell(int a_nX, int a_nY, int a_nZ);
+	/*
+	USAGE: Finds the bucket of a cell without changing the table
+	ARGUMENTS:
+	-	int a_nX -> cell coordinate in x
+	-	int a_nY -> cell coordinate in y
+	-	int a_nZ -> cell coordinate in z
+	OUTPUT: index of the bucket, -1 if the cell is empty
+	*/
+	int LookupCell(int a_nX, int a_nY, int a_nZ);
+	/*
+	USAGE: Adds the entities of a cell that overlap an AABB to a list
+	ARGUMENTS:
+	-	int a_nX -> cell coordinate in x
+	-	int a_nY -> cell coordinate in y
+	-	int a_nZ -> cell coordinate in z
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	-	std::vector<uint>& a_entityList -> list to add to (entities can end up more than once)
+	OUTPUT: ---
+	*/
+	void QueryCell(int a_nX, int a_nY, int a_nZ, vector3 a_v3Min, vector3 a_v3Max, std::vector<uint>& a_entityList);
+};
+
+} //namespace Simplex
+
+#endif //__MYSPATIALHASHGRID_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
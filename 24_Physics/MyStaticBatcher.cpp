@@ -0,0 +1,270 @@
+#include "MyStaticBatcher.h"
+#include "MyRenderThread.h"
+using namespace Simplex;
+//  MyStaticBatcher
+MyStaticBatcher::MyStaticBatcher(float a_fClusterSize)
+{
+	m_fClusterSize = a_fClusterSize < 1.0f ? 1.0f : a_fClusterSize;
+	m_pMeshMngr = MeshManager::GetInstance();
+}
+MyStaticBatcher::MyStaticBatcher(MyStaticBatcher const& other) {}
+MyStaticBatcher& MyStaticBatcher::operator=(MyStaticBatcher const& other) { return *this; }
+MyStaticBatcher::~MyStaticBatcher(void)
+{
+	//the combined meshes belong to the MeshManager
+	m_clusterList.clear();
+	m_clusterMap.clear();
+	m_entityMap.clear();
+	m_pMeshMngr = nullptr;
+}
+uint MyStaticBatcher::GetClusterCount(void)
+{
+	uint uCount = 0;
+	for (uint i = 0; i < m_clusterList.size(); ++i)
+	{
+		if (m_clusterList[i].m_entityList.size() > 0)
+			++uCount;
+	}
+	return uCount;
+}
+uint MyStaticBatcher::GetEntityCount(void) { return m_entityMap.size(); }
+uint MyStaticBatcher::GetDrawnCount(void) { return m_uDrawnCount; }
+uint MyStaticBatcher::GetBuildCount(void) { return m_uBuildCount; }
+bool MyStaticBatcher::Contains(MyEntity* a_pEntity) { return m_entityMap.find(a_pEntity) != m_entityMap.end(); }
+uint MyStaticBatcher::GetCluster(int a_nMaterial, vector3 a_v3Position)
+{
+	glm::ivec3 v3Cell = glm::ivec3(glm::floor(a_v3Position / m_fClusterSize));
+	//16 bits for the material and each coordinate of the cell
+	uint64_t uKey = static_cast<uint64_t>(a_nMaterial & 0xFFFF) << 48;
+	uKey |= static_cast<uint64_t>((v3Cell.x + 32768) & 0xFFFF) << 32;
+	uKey |= static_cast<uint64_t>((v3Cell.y + 32768) & 0xFFFF) << 16;
+	uKey |= static_cast<uint64_t>((v3Cell.z + 32768) & 0xFFFF);
+
+	auto cluster = m_clusterMap.find(uKey);
+	if (cluster != m_clusterMap.end())
+		return cluster->second;
+
+	MyStaticCluster newCluster;
+	newCluster.m_nMaterial = a_nMaterial;
+	newCluster.m_v3Cell = v3Cell;
+	m_clusterList.push_back(newCluster);
+	uint uIndex = m_clusterList.size() - 1;
+	m_clusterMap[uKey] = uIndex;
+	return uIndex;
+}
+bool MyStaticBatcher::Add(MyEntity* a_pEntity)
+{
+	if (a_pEntity == nullptr || a_pEntity->GetMeshCount() == 0)
+		return false;
+	if (Contains(a_pEntity))
+		return true;
+
+	//the cell is picked by the center so every mesh of the entity lands in the same space
+	MyRigidBody* pRigidBody = a_pEntity->GetRigidBody();
+	vector3 v3Min = pRigidBody->GetMinGlobal();
+	vector3 v3Max = pRigidBody->GetMaxGlobal();
+	vector3 v3Center = (v3Min + v3Max) * 0.5f;
+
+	std::vector<uint>& clusterList = m_entityMap[a_pEntity];
+	MyTextureAtlas* pAtlas = MyTextureAtlas::GetInstance();
+	for (uint i = 0; i < a_pEntity->GetMeshCount(); ++i)
+	{
+		Mesh* pMesh = m_pMeshMngr->GetMesh(a_pEntity->GetMeshIndex(i));
+		if (pMesh == nullptr)
+			continue;
+		//meshes with their texture in the atlas share the cluster of the page
+		uint uCluster = GetCluster(pAtlas->GetMeshMaterial(a_pEntity->GetMeshIndex(i)), v3Center);
+		//entities with many meshes of one material are added once
+		if (std::find(clusterList.begin(), clusterList.end(), uCluster) != clusterList.end())
+			continue;
+		clusterList.push_back(uCluster);
+
+		MyStaticCluster& cluster = m_clusterList[uCluster];
+		cluster.m_entityList.push_back(a_pEntity);
+		cluster.m_v3Min = (glm::min)(cluster.m_v3Min, v3Min);
+		cluster.m_v3Max = (glm::max)(cluster.m_v3Max, v3Max);
+		cluster.m_bDirty = true;
+	}
+	return true;
+}
+void MyStaticBatcher::Remove(MyEntity* a_pEntity)
+{
+	auto entity = m_entityMap.find(a_pEntity);
+	if (entity == m_entityMap.end())
+		return;
+
+	//the meshes are rebuilt when the cluster is drawn, not now
+	for (uint i = 0; i < entity->second.size(); ++i)
+	{
+		MyStaticCluster& cluster = m_clusterList[entity->second[i]];
+		auto found = std::find(cluster.m_entityList.begin(), cluster.m_entityList.end(), a_pEntity);
+		if (found != cluster.m_entityList.end())
+		{
+			*found = cluster.m_entityList.back();
+			cluster.m_entityList.pop_back();
+		}
+		cluster.m_bDirty = true;
+	}
+	m_entityMap.erase(entity);
+}
+void MyStaticBatcher::Clear(void)
+{
+	for (uint i = 0; i < m_clusterList.size(); ++i)
+	{
+		m_clusterList[i].m_entityList.clear();
+		m_clusterList[i].m_bDirty = true;
+	}
+	m_entityMap.clear();
+}
+void MyStaticBatcher::Build(MyStaticCluster& a_cluster)
+{
+	std::vector<vector3> positionList;
+	std::vector<vector3> colorList;
+	std::vector<vector3> normalList;
+	std::vector<vector3> uvList;
+
+	MyTextureAtlas* pAtlas = MyTextureAtlas::GetInstance();
+	a_cluster.m_v3Min = vector3(FLT_MAX);
+	a_cluster.m_v3Max = vector3(-FLT_MAX);
+	for (uint i = 0; i < a_cluster.m_entityList.size(); ++i)
+	{
+		MyEntity* pEntity = a_cluster.m_entityList[i];
+		matrix4 m4ToWorld = pEntity->GetModelMatrix();
+		matrix3 m3Normal = glm::transpose(glm::inverse(matrix3(m4ToWorld)));
+		MyRigidBody* pRigidBody = pEntity->GetRigidBody();
+		a_cluster.m_v3Min = (glm::min)(a_cluster.m_v3Min, pRigidBody->GetMinGlobal());
+		a_cluster.m_v3Max = (glm::max)(a_cluster.m_v3Max, pRigidBody->GetMaxGlobal());
+
+		for (uint j = 0; j < pEntity->GetMeshCount(); ++j)
+		{
+			uint uMesh = pEntity->GetMeshIndex(j);
+			Mesh* pMesh = m_pMeshMngr->GetMesh(uMesh);
+			if (pMesh == nullptr || pAtlas->GetMeshMaterial(uMesh) != a_cluster.m_nMaterial)
+				continue;
+
+			//vertices are baked in world space, the cluster is drawn with the identity
+			std::vector<vector3> vertexList = pMesh->GetVertexList();
+			uint uFirst = positionList.size();
+			for (uint k = 0; k < vertexList.size(); ++k)
+			{
+				positionList.push_back(vector3(m4ToWorld * vector4(vertexList[k], 1.0f)));
+			}
+
+			//lists the mesh does not have (or has partially) get the defaults CompleteMesh would use
+			std::vector<vector3> list = pMesh->GetColorList();
+			for (uint k = 0; k < vertexList.size(); ++k)
+			{
+				colorList.push_back(k < list.size() ? list[k] : vector3(1.0f));
+			}
+			//UVs of textures in the atlas are moved to their place in the page
+			list = pMesh->GetUVList();
+			vector4 v4Rect = pAtlas->GetMeshRect(uMesh);
+			for (uint k = 0; k < vertexList.size(); ++k)
+			{
+				vector3 v3UV = k < list.size() ? list[k] : ZERO_V3;
+				uvList.push_back(vector3(v3UV.x * v4Rect.z + v4Rect.x, v3UV.y * v4Rect.w + v4Rect.y, v3UV.z));
+			}
+			list = pMesh->GetNormalList();
+			for (uint k = 0; k < vertexList.size(); ++k)
+			{
+				if (k < list.size())
+					normalList.push_back(glm::normalize(m3Normal * list[k]));
+				else
+				{
+					//flat normal of the triangle the vertex belongs to
+					uint uTriangle = uFirst + k - k % 3;
+					vector3 v3Normal = AXIS_Y;
+					if (uTriangle + 2 < uFirst + vertexList.size())
+					{
+						vector3 v3Cross = glm::cross(positionList[uTriangle + 1] - positionList[uTriangle], positionList[uTriangle + 2] - positionList[uTriangle]);
+						if (glm::length(v3Cross) > 0.0f)
+							v3Normal = glm::normalize(v3Cross);
+					}
+					normalList.push_back(v3Normal);
+				}
+			}
+		}
+	}
+	a_cluster.m_bDirty = false;
+	//the mesh is kept for the next build that has vertices, its old ones must not be drawn meanwhile
+	a_cluster.m_bEmpty = positionList.size() == 0;
+	if (a_cluster.m_bEmpty)
+		return;
+
+	//the buffers are created (or swapped under the mesh being drawn) on the render thread between frames
+	MyRenderQueue* pRenderQueue = MyRenderQueue::GetInstance();
+	bool bNew = a_cluster.m_nMesh < 0;
+	MyRenderThread::GetInstance()->Invoke([&]()
+	{
+		Mesh* pMesh = new Mesh();
+		pMesh->AddVertexPositionList(positionList);
+		pMesh->AddVertexColorList(colorList);
+		pMesh->AddVertexNormalList(normalList);
+		pMesh->AddVertexUVList(uvList);
+		pMesh->SetMaterial(a_cluster.m_nMaterial);
+		pMesh->CompileOpenGL3X();
+
+		if (bNew)
+		{
+			a_cluster.m_nMesh = m_pMeshMngr->AddMesh(pMesh);
+		}
+		else
+		{
+			//the index stays the same, the old buffers leave with the temporary mesh
+			m_pMeshMngr->GetMesh(a_cluster.m_nMesh)->Swap(*pMesh);
+			SafeDelete(pMesh);
+		}
+	});
+	if (bNew)
+		pRenderQueue->AddOccluder(a_cluster.m_nMesh);
+	else
+		pRenderQueue->GetOcclusionCuller()->ForgetMesh(a_cluster.m_nMesh);
+}
+void MyStaticBatcher::AddToRenderList(void)
+{
+	m_uDrawnCount = 0;
+	m_uBuildCount = 0;
+	MyRenderQueue* pRenderQueue = MyRenderQueue::GetInstance();
+	matrix4 m4ViewProjection = pRenderQueue->GetViewProjection();
+	MyCommandBuffer* pBuffer = pRenderQueue->GetBuffer();
+
+	for (uint i = 0; i < m_clusterList.size(); ++i)
+	{
+		MyStaticCluster& cluster = m_clusterList[i];
+		if (cluster.m_entityList.size() == 0)
+			continue;
+
+		//the cluster is outside the frustum if all its corners are outside the same plane
+		uint uOutside[6] = { 0, 0, 0, 0, 0, 0 };
+		for (uint j = 0; j < 8; ++j)
+		{
+			vector3 v3Corner = vector3(j & 1 ? cluster.m_v3Max.x : cluster.m_v3Min.x, j & 2 ? cluster.m_v3Max.y : cluster.m_v3Min.y, j & 4 ? cluster.m_v3Max.z : cluster.m_v3Min.z);
+			vector4 v4Clip = m4ViewProjection * vector4(v3Corner, 1.0f);
+			for (uint k = 0; k < 3; ++k)
+			{
+				if (v4Clip[k] < -v4Clip.w) ++uOutside[k * 2];
+				if (v4Clip[k] > v4Clip.w) ++uOutside[k * 2 + 1];
+			}
+		}
+		bool bVisible = true;
+		for (uint k = 0; k < 6; ++k)
+		{
+			if (uOutside[k] == 8)
+				bVisible = false;
+		}
+		if (!bVisible)
+			continue;
+
+		//clusters that changed are only rebuilt when they are seen
+		if (cluster.m_bDirty)
+		{
+			Build(cluster);
+			++m_uBuildCount;
+		}
+		if (cluster.m_nMesh < 0 || cluster.m_bEmpty)
+			continue;
+
+		pBuffer->Push(cluster.m_nMesh, RENDER_SOLID, IDENTITY_M4);
+		++m_uDrawnCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYSTATICBATCHER_H_
+#define __MYSTATICBATCHER_H_
+
+#include "MyEntity.h"
+
+namespace Simplex
+{
+
+//Static entities of one material inside one cell of space, drawn as a single mesh
+struct MyStaticCluster
+{
+	int m_nMaterial = 0; //material shared by the meshes of the cluster, the page material for textures in the atlas
+	glm::ivec3 m_v3Cell = glm::ivec3(0); //cell of the space the cluster covers
+	std::vector<MyEntity*> m_entityList; //entities baked into the mesh
+	int m_nMesh = -1; //index of the combined mesh in the MeshManager, -1 until the first build
+	bool m_bEmpty = true; //did the last build have no vertices? (the mesh keeps the old ones and is not drawn)
+	bool m_bDirty = true; //did the entity list change since the last build?
+	vector3 m_v3Min = vector3(FLT_MAX); //world bounds, only grow until the next build
+	vector3 m_v3Max = vector3(-FLT_MAX);
+};
+
+//Merges the meshes of static entities sharing a material into one combined mesh per cluster of space,
+//the vertices are baked in world space so each cluster is a single draw call culled as a whole
+class MyStaticBatcher
+{
+	float m_fClusterSize = 16.0f; //size of the cells of space the clusters cover
+	std::vector<MyStaticCluster> m_clusterList; //all the clusters, empty ones keep their mesh for later
+	std::map<uint64_t, uint> m_clusterMap; //cluster index by material and cell
+	std::map<MyEntity*, std::vector<uint>> m_entityMap; //clusters each entity is baked into
+
+	uint m_uDrawnCount = 0; //clusters drawn on the last call
+	uint m_uBuildCount = 0; //clusters rebuilt on the last call
+
+	MeshManager* m_pMeshMngr = nullptr; //Mesh Manager singleton
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: float a_fClusterSize = 16.0f -> size of the cells of space the clusters cover
+	OUTPUT: class object instance
+	*/
+	MyStaticBatcher(float a_fClusterSize = 16.0f);
+	/*
+	USAGE: Destructor, the combined meshes belong to the MeshManager
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MyStaticBatcher(void);
+	/*
+	USAGE: Adds a static entity to the clusters of the materials of its meshes, entities that do not
+	know their meshes cannot be batched
+	ARGUMENTS: MyEntity* a_pEntity -> entity to add
+	OUTPUT: was it added?
+	*/
+	bool Add(MyEntity* a_pEntity);
+	/*
+	USAGE: Removes an entity from its clusters, they are rebuilt the next time they are drawn
+	ARGUMENTS: MyEntity* a_pEntity -> entity to remove
+	OUTPUT: ---
+	*/
+	void Remove(MyEntity* a_pEntity);
+	/*
+	USAGE: Asks if an entity is in a cluster
+	ARGUMENTS: MyEntity* a_pEntity -> entity to look for
+	OUTPUT: is it batched?
+	*/
+	bool Contains(MyEntity* a_pEntity);
+	/*
+	USAGE: Removes all the entities, the meshes are kept for the clusters built later
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Records a command for each cluster inside the frustum of the render queue camera, rebuilding
+	the dirty ones first; needs to be called from the simulation thread, the meshes are compiled by the
+	render thread
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void AddToRenderList(void);
+	/*
+	USAGE: Gets the number of clusters with entities
+	ARGUMENTS: ---
+	OUTPUT: cluster count
+	*/
+	uint GetClusterCount(void);
+	/*
+	USAGE: Gets the number of entities in the clusters
+	ARGUMENTS: ---
+	OUTPUT: entity count
+	*/
+	uint GetEntityCount(void);
+	/*
+	USAGE: Gets the number of clusters drawn on the last call
+	ARGUMENTS: ---
+	OUTPUT: drawn count
+	*/
+	uint GetDrawnCount(void);
+	/*
+	USAGE: Gets the number of clusters rebuilt on the last call
+	ARGUMENTS: ---
+	OUTPUT: build count
+	*/
+	uint GetBuildCount(void);
+private:
+	/*
+	USAGE: copy constructor, batches are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MyStaticBatcher(MyStaticBatcher const& other);
+	/*
+	USAGE: copy assignment operator, batches are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MyStaticBatcher& operator=(MyStaticBatcher const& other);
+	/*
+	USAGE: Gets (creating it if needed) the cluster of a material at a position
+	ARGUMENTS:
+	-	int a_nMaterial -> material index
+	-	vector3 a_v3Position -> position in world space
+	OUTPUT: cluster index
+	*/
+	uint GetCluster(int a_nMaterial, vector3 a_v3Position);
+	/*
+	USAGE: Bakes the meshes of the entities of a cluster into its combined mesh
+	ARGUMENTS: MyStaticCluster& a_cluster -> cluster to build
+	OUTPUT: ---
+	*/
+	void Build(MyStaticCluster& a_cluster);
+};
+
+} //namespace Simplex
+
+#endif //__MYSTATICBATCHER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "MySystemScheduler.h"
+using namespace Simplex;
+//  MySystemScheduler
+MySystemScheduler::MySystemScheduler(void) {}
+MySystemScheduler::MySystemScheduler(MySystemScheduler const& other) {}
+MySystemScheduler& MySystemScheduler::operator=(MySystemScheduler const& other) { return *this; }
+MySystemScheduler::~MySystemScheduler(void)
+{
+	m_systemList.clear();
+	m_waveList.clear();
+	m_queryList.clear();
+	m_chunkList.clear();
+	m_jobList.clear();
+}
+uint MySystemScheduler::GetSystemCount(void) { return m_systemList.size(); }
+uint MySystemScheduler::GetWaveCount(void) { return m_uWaveCount; }
+float MySystemScheduler::GetTime(void) { return m_fTime; }
+bool MySystemScheduler::IsConflicting(MySystem const& a_first, MySystem const& a_second)
+{
+	//reading the same data at once is fine, a write needs the other one to be done
+	if ((a_first.m_uWrite & (a_second.m_uRead | a_second.m_uWrite)) != 0)
+		return true;
+	return (a_second.m_uWrite & a_first.m_uRead) != 0;
+}
+uint MySystemScheduler::AddSystem(MySystem const& a_system)
+{
+	uint uWave = 0;
+	for (uint i = 0; i < m_systemList.size(); ++i)
+	{
+		if (IsConflicting(m_systemList[i], a_system))
+			uWave = (std::max)(uWave, m_waveList[i] + 1);
+	}
+	m_systemList.push_back(a_system);
+	m_waveList.push_back(uWave);
+	m_uWaveCount = (std::max)(m_uWaveCount, uWave + 1);
+	return m_systemList.size() - 1;
+}
+void MySystemScheduler::Run(void)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	MyArchetypeStore* pStore = MyArchetypeStore::GetInstance();
+	for (uint uWave = 0; uWave < m_uWaveCount; ++uWave)
+	{
+		//a job per chunk of the parallel systems, a job for all the chunks of the others
+		m_chunkList.clear();
+		m_jobList.clear();
+		for (uint i = 0; i < m_systemList.size(); ++i)
+		{
+			MySystem const& system = m_systemList[i];
+			if (m_waveList[i] != uWave || !system.m_update)
+				continue;
+			pStore->Query(system.m_uRequire, system.m_uExclude, m_queryList);
+			if (m_queryList.empty())
+				continue;
+
+			MySystemJob job;
+			job.m_uSystem = i;
+			job.m_uFirst = m_chunkList.size();
+			m_chunkList.insert(m_chunkList.end(), m_queryList.begin(), m_queryList.end());
+			if (system.m_bParallel)
+			{
+				job.m_uCount = 1;
+				for (uint j = 0; j < m_queryList.size(); ++j, ++job.m_uFirst)
+					m_jobList.push_back(job);
+			}
+			else
+			{
+				job.m_uCount = m_queryList.size();
+				m_jobList.push_back(job);
+			}
+		}
+
+		MyJobSystem::GetInstance()->ParallelFor(m_jobList.size(), 1, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+		{
+			for (uint i = a_uBegin; i < a_uEnd; ++i)
+			{
+				MySystemJob const& job = m_jobList[i];
+				MySystem const& system = m_systemList[job.m_uSystem];
+				for (uint j = job.m_uFirst; j < job.m_uFirst + job.m_uCount; ++j)
+					system.m_update(m_chunkList[j]);
+			}
+		});
+	}
+
+	m_fTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
\ No newline at end of file
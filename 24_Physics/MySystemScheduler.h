@@ -0,0 +1,122 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYSYSTEMSCHEDULER_H_
+#define __MYSYSTEMSCHEDULER_H_
+
+#include "MyArchetypeStore.h"
+
+namespace Simplex
+{
+
+//Work done on the chunks of the archetypes matching a query, it declares the components it touches
+//so the scheduler knows which systems can run at the same time
+struct MySystem
+{
+	String m_sName = ""; //name of the system
+	uint m_uRequire = 0; //components the entities need to have (MY_COMPONENT bits)
+	uint m_uExclude = 0; //components the entities cannot have
+	uint m_uRead = 0; //components the update reads
+	uint m_uWrite = 0; //components the update writes
+	bool m_bParallel = true; //can its chunks be updated at once? (false updates them in order on one thread)
+	std::function<void(MyArchetypeChunk* a_pChunk)> m_update; //work on one chunk (a ParallelFor inside runs serially)
+};
+
+//Runs systems over the archetype store in waves: a system goes in the wave after the last system added
+//before it that writes what it reads or reads or writes what it writes, so the systems of a wave touch
+//different data and all their chunks are spread on the job system at once
+class MySystemScheduler
+{
+	//chunks of a wave given to one thread at a time
+	struct MySystemJob
+	{
+		uint m_uSystem = 0; //system to run
+		uint m_uFirst = 0; //first chunk in the chunk list
+		uint m_uCount = 0; //chunks to update
+	};
+
+	std::vector<MySystem> m_systemList; //systems in the order they were added
+	std::vector<uint> m_waveList; //wave of each system
+	uint m_uWaveCount = 0; //waves needed to run all the systems
+
+	std::vector<MyArchetypeChunk*> m_queryList; //chunks found by the query of a system
+	std::vector<MyArchetypeChunk*> m_chunkList; //chunks of all the systems of the wave being run
+	std::vector<MySystemJob> m_jobList; //jobs of the wave being run
+	float m_fTime = 0.0f; //milliseconds the last run took
+public:
+	/*
+	USAGE: Constructor
+	ARGUMENTS: ---
+	OUTPUT: class object instance
+	*/
+	MySystemScheduler(void);
+	/*
+	USAGE: Destructor
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	~MySystemScheduler(void);
+	/*
+	USAGE: Adds a system after the ones added before, its wave is decided here
+	ARGUMENTS: MySystem const& a_system -> system to add
+	OUTPUT: index of the system
+	*/
+	uint AddSystem(MySystem const& a_system);
+	/*
+	USAGE: Runs all the systems wave by wave on the job system, a wave starts when the one before is done;
+	the systems cannot add, remove or change the components of entities while they run
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Run(void);
+	/*
+	USAGE: Gets the number of systems
+	ARGUMENTS: ---
+	OUTPUT: system count
+	*/
+	uint GetSystemCount(void);
+	/*
+	USAGE: Gets the number of waves the systems run in
+	ARGUMENTS: ---
+	OUTPUT: wave count
+	*/
+	uint GetWaveCount(void);
+	/*
+	USAGE: Gets the milliseconds the last run took
+	ARGUMENTS: ---
+	OUTPUT: run time
+	*/
+	float GetTime(void);
+private:
+	/*
+	USAGE: copy constructor, systems are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: class object instance
+	*/
+	MySystemScheduler(MySystemScheduler const& other);
+	/*
+	USAGE: copy assignment operator, systems are not copied
+	ARGUMENTS: class object to copy
+	OUTPUT: ---
+	*/
+	MySystemScheduler& operator=(MySystemScheduler const& other);
+	/*
+	USAGE: Asks if two systems touch the same data with at least one of them writing it
+	ARGUMENTS:
+	-	MySystem const& a_first -> system added first
+	-	MySystem const& a_second -> system added later
+	OUTPUT: do they need to run one after the other?
+	*/
+	static bool IsConflicting(MySystem const& a_first, MySystem const& a_second);
+};
+
+} //namespace Simplex
+
+#endif //__MYSYSTEMSCHEDULER_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
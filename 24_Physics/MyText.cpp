@@ -0,0 +1,367 @@
+#include "MyText.h"
+using namespace Simplex;
+//  MyText
+Simplex::MyText* Simplex::MyText::m_pInstance = nullptr;
+void Simplex::MyText::Init(void)
+{
+	m_uLineCount = 0;
+	m_uShader = 0;
+	m_uVAO = 0;
+	m_uVBO = 0;
+	m_uTexture = 0;
+	m_nScreen = -1;
+	m_nFont = -1;
+	m_bPersistent = false;
+	m_pMapped = nullptr;
+	m_uRegion = 0;
+	for (uint i = 0; i < m_uRegionCount; ++i)
+	{
+		m_fence[i] = nullptr;
+		for (uint j = 0; j < m_uMaxLines; ++j)
+		{
+			m_uRegionVersion[i][j] = 0;
+		}
+	}
+	SetLineHeight(20.0f);
+}
+void Simplex::MyText::Release(void)
+{
+	for (uint i = 0; i < m_uRegionCount; ++i)
+	{
+		if (m_fence[i])
+			glDeleteSync(m_fence[i]);
+		m_fence[i] = nullptr;
+	}
+	if (m_pMapped)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		m_pMapped = nullptr;
+	}
+	if (m_uVBO)
+		glDeleteBuffers(1, &m_uVBO);
+	if (m_uVAO)
+		glDeleteVertexArrays(1, &m_uVAO);
+	if (m_uShader)
+		glDeleteProgram(m_uShader);
+	m_uVBO = 0;
+	m_uVAO = 0;
+	m_uShader = 0;
+	//the texture belongs to the TextureManager
+	m_uTexture = 0;
+}
+Simplex::MyText* Simplex::MyText::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyText();
+	}
+	return m_pInstance;
+}
+void Simplex::MyText::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//Accessors
+void Simplex::MyText::SetLineHeight(float a_fHeight)
+{
+	//the cells of the font are 52.5 x 82 pixels
+	m_fCellHeight = a_fHeight;
+	m_fCellWidth = a_fHeight * (52.5f / 82.0f);
+	GenerateGlyphs();
+
+	//every line needs to be encoded with the new size
+	for (uint i = 0; i < m_uMaxLines; ++i)
+	{
+		EncodeLine(i);
+		++m_line[i].m_uVersion;
+	}
+}
+//The big 3
+Simplex::MyText::MyText() { Init(); }
+Simplex::MyText::MyText(MyText const& a_pOther) { }
+Simplex::MyText& Simplex::MyText::operator=(MyText const& a_pOther) { return *this; }
+Simplex::MyText::~MyText() { Release(); };
+// other methods
+Simplex::uint Simplex::MyText::PackColor(vector3 a_v3Color)
+{
+	vector3 v3Color = glm::clamp(a_v3Color, 0.0f, 1.0f) * 255.0f;
+	return static_cast<uint>(v3Color.r) | (static_cast<uint>(v3Color.g) << 8) | (static_cast<uint>(v3Color.b) << 16) | (255u << 24);
+}
+void Simplex::MyText::GenerateGlyphs(void)
+{
+	//the font is a grid of 10 x 10 cells starting at the space character,
+	//the texture is stored bottom up so the first row is at the top (v = 1)
+	for (uint i = 0; i < 96; ++i)
+	{
+		float fU0 = (i % 10) / 10.0f;
+		float fU1 = fU0 + 0.1f;
+		float fV0 = 1.0f - (i / 10) / 10.0f;
+		float fV1 = fV0 - 0.1f;
+
+		MyTextVertex corner[4];
+		corner[0] = { { 0.0f, 0.0f }, { fU0, fV0 }, 0 }; //top left
+		corner[1] = { { m_fCellWidth, 0.0f }, { fU1, fV0 }, 0 }; //top right
+		corner[2] = { { m_fCellWidth, m_fCellHeight }, { fU1, fV1 }, 0 }; //bottom right
+		corner[3] = { { 0.0f, m_fCellHeight }, { fU0, fV1 }, 0 }; //bottom left
+
+		m_glyphQuad[i][0] = corner[0];
+		m_glyphQuad[i][1] = corner[3];
+		m_glyphQuad[i][2] = corner[2];
+		m_glyphQuad[i][3] = corner[0];
+		m_glyphQuad[i][4] = corner[2];
+		m_glyphQuad[i][5] = corner[1];
+	}
+}
+void Simplex::MyText::Print(String a_sInput, vector3 a_v3Color)
+{
+	if (m_uLineCount >= m_uMaxLines)
+		return;
+
+	MyTextLine& line = m_line[m_uLineCount];
+	uint uColor = PackColor(a_v3Color);
+	line.m_sPending += a_sInput;
+	line.m_pendingColorList.insert(line.m_pendingColorList.end(), a_sInput.size(), uColor);
+}
+void Simplex::MyText::PrintLine(String a_sInput, vector3 a_v3Color)
+{
+	Print(a_sInput, a_v3Color);
+	if (m_uLineCount < m_uMaxLines)
+		++m_uLineCount;
+}
+void Simplex::MyText::EncodeLine(uint a_uLine)
+{
+	MyTextLine& line = m_line[a_uLine];
+	line.m_vertexList.clear();
+
+	float fY = m_fCellHeight * a_uLine;
+	uint uCharacters = line.m_sText.size();
+	if (uCharacters > m_uMaxCharacters)
+		uCharacters = m_uMaxCharacters;
+	for (uint i = 0; i < uCharacters; ++i)
+	{
+		//spaces and characters not in the font only move the cursor
+		uint uGlyph = static_cast<unsigned char>(line.m_sText[i]);
+		if (uGlyph <= 32 || uGlyph >= 128)
+			continue;
+		uGlyph -= 32;
+
+		float fX = m_fCellWidth * i;
+		for (uint j = 0; j < 6; ++j)
+		{
+			MyTextVertex vertex = m_glyphQuad[uGlyph][j];
+			vertex.m_fPosition[0] += fX;
+			vertex.m_fPosition[1] += fY;
+			vertex.m_uColor = line.m_colorList[i];
+			line.m_vertexList.push_back(vertex);
+		}
+	}
+}
+void Simplex::MyText::CreateDeviceObjects(void)
+{
+	const GLchar *vertex_shader =
+		"#version 330\n"
+		"uniform vec2 Screen;\n"
+		"in vec2 Position;\n"
+		"in vec2 UV;\n"
+		"in vec4 Color;\n"
+		"out vec2 Frag_UV;\n"
+		"out vec4 Frag_Color;\n"
+		"void main()\n"
+		"{\n"
+		"	Frag_UV = UV;\n"
+		"	Frag_Color = Color;\n"
+		"	gl_Position = vec4(Position.x / Screen.x * 2 - 1, 1 - Position.y / Screen.y * 2, 0, 1);\n"
+		"}\n";
+
+	const GLchar* fragment_shader =
+		"#version 330\n"
+		"uniform sampler2D Font;\n"
+		"in vec2 Frag_UV;\n"
+		"in vec4 Frag_Color;\n"
+		"out vec4 Out_Color;\n"
+		"void main()\n"
+		"{\n"
+		"	vec4 v4Color = texture(Font, Frag_UV);\n"
+		"	if(v4Color.w == 0)\n"
+		"		discard;\n"
+		"	Out_Color = v4Color * Frag_Color;\n"
+		"}\n";
+
+	m_uShader = glCreateProgram();
+	GLuint uVertHandle = glCreateShader(GL_VERTEX_SHADER);
+	GLuint uFragHandle = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(uVertHandle, 1, &vertex_shader, 0);
+	glShaderSource(uFragHandle, 1, &fragment_shader, 0);
+	glCompileShader(uVertHandle);
+	glCompileShader(uFragHandle);
+	glAttachShader(m_uShader, uVertHandle);
+	glAttachShader(m_uShader, uFragHandle);
+	glLinkProgram(m_uShader);
+	//the program keeps them alive
+	glDeleteShader(uVertHandle);
+	glDeleteShader(uFragHandle);
+
+	//locations are asked once, not every frame
+	m_nScreen = glGetUniformLocation(m_uShader, "Screen");
+	m_nFont = glGetUniformLocation(m_uShader, "Font");
+	GLint nPosition = glGetAttribLocation(m_uShader, "Position");
+	GLint nUV = glGetAttribLocation(m_uShader, "UV");
+	GLint nColor = glGetAttribLocation(m_uShader, "Color");
+
+	TextureManager* pTextureMngr = TextureManager::GetInstance();
+	int nTexture = pTextureMngr->LoadTexture("Font.png");
+	if (nTexture >= 0)
+		m_uTexture = pTextureMngr->ReturnGLIndex(nTexture);
+
+	glGenVertexArrays(1, &m_uVAO);
+	glGenBuffers(1, &m_uVBO);
+	glBindVertexArray(m_uVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+
+	//one region per frame in flight, each with a fixed slot per line
+	GLsizeiptr nSize = sizeof(MyTextVertex) * m_uRegionCount * m_uMaxLines * m_uMaxCharacters * 6;
+	if (GLEW_ARB_buffer_storage)
+	{
+		//if it cannot be mapped we can still update it with glBufferSubData
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_ARRAY_BUFFER, nSize, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+		m_pMapped = static_cast<MyTextVertex*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, nSize, flags));
+		m_bPersistent = m_pMapped != nullptr;
+	}
+	else
+		glBufferData(GL_ARRAY_BUFFER, nSize, nullptr, GL_DYNAMIC_DRAW);
+
+	glEnableVertexAttribArray(nPosition);
+	glEnableVertexAttribArray(nUV);
+	glEnableVertexAttribArray(nColor);
+	glVertexAttribPointer(nPosition, 2, GL_FLOAT, GL_FALSE, sizeof(MyTextVertex), (GLvoid*)offsetof(MyTextVertex, m_fPosition));
+	glVertexAttribPointer(nUV, 2, GL_FLOAT, GL_FALSE, sizeof(MyTextVertex), (GLvoid*)offsetof(MyTextVertex, m_fUV));
+	glVertexAttribPointer(nColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(MyTextVertex), (GLvoid*)offsetof(MyTextVertex, m_uColor));
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+void Simplex::MyText::Publish(MyTextFrame& a_frame)
+{
+	//a line that was not finished with PrintLine is shown as well
+	if (m_uLineCount < m_uMaxLines && m_line[m_uLineCount].m_sPending.size() > 0)
+		++m_uLineCount;
+
+	//the frame takes the printed lines and gives back the ones it had to print the next frame over
+	for (uint i = 0; i < m_uLineCount; ++i)
+	{
+		MyTextLine& line = m_line[i];
+		std::swap(a_frame.m_sText[i], line.m_sPending);
+		std::swap(a_frame.m_colorList[i], line.m_pendingColorList);
+		line.m_sPending.clear();
+		line.m_pendingColorList.clear();
+	}
+	a_frame.m_uLineCount = m_uLineCount;
+	m_uLineCount = 0;
+}
+void Simplex::MyText::Render(MyTextFrame const& a_frame)
+{
+	//only the lines that changed get encoded again
+	uint uLineCount = a_frame.m_uLineCount;
+	for (uint i = 0; i < uLineCount; ++i)
+	{
+		MyTextLine& line = m_line[i];
+		if (a_frame.m_sText[i] != line.m_sText || a_frame.m_colorList[i] != line.m_colorList)
+		{
+			line.m_sText = a_frame.m_sText[i];
+			line.m_colorList = a_frame.m_colorList[i];
+			EncodeLine(i);
+			++line.m_uVersion;
+		}
+	}
+	if (uLineCount == 0)
+		return;
+
+	if (m_uShader == 0)
+		CreateDeviceObjects();
+
+	// Backup GL state
+	GLint last_program, last_texture, last_array_buffer, last_vertex_array;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+	glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
+	GLint last_blend_src, last_blend_dst;
+	glGetIntegerv(GL_BLEND_SRC_RGB, &last_blend_src);
+	glGetIntegerv(GL_BLEND_DST_RGB, &last_blend_dst);
+	GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
+	GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+
+	//make sure the GPU is done reading this region from the last time we used it
+	if (m_fence[m_uRegion])
+	{
+		glClientWaitSync(m_fence[m_uRegion], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+		glDeleteSync(m_fence[m_uRegion]);
+		m_fence[m_uRegion] = nullptr;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_uVBO);
+
+	//bring the region up to date with the lines it has an old version of
+	uint uSlotSize = m_uMaxCharacters * 6;
+	uint uRegionStart = m_uRegion * m_uMaxLines * uSlotSize;
+	GLsizei nDrawCount = 0;
+	for (uint i = 0; i < uLineCount; ++i)
+	{
+		MyTextLine& line = m_line[i];
+		uint uVertexCount = line.m_vertexList.size();
+		uint uSlotStart = uRegionStart + i * uSlotSize;
+		if (m_uRegionVersion[m_uRegion][i] != line.m_uVersion)
+		{
+			if (uVertexCount > 0)
+			{
+				if (m_bPersistent)
+					memcpy(m_pMapped + uSlotStart, line.m_vertexList.data(), sizeof(MyTextVertex) * uVertexCount);
+				else
+					glBufferSubData(GL_ARRAY_BUFFER, sizeof(MyTextVertex) * uSlotStart, sizeof(MyTextVertex) * uVertexCount, line.m_vertexList.data());
+			}
+			m_uRegionVersion[m_uRegion][i] = line.m_uVersion;
+		}
+		if (uVertexCount > 0)
+		{
+			m_nFirst[nDrawCount] = uSlotStart;
+			m_nCount[nDrawCount] = uVertexCount;
+			++nDrawCount;
+		}
+	}
+
+	if (nDrawCount > 0)
+	{
+		SystemSingleton* pSystem = SystemSingleton::GetInstance();
+		glUseProgram(m_uShader);
+		glUniform2f(m_nScreen, static_cast<float>(pSystem->GetWindowWidth()), static_cast<float>(pSystem->GetWindowHeight()));
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, m_uTexture);
+		glUniform1i(m_nFont, 0);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glDisable(GL_DEPTH_TEST);
+		glBindVertexArray(m_uVAO);
+
+		//all the lines in a single call
+		glMultiDrawArrays(GL_TRIANGLES, m_nFirst, m_nCount, nDrawCount);
+	}
+
+	if (m_bPersistent)
+		m_fence[m_uRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_uRegion = (m_uRegion + 1) % m_uRegionCount;
+
+	// Restore modified GL state
+	glUseProgram(last_program);
+	glBindTexture(GL_TEXTURE_2D, last_texture);
+	glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+	glBindVertexArray(last_vertex_array);
+	glBlendFunc(last_blend_src, last_blend_dst);
+	if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+	if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+}
\ No newline at end of file
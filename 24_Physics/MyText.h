@@ -0,0 +1,193 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYTEXT_H_
+#define __MYTEXT_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+//Vertex of a character quad
+struct MyTextVertex
+{
+	float m_fPosition[2]; //position in pixels from the top left corner of the window
+	float m_fUV[2]; //texture coordinate in the font
+	uint m_uColor; //RGBA color packed in 4 bytes
+};
+
+//Line of text, encoded once when it changes
+struct MyTextLine
+{
+	String m_sText = ""; //text shown
+	std::vector<uint> m_colorList; //packed color of each character shown
+	String m_sPending = ""; //text being printed this frame
+	std::vector<uint> m_pendingColorList; //packed color of each character being printed this frame
+	uint m_uVersion = 0; //incremented each time the line changes
+	std::vector<MyTextVertex> m_vertexList; //encoded quads of the line
+};
+
+//Lines printed during a frame, handed from the thread that prints them to the one that draws them
+struct MyTextFrame
+{
+	static const uint m_uMaxLines = 64; //lines that can be shown
+	uint m_uLineCount = 0; //lines printed
+	String m_sText[m_uMaxLines]; //text of each line
+	std::vector<uint> m_colorList[m_uMaxLines]; //packed color of each character of each line
+};
+
+//System Class
+class MyText
+{
+	static const uint m_uMaxLines = MyTextFrame::m_uMaxLines; //lines that can be shown
+	static const uint m_uMaxCharacters = 128; //characters per line that can be shown
+	static const uint m_uRegionCount = 3; //frames the ring buffer holds so we never write what the GPU reads
+
+	MyTextVertex m_glyphQuad[96][6]; //quad of each printable character (32 to 127) for a cell at the origin
+
+	float m_fCellWidth = 0.0f; //width of a character in pixels
+	float m_fCellHeight = 0.0f; //height of a line in pixels
+
+	uint m_uLineCount = 0; //lines printed this frame
+	MyTextLine m_line[m_uMaxLines]; //lines of text
+
+	GLuint m_uShader = 0; //shader program
+	GLuint m_uVAO = 0; //vertex array object
+	GLuint m_uVBO = 0; //ring vertex buffer
+	GLuint m_uTexture = 0; //font texture
+	GLint m_nScreen = -1; //location of the screen size uniform
+	GLint m_nFont = -1; //location of the font sampler uniform
+
+	bool m_bPersistent = false; //is the vertex buffer persistently mapped?
+	MyTextVertex* m_pMapped = nullptr; //mapped ring buffer (if persistent)
+	uint m_uRegion = 0; //region of the ring used this frame
+	GLsync m_fence[m_uRegionCount]; //signaled when the GPU is done with each region
+	uint m_uRegionVersion[m_uRegionCount][m_uMaxLines]; //version of each line stored in each region
+
+	GLint m_nFirst[m_uMaxLines]; //first vertex of each line for the draw call
+	GLsizei m_nCount[m_uMaxLines]; //vertex count of each line for the draw call
+
+	static MyText* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyText* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds text to the current line
+	ARGUMENTS:
+	-	String a_sInput -> text to add
+	-	vector3 a_v3Color = C_WHITE -> color of the text
+	OUTPUT: ---
+	*/
+	void Print(String a_sInput, vector3 a_v3Color = C_WHITE);
+	/*
+	USAGE: Adds text to the current line and starts a new one
+	ARGUMENTS:
+	-	String a_sInput -> text to add
+	-	vector3 a_v3Color = C_WHITE -> color of the text
+	OUTPUT: ---
+	*/
+	void PrintLine(String a_sInput, vector3 a_v3Color = C_WHITE);
+	/*
+	USAGE: Hands the lines printed this frame to a frame drawn by another thread and starts over, the
+	strings are swapped so both sides keep reusing their memory
+	ARGUMENTS: MyTextFrame& a_frame -> frame that gets the lines
+	OUTPUT: ---
+	*/
+	void Publish(MyTextFrame& a_frame);
+	/*
+	USAGE: Re-encodes only the lines of a frame that changed since the last one drawn, brings the current
+	region of the ring buffer up to date and draws all the lines in a single call
+	ARGUMENTS: MyTextFrame const& a_frame -> lines to draw
+	OUTPUT: ---
+	*/
+	void Render(MyTextFrame const& a_frame);
+	/*
+	USAGE: Sets the height of a line, the width of the characters keeps the aspect of the font
+	ARGUMENTS: float a_fHeight -> height in pixels
+	OUTPUT: ---
+	*/
+	void SetLineHeight(float a_fHeight);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyText(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyText(MyText const& a_pOther);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyText& operator=(MyText const& a_pOther);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyText(void);
+	/*
+	Usage: releases the allocated member pointers and OpenGL objects
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Builds the quad of every character for the current cell size
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void GenerateGlyphs(void);
+	/*
+	USAGE: Creates the shader, the ring buffer and loads the font, done on the first Render so we are sure there is a context
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void CreateDeviceObjects(void);
+	/*
+	USAGE: Encodes the quads of a line from the glyph table
+	ARGUMENTS: uint a_uLine -> line to encode
+	OUTPUT: ---
+	*/
+	void EncodeLine(uint a_uLine);
+	/*
+	USAGE: Packs a color into 4 bytes
+	ARGUMENTS: vector3 a_v3Color -> color to pack
+	OUTPUT: packed color
+	*/
+	uint PackColor(vector3 a_v3Color);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYTEXT_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include "MyTextureAtlas.h"
+#include "MyRenderThread.h"
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui\stb_rect_pack.h"
+using namespace Simplex;
+//  MyTextureAtlas
+Simplex::MyTextureAtlas* Simplex::MyTextureAtlas::m_pInstance = nullptr;
+void Simplex::MyTextureAtlas::Init(void)
+{
+	m_pMeshMngr = MeshManager::GetInstance();
+	m_pMaterialMngr = MaterialManager::GetInstance();
+}
+void Simplex::MyTextureAtlas::Release(void)
+{
+	//the copies and the page materials belong to their managers
+	if (m_pageList.size() > 0)
+		glDeleteTextures(m_pageList.size(), m_pageList.data());
+	m_pageList.clear();
+	m_entryList.clear();
+	m_meshMap.clear();
+	m_geometryMap.clear();
+	m_uTextureCount = 0;
+}
+Simplex::MyTextureAtlas* Simplex::MyTextureAtlas::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyTextureAtlas();
+	}
+	return m_pInstance;
+}
+void Simplex::MyTextureAtlas::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyTextureAtlas::MyTextureAtlas() { Init(); }
+Simplex::MyTextureAtlas::MyTextureAtlas(MyTextureAtlas const& other) { }
+Simplex::MyTextureAtlas& Simplex::MyTextureAtlas::operator=(MyTextureAtlas const& other) { return *this; }
+Simplex::MyTextureAtlas::~MyTextureAtlas() { Release(); }
+//Accessors
+Simplex::uint Simplex::MyTextureAtlas::GetPageCount(void) { return m_pageList.size(); }
+Simplex::uint Simplex::MyTextureAtlas::GetTextureCount(void) { return m_uTextureCount; }
+void Simplex::MyTextureAtlas::SetPageSize(uint a_uPageSize, uint a_uPadding)
+{
+	m_uPageSize = (glm::max)(a_uPageSize, 64u);
+	m_uPadding = a_uPadding;
+	m_uMaxSize = m_uPageSize / 2;
+}
+Simplex::MyAtlasEntry Simplex::MyTextureAtlas::GetEntry(int a_nMaterial)
+{
+	if (a_nMaterial < 0 || a_nMaterial >= static_cast<int>(m_entryList.size()))
+		return MyAtlasEntry();
+	return m_entryList[a_nMaterial];
+}
+//Packing
+Simplex::uint Simplex::MyTextureAtlas::Pack(std::vector<MyAtlasRect>& a_rectList, uint a_uPageSize, uint a_uPadding)
+{
+	for (uint i = 0; i < a_rectList.size(); ++i)
+	{
+		a_rectList[i].m_nPage = -1;
+	}
+
+	//each page takes what fits of the rectangles left by the previous ones
+	std::vector<stbrp_node> nodeList(a_uPageSize);
+	std::vector<stbrp_rect> packList;
+	uint uPageCount = 0;
+	while (true)
+	{
+		packList.clear();
+		for (uint i = 0; i < a_rectList.size(); ++i)
+		{
+			MyAtlasRect& rect = a_rectList[i];
+			if (rect.m_nPage >= 0 || rect.m_uWidth + a_uPadding * 2 > a_uPageSize || rect.m_uHeight + a_uPadding * 2 > a_uPageSize)
+				continue;
+			stbrp_rect pack;
+			pack.id = i;
+			pack.w = rect.m_uWidth + a_uPadding * 2;
+			pack.h = rect.m_uHeight + a_uPadding * 2;
+			packList.push_back(pack);
+		}
+		if (packList.size() == 0)
+			break;
+
+		stbrp_context context;
+		stbrp_init_target(&context, a_uPageSize, a_uPageSize, nodeList.data(), nodeList.size());
+		stbrp_pack_rects(&context, packList.data(), packList.size());
+		bool bPlaced = false;
+		for (uint i = 0; i < packList.size(); ++i)
+		{
+			if (!packList[i].was_packed)
+				continue;
+			MyAtlasRect& rect = a_rectList[packList[i].id];
+			rect.m_nPage = uPageCount;
+			rect.m_uX = packList[i].x + a_uPadding;
+			rect.m_uY = packList[i].y + a_uPadding;
+			bPlaced = true;
+		}
+		if (!bPlaced)
+			break;
+		++uPageCount;
+	}
+	return uPageCount;
+}
+void Simplex::MyTextureAtlas::PackRect(matrix4& a_m4ToWorld, vector4 a_v4Rect)
+{
+	//the identity rectangle leaves the row as (0, 0, 0, 1)
+	a_m4ToWorld[0][3] = a_v4Rect.x;
+	a_m4ToWorld[1][3] = a_v4Rect.y;
+	a_m4ToWorld[2][3] = a_v4Rect.z - 1.0f;
+	a_m4ToWorld[3][3] = a_v4Rect.w;
+}
+Simplex::uint Simplex::MyTextureAtlas::Build(void)
+{
+	Release();
+
+	//one rectangle per texture, the materials sharing a texture share it
+	uint uMaterialCount = m_pMaterialMngr->GetMaterialCount();
+	m_entryList.assign(uMaterialCount, MyAtlasEntry());
+	std::vector<int> materialTextureList(uMaterialCount, -1);
+	std::vector<GLuint> textureList;
+	std::vector<MyAtlasRect> rectList;
+	GLint last_texture;
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+	for (uint i = 0; i < uMaterialCount; ++i)
+	{
+		//the normal and specular maps would need pages of their own
+		Material* pMaterial = m_pMaterialMngr->GetMaterial(i);
+		if (pMaterial == nullptr)
+			continue;
+		GLuint uDiffuse = pMaterial->GetDiffuseMap();
+		if (uDiffuse == 0 || pMaterial->GetNormalMap() != 0 || pMaterial->GetSpecularMap() != 0)
+			continue;
+
+		auto texture = std::find(textureList.begin(), textureList.end(), uDiffuse);
+		if (texture != textureList.end())
+		{
+			materialTextureList[i] = texture - textureList.begin();
+			continue;
+		}
+
+		GLint nWidth = 0;
+		GLint nHeight = 0;
+		glBindTexture(GL_TEXTURE_2D, uDiffuse);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &nWidth);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &nHeight);
+		if (nWidth <= 0 || nHeight <= 0 || static_cast<uint>(nWidth) > m_uMaxSize || static_cast<uint>(nHeight) > m_uMaxSize)
+			continue;
+
+		MyAtlasRect rect;
+		rect.m_uWidth = nWidth;
+		rect.m_uHeight = nHeight;
+		materialTextureList[i] = textureList.size();
+		textureList.push_back(uDiffuse);
+		rectList.push_back(rect);
+	}
+
+	uint uPageCount = Pack(rectList, m_uPageSize, m_uPadding);
+	if (uPageCount == 0)
+	{
+		glBindTexture(GL_TEXTURE_2D, last_texture);
+		return 0;
+	}
+
+	//the pages are only as tall as their content
+	std::vector<uint> pageHeightList(uPageCount, 0);
+	for (uint i = 0; i < rectList.size(); ++i)
+	{
+		MyAtlasRect& rect = rectList[i];
+		if (rect.m_nPage >= 0)
+			pageHeightList[rect.m_nPage] = (glm::max)(pageHeightList[rect.m_nPage], rect.m_uY + rect.m_uHeight + m_uPadding);
+	}
+	m_pageList.resize(uPageCount);
+	glGenTextures(uPageCount, m_pageList.data());
+	for (uint i = 0; i < uPageCount; ++i)
+	{
+		glBindTexture(GL_TEXTURE_2D, m_pageList[i]);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_uPageSize, pageHeightList[i], 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	}
+
+	//each texture is read back and copied with its edges repeated into the padding
+	std::vector<uint32_t> pixelList;
+	std::vector<uint32_t> paddedList;
+	for (uint i = 0; i < rectList.size(); ++i)
+	{
+		MyAtlasRect& rect = rectList[i];
+		if (rect.m_nPage < 0)
+			continue;
+		pixelList.resize(rect.m_uWidth * rect.m_uHeight);
+		glBindTexture(GL_TEXTURE_2D, textureList[i]);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixelList.data());
+
+		uint uWidth = rect.m_uWidth + m_uPadding * 2;
+		uint uHeight = rect.m_uHeight + m_uPadding * 2;
+		paddedList.resize(uWidth * uHeight);
+		for (uint y = 0; y < uHeight; ++y)
+		{
+			uint uRow = glm::clamp(static_cast<int>(y) - static_cast<int>(m_uPadding), 0, static_cast<int>(rect.m_uHeight) - 1);
+			for (uint x = 0; x < uWidth; ++x)
+			{
+				uint uColumn = glm::clamp(static_cast<int>(x) - static_cast<int>(m_uPadding), 0, static_cast<int>(rect.m_uWidth) - 1);
+				paddedList[y * uWidth + x] = pixelList[uRow * rect.m_uWidth + uColumn];
+			}
+		}
+		glBindTexture(GL_TEXTURE_2D, m_pageList[rect.m_nPage]);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, rect.m_uX - m_uPadding, rect.m_uY - m_uPadding, uWidth, uHeight, GL_RGBA, GL_UNSIGNED_BYTE, paddedList.data());
+		++m_uTextureCount;
+	}
+	for (uint i = 0; i < uPageCount; ++i)
+	{
+		glBindTexture(GL_TEXTURE_2D, m_pageList[i]);
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+	glBindTexture(GL_TEXTURE_2D, last_texture);
+
+	//one material per page, the meshes drawn with it only differ by the rectangle they read
+	std::vector<int> pageMaterialList(uPageCount);
+	for (uint i = 0; i < uPageCount; ++i)
+	{
+		String sName = "Atlas_" + std::to_string(i);
+		int nMaterial = m_pMaterialMngr->IdentifyMaterial(sName);
+		if (nMaterial < 0)
+			nMaterial = m_pMaterialMngr->AddMaterial(sName);
+		Material* pMaterial = m_pMaterialMngr->GetMaterial(nMaterial);
+		pMaterial->SetDiffuseMapName(sName);
+		pMaterial->SetDiffuseMapID(m_pageList[i]);
+		pageMaterialList[i] = nMaterial;
+	}
+	for (uint i = 0; i < uMaterialCount; ++i)
+	{
+		if (materialTextureList[i] < 0)
+			continue;
+		MyAtlasRect& rect = rectList[materialTextureList[i]];
+		if (rect.m_nPage < 0)
+			continue;
+		float fHeight = static_cast<float>(pageHeightList[rect.m_nPage]);
+		MyAtlasEntry& entry = m_entryList[i];
+		entry.m_nPage = rect.m_nPage;
+		entry.m_nMaterial = pageMaterialList[rect.m_nPage];
+		entry.m_v4Rect = vector4(rect.m_uX / static_cast<float>(m_uPageSize), rect.m_uY / fHeight,
+			rect.m_uWidth / static_cast<float>(m_uPageSize), rect.m_uHeight / fHeight);
+	}
+	return m_uTextureCount;
+}
+//Meshes
+bool Simplex::MyTextureAtlas::CanUseAtlas(uint a_uMeshIndex)
+{
+	if (m_pageList.size() == 0)
+		return false;
+	auto mesh = m_meshMap.find(a_uMeshIndex);
+	if (mesh != m_meshMap.end())
+		return mesh->second != -1;
+
+	//UVs outside the texture would read its neighbors in the page
+	Mesh* pMesh = m_pMeshMngr->GetMesh(a_uMeshIndex);
+	bool bAtlas = pMesh != nullptr && GetEntry(pMesh->GetMaterialIndex()).m_nPage >= 0;
+	if (bAtlas)
+	{
+		std::vector<vector3> uvList = pMesh->GetUVList();
+		bAtlas = uvList.size() > 0;
+		for (uint i = 0; i < uvList.size() && bAtlas; ++i)
+		{
+			bAtlas = uvList[i].x >= -0.001f && uvList[i].x <= 1.001f && uvList[i].y >= -0.001f && uvList[i].y <= 1.001f;
+		}
+	}
+	//-2 marks the meshes that can use the atlas but have no copy yet
+	m_meshMap[a_uMeshIndex] = bAtlas ? -2 : -1;
+	return bAtlas;
+}
+int Simplex::MyTextureAtlas::GetMeshMaterial(uint a_uMeshIndex)
+{
+	Mesh* pMesh = m_pMeshMngr->GetMesh(a_uMeshIndex);
+	if (pMesh == nullptr)
+		return -1;
+	if (!CanUseAtlas(a_uMeshIndex))
+		return pMesh->GetMaterialIndex();
+	return GetEntry(pMesh->GetMaterialIndex()).m_nMaterial;
+}
+Simplex::vector4 Simplex::MyTextureAtlas::GetMeshRect(uint a_uMeshIndex)
+{
+	if (!CanUseAtlas(a_uMeshIndex))
+		return vector4(0.0f, 0.0f, 1.0f, 1.0f);
+	return GetEntry(m_pMeshMngr->GetMesh(a_uMeshIndex)->GetMaterialIndex()).m_v4Rect;
+}
+int Simplex::MyTextureAtlas::GetMesh(uint a_uMeshIndex)
+{
+	if (!CanUseAtlas(a_uMeshIndex))
+		return -1;
+	int& nCopy = m_meshMap[a_uMeshIndex];
+	if (nCopy >= 0)
+		return nCopy;
+
+	Mesh* pMesh = m_pMeshMngr->GetMesh(a_uMeshIndex);
+	MyAtlasEntry entry = GetEntry(pMesh->GetMaterialIndex());
+	std::vector<vector3> listArray[6] = { pMesh->GetVertexList(), pMesh->GetColorList(), pMesh->GetNormalList(),
+		pMesh->GetUVList(), pMesh->GetTangentList(), pMesh->GetBitangetList() };
+
+	//meshes with the same vertices on the same page share their copy
+	uint64_t uHash = 14695981039346656037ULL ^ static_cast<uint64_t>(entry.m_nPage);
+	for (uint i = 0; i < 6; ++i)
+	{
+		uHash = (uHash ^ listArray[i].size()) * 1099511628211ULL;
+		unsigned char const* pByte = reinterpret_cast<unsigned char const*>(listArray[i].data());
+		for (uint j = 0; j < listArray[i].size() * sizeof(vector3); ++j)
+		{
+			uHash = (uHash ^ pByte[j]) * 1099511628211ULL;
+		}
+	}
+	auto geometry = m_geometryMap.find(uHash);
+	if (geometry != m_geometryMap.end())
+	{
+		nCopy = geometry->second;
+		return nCopy;
+	}
+
+	int nMesh = -1;
+	MyRenderThread::GetInstance()->Invoke([&]()
+	{
+		Mesh* pCopy = new Mesh();
+		pCopy->AddVertexPositionList(listArray[0]);
+		pCopy->AddVertexColorList(listArray[1]);
+		pCopy->AddVertexNormalList(listArray[2]);
+		pCopy->AddVertexUVList(listArray[3]);
+		pCopy->AddVertexTangentList(listArray[4]);
+		pCopy->AddVertexBinormalList(listArray[5]);
+		pCopy->SetMaterial(entry.m_nMaterial);
+		pCopy->CompileOpenGL3X();
+		nMesh = m_pMeshMngr->AddMesh(pCopy);
+	});
+	nCopy = nMesh;
+	m_geometryMap[uHash] = nCopy;
+	return nCopy;
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYTEXTUREATLAS_H_
+#define __MYTEXTUREATLAS_H_
+
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+//Rectangle to pack, the size is given and the place is found
+struct MyAtlasRect
+{
+	uint m_uWidth = 0; //size of the texture in pixels, the padding is added by the packer
+	uint m_uHeight = 0;
+	int m_nPage = -1; //page the rectangle went to, -1 if it does not fit in an empty page
+	uint m_uX = 0; //corner of the texture in the page (inside the padding)
+	uint m_uY = 0;
+};
+
+//Place of a material in the atlas
+struct MyAtlasEntry
+{
+	int m_nPage = -1; //page holding the diffuse map, -1 if the material is not in the atlas
+	int m_nMaterial = -1; //material of the page, drawn instead of the original one
+	vector4 m_v4Rect = vector4(0.0f, 0.0f, 1.0f, 1.0f); //offset (xy) and scale (zw) of the texture in the page
+};
+
+//System Class, packs the diffuse maps of the loaded materials into shared pages so the meshes that only
+//differ by texture can be drawn with the same material. The meshes keep their UVs, a copy of each mesh
+//with the page material is drawn instead and the rectangle of the texture goes in the unused last row of
+//its instance matrix (the Simplex shader reads it and restores the row)
+class MyTextureAtlas
+{
+	uint m_uPageSize = 4096; //width of the pages, the height is trimmed to what is used
+	uint m_uPadding = 4; //pixels repeated around each texture so filtering does not bleed
+	uint m_uMaxSize = 2048; //textures larger than this keep their own
+	std::vector<GLuint> m_pageList; //textures of the pages
+	std::vector<MyAtlasEntry> m_entryList; //entry of each material
+	std::map<uint, int> m_meshMap; //copy using the page material of each mesh asked for, -1 if it cannot use the atlas
+	std::map<uint64_t, int> m_geometryMap; //copies by geometry and page, meshes with the same vertices share them
+	uint m_uTextureCount = 0; //textures in the pages
+	MeshManager* m_pMeshMngr = nullptr; //Mesh Manager singleton
+	MaterialManager* m_pMaterialMngr = nullptr; //Material Manager singleton
+
+	static MyTextureAtlas* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyTextureAtlas* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Packs rectangles into as many square pages as needed, does not touch OpenGL
+	ARGUMENTS:
+	-	std::vector<MyAtlasRect>& a_rectList -> rectangles to pack, their place is filled
+	-	uint a_uPageSize -> size of the pages
+	-	uint a_uPadding -> space left around each rectangle
+	OUTPUT: number of pages used
+	*/
+	static uint Pack(std::vector<MyAtlasRect>& a_rectList, uint a_uPageSize, uint a_uPadding);
+	/*
+	USAGE: Writes the rectangle of a texture in the last row of an instance matrix, the shader reads it
+	back and restores the row to (0, 0, 0, 1)
+	ARGUMENTS:
+	-	matrix4& a_m4ToWorld -> affine model matrix to modify
+	-	vector4 a_v4Rect -> offset (xy) and scale (zw) of the texture
+	OUTPUT: ---
+	*/
+	static void PackRect(matrix4& a_m4ToWorld, vector4 a_v4Rect);
+	/*
+	USAGE: Packs the diffuse maps of all the loaded materials that have no normal or specular map into
+	pages, needs to be called from the thread with the context (through MyRenderThread::Invoke once the
+	render thread runs) once the models are loaded and before the static entities are batched; replaces
+	the previous pages
+	ARGUMENTS: ---
+	OUTPUT: number of textures in the atlas
+	*/
+	uint Build(void);
+	/*
+	USAGE: Sets the size of the pages and the padding used by the next Build
+	ARGUMENTS:
+	-	uint a_uPageSize -> width of the pages
+	-	uint a_uPadding -> pixels repeated around each texture
+	OUTPUT: ---
+	*/
+	void SetPageSize(uint a_uPageSize, uint a_uPadding = 4);
+	/*
+	USAGE: Gets the place of a material in the atlas
+	ARGUMENTS: int a_nMaterial -> material index
+	OUTPUT: entry, its page is -1 if the material is not in the atlas
+	*/
+	MyAtlasEntry GetEntry(int a_nMaterial);
+	/*
+	USAGE: Gets the material a mesh is drawn with, the page material if its texture is in the atlas and its
+	UVs stay inside the texture, so meshes of different materials can be merged
+	ARGUMENTS: uint a_uMeshIndex -> index of the mesh in the MeshManager
+	OUTPUT: material index
+	*/
+	int GetMeshMaterial(uint a_uMeshIndex);
+	/*
+	USAGE: Gets the rectangle the UVs of a mesh are moved to, (0, 0, 1, 1) if it does not use the atlas
+	ARGUMENTS: uint a_uMeshIndex -> index of the mesh in the MeshManager
+	OUTPUT: offset (xy) and scale (zw)
+	*/
+	vector4 GetMeshRect(uint a_uMeshIndex);
+	/*
+	USAGE: Gets (creating it the first time) the copy of a mesh drawn with the page material, meshes with
+	the same vertices on the same page share it; needs to be called from the simulation thread, the copy is
+	compiled by the render thread
+	ARGUMENTS: uint a_uMeshIndex -> index of the mesh in the MeshManager
+	OUTPUT: index of the copy, -1 if the mesh cannot use the atlas
+	*/
+	int GetMesh(uint a_uMeshIndex);
+	/*
+	USAGE: Gets the number of pages
+	ARGUMENTS: ---
+	OUTPUT: page count
+	*/
+	uint GetPageCount(void);
+	/*
+	USAGE: Gets the number of textures in the pages
+	ARGUMENTS: ---
+	OUTPUT: texture count
+	*/
+	uint GetTextureCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyTextureAtlas(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyTextureAtlas(MyTextureAtlas const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyTextureAtlas& operator=(MyTextureAtlas const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyTextureAtlas(void);
+	/*
+	Usage: releases the pages
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Asks if a mesh can be drawn with the page material of its texture
+	ARGUMENTS: uint a_uMeshIndex -> index of the mesh in the MeshManager
+	OUTPUT: is its material in the atlas with all its UVs inside the texture?
+	*/
+	bool CanUseAtlas(uint a_uMeshIndex);
+};
+
+} //namespace Simplex
+
+#endif //__MYTEXTUREATLAS_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
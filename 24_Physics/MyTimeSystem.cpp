@@ -0,0 +1,189 @@
+#include "MyTimeSystem.h"
+using namespace Simplex;
+//  MyTimeSystem
+Simplex::MyTimeSystem* Simplex::MyTimeSystem::m_pInstance = nullptr;
+void Simplex::MyTimeSystem::Init(void)
+{
+	m_start = Clock::now();
+	m_deadline = m_start;
+	m_lastFrame = m_start;
+	m_uTargetRate = 0;
+	m_nSpinMargin = 2000000;
+	m_nFrameDelta = 0;
+	m_uFrameCount = 0;
+	for (uint i = 0; i < m_uStatWindow; ++i)
+	{
+		m_fFrameTime[i] = 0.0f;
+	}
+	m_sortList.reserve(m_uStatWindow);
+
+	//clock 0 always exists, like the one of the SystemSingleton
+	GenClock();
+}
+void Simplex::MyTimeSystem::Release(void)
+{
+	m_clockList.clear();
+	m_sortList.clear();
+}
+Simplex::MyTimeSystem* Simplex::MyTimeSystem::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyTimeSystem();
+	}
+	return m_pInstance;
+}
+void Simplex::MyTimeSystem::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyTimeSystem::MyTimeSystem() { Init(); }
+Simplex::MyTimeSystem::MyTimeSystem(MyTimeSystem const& other) { }
+Simplex::MyTimeSystem& Simplex::MyTimeSystem::operator=(MyTimeSystem const& other) { return *this; }
+Simplex::MyTimeSystem::~MyTimeSystem() { Release(); }
+//Accessors
+Simplex::MyTimeSystem::Nanoseconds Simplex::MyTimeSystem::GetTime(void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count();
+}
+void Simplex::MyTimeSystem::SetTargetRate(uint a_uRate) { m_uTargetRate = a_uRate; }
+Simplex::uint Simplex::MyTimeSystem::GetTargetRate(void) { return m_uTargetRate; }
+Simplex::MyTimeSystem::Nanoseconds Simplex::MyTimeSystem::GetFrameDeltaNanoseconds(void) { return m_nFrameDelta; }
+float Simplex::MyTimeSystem::GetFrameDelta(void) { return static_cast<float>(m_nFrameDelta) / 1000000000.0f; }
+//Clocks
+Simplex::uint Simplex::MyTimeSystem::GenClock(void)
+{
+	Clock::time_point now = Clock::now();
+	MyClock clock;
+	clock.m_start = now;
+	clock.m_last = now;
+	clock.m_timerEnd = now;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_clockList.push_back(clock);
+	return m_clockList.size() - 1;
+}
+void Simplex::MyTimeSystem::ResetClock(uint a_uClock)
+{
+	Clock::time_point now = Clock::now();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (a_uClock >= m_clockList.size())
+		return;
+	m_clockList[a_uClock].m_start = now;
+	m_clockList[a_uClock].m_last = now;
+}
+Simplex::MyTimeSystem::Nanoseconds Simplex::MyTimeSystem::GetDeltaNanoseconds(uint a_uClock)
+{
+	Clock::time_point now = Clock::now();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (a_uClock >= m_clockList.size())
+		return 0;
+	Nanoseconds nDelta = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_clockList[a_uClock].m_last).count();
+	m_clockList[a_uClock].m_last = now;
+	return nDelta;
+}
+float Simplex::MyTimeSystem::GetDeltaTime(uint a_uClock)
+{
+	return static_cast<float>(GetDeltaNanoseconds(a_uClock)) / 1000000000.0f;
+}
+float Simplex::MyTimeSystem::GetTimeSinceStart(uint a_uClock)
+{
+	Clock::time_point now = Clock::now();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (a_uClock >= m_clockList.size())
+		return 0.0f;
+	return std::chrono::duration<float>(now - m_clockList[a_uClock].m_start).count();
+}
+void Simplex::MyTimeSystem::StartTimerOnClock(float a_fTime, uint a_uClock)
+{
+	Clock::time_point now = Clock::now();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (a_uClock >= m_clockList.size())
+		return;
+	m_clockList[a_uClock].m_timerEnd = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(a_fTime));
+}
+bool Simplex::MyTimeSystem::IsTimerDone(uint a_uClock)
+{
+	Clock::time_point now = Clock::now();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (a_uClock >= m_clockList.size())
+		return true;
+	return now >= m_clockList[a_uClock].m_timerEnd;
+}
+//Frames
+float Simplex::MyTimeSystem::Pace(void)
+{
+	Clock::time_point now = Clock::now();
+	if (m_uTargetRate > 0)
+	{
+		Nanoseconds nPeriod = 1000000000 / m_uTargetRate;
+		m_deadline += std::chrono::nanoseconds(nPeriod);
+		//a frame that ran late does not make the next ones rush to catch up
+		if (m_deadline < now)
+			m_deadline = now;
+
+		//sleeping wakes up late (a whole scheduler tick on some systems) so it stops short of the deadline
+		Clock::time_point wake = m_deadline - std::chrono::nanoseconds(m_nSpinMargin);
+		if (now < wake)
+		{
+			std::this_thread::sleep_until(wake);
+			//the margin jumps to the worst wake up seen and slowly comes back when the sleeps are precise
+			Nanoseconds nLate = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - wake).count();
+			if (nLate > m_nSpinMargin)
+				m_nSpinMargin = nLate;
+			else
+				m_nSpinMargin -= (m_nSpinMargin - nLate) / 16;
+			m_nSpinMargin = (std::min)((std::max)(m_nSpinMargin, static_cast<Nanoseconds>(100000)), nPeriod / 2);
+		}
+		//the rest is spun, giving the core away each time
+		while (Clock::now() < m_deadline)
+		{
+			std::this_thread::yield();
+		}
+		now = Clock::now();
+	}
+	else
+	{
+		m_deadline = now;
+	}
+
+	Nanoseconds nDelta = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_lastFrame).count();
+	m_lastFrame = now;
+	m_nFrameDelta = nDelta;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_fFrameTime[m_uFrameCount % m_uStatWindow] = static_cast<float>(nDelta) / 1000000.0f;
+	++m_uFrameCount;
+	return static_cast<float>(nDelta) / 1000000000.0f;
+}
+Simplex::MyFrameStats Simplex::MyTimeSystem::GetFrameStats(void)
+{
+	MyFrameStats stats;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	stats.m_uCount = m_uFrameCount < m_uStatWindow ? m_uFrameCount : m_uStatWindow;
+	if (stats.m_uCount == 0)
+		return stats;
+
+	//the ring is copied so it can be partially sorted, the scratch list was reserved on Init
+	m_sortList.assign(m_fFrameTime, m_fFrameTime + stats.m_uCount);
+	float fSum = 0.0f;
+	for (uint i = 0; i < stats.m_uCount; ++i)
+	{
+		fSum += m_sortList[i];
+		stats.m_fMax = (std::max)(stats.m_fMax, m_sortList[i]);
+	}
+	stats.m_fMean = fSum / stats.m_uCount;
+
+	uint uMedian = stats.m_uCount / 2;
+	std::nth_element(m_sortList.begin(), m_sortList.begin() + uMedian, m_sortList.end());
+	stats.m_fMedian = m_sortList[uMedian];
+	uint uP99 = (stats.m_uCount * 99 + 99) / 100 - 1;
+	std::nth_element(m_sortList.begin(), m_sortList.begin() + uP99, m_sortList.end());
+	stats.m_fP99 = m_sortList[uP99];
+	return stats;
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYTIMESYSTEM_H_
+#define __MYTIMESYSTEM_H_
+
+#include "Simplex\Simplex.h"
+
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+namespace Simplex
+{
+
+//Frame times over the last frames, in milliseconds
+struct MyFrameStats
+{
+	uint m_uCount = 0; //frames in the window
+	float m_fMean = 0.0f; //average frame time
+	float m_fMedian = 0.0f; //half the frames took less than this
+	float m_fP99 = 0.0f; //99 of each 100 frames took less than this
+	float m_fMax = 0.0f; //longest frame
+};
+
+//System Class, clocks on the steady clock of the standard library (nanoseconds instead of the milliseconds
+//of GetTickCount the SystemSingleton uses) and a pacer that waits for the next frame sleeping and then spinning;
+//the clocks and the stats can be used from any thread
+class MyTimeSystem
+{
+public:
+	typedef std::chrono::steady_clock Clock; //clock all the times come from
+	typedef int64_t Nanoseconds; //time in nanoseconds
+
+private:
+	static const uint m_uStatWindow = 240; //frames the stats are computed over
+
+	//a clock knows when it was created, when it was last asked for its delta and when its timer ends
+	struct MyClock
+	{
+		Clock::time_point m_start;
+		Clock::time_point m_last;
+		Clock::time_point m_timerEnd;
+	};
+
+	Clock::time_point m_start; //when the system started
+	std::mutex m_mutex; //guards the clocks and the frame times
+	std::vector<MyClock> m_clockList; //clocks generated
+
+	uint m_uTargetRate = 0; //frames per second the pacer aims for (0 does not wait)
+	Clock::time_point m_deadline; //when the next frame starts
+	Clock::time_point m_lastFrame; //when the last frame started
+	Nanoseconds m_nSpinMargin = 2000000; //time before the deadline the pacer stops sleeping and spins
+	std::atomic<Nanoseconds> m_nFrameDelta; //duration of the last frame
+
+	float m_fFrameTime[m_uStatWindow]; //ring of the last frame times in milliseconds
+	uint m_uFrameCount = 0; //frames recorded so far
+	std::vector<float> m_sortList; //scratch copy of the ring to find the percentiles
+
+	static MyTimeSystem* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyTimeSystem* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Gets the nanoseconds since the system started
+	ARGUMENTS: ---
+	OUTPUT: time
+	*/
+	Nanoseconds GetTime(void);
+	/*
+	USAGE: Adds a clock starting at the current time
+	ARGUMENTS: ---
+	OUTPUT: index of the new clock
+	*/
+	uint GenClock(void);
+	/*
+	USAGE: Restarts the specified clock, its delta and its time since start count from now
+	ARGUMENTS: uint a_uClock -> clock to restart
+	OUTPUT: ---
+	*/
+	void ResetClock(uint a_uClock);
+	/*
+	USAGE: Gets the nanoseconds since the last time the delta of this clock was asked for (or since it started)
+	ARGUMENTS: uint a_uClock -> clock to query
+	OUTPUT: delta in nanoseconds
+	*/
+	Nanoseconds GetDeltaNanoseconds(uint a_uClock);
+	/*
+	USAGE: Gets the seconds since the last time the delta of this clock was asked for (or since it started)
+	ARGUMENTS: uint a_uClock -> clock to query
+	OUTPUT: delta in seconds
+	*/
+	float GetDeltaTime(uint a_uClock);
+	/*
+	USAGE: Gets the seconds since the clock started, it does not change its delta
+	ARGUMENTS: uint a_uClock -> clock to query
+	OUTPUT: time in seconds
+	*/
+	float GetTimeSinceStart(uint a_uClock);
+	/*
+	USAGE: Starts a countdown on the clock
+	ARGUMENTS:
+	-	float a_fTime -> seconds to count
+	-	uint a_uClock -> clock to count with
+	OUTPUT: ---
+	*/
+	void StartTimerOnClock(float a_fTime, uint a_uClock);
+	/*
+	USAGE: Asks if the countdown of the clock is over
+	ARGUMENTS: uint a_uClock -> clock to query
+	OUTPUT: is it over? (true if the clock does not exist)
+	*/
+	bool IsTimerDone(uint a_uClock);
+	/*
+	USAGE: Sets the frames per second the pacer aims for
+	ARGUMENTS: uint a_uRate -> frames per second, 0 does not wait
+	OUTPUT: ---
+	*/
+	void SetTargetRate(uint a_uRate);
+	/*
+	USAGE: Gets the frames per second the pacer aims for
+	ARGUMENTS: ---
+	OUTPUT: frames per second
+	*/
+	uint GetTargetRate(void);
+	/*
+	USAGE: Ends a frame, waits for the start of the next one (sleeping while the deadline is far and spinning
+	the rest) and records how long the frame took; call it once per frame from the thread driving the frames
+	ARGUMENTS: ---
+	OUTPUT: seconds the frame took
+	*/
+	float Pace(void);
+	/*
+	USAGE: Gets the nanoseconds the last frame took (between the last two calls to Pace)
+	ARGUMENTS: ---
+	OUTPUT: frame delta
+	*/
+	Nanoseconds GetFrameDeltaNanoseconds(void);
+	/*
+	USAGE: Gets the seconds the last frame took (between the last two calls to Pace)
+	ARGUMENTS: ---
+	OUTPUT: frame delta
+	*/
+	float GetFrameDelta(void);
+	/*
+	USAGE: Gets the mean, median, 99th percentile and maximum of the last frame times
+	ARGUMENTS: ---
+	OUTPUT: frame stats
+	*/
+	MyFrameStats GetFrameStats(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyTimeSystem(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyTimeSystem(MyTimeSystem const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyTimeSystem& operator=(MyTimeSystem const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyTimeSystem(void);
+	/*
+	Usage: releases the clocks
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+};
+
+} //namespace Simplex
+
+#endif //__MYTIMESYSTEM_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include "MyTransformSystem.h"
+using namespace Simplex;
+//  MyTransformSystem
+Simplex::MyTransformSystem* Simplex::MyTransformSystem::m_pInstance = nullptr;
+void Simplex::MyTransformSystem::Init(void)
+{
+	m_bSorted = true;
+	m_uChangedCount = 0;
+}
+void Simplex::MyTransformSystem::Release(void)
+{
+	m_localList.clear();
+	m_worldList.clear();
+	m_parentList.clear();
+	m_levelList.clear();
+	m_dirtyList.clear();
+	m_changedList.clear();
+	m_handleList.clear();
+	m_slotList.clear();
+	m_freeList.clear();
+	m_levelStart.clear();
+}
+Simplex::MyTransformSystem* Simplex::MyTransformSystem::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyTransformSystem();
+	}
+	return m_pInstance;
+}
+void Simplex::MyTransformSystem::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyTransformSystem::MyTransformSystem() { Init(); }
+Simplex::MyTransformSystem::MyTransformSystem(MyTransformSystem const& other) { }
+Simplex::MyTransformSystem& Simplex::MyTransformSystem::operator=(MyTransformSystem const& other) { return *this; }
+Simplex::MyTransformSystem::~MyTransformSystem() { Release(); }
+//Accessors
+int Simplex::MyTransformSystem::GetParent(uint a_uHandle)
+{
+	int nParent = m_parentList[m_slotList[a_uHandle]];
+	return nParent < 0 ? -1 : static_cast<int>(m_handleList[nParent]);
+}
+Simplex::matrix4 Simplex::MyTransformSystem::GetLocal(uint a_uHandle) { return m_localList[m_slotList[a_uHandle]]; }
+Simplex::matrix4 Simplex::MyTransformSystem::GetWorld(uint a_uHandle) { return m_worldList[m_slotList[a_uHandle]]; }
+bool Simplex::MyTransformSystem::HasChanged(uint a_uHandle)
+{
+	uint uSlot = m_slotList[a_uHandle];
+	return uSlot < m_changedList.size() && m_changedList[uSlot] != 0;
+}
+Simplex::uint Simplex::MyTransformSystem::GetChangedCount(void) { return m_uChangedCount; }
+Simplex::uint Simplex::MyTransformSystem::GetNodeCount(void) { return m_localList.size(); }
+bool Simplex::MyTransformSystem::SetLocal(uint a_uHandle, matrix4 const& a_m4Local)
+{
+	uint uSlot = m_slotList[a_uHandle];
+	//setting the same transform does not dirty the subtree
+	if (m_localList[uSlot] == a_m4Local)
+		return false;
+
+	m_localList[uSlot] = a_m4Local;
+	m_dirtyList[uSlot] = 1;
+	if (m_parentList[uSlot] < 0)
+		m_worldList[uSlot] = a_m4Local;
+	return true;
+}
+//Hierarchy
+Simplex::uint Simplex::MyTransformSystem::Create(int a_nParent)
+{
+	uint uHandle = m_slotList.size();
+	if (m_freeList.size() > 0)
+	{
+		uHandle = m_freeList.back();
+		m_freeList.pop_back();
+	}
+	else
+	{
+		m_slotList.push_back(0);
+	}
+
+	int nParent = a_nParent < 0 ? -1 : static_cast<int>(m_slotList[a_nParent]);
+	m_slotList[uHandle] = m_localList.size();
+	m_localList.push_back(IDENTITY_M4);
+	m_worldList.push_back(nParent < 0 ? IDENTITY_M4 : m_worldList[nParent]);
+	m_parentList.push_back(nParent);
+	m_levelList.push_back(0);
+	m_dirtyList.push_back(1);
+	m_changedList.push_back(0);
+	m_handleList.push_back(uHandle);
+
+	//the levels are found when the slots are sorted
+	m_bSorted = false;
+	return uHandle;
+}
+void Simplex::MyTransformSystem::Destroy(uint a_uHandle)
+{
+	uint uSlot = m_slotList[a_uHandle];
+	uint uLast = m_localList.size() - 1;
+
+	//the children stay where they are
+	for (uint i = 0; i < m_parentList.size(); ++i)
+	{
+		if (m_parentList[i] == static_cast<int>(uSlot))
+		{
+			m_parentList[i] = -1;
+			m_localList[i] = m_worldList[i];
+			m_dirtyList[i] = 1;
+		}
+	}
+
+	//the last slot fills the hole, the ones pointing to it follow it
+	if (uSlot != uLast)
+	{
+		m_localList[uSlot] = m_localList[uLast];
+		m_worldList[uSlot] = m_worldList[uLast];
+		m_parentList[uSlot] = m_parentList[uLast];
+		m_dirtyList[uSlot] = m_dirtyList[uLast];
+		m_changedList[uSlot] = m_changedList[uLast];
+		m_handleList[uSlot] = m_handleList[uLast];
+		m_slotList[m_handleList[uSlot]] = uSlot;
+		for (uint i = 0; i < m_parentList.size(); ++i)
+		{
+			if (m_parentList[i] == static_cast<int>(uLast))
+				m_parentList[i] = uSlot;
+		}
+	}
+	m_localList.pop_back();
+	m_worldList.pop_back();
+	m_parentList.pop_back();
+	m_levelList.pop_back();
+	m_dirtyList.pop_back();
+	m_changedList.pop_back();
+	m_handleList.pop_back();
+
+	m_freeList.push_back(a_uHandle);
+	m_bSorted = false;
+}
+bool Simplex::MyTransformSystem::SetParent(uint a_uHandle, int a_nParent)
+{
+	uint uSlot = m_slotList[a_uHandle];
+	int nParent = a_nParent < 0 ? -1 : static_cast<int>(m_slotList[a_nParent]);
+	if (m_parentList[uSlot] == nParent)
+		return true;
+
+	//the new parent cannot be below the node
+	for (int nAncestor = nParent; nAncestor >= 0; nAncestor = m_parentList[nAncestor])
+	{
+		if (nAncestor == static_cast<int>(uSlot))
+			return false;
+	}
+
+	m_parentList[uSlot] = nParent;
+	m_dirtyList[uSlot] = 1;
+	if (nParent < 0)
+		m_worldList[uSlot] = m_localList[uSlot];
+	m_bSorted = false;
+	return true;
+}
+void Simplex::MyTransformSystem::Sort(void)
+{
+	uint uCount = m_localList.size();
+
+	//level of each slot, walking up until a known one
+	const uint uUnknown = static_cast<uint>(-1);
+	m_levelList.assign(uCount, uUnknown);
+	std::vector<uint> chainList;
+	uint uLevelCount = 0;
+	for (uint i = 0; i < uCount; ++i)
+	{
+		int nSlot = i;
+		while (nSlot >= 0 && m_levelList[nSlot] == uUnknown)
+		{
+			chainList.push_back(nSlot);
+			nSlot = m_parentList[nSlot];
+		}
+		uint uLevel = nSlot < 0 ? 0 : m_levelList[nSlot] + 1;
+		while (chainList.size() > 0)
+		{
+			m_levelList[chainList.back()] = uLevel++;
+			chainList.pop_back();
+		}
+		if (uLevel > uLevelCount)
+			uLevelCount = uLevel;
+	}
+
+	//counting sort by level
+	m_levelStart.assign(uLevelCount + 1, 0);
+	for (uint i = 0; i < uCount; ++i)
+	{
+		++m_levelStart[m_levelList[i] + 1];
+	}
+	for (uint i = 0; i < uLevelCount; ++i)
+	{
+		m_levelStart[i + 1] += m_levelStart[i];
+	}
+	std::vector<uint> newSlotList(uCount);
+	std::vector<uint> nextList(m_levelStart.begin(), m_levelStart.end() - 1);
+	for (uint i = 0; i < uCount; ++i)
+	{
+		newSlotList[i] = nextList[m_levelList[i]]++;
+	}
+
+	//move everything to its new slot
+	std::vector<matrix4> localList(uCount);
+	std::vector<matrix4> worldList(uCount);
+	std::vector<int> parentList(uCount);
+	std::vector<uint> levelList(uCount);
+	std::vector<uint8_t> dirtyList(uCount);
+	std::vector<uint8_t> changedList(uCount);
+	std::vector<uint> handleList(uCount);
+	for (uint i = 0; i < uCount; ++i)
+	{
+		uint uSlot = newSlotList[i];
+		localList[uSlot] = m_localList[i];
+		worldList[uSlot] = m_worldList[i];
+		parentList[uSlot] = m_parentList[i] < 0 ? -1 : static_cast<int>(newSlotList[m_parentList[i]]);
+		levelList[uSlot] = m_levelList[i];
+		dirtyList[uSlot] = m_dirtyList[i];
+		changedList[uSlot] = m_changedList[i];
+		handleList[uSlot] = m_handleList[i];
+		m_slotList[m_handleList[i]] = uSlot;
+	}
+	m_localList.swap(localList);
+	m_worldList.swap(worldList);
+	m_parentList.swap(parentList);
+	m_levelList.swap(levelList);
+	m_dirtyList.swap(dirtyList);
+	m_changedList.swap(changedList);
+	m_handleList.swap(handleList);
+	m_bSorted = true;
+}
+void Simplex::MyTransformSystem::Update(void)
+{
+	if (!m_bSorted)
+		Sort();
+
+	//a slot is recomputed if it is dirty or its parent was, parents are always in an earlier level
+	m_changedList.assign(m_localList.size(), 0);
+	MyJobSystem* pJobSystem = MyJobSystem::GetInstance();
+	for (uint uLevel = 0; uLevel + 1 < m_levelStart.size(); ++uLevel)
+	{
+		uint uFirst = m_levelStart[uLevel];
+		pJobSystem->ParallelFor(m_levelStart[uLevel + 1] - uFirst, 256, [this, uFirst](uint a_uBegin, uint a_uEnd, uint a_uThread)
+		{
+			for (uint i = uFirst + a_uBegin; i < uFirst + a_uEnd; ++i)
+			{
+				int nParent = m_parentList[i];
+				if (m_dirtyList[i] == 0 && (nParent < 0 || m_changedList[nParent] == 0))
+					continue;
+				m_worldList[i] = nParent < 0 ? m_localList[i] : m_worldList[nParent] * m_localList[i];
+				m_dirtyList[i] = 0;
+				m_changedList[i] = 1;
+			}
+		});
+	}
+
+	m_uChangedCount = 0;
+	for (uint i = 0; i < m_changedList.size(); ++i)
+	{
+		m_uChangedCount += m_changedList[i];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYTRANSFORMSYSTEM_H_
+#define __MYTRANSFORMSYSTEM_H_
+
+#include "MyJobSystem.h"
+
+namespace Simplex
+{
+
+//System Class, local and world matrices of all the nodes in flat arrays sorted by depth in the hierarchy
+//(so parents are always before their children), only the nodes marked dirty and their subtrees are
+//recomputed, one level at a time with the nodes of each level in parallel
+class MyTransformSystem
+{
+	std::vector<matrix4> m_localList; //transform of each slot relative to its parent
+	std::vector<matrix4> m_worldList; //transform of each slot in global space
+	std::vector<int> m_parentList; //slot of the parent of each slot, -1 for roots
+	std::vector<uint> m_levelList; //depth of each slot in the hierarchy
+	std::vector<uint8_t> m_dirtyList; //1 for the slots whose local transform changed since the last update
+	std::vector<uint8_t> m_changedList; //1 for the slots whose world transform was computed in the last update
+	std::vector<uint> m_handleList; //handle of each slot
+	std::vector<uint> m_slotList; //slot of each handle, the slots move when they are sorted
+	std::vector<uint> m_freeList; //handles returned to the system
+	std::vector<uint> m_levelStart; //first slot of each level, plus one past the last slot
+	bool m_bSorted = true; //are the slots sorted by level?
+	uint m_uChangedCount = 0; //world transforms computed in the last update
+
+	static MyTransformSystem* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyTransformSystem* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Creates a node with the identity as transform
+	ARGUMENTS: int a_nParent = -1 -> handle of the parent, -1 for a root
+	OUTPUT: handle of the node
+	*/
+	uint Create(int a_nParent = -1);
+	/*
+	USAGE: Destroys a node, its children become roots keeping their world transform
+	ARGUMENTS: uint a_uHandle -> node to destroy
+	OUTPUT: ---
+	*/
+	void Destroy(uint a_uHandle);
+	/*
+	USAGE: Sets the parent of a node, the local transform is kept (the node moves with the new parent)
+	ARGUMENTS:
+	-	uint a_uHandle -> node
+	-	int a_nParent -> handle of the parent, -1 for a root
+	OUTPUT: was it set? (a node cannot be parented to its own subtree)
+	*/
+	bool SetParent(uint a_uHandle, int a_nParent);
+	/*
+	USAGE: Gets the parent of a node
+	ARGUMENTS: uint a_uHandle -> node
+	OUTPUT: handle of the parent, -1 for a root
+	*/
+	int GetParent(uint a_uHandle);
+	/*
+	USAGE: Sets the transform of a node relative to its parent, marking it dirty if it changed; the
+	world transform of a root is set right away
+	ARGUMENTS:
+	-	uint a_uHandle -> node
+	-	matrix4 const& a_m4Local -> transform relative to the parent
+	OUTPUT: did it change?
+	*/
+	bool SetLocal(uint a_uHandle, matrix4 const& a_m4Local);
+	/*
+	USAGE: Gets the transform of a node relative to its parent
+	ARGUMENTS: uint a_uHandle -> node
+	OUTPUT: local transform
+	*/
+	matrix4 GetLocal(uint a_uHandle);
+	/*
+	USAGE: Gets the transform of a node in global space as of the last update (or the last SetLocal for roots)
+	ARGUMENTS: uint a_uHandle -> node
+	OUTPUT: world transform
+	*/
+	matrix4 GetWorld(uint a_uHandle);
+	/*
+	USAGE: Asks if the world transform of a node was computed in the last update, the nodes that did not
+	change do not need their bounds or render data updated
+	ARGUMENTS: uint a_uHandle -> node
+	OUTPUT: did it change?
+	*/
+	bool HasChanged(uint a_uHandle);
+	/*
+	USAGE: Gets the number of world transforms computed in the last update
+	ARGUMENTS: ---
+	OUTPUT: changed count
+	*/
+	uint GetChangedCount(void);
+	/*
+	USAGE: Gets the number of nodes
+	ARGUMENTS: ---
+	OUTPUT: node count
+	*/
+	uint GetNodeCount(void);
+	/*
+	USAGE: Sorts the nodes if the hierarchy changed and recomputes the world transform of the dirty ones
+	and their subtrees in a single pass
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Update(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyTransformSystem(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyTransformSystem(MyTransformSystem const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyTransformSystem& operator=(MyTransformSystem const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyTransformSystem(void);
+	/*
+	Usage: releases the member lists
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Sorts the slots by level (stable, so the order inside a level is kept)
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Sort(void);
+};
+
+} //namespace Simplex
+
+#endif //__MYTRANSFORMSYSTEM_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
@@ -0,0 +1,516 @@
+#include "MyVoxelWorld.h"
+#include "MyRenderThread.h"
+using namespace Simplex;
+static const int CHUNK_SIZE = MyVoxelChunk::m_nSize;
+static int FloorDiv(int a_nValue, int a_nDivisor)
+{
+	return a_nValue >= 0 ? a_nValue / a_nDivisor : (a_nValue - a_nDivisor + 1) / a_nDivisor;
+}
+static int BlockIndex(glm::ivec3 a_v3Local)
+{
+	return a_v3Local.x + CHUNK_SIZE * (a_v3Local.y + CHUNK_SIZE * a_v3Local.z);
+}
+//  MyVoxelWorld
+Simplex::MyVoxelWorld* Simplex::MyVoxelWorld::m_pInstance = nullptr;
+void Simplex::MyVoxelWorld::Init(void)
+{
+	m_pMeshMngr = MeshManager::GetInstance();
+	m_uDrawnCount = 0;
+	m_uBuildCount = 0;
+	m_uQuadCount = 0;
+
+	//kind 0 is air
+	m_typeList.push_back(MyBlockType());
+}
+void Simplex::MyVoxelWorld::Release(void)
+{
+	//the meshes of the chunks belong to the MeshManager
+	for (uint i = 0; i < m_chunkList.size(); ++i)
+	{
+		SafeDelete(m_chunkList[i]);
+	}
+	m_chunkList.clear();
+	m_chunkMap.clear();
+	m_buildList.clear();
+	m_visibleList.clear();
+	m_typeList.clear();
+	m_pMeshMngr = nullptr;
+}
+Simplex::MyVoxelWorld* Simplex::MyVoxelWorld::GetInstance()
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new MyVoxelWorld();
+	}
+	return m_pInstance;
+}
+void Simplex::MyVoxelWorld::ReleaseInstance()
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+//The big 3
+Simplex::MyVoxelWorld::MyVoxelWorld() { Init(); }
+Simplex::MyVoxelWorld::MyVoxelWorld(MyVoxelWorld const& other) { }
+Simplex::MyVoxelWorld& Simplex::MyVoxelWorld::operator=(MyVoxelWorld const& other) { return *this; }
+Simplex::MyVoxelWorld::~MyVoxelWorld() { Release(); }
+//Accessors
+Simplex::uint Simplex::MyVoxelWorld::GetChunkCount(void) { return m_chunkList.size(); }
+Simplex::uint Simplex::MyVoxelWorld::GetBlockCount(void)
+{
+	uint uCount = 0;
+	for (uint i = 0; i < m_chunkList.size(); ++i)
+	{
+		uCount += m_chunkList[i]->m_uBlockCount;
+	}
+	return uCount;
+}
+Simplex::uint Simplex::MyVoxelWorld::GetDrawnCount(void) { return m_uDrawnCount; }
+Simplex::uint Simplex::MyVoxelWorld::GetBuildCount(void) { return m_uBuildCount; }
+Simplex::uint Simplex::MyVoxelWorld::GetQuadCount(void) { return m_uQuadCount; }
+//Blocks
+uint8_t Simplex::MyVoxelWorld::AddBlockType(int a_nMaterial, vector3 a_v3Color)
+{
+	if (m_typeList.size() > 255)
+		return 0;
+	MyBlockType type;
+	type.m_nMaterial = a_nMaterial;
+	type.m_v3Color = a_v3Color;
+	m_typeList.push_back(type);
+	return static_cast<uint8_t>(m_typeList.size() - 1);
+}
+uint64_t Simplex::MyVoxelWorld::GetKey(glm::ivec3 a_v3Coord)
+{
+	//16 bits for each coordinate
+	uint64_t uKey = static_cast<uint64_t>((a_v3Coord.x + 32768) & 0xFFFF) << 32;
+	uKey |= static_cast<uint64_t>((a_v3Coord.y + 32768) & 0xFFFF) << 16;
+	uKey |= static_cast<uint64_t>((a_v3Coord.z + 32768) & 0xFFFF);
+	return uKey;
+}
+Simplex::MyVoxelChunk* Simplex::MyVoxelWorld::GetChunk(glm::ivec3 a_v3Coord, bool a_bCreate)
+{
+	uint64_t uKey = GetKey(a_v3Coord);
+	auto chunk = m_chunkMap.find(uKey);
+	if (chunk != m_chunkMap.end())
+		return m_chunkList[chunk->second];
+	if (!a_bCreate)
+		return nullptr;
+
+	MyVoxelChunk* pChunk = new MyVoxelChunk();
+	pChunk->m_v3Coord = a_v3Coord;
+	memset(pChunk->m_block, 0, sizeof(pChunk->m_block));
+	m_chunkList.push_back(pChunk);
+	m_chunkMap[uKey] = m_chunkList.size() - 1;
+	return pChunk;
+}
+void Simplex::MyVoxelWorld::MarkDirty(glm::ivec3 a_v3Coord)
+{
+	MyVoxelChunk* pChunk = GetChunk(a_v3Coord, false);
+	if (pChunk)
+		pChunk->m_bDirty = true;
+}
+void Simplex::MyVoxelWorld::SetBlock(glm::ivec3 a_v3Block, uint8_t a_uType)
+{
+	if (a_uType >= m_typeList.size())
+		return;
+
+	glm::ivec3 v3Coord = glm::ivec3(FloorDiv(a_v3Block.x, CHUNK_SIZE), FloorDiv(a_v3Block.y, CHUNK_SIZE), FloorDiv(a_v3Block.z, CHUNK_SIZE));
+	//air does not create chunks
+	MyVoxelChunk* pChunk = GetChunk(v3Coord, a_uType != 0);
+	if (pChunk == nullptr)
+		return;
+
+	glm::ivec3 v3Local = a_v3Block - v3Coord * CHUNK_SIZE;
+	uint8_t& uBlock = pChunk->m_block[BlockIndex(v3Local)];
+	if (uBlock == a_uType)
+		return;
+	if (uBlock == 0)
+		++pChunk->m_uBlockCount;
+	else if (a_uType == 0)
+		--pChunk->m_uBlockCount;
+	uBlock = a_uType;
+	pChunk->m_bDirty = true;
+
+	//the faces of the neighbors touching the block appear or disappear as well
+	for (int i = 0; i < 3; ++i)
+	{
+		glm::ivec3 v3Step = glm::ivec3(0);
+		v3Step[i] = 1;
+		if (v3Local[i] == 0)
+			MarkDirty(v3Coord - v3Step);
+		if (v3Local[i] == CHUNK_SIZE - 1)
+			MarkDirty(v3Coord + v3Step);
+	}
+}
+void Simplex::MyVoxelWorld::Fill(glm::ivec3 a_v3Min, glm::ivec3 a_v3Max, uint8_t a_uType)
+{
+	for (int z = a_v3Min.z; z <= a_v3Max.z; ++z)
+	{
+		for (int y = a_v3Min.y; y <= a_v3Max.y; ++y)
+		{
+			for (int x = a_v3Min.x; x <= a_v3Max.x; ++x)
+			{
+				SetBlock(glm::ivec3(x, y, z), a_uType);
+			}
+		}
+	}
+}
+uint8_t Simplex::MyVoxelWorld::GetBlock(glm::ivec3 a_v3Block)
+{
+	glm::ivec3 v3Coord = glm::ivec3(FloorDiv(a_v3Block.x, CHUNK_SIZE), FloorDiv(a_v3Block.y, CHUNK_SIZE), FloorDiv(a_v3Block.z, CHUNK_SIZE));
+	auto chunk = m_chunkMap.find(GetKey(v3Coord));
+	if (chunk == m_chunkMap.end())
+		return 0;
+	return m_chunkList[chunk->second]->m_block[BlockIndex(a_v3Block - v3Coord * CHUNK_SIZE)];
+}
+bool Simplex::MyVoxelWorld::IsSolid(vector3 a_v3Position)
+{
+	return GetBlock(glm::ivec3(glm::floor(a_v3Position))) != 0;
+}
+//Collisions
+Simplex::vector3 Simplex::MyVoxelWorld::MoveBox(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Move, glm::bvec3& a_bHit)
+{
+	//faces closer than this are touching, it keeps a box resting on a face from falling into the block
+	const float fSkin = 0.001f;
+	a_bHit = glm::bvec3(false);
+	if (m_chunkList.size() == 0)
+		return a_v3Move;
+
+	//y goes first so a box landing on the ground slides on it instead of getting stuck on its edges
+	const int nAxisOrder[3] = { 1, 0, 2 };
+	for (int n = 0; n < 3; ++n)
+	{
+		int d = nAxisOrder[n];
+		float fMove = a_v3Move[d];
+		if (fMove == 0.0f)
+			continue;
+		int u = (d + 1) % 3;
+		int v = (d + 2) % 3;
+
+		//blocks the face of the box moving forward sweeps through
+		int nFrom, nTo;
+		if (fMove > 0.0f)
+		{
+			nFrom = static_cast<int>(glm::floor(a_v3Max[d] - fSkin));
+			nTo = static_cast<int>(glm::floor(a_v3Max[d] + fMove));
+		}
+		else
+		{
+			nFrom = static_cast<int>(glm::floor(a_v3Min[d] + fMove));
+			nTo = static_cast<int>(glm::floor(a_v3Min[d] + fSkin));
+		}
+		int nMinU = static_cast<int>(glm::floor(a_v3Min[u] + fSkin));
+		int nMaxU = static_cast<int>(glm::floor(a_v3Max[u] - fSkin));
+		int nMinV = static_cast<int>(glm::floor(a_v3Min[v] + fSkin));
+		int nMaxV = static_cast<int>(glm::floor(a_v3Max[v] - fSkin));
+
+		//the closest layer with a block stops the box at its face
+		bool bHit = false;
+		int nStep = fMove > 0.0f ? 1 : -1;
+		int nLayer = fMove > 0.0f ? nFrom : nTo;
+		int nLast = fMove > 0.0f ? nTo : nFrom;
+		for (; !bHit; nLayer += nStep)
+		{
+			for (int j = nMinV; j <= nMaxV && !bHit; ++j)
+			{
+				for (int i = nMinU; i <= nMaxU && !bHit; ++i)
+				{
+					glm::ivec3 v3Block;
+					v3Block[d] = nLayer;
+					v3Block[u] = i;
+					v3Block[v] = j;
+					bHit = GetBlock(v3Block) != 0;
+				}
+			}
+			if (bHit || nLayer == nLast)
+				break;
+		}
+		if (bHit)
+		{
+			if (fMove > 0.0f)
+				fMove = (glm::min)(fMove, nLayer - a_v3Max[d]);
+			else
+				fMove = (glm::max)(fMove, nLayer + 1.0f - a_v3Min[d]);
+			a_bHit[d] = true;
+		}
+
+		a_v3Move[d] = fMove;
+		a_v3Min[d] += fMove;
+		a_v3Max[d] += fMove;
+	}
+	return a_v3Move;
+}
+//Meshes
+void Simplex::MyVoxelWorld::BuildMesh(MyVoxelChunk* a_pChunk)
+{
+	for (uint i = 0; i < a_pChunk->m_meshList.size(); ++i)
+	{
+		MyVoxelMesh& mesh = a_pChunk->m_meshList[i];
+		mesh.m_positionList.clear();
+		mesh.m_normalList.clear();
+		mesh.m_uvList.clear();
+		mesh.m_colorList.clear();
+	}
+	if (a_pChunk->m_uBlockCount == 0)
+		return;
+
+	glm::ivec3 v3Origin = a_pChunk->m_v3Coord * CHUNK_SIZE;
+	uint8_t mask[CHUNK_SIZE * CHUNK_SIZE];
+	for (int d = 0; d < 3; ++d)
+	{
+		//u and v go along the face so u cross v points along d
+		int u = (d + 1) % 3;
+		int v = (d + 2) % 3;
+		for (int nSide = -1; nSide <= 1; nSide += 2)
+		{
+			glm::ivec3 v3Step = glm::ivec3(0);
+			v3Step[d] = nSide;
+			vector3 v3Normal = vector3(0.0f);
+			v3Normal[d] = static_cast<float>(nSide);
+
+			for (int nSlice = 0; nSlice < CHUNK_SIZE; ++nSlice)
+			{
+				//kind of the block of each face of the slice looking to the side, 0 if the face is hidden
+				for (int j = 0; j < CHUNK_SIZE; ++j)
+				{
+					for (int i = 0; i < CHUNK_SIZE; ++i)
+					{
+						glm::ivec3 v3Local;
+						v3Local[d] = nSlice;
+						v3Local[u] = i;
+						v3Local[v] = j;
+						uint8_t uType = a_pChunk->m_block[BlockIndex(v3Local)];
+						if (uType != 0)
+						{
+							//the neighbors past the border are looked up in the world (the blocks do not change while meshing)
+							glm::ivec3 v3Next = v3Local + v3Step;
+							uint8_t uNext = (v3Next[d] >= 0 && v3Next[d] < CHUNK_SIZE) ? a_pChunk->m_block[BlockIndex(v3Next)] : GetBlock(v3Origin + v3Next);
+							if (uNext != 0)
+								uType = 0;
+						}
+						mask[i + j * CHUNK_SIZE] = uType;
+					}
+				}
+
+				//each face grows along u as far as it can and then along v while the whole row matches
+				for (int j = 0; j < CHUNK_SIZE; ++j)
+				{
+					for (int i = 0; i < CHUNK_SIZE;)
+					{
+						uint8_t uType = mask[i + j * CHUNK_SIZE];
+						if (uType == 0)
+						{
+							++i;
+							continue;
+						}
+						int nWidth = 1;
+						while (i + nWidth < CHUNK_SIZE && mask[i + nWidth + j * CHUNK_SIZE] == uType)
+							++nWidth;
+						int nHeight = 1;
+						bool bGrow = true;
+						while (j + nHeight < CHUNK_SIZE && bGrow)
+						{
+							for (int k = 0; k < nWidth && bGrow; ++k)
+							{
+								bGrow = mask[i + k + (j + nHeight) * CHUNK_SIZE] == uType;
+							}
+							if (bGrow)
+								++nHeight;
+						}
+						for (int l = 0; l < nHeight; ++l)
+						{
+							for (int k = 0; k < nWidth; ++k)
+							{
+								mask[i + k + (j + l) * CHUNK_SIZE] = 0;
+							}
+						}
+
+						//mesh of the material of the block
+						MyBlockType const& type = m_typeList[uType];
+						MyVoxelMesh* pMesh = nullptr;
+						for (uint m = 0; m < a_pChunk->m_meshList.size() && pMesh == nullptr; ++m)
+						{
+							if (a_pChunk->m_meshList[m].m_nMaterial == type.m_nMaterial)
+								pMesh = &a_pChunk->m_meshList[m];
+						}
+						if (pMesh == nullptr)
+						{
+							a_pChunk->m_meshList.push_back(MyVoxelMesh());
+							pMesh = &a_pChunk->m_meshList.back();
+							pMesh->m_nMaterial = type.m_nMaterial;
+						}
+
+						//corners of the quad, counter clockwise seen from the side it looks to
+						vector3 v3Corner = vector3(0.0f);
+						v3Corner[d] = static_cast<float>(nSlice + (nSide > 0 ? 1 : 0));
+						v3Corner[u] = static_cast<float>(i);
+						v3Corner[v] = static_cast<float>(j);
+						v3Corner += vector3(v3Origin);
+						vector3 v3U = vector3(0.0f);
+						v3U[u] = static_cast<float>(nWidth);
+						vector3 v3V = vector3(0.0f);
+						v3V[v] = static_cast<float>(nHeight);
+						vector3 v3Position[4] = { v3Corner, v3Corner + v3U, v3Corner + v3U + v3V, v3Corner + v3V };
+						//the texture repeats once per block
+						vector3 v3UV[4] = { ZERO_V3, vector3(nWidth, 0.0f, 0.0f), vector3(nWidth, nHeight, 0.0f), vector3(0.0f, nHeight, 0.0f) };
+						if (nSide < 0)
+						{
+							std::swap(v3Position[1], v3Position[3]);
+							std::swap(v3UV[1], v3UV[3]);
+						}
+						const int nCorner[6] = { 0, 1, 2, 0, 2, 3 };
+						for (int c = 0; c < 6; ++c)
+						{
+							pMesh->m_positionList.push_back(v3Position[nCorner[c]]);
+							pMesh->m_normalList.push_back(v3Normal);
+							pMesh->m_uvList.push_back(v3UV[nCorner[c]]);
+							pMesh->m_colorList.push_back(type.m_v3Color);
+						}
+						i += nWidth;
+					}
+				}
+			}
+		}
+	}
+}
+void Simplex::MyVoxelWorld::Upload(MyVoxelChunk* a_pChunk)
+{
+	for (uint i = 0; i < a_pChunk->m_meshList.size(); ++i)
+	{
+		MyVoxelMesh& mesh = a_pChunk->m_meshList[i];
+		//a material the chunk no longer has keeps its mesh, it is just not drawn
+		if (mesh.m_positionList.size() == 0)
+			continue;
+
+		Mesh* pMesh = new Mesh();
+		pMesh->AddVertexPositionList(mesh.m_positionList);
+		pMesh->AddVertexColorList(mesh.m_colorList);
+		pMesh->AddVertexNormalList(mesh.m_normalList);
+		pMesh->AddVertexUVList(mesh.m_uvList);
+		pMesh->SetMaterial(mesh.m_nMaterial);
+		pMesh->CompileOpenGL3X();
+
+		if (mesh.m_nMesh < 0)
+		{
+			mesh.m_nMesh = m_pMeshMngr->AddMesh(pMesh);
+		}
+		else
+		{
+			//the index stays the same, the old buffers leave with the temporary mesh
+			m_pMeshMngr->GetMesh(mesh.m_nMesh)->Swap(*pMesh);
+			SafeDelete(pMesh);
+		}
+	}
+}
+void Simplex::MyVoxelWorld::AddToRenderList(void)
+{
+	m_uDrawnCount = 0;
+	m_uBuildCount = 0;
+	MyRenderQueue* pRenderQueue = MyRenderQueue::GetInstance();
+	matrix4 m4ViewProjection = pRenderQueue->GetViewProjection();
+	MyCommandBuffer* pBuffer = pRenderQueue->GetBuffer();
+
+	m_visibleList.clear();
+	m_buildList.clear();
+	for (uint i = 0; i < m_chunkList.size(); ++i)
+	{
+		MyVoxelChunk* pChunk = m_chunkList[i];
+		if (pChunk->m_uBlockCount == 0 && !pChunk->m_bDirty)
+			continue;
+
+		//the chunk is outside the frustum if all its corners are outside the same plane
+		vector3 v3Min = vector3(pChunk->m_v3Coord * CHUNK_SIZE);
+		vector3 v3Max = v3Min + vector3(static_cast<float>(CHUNK_SIZE));
+		uint uOutside[6] = { 0, 0, 0, 0, 0, 0 };
+		for (uint j = 0; j < 8; ++j)
+		{
+			vector3 v3Corner = vector3(j & 1 ? v3Max.x : v3Min.x, j & 2 ? v3Max.y : v3Min.y, j & 4 ? v3Max.z : v3Min.z);
+			vector4 v4Clip = m4ViewProjection * vector4(v3Corner, 1.0f);
+			for (uint k = 0; k < 3; ++k)
+			{
+				if (v4Clip[k] < -v4Clip.w) ++uOutside[k * 2];
+				if (v4Clip[k] > v4Clip.w) ++uOutside[k * 2 + 1];
+			}
+		}
+		bool bVisible = true;
+		for (uint k = 0; k < 6; ++k)
+		{
+			if (uOutside[k] == 8)
+				bVisible = false;
+		}
+		if (!bVisible)
+			continue;
+
+		//chunks that changed are only meshed again when they are seen
+		m_visibleList.push_back(pChunk);
+		if (pChunk->m_bDirty)
+			m_buildList.push_back(pChunk);
+	}
+
+	if (m_buildList.size() > 0)
+	{
+		//the faces of all the dirty chunks are found at once, each chunk only writes its own lists
+		MyJobSystem::GetInstance()->ParallelFor(m_buildList.size(), 1, [this](uint a_uBegin, uint a_uEnd, uint a_uThread)
+		{
+			for (uint i = a_uBegin; i < a_uEnd; ++i)
+			{
+				BuildMesh(m_buildList[i]);
+			}
+		});
+
+		//and compiled together by the render thread between frames
+		MyRenderThread::GetInstance()->Invoke([this]()
+		{
+			for (uint i = 0; i < m_buildList.size(); ++i)
+			{
+				Upload(m_buildList[i]);
+			}
+		});
+
+		//the culler reads the new vertices the next time the meshes are drawn, the chunks hide what is behind them
+		MyOcclusionCuller* pCuller = pRenderQueue->GetOcclusionCuller();
+		for (uint i = 0; i < m_buildList.size(); ++i)
+		{
+			MyVoxelChunk* pChunk = m_buildList[i];
+			for (uint j = 0; j < pChunk->m_meshList.size(); ++j)
+			{
+				MyVoxelMesh& mesh = pChunk->m_meshList[j];
+				m_uQuadCount -= mesh.m_uVertexCount / 6;
+				mesh.m_uVertexCount = mesh.m_positionList.size();
+				m_uQuadCount += mesh.m_uVertexCount / 6;
+				if (mesh.m_nMesh >= 0)
+				{
+					pRenderQueue->AddOccluder(mesh.m_nMesh);
+					pCuller->ForgetMesh(mesh.m_nMesh);
+				}
+				//the lists keep their memory for the next time the chunk changes
+				mesh.m_positionList.clear();
+				mesh.m_normalList.clear();
+				mesh.m_uvList.clear();
+				mesh.m_colorList.clear();
+			}
+			pChunk->m_bDirty = false;
+		}
+		m_uBuildCount = m_buildList.size();
+	}
+
+	//vertices are in world space, the chunks are drawn with the identity
+	for (uint i = 0; i < m_visibleList.size(); ++i)
+	{
+		MyVoxelChunk* pChunk = m_visibleList[i];
+		bool bDrawn = false;
+		for (uint j = 0; j < pChunk->m_meshList.size(); ++j)
+		{
+			MyVoxelMesh& mesh = pChunk->m_meshList[j];
+			if (mesh.m_nMesh < 0 || mesh.m_uVertexCount == 0)
+				continue;
+			pBuffer->Push(mesh.m_nMesh, RENDER_SOLID, IDENTITY_M4);
+			bDrawn = true;
+		}
+		if (bDrawn)
+			++m_uDrawnCount;
+	}
+}
\ No newline at end of file
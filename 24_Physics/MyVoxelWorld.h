@@ -0,0 +1,240 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYVOXELWORLD_H_
+#define __MYVOXELWORLD_H_
+
+#include "MyRenderQueue.h"
+
+namespace Simplex
+{
+
+//Look of a kind of block, the faces of neighboring blocks of the same kind are merged
+struct MyBlockType
+{
+	int m_nMaterial = 0; //material of the faces, its texture is repeated once per block
+	vector3 m_v3Color = vector3(1.0f); //color of the vertices
+};
+
+//Mesh of the faces of one material in a chunk, the lists are filled by the job system before the upload
+struct MyVoxelMesh
+{
+	int m_nMaterial = 0; //material of the faces
+	int m_nMesh = -1; //index of the mesh in the MeshManager, -1 until the first upload
+	uint m_uVertexCount = 0; //vertices of the last upload (nothing is drawn if 0)
+	std::vector<vector3> m_positionList; //vertices waiting for the upload, in world space
+	std::vector<vector3> m_normalList;
+	std::vector<vector3> m_uvList;
+	std::vector<vector3> m_colorList;
+};
+
+//Cube of blocks of the world, only the chunks with blocks are stored
+struct MyVoxelChunk
+{
+	static const int m_nSize = 16; //blocks along each side
+
+	glm::ivec3 m_v3Coord = glm::ivec3(0); //position in chunks, the first block is at m_v3Coord * m_nSize
+	uint8_t m_block[m_nSize * m_nSize * m_nSize]; //kind of each block, 0 is air (x changes first, then y, then z)
+	uint m_uBlockCount = 0; //blocks that are not air
+	bool m_bDirty = true; //did a block (or one of a neighbor touching it) change since the last mesh?
+	std::vector<MyVoxelMesh> m_meshList; //one mesh per material found in the chunk
+};
+
+//System Class, a world of blocks stored by kind in chunks of 16x16x16. Each chunk is drawn with one mesh per
+//material: only the faces between a block and air are kept and neighboring faces of the same kind are merged
+//into larger quads (greedy meshing). The chunks are meshed on the job system when they change and the blocks
+//have no rigid bodies, the collisions are answered by looking at the grid
+class MyVoxelWorld
+{
+	std::vector<MyBlockType> m_typeList; //kinds of block, the first one is air
+	std::vector<MyVoxelChunk*> m_chunkList; //chunks with blocks (or that had them)
+	std::map<uint64_t, uint> m_chunkMap; //index of each chunk by its position
+
+	std::vector<MyVoxelChunk*> m_visibleList; //chunks inside the frustum this frame
+	std::vector<MyVoxelChunk*> m_buildList; //chunks meshed this frame
+	uint m_uDrawnCount = 0; //chunks drawn on the last call
+	uint m_uBuildCount = 0; //chunks meshed on the last call
+	uint m_uQuadCount = 0; //quads of all the chunk meshes
+
+	MeshManager* m_pMeshMngr = nullptr; //Mesh Manager singleton
+	static MyVoxelWorld* m_pInstance; // Singleton pointer
+public:
+	/*
+	Usage: Gets the singleton pointer
+	Arguments: ---
+	Output: singleton pointer
+	*/
+	static MyVoxelWorld* GetInstance();
+	/*
+	Usage: Releases the content of the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	static void ReleaseInstance(void);
+	/*
+	USAGE: Adds a kind of block
+	ARGUMENTS:
+	-	int a_nMaterial -> material of its faces, its texture is repeated once per block
+	-	vector3 a_v3Color = vector3(1.0f) -> color of its vertices
+	OUTPUT: kind of block to set, 0 if there are already 255
+	*/
+	uint8_t AddBlockType(int a_nMaterial, vector3 a_v3Color = vector3(1.0f));
+	/*
+	USAGE: Sets the kind of a block, the chunks that see it are meshed again the next time they are drawn
+	ARGUMENTS:
+	-	glm::ivec3 a_v3Block -> position of the block (it covers from there to the next integer)
+	-	uint8_t a_uType -> kind of block, 0 for air
+	OUTPUT: ---
+	*/
+	void SetBlock(glm::ivec3 a_v3Block, uint8_t a_uType);
+	/*
+	USAGE: Sets the kind of all the blocks of a box
+	ARGUMENTS:
+	-	glm::ivec3 a_v3Min -> first block of the box
+	-	glm::ivec3 a_v3Max -> last block of the box (included)
+	-	uint8_t a_uType -> kind of block, 0 for air
+	OUTPUT: ---
+	*/
+	void Fill(glm::ivec3 a_v3Min, glm::ivec3 a_v3Max, uint8_t a_uType);
+	/*
+	USAGE: Gets the kind of a block
+	ARGUMENTS: glm::ivec3 a_v3Block -> position of the block
+	OUTPUT: kind of block, 0 for air (and for the blocks of chunks that do not exist)
+	*/
+	uint8_t GetBlock(glm::ivec3 a_v3Block);
+	/*
+	USAGE: Asks if a point is inside a block
+	ARGUMENTS: vector3 a_v3Position -> point in world space
+	OUTPUT: is it solid?
+	*/
+	bool IsSolid(vector3 a_v3Position);
+	/*
+	USAGE: Moves a box through the blocks one axis at a time (y first), stopping it against the faces it hits
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum of the box before moving, in world space
+	-	vector3 a_v3Max -> maximum of the box before moving, in world space
+	-	vector3 a_v3Move -> movement wanted
+	-	glm::bvec3& a_bHit -> for each axis, did the box hit a block?
+	OUTPUT: movement allowed
+	*/
+	vector3 MoveBox(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Move, glm::bvec3& a_bHit);
+	/*
+	USAGE: Records a command for each chunk mesh inside the frustum of the render queue camera, meshing the
+	dirty ones first on the job system; needs to be called from the simulation thread, the meshes are compiled
+	by the render thread
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void AddToRenderList(void);
+	/*
+	USAGE: Gets the number of chunks
+	ARGUMENTS: ---
+	OUTPUT: chunk count
+	*/
+	uint GetChunkCount(void);
+	/*
+	USAGE: Gets the number of blocks that are not air
+	ARGUMENTS: ---
+	OUTPUT: block count
+	*/
+	uint GetBlockCount(void);
+	/*
+	USAGE: Gets the number of chunks drawn by the last call to AddToRenderList
+	ARGUMENTS: ---
+	OUTPUT: drawn count
+	*/
+	uint GetDrawnCount(void);
+	/*
+	USAGE: Gets the number of chunks meshed by the last call to AddToRenderList
+	ARGUMENTS: ---
+	OUTPUT: build count
+	*/
+	uint GetBuildCount(void);
+	/*
+	USAGE: Gets the number of quads of all the chunk meshes
+	ARGUMENTS: ---
+	OUTPUT: quad count
+	*/
+	uint GetQuadCount(void);
+private:
+	/*
+	Usage: constructor
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyVoxelWorld(void);
+	/*
+	Usage: copy constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyVoxelWorld(MyVoxelWorld const& other);
+	/*
+	Usage: copy assignment operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyVoxelWorld& operator=(MyVoxelWorld const& other);
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyVoxelWorld(void);
+	/*
+	Usage: releases the chunks, their meshes belong to the MeshManager
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: initializes the singleton
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	USAGE: Packs the position of a chunk in a key of the map
+	ARGUMENTS: glm::ivec3 a_v3Coord -> position in chunks
+	OUTPUT: key
+	*/
+	static uint64_t GetKey(glm::ivec3 a_v3Coord);
+	/*
+	USAGE: Gets the chunk at a position
+	ARGUMENTS:
+	-	glm::ivec3 a_v3Coord -> position in chunks
+	-	bool a_bCreate -> is it created if it does not exist?
+	OUTPUT: chunk, nullptr if it does not exist and was not created
+	*/
+	MyVoxelChunk* GetChunk(glm::ivec3 a_v3Coord, bool a_bCreate);
+	/*
+	USAGE: Marks the chunk at a position as dirty if it exists
+	ARGUMENTS: glm::ivec3 a_v3Coord -> position in chunks
+	OUTPUT: ---
+	*/
+	void MarkDirty(glm::ivec3 a_v3Coord);
+	/*
+	USAGE: Fills the vertex lists of the meshes of a chunk with its visible faces, merging the faces of the same
+	kind of block; it only reads the blocks so many chunks can be meshed at once
+	ARGUMENTS: MyVoxelChunk* a_pChunk -> chunk to mesh
+	OUTPUT: ---
+	*/
+	void BuildMesh(MyVoxelChunk* a_pChunk);
+	/*
+	USAGE: Compiles the vertex lists of the meshes of a chunk (or swaps them under the mesh being drawn)
+	ARGUMENTS: MyVoxelChunk* a_pChunk -> chunk to upload
+	OUTPUT: ---
+	*/
+	void Upload(MyVoxelChunk* a_pChunk);
+};
+
+} //namespace Simplex
+
+#endif //__MYVOXELWORLD_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
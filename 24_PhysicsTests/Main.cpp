@@ -0,0 +1,33 @@
+// Include standard headers
+#include "Main.h"
+
+int main(void)
+{
+	using namespace Simplex;
+	//tests of the 24_Physics classes, they print their timings so the numbers quoted for them can be checked
+	struct MyTestEntry { const char* m_sName; MyTest m_test; };
+	MyTestEntry testList[] =
+	{
+		{ "GJK warm start", TestGJKWarmStart },
+		{ "Occlusion culler", TestOcclusionCuller },
+		{ "Animation clip", TestAnimationClip },
+		{ "Pose cache", TestPoseCache },
+		{ "Light clusters", TestLightClusters },
+		{ "Particle system", TestParticleSystem },
+	};
+
+	uint uFailed = 0;
+	uint uCount = sizeof(testList) / sizeof(testList[0]);
+	for (uint i = 0; i < uCount; ++i)
+	{
+		printf("%s\n", testList[i].m_sName);
+		bool bPassed = testList[i].m_test();
+		printf("%s\n\n", bPassed ? "PASS" : "FAIL");
+		if (!bPassed)
+			++uFailed;
+	}
+	printf("%u of %u tests passed\n", uCount - uFailed, uCount);
+
+	ReleaseContext();
+	return uFailed;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "MyTests.h"
+#include "MyEntityManager.h"
+#include "MyRenderThread.h"
+using namespace Simplex;
+//hidden window that owns the context of the tests that need one
+static sf::Window* pWindow = nullptr;
+bool Simplex::Check(bool a_bCondition, String a_sMessage)
+{
+	if (!a_bCondition)
+		printf("\tfailed: %s\n", a_sMessage.c_str());
+	return a_bCondition;
+}
+bool Simplex::InitContext(void)
+{
+	if (pWindow != nullptr)
+		return true;
+
+	//same context the application asks for, the window is never shown
+	pWindow = new sf::Window(sf::VideoMode(64, 64, 32), "24_PhysicsTests", sf::Style::None,
+		sf::ContextSettings(24, 0, 0, 4, 5, 0, false));
+	pWindow->setVisible(false);
+
+	glewExperimental = true;
+	if (glewInit() != GLEW_OK)
+	{
+		fprintf(stderr, "Failed to initialize GLEW\n");
+		SafeDelete(pWindow);
+		return false;
+	}
+	return true;
+}
+void Simplex::ReleaseContext(void)
+{
+	//same order as the application
+	MyEntityManager::ReleaseInstance();
+	MySolverPool::ReleaseInstance();
+	MyTransformSystem::ReleaseInstance();
+	MyArchetypeStore::ReleaseInstance();
+	MyRenderQueue::ReleaseInstance();
+	MyLightClusters::ReleaseInstance();
+	MyParticleSystem::ReleaseInstance();
+	MyJobSystem::ReleaseInstance();
+	MyRenderThread::ReleaseInstance();
+	if (pWindow != nullptr)
+		ReleaseAllSingletons();
+	SafeDelete(pWindow);
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+/*----------------------------------------------
+Programmer: agent (agent@local)
+Date: 2026/10
+----------------------------------------------*/
+#ifndef __MYTESTS_H_
+#define __MYTESTS_H_
+
+#include "Simplex\Simplex.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace Simplex
+{
+
+//A test of the runner, it prints what it measured and tells if it passed
+typedef bool(*MyTest)(void);
+
+/*
+USAGE: Prints a check of a test that failed
+ARGUMENTS:
+-	bool a_bCondition -> what the test expects
+-	String a_sMessage -> printed if it does not hold
+OUTPUT: the condition
+*/
+bool Check(bool a_bCondition, String a_sMessage);
+/*
+USAGE: Creates an OpenGL context in a hidden window for the tests that need one (rigid bodies make
+their wire shapes when created), the first call creates it and the others reuse it
+ARGUMENTS: ---
+OUTPUT: is there a context?
+*/
+bool InitContext(void);
+/*
+USAGE: Releases the singletons the tests used and the context if there is one
+ARGUMENTS: ---
+OUTPUT: ---
+*/
+void ReleaseContext(void);
+
+/*
+USAGE: Intersects random box and convex hull pairs with GJK against a brute force SAT and counts the
+support points evaluated from an empty simplex, from the simplex of the last test and from it after a
+small motion
+ARGUMENTS: ---
+OUTPUT: did it pass?
+*/
+bool TestGJKWarmStart(void);
+/*
+USAGE: Culls boxes with a wall in front of the camera, only the box right behind it is hidden
+ARGUMENTS: ---
+OUTPUT: did it pass?
+*/
+bool TestOcclusionCuller(void);
+/*
+USAGE: Compresses a clip of 20 tracks and 600 frames, compares its size with the baked frames and its
+poses with the ones interpolated from the frames
+ARGUMENTS: ---
+OUTPUT: did it pass?
+*/
+bool TestAnimationClip(void);
+/*
+USAGE: Samples 5000 instances of a clip playing 350 different frames with and without the pose cache
+and checks each instance gets the pose of its frame
+ARGUMENTS: ---
+OUTPUT: did it pass?
+*/
+bool TestPoseCache(void);
+/*
+USAGE: Bins known lights and checks the clusters they land in, then checks random lights are in the
+clusters of the points they reach and times the binning of 1024 and 2048 lights
+ARGUMENTS: ---
+OUTPUT: did it pass?
+*/
+bool TestLightClusters(void);
+/*
+USAGE: Updates a million particles for two seconds, prints the average milliseconds of an update and
+checks none were lost or went through the ground
+ARGUMENTS: ---
+OUTPUT: did it pass?
+*/
+bool TestParticleSystem(void);
+
+} //namespace Simplex
+
+#endif //__MYTESTS_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
\ No newline at end of file
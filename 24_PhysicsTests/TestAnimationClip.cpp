@@ -0,0 +1,81 @@
+#include "MyTests.h"
+#include "MyAnimationClip.h"
+using namespace Simplex;
+//frames of the test clip before compression
+struct MyTestTrack
+{
+	int m_nParent = -1;
+	vector3 m_v3Pivot = ZERO_V3;
+	std::vector<vector3> m_translationList;
+	std::vector<vector3> m_rotationList;
+	std::vector<vector3> m_scaleList;
+};
+//model matrix of a track at a fractional frame interpolated from the uncompressed frames
+static matrix4 SampleFrames(std::vector<MyTestTrack> const& a_trackList, uint a_uTrack, float a_fFrame)
+{
+	MyTestTrack const& track = a_trackList[a_uTrack];
+	uint uFrame = static_cast<uint>(a_fFrame);
+	uint uNext = (std::min)(uFrame + 1, static_cast<uint>(track.m_translationList.size()) - 1);
+	float fAlpha = a_fFrame - uFrame;
+
+	vector3 v3Translation = glm::mix(track.m_translationList[uFrame], track.m_translationList[uNext], fAlpha);
+	vector3 v3Scale = glm::mix(track.m_scaleList[uFrame], track.m_scaleList[uNext], fAlpha);
+	quaternion qFrom = quaternion(glm::radians(track.m_rotationList[uFrame]));
+	quaternion qTo = quaternion(glm::radians(track.m_rotationList[uNext]));
+	if (glm::dot(qFrom, qTo) < 0.0f)
+		qTo = -qTo;
+	quaternion qRotation = glm::normalize(qFrom * (1.0f - fAlpha) + qTo * fAlpha);
+
+	matrix4 m4Local = glm::translate(v3Translation + track.m_v3Pivot) * glm::mat4_cast(qRotation) *
+		glm::scale(v3Scale) * glm::translate(-track.m_v3Pivot);
+	if (track.m_nParent < 0)
+		return m4Local;
+	return SampleFrames(a_trackList, track.m_nParent, a_fFrame) * m4Local;
+}
+bool Simplex::TestAnimationClip(void)
+{
+	//20 tracks in a tree, 600 frames of swinging and turning with some tracks still
+	const uint uTrackCount = 20;
+	const uint uFrameCount = 600;
+	MyAnimationClip clip(0.001f, 0.001f, 0.001f);
+	std::vector<MyTestTrack> trackList(uTrackCount);
+	bool bPassed = true;
+	for (uint i = 0; i < uTrackCount; ++i)
+	{
+		MyTestTrack& track = trackList[i];
+		track.m_nParent = i == 0 ? -1 : static_cast<int>(i / 2);
+		track.m_v3Pivot = vector3(0.0f, i * 0.1f, 0.0f);
+		for (uint f = 0; f < uFrameCount; ++f)
+		{
+			float fTime = f / 30.0f;
+			track.m_translationList.push_back(i % 3 == 0 ? vector3(0.0f, 0.5f * sinf(fTime + i), 0.0f) : vector3(0.0f, 1.0f, 0.0f));
+			track.m_rotationList.push_back(vector3(30.0f * sinf(fTime * (1 + i % 4)), i % 2 ? 0.0f : 270.0f * f / uFrameCount, 0.0f));
+			track.m_scaleList.push_back(vector3(1.0f));
+		}
+		int nTrack = clip.AddTrack("track" + std::to_string(i), track.m_nParent, track.m_v3Pivot, std::vector<uint>(),
+			track.m_translationList, track.m_rotationList, track.m_scaleList);
+		bPassed = Check(nTrack == static_cast<int>(i), "track " + std::to_string(i) + " was not added") && bPassed;
+	}
+	printf("\t%u tracks, %u frames: %u keys of %u, %.1f KB against %.1f KB baked\n", uTrackCount, uFrameCount,
+		clip.GetKeyCount(), uTrackCount * uFrameCount * 3, clip.GetMemoryUsage() / 1024.0f, clip.GetBakedMemoryUsage() / 1024.0f);
+
+	//the sampled poses stay close to the frames they were compressed from, between frames too
+	std::vector<matrix4> poseList(uTrackCount);
+	float fError = 0.0f;
+	for (float fFrame = 0.0f; fFrame < uFrameCount - 1; fFrame += 0.37f)
+	{
+		clip.Sample(fFrame, poseList.data());
+		for (uint i = 0; i < uTrackCount; ++i)
+		{
+			matrix4 m4Expected = SampleFrames(trackList, i, fFrame);
+			for (uint c = 0; c < 4; ++c)
+				for (uint r = 0; r < 4; ++r)
+					fError = (std::max)(fError, fabs(m4Expected[c][r] - poseList[i][c][r]));
+		}
+	}
+	printf("\tlargest error of a pose matrix element %f\n", fError);
+
+	bPassed = Check(clip.GetMemoryUsage() * 10 < clip.GetBakedMemoryUsage(), "the clip is not a tenth of the baked frames") && bPassed;
+	bPassed = Check(fError < 0.02f, "the sampled poses are off the frames") && bPassed;
+	return bPassed;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "MyTests.h"
+#include "MyGJK.h"
+using namespace Simplex;
+//random orientation of a box or hull of the test, glm::rotate takes degrees
+static matrix4 RandomRotation(std::mt19937& a_rng)
+{
+	std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	vector3 v3Axis = vector3(unit(a_rng), unit(a_rng), unit(a_rng)) + vector3(0.01f);
+	return glm::rotate(IDENTITY_M4, angle(a_rng), glm::normalize(v3Axis));
+}
+bool Simplex::TestGJKWarmStart(void)
+{
+	if (!Check(InitContext(), "no OpenGL context for the rigid bodies"))
+		return false;
+
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	//a box of half size 1 and a hull of the same box with points inside it that Quickhull drops
+	std::vector<vector3> cornerList;
+	for (uint i = 0; i < 8; ++i)
+		cornerList.push_back(vector3(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f));
+	std::vector<vector3> pointList = cornerList;
+	for (uint i = 0; i < 200; ++i)
+		pointList.push_back(vector3(unit(rng), unit(rng), unit(rng)));
+	MyConvexHull hull(pointList);
+	MyRigidBody rigidBodyA(cornerList);
+	MyRigidBody rigidBodyB(cornerList);
+
+	const uint uTests = 200000;
+	uint uMismatch = 0;
+	uint uBadDepth = 0;
+	uint uColdCount = 0;
+	uint uWarmCount = 0;
+	uint uMovingCount = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint t = 0; t < uTests; ++t)
+	{
+		matrix4 m4A = glm::translate(vector3(2.0f * unit(rng), 2.0f * unit(rng), 2.0f * unit(rng))) * RandomRotation(rng);
+		matrix4 m4B = RandomRotation(rng);
+		rigidBodyA.SetModelMatrix(m4A);
+		rigidBodyB.SetModelMatrix(m4B);
+		rigidBodyA.SetConvexHull(t & 1 ? &hull : nullptr);
+
+		//brute force SAT over the 15 axes of the two boxes, minimum overlap on the axes if they intersect
+		vector3 v3Corner[2][8];
+		vector3 v3Axis[15];
+		for (uint i = 0; i < 8; ++i)
+		{
+			v3Corner[0][i] = vector3(m4A * vector4(cornerList[i], 1.0f));
+			v3Corner[1][i] = vector3(m4B * vector4(cornerList[i], 1.0f));
+		}
+		for (uint i = 0; i < 3; ++i)
+		{
+			v3Axis[i] = vector3(m4A[i]);
+			v3Axis[3 + i] = vector3(m4B[i]);
+			for (uint j = 0; j < 3; ++j)
+				v3Axis[6 + i * 3 + j] = glm::cross(vector3(m4A[i]), vector3(m4B[j]));
+		}
+		bool bSeparated = false;
+		float fOverlap = FLT_MAX;
+		for (uint k = 0; k < 15 && !bSeparated; ++k)
+		{
+			if (glm::length(v3Axis[k]) < 0.0001f)
+				continue;
+			vector3 v3Normal = glm::normalize(v3Axis[k]);
+			float fMin[2] = { FLT_MAX, FLT_MAX };
+			float fMax[2] = { -FLT_MAX, -FLT_MAX };
+			for (uint s = 0; s < 2; ++s)
+			{
+				for (uint i = 0; i < 8; ++i)
+				{
+					float fProjection = glm::dot(v3Corner[s][i], v3Normal);
+					fMin[s] = (std::min)(fMin[s], fProjection);
+					fMax[s] = (std::max)(fMax[s], fProjection);
+				}
+			}
+			bSeparated = fMax[0] < fMin[1] || fMax[1] < fMin[0];
+			fOverlap = (std::min)(fOverlap, (std::min)(fMax[0] - fMin[1], fMax[1] - fMin[0]));
+		}
+
+		//the first test starts empty, the second one from its simplex as the next frame of a resting pair
+		MySimplexCache cache;
+		uint uCold = 0;
+		uint uWarm = 0;
+		bool bIntersect = MyGJK::Intersect(&rigidBodyA, &rigidBodyB, cache, uCold);
+		MySimplexCache warmCache = cache;
+		MyGJK::Intersect(&rigidBodyA, &rigidBodyB, warmCache, uWarm);
+		uColdCount += uCold;
+		uWarmCount += uWarm;
+
+		//and the next frame of a pair that moved a little (a hundredth of a unit and a degree), the box is
+		//put back for the checks below
+		uint uMoving = 0;
+		MySimplexCache movingCache = cache;
+		rigidBodyA.SetModelMatrix(glm::translate(vector3(0.01f * unit(rng), 0.01f * unit(rng), 0.01f * unit(rng))) * m4A *
+			glm::rotate(IDENTITY_M4, 1.0f, AXIS_Y));
+		MyGJK::Intersect(&rigidBodyA, &rigidBodyB, movingCache, uMoving);
+		rigidBodyA.SetModelMatrix(m4A);
+		uMovingCount += uMoving;
+
+		//boxes barely touching or barely apart can go either way
+		if (bIntersect == bSeparated && fabs(fOverlap) > 0.001f)
+			++uMismatch;
+		if (bIntersect && !bSeparated)
+		{
+			MyContact contact;
+			MyGJK::Penetration(&rigidBodyA, &rigidBodyB, cache, contact);
+			if (fabs(contact.m_fDepth - fOverlap) > 0.01f * (std::max)(1.0f, fOverlap))
+				++uBadDepth;
+		}
+	}
+	float fTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	float fCold = uColdCount / static_cast<float>(uTests);
+	float fWarm = uWarmCount / static_cast<float>(uTests);
+	float fMoving = uMovingCount / static_cast<float>(uTests);
+	printf("\t%u pairs, support points per pair: %.2f from an empty simplex, %.2f from the last one, %.2f from the last one after moving (%.1f ms)\n",
+		uTests, fCold, fWarm, fMoving, fTime);
+
+	bool bPassed = Check(uMismatch == 0, std::to_string(uMismatch) + " pairs disagree with SAT");
+	bPassed = Check(uBadDepth == 0, std::to_string(uBadDepth) + " EPA depths off the SAT overlap") && bPassed;
+	bPassed = Check(fWarm < fCold, "the cached simplex does not save support points") && bPassed;
+	return bPassed;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "MyTests.h"
+#include "MyLightClusters.h"
+using namespace Simplex;
+//is the light in the list of the cluster? (false for positions outside the clusters)
+static bool IsInCluster(MyLightClusters* a_pClusters, int a_nCluster, uint a_uLight)
+{
+	if (a_nCluster < 0)
+		return false;
+	MyLightCluster cluster = a_pClusters->GetCluster(a_nCluster);
+	std::vector<uint16_t> const& indexList = a_pClusters->GetIndexList();
+	for (uint i = cluster.m_uOffset; i < cluster.m_uOffset + cluster.m_uCount; ++i)
+	{
+		if (indexList[i] == a_uLight)
+			return true;
+	}
+	return false;
+}
+//adds lights at random in a box of 80 x 6 x 80 around the origin
+static void AddRandomLights(MyLightClusters* a_pClusters, uint a_uCount, std::mt19937& a_rng)
+{
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	for (uint i = 0; i < a_uCount; ++i)
+		a_pClusters->AddLight(vector3(unit(a_rng) * 40.0f, unit(a_rng) * 3.0f + 1.0f, unit(a_rng) * 40.0f), vector3(1.0f, 0.5f, 0.2f), 0.1f);
+}
+bool Simplex::TestLightClusters(void)
+{
+	MyLightClusters* pClusters = MyLightClusters::GetInstance();
+	pClusters->ClearLights();
+	matrix4 m4Projection = glm::perspective(45.0f, 16.0f / 9.0f, 0.01f, 1000.0f);
+	bool bPassed = true;
+
+	//lights of radius 1 (intensity at the cutoff) in front, far, behind and beside the camera
+	pClusters->SetGrid(16, 9, 24);
+	pClusters->SetCutoff(0.02f);
+	uint uCenter = pClusters->AddLight(ZERO_V3, vector3(1.0f), 0.02f);
+	uint uFar = pClusters->AddLight(vector3(0.0f, 0.0f, -80.0f), vector3(1.0f), 0.02f);
+	uint uBehind = pClusters->AddLight(vector3(0.0f, 0.0f, 30.0f), vector3(1.0f), 0.02f);
+	uint uBeside = pClusters->AddLight(vector3(-200.0f, 0.0f, 0.0f), vector3(1.0f), 0.02f);
+	pClusters->Bin(glm::lookAt(vector3(0.0f, 0.0f, 20.0f), ZERO_V3, AXIS_Y), m4Projection);
+
+	//the center of the screen is tile 8 of 16 across and 4 of 9 down
+	int nCenter = pClusters->FindCluster(ZERO_V3);
+	int nFar = pClusters->FindCluster(vector3(0.0f, 0.0f, -80.0f));
+	int nAside = pClusters->FindCluster(vector3(5.0f, 0.0f, 0.0f));
+	bPassed = Check(nCenter >= 0 && nCenter % 16 == 8 && nCenter / 16 % 9 == 4, "the origin is not in the center tile") && bPassed;
+	bPassed = Check(nFar >= 0 && nFar / (16 * 9) > nCenter / (16 * 9), "the far light is not in a farther slice") && bPassed;
+	bPassed = Check(IsInCluster(pClusters, nCenter, uCenter) && !IsInCluster(pClusters, nCenter, uFar), "wrong lights in the center cluster") && bPassed;
+	bPassed = Check(IsInCluster(pClusters, nFar, uFar) && !IsInCluster(pClusters, nFar, uCenter), "wrong lights in the far cluster") && bPassed;
+	bPassed = Check(nAside >= 0 && !IsInCluster(pClusters, nAside, uCenter), "the center light reaches a cluster 5 units away") && bPassed;
+	std::vector<uint16_t> const& indexList = pClusters->GetIndexList();
+	bPassed = Check(std::find(indexList.begin(), indexList.end(), uBehind) == indexList.end(), "the light behind the camera was binned") && bPassed;
+	bPassed = Check(std::find(indexList.begin(), indexList.end(), uBeside) == indexList.end(), "the light outside the frustum was binned") && bPassed;
+
+	//random lights, every light reaching a point has to be in the cluster of the point
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	matrix4 m4View = glm::lookAt(vector3(0.0f, 5.0f, 25.0f), ZERO_V3, AXIS_Y);
+	pClusters->ClearLights();
+	AddRandomLights(pClusters, 2048, rng);
+	pClusters->Bin(m4View, m4Projection);
+	uint uMissing = 0;
+	uint uTested = 0;
+	for (uint t = 0; t < 20000; ++t)
+	{
+		vector3 v3Point = vector3(unit(rng) * 40.0f, unit(rng) * 3.0f + 1.0f, unit(rng) * 40.0f);
+		int nCluster = pClusters->FindCluster(v3Point);
+		if (nCluster < 0)
+			continue;
+		++uTested;
+		for (uint i = 0; i < pClusters->GetLightCount(); ++i)
+		{
+			MyPointLight* pLight = pClusters->GetLight(i);
+			if (glm::distance(pLight->m_v3Position, v3Point) < pLight->m_fRadius && !IsInCluster(pClusters, nCluster, i))
+				++uMissing;
+		}
+	}
+	printf("\t%u points in the clusters, %u lights missing from their cluster\n", uTested, uMissing);
+	bPassed = Check(uTested > 0 && uMissing == 0, "lights are missing from the clusters they reach") && bPassed;
+
+	//best binning time of a few runs, the index list is already allocated
+	uint uCount[2] = { 1024, 2048 };
+	for (uint c = 0; c < 2; ++c)
+	{
+		pClusters->ClearLights();
+		AddRandomLights(pClusters, uCount[c], rng);
+		pClusters->Bin(m4View, m4Projection);
+		float fBest = FLT_MAX;
+		for (uint i = 0; i < 20; ++i)
+		{
+			pClusters->Bin(m4View, m4Projection);
+			fBest = (std::min)(fBest, pClusters->GetBinTime());
+		}
+		printf("\t%u lights binned in %.2f ms (%u entries, %u threads)\n", uCount[c], fBest,
+			static_cast<uint>(pClusters->GetIndexList().size()), MyJobSystem::GetInstance()->GetThreadCount());
+	}
+	pClusters->ClearLights();
+	return bPassed;
+}
\ No newline at end of file
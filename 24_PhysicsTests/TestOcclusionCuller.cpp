@@ -0,0 +1,79 @@
+#include "MyTests.h"
+#include "MyRenderQueue.h"
+using namespace Simplex;
+//triangles of a unit cube centered in the origin, counter clockwise seen from outside
+static std::vector<vector3> CubeTriangles(void)
+{
+	static const uint uQuad[6][4] = { { 0, 2, 3, 1 },{ 4, 5, 7, 6 },{ 0, 1, 5, 4 },{ 2, 6, 7, 3 },{ 0, 4, 6, 2 },{ 1, 3, 7, 5 } };
+	vector3 v3Corner[8];
+	for (uint i = 0; i < 8; ++i)
+		v3Corner[i] = vector3(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f);
+	std::vector<vector3> triangleList;
+	for (uint i = 0; i < 6; ++i)
+	{
+		triangleList.push_back(v3Corner[uQuad[i][0]]);
+		triangleList.push_back(v3Corner[uQuad[i][1]]);
+		triangleList.push_back(v3Corner[uQuad[i][2]]);
+		triangleList.push_back(v3Corner[uQuad[i][0]]);
+		triangleList.push_back(v3Corner[uQuad[i][2]]);
+		triangleList.push_back(v3Corner[uQuad[i][3]]);
+	}
+	return triangleList;
+}
+//is the command placed at the position among the visible ones?
+static bool IsKept(MyRenderCommand const* a_pCommand, uint a_uCount, vector3 a_v3Position)
+{
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		if (vector3(a_pCommand[i].m_m4ToWorld[3]) == a_v3Position)
+			return true;
+	}
+	return false;
+}
+bool Simplex::TestOcclusionCuller(void)
+{
+	//a wall that hides everything right behind it, the boxes use a mesh that is not an occluder
+	MyOcclusionCuller culler;
+	std::vector<vector3> cubeList = CubeTriangles();
+	culler.SetMesh(0, cubeList, true);
+	culler.SetMesh(1, cubeList, false);
+
+	vector3 v3Wall = ZERO_V3;
+	vector3 v3Behind = vector3(0.0f, 0.0f, -5.0f);
+	vector3 v3Side = vector3(10.0f, 0.0f, -5.0f);
+	vector3 v3Front = vector3(0.0f, 0.0f, 5.0f);
+	MyRenderCommand commandList[4] =
+	{
+		{ 0, RENDER_SOLID, glm::translate(v3Wall) * glm::scale(vector3(8.0f, 6.0f, 0.5f)) },
+		{ 1, RENDER_SOLID, glm::translate(v3Behind) },
+		{ 1, RENDER_SOLID, glm::translate(v3Side) },
+		{ 1, RENDER_SOLID, glm::translate(v3Front) },
+	};
+	matrix4 m4View = glm::lookAt(vector3(0.0f, 0.0f, 15.0f), ZERO_V3, AXIS_Y);
+	matrix4 m4Projection = glm::perspective(45.0f, 16.0f / 9.0f, 0.01f, 1000.0f);
+
+	MyRenderCommand cullList[4];
+	std::copy(commandList, commandList + 4, cullList);
+	uint uVisible = culler.Cull(cullList, 4, m4Projection * m4View);
+	printf("\t%u of 4 commands visible, %u occluders, %u triangles\n", uVisible, culler.GetOccluderCount(), culler.GetTriangleCount());
+
+	bool bPassed = Check(uVisible == 3 && culler.GetOccludedCount() == 1, "only the box behind the wall should be culled");
+	bPassed = Check(!IsKept(cullList, uVisible, v3Behind), "the box behind the wall is visible") && bPassed;
+	bPassed = Check(IsKept(cullList, uVisible, v3Wall), "the wall was culled") && bPassed;
+	bPassed = Check(IsKept(cullList, uVisible, v3Side), "the box off to the side was culled") && bPassed;
+	bPassed = Check(IsKept(cullList, uVisible, v3Front), "the box in front of the wall was culled") && bPassed;
+	bPassed = Check(culler.IsOccluded(vector3(-0.5f), vector3(0.5f), glm::translate(v3Behind)), "IsOccluded misses the box behind the wall") && bPassed;
+	bPassed = Check(!culler.IsOccluded(vector3(-0.5f), vector3(0.5f), glm::translate(v3Side)), "IsOccluded hides the box off to the side") && bPassed;
+
+	//seen from the other side the box that was in front is the hidden one
+	std::copy(commandList, commandList + 4, cullList);
+	uVisible = culler.Cull(cullList, 4, m4Projection * glm::lookAt(vector3(0.0f, 0.0f, -30.0f), ZERO_V3, AXIS_Y));
+	bPassed = Check(uVisible == 3 && !IsKept(cullList, uVisible, v3Front), "seen from the other side the wall does not hide the box behind it") && bPassed;
+
+	//and a disabled culler keeps everything
+	culler.SetEnabled(false);
+	std::copy(commandList, commandList + 4, cullList);
+	uVisible = culler.Cull(cullList, 4, m4Projection * m4View);
+	bPassed = Check(uVisible == 4, "the disabled culler removed commands") && bPassed;
+	return bPassed;
+}
\ No newline at end of file
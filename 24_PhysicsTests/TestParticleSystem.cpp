@@ -0,0 +1,46 @@
+#include "MyTests.h"
+#include "MyParticleSystem.h"
+using namespace Simplex;
+bool Simplex::TestParticleSystem(void)
+{
+	//a million particles that live longer than the test, thrown up from one unit above the ground
+	MyParticleSystem* pParticles = MyParticleSystem::GetInstance();
+	MyParticleEmitter emitter;
+	emitter.m_v3Position = vector3(0.0f, 1.0f, 0.0f);
+	emitter.m_fRadius = 0.5f;
+	emitter.m_v3Velocity = vector3(0.0f, 4.0f, 0.0f);
+	emitter.m_fSpread = 3.0f;
+	emitter.m_fLife = 100.0f;
+	emitter.m_fDrag = 0.1f;
+	emitter.m_v4ColorStart = vector4(1.0f, 0.8f, 0.2f, 1.0f);
+	emitter.m_v4ColorEnd = vector4(1.0f, 0.0f, 0.0f, 0.0f);
+	emitter.m_fSizeStart = 0.1f;
+	emitter.m_fSizeEnd = 0.02f;
+	uint uEmitter = pParticles->AddEmitter(emitter);
+	const uint uCount = 1000000;
+	pParticles->Burst(uEmitter, uCount);
+
+	//two seconds at 60 frames per second, the time is averaged after the first second
+	const uint uFrameCount = 120;
+	float fTotal = 0.0f;
+	for (uint i = 0; i < uFrameCount; ++i)
+	{
+		pParticles->Update(1.0f / 60.0f);
+		if (i >= uFrameCount / 2)
+			fTotal += pParticles->GetUpdateTime();
+	}
+	printf("\t%u particles updated in %.2f ms per frame (%s, %u threads)\n", pParticles->GetParticleCount(), fTotal / (uFrameCount / 2),
+		pParticles->IsUsingAVX2() ? "AVX2" : "SSE", MyJobSystem::GetInstance()->GetThreadCount());
+
+	//none died, none went through the ground
+	std::vector<MyParticleInstance> particleList;
+	pParticles->Publish(particleList);
+	float fLowest = FLT_MAX;
+	for (uint i = 0; i < particleList.size(); ++i)
+		fLowest = (std::min)(fLowest, particleList[i].m_v3Position.y);
+	bool bPassed = Check(pParticles->GetParticleCount() == uCount && particleList.size() == uCount, "particles were lost");
+	bPassed = Check(fLowest >= 0.0f, "particles went through the ground") && bPassed;
+
+	MyParticleSystem::ReleaseInstance();
+	return bPassed;
+}
\ No newline at end of file
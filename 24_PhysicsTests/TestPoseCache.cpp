@@ -0,0 +1,78 @@
+#include "MyTests.h"
+#include "MyPoseCache.h"
+#include <set>
+using namespace Simplex;
+//milliseconds an update of the instances takes, averaged over a few after a first one that allocates
+template <typename Update>
+static float TimeUpdate(Update a_update)
+{
+	a_update();
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint i = 0; i < 10; ++i)
+		a_update();
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / 10.0f;
+}
+bool Simplex::TestPoseCache(void)
+{
+	//a chain of 20 tracks over 600 frames
+	const uint uTrackCount = 20;
+	const uint uFrameCount = 600;
+	MyAnimationClip clip;
+	for (uint i = 0; i < uTrackCount; ++i)
+	{
+		std::vector<vector3> translationList, rotationList, scaleList;
+		for (uint f = 0; f < uFrameCount; ++f)
+		{
+			translationList.push_back(vector3(0.0f, sinf(f * 0.1f + i), 0.0f));
+			rotationList.push_back(vector3(30.0f * sinf(f * 0.05f), 0.0f, 0.0f));
+			scaleList.push_back(vector3(1.0f));
+		}
+		clip.AddTrack("track" + std::to_string(i), static_cast<int>(i) - 1, ZERO_V3, std::vector<uint>(), translationList, rotationList, scaleList);
+	}
+
+	//5000 instances on 50 frames of the clip, each one seven ways a hundredth of a frame apart
+	std::vector<MyAnimationInstance> instanceList(5000);
+	std::vector<MyAnimationInstance*> pointerList;
+	for (uint i = 0; i < instanceList.size(); ++i)
+	{
+		instanceList[i].m_pClip = &clip;
+		instanceList[i].m_fFrame = (i % 50) * 3.3f + (i % 7) * 0.01f;
+		pointerList.push_back(&instanceList[i]);
+	}
+	uint uCount = static_cast<uint>(pointerList.size());
+
+	float fUncached = TimeUpdate([&]() { MyAnimationClip::SampleBatch(pointerList.data(), uCount); });
+	printf("\t%u instances, %u tracks: %.2f ms sampled one by one\n", uCount, uTrackCount, fUncached);
+
+	//exact frames and frames snapped to half a frame
+	bool bPassed = true;
+	float fQuantization[2] = { 0.0f, 0.5f };
+	std::vector<matrix4> poseList(uTrackCount);
+	for (uint q = 0; q < 2; ++q)
+	{
+		MyPoseCache cache(fQuantization[q]);
+		float fCached = TimeUpdate([&]() { cache.Update(pointerList.data(), uCount); });
+		printf("\tquantization %.1f: %u poses, %.0f%% hits, %.2f ms\n", fQuantization[q], cache.GetPoseCount(), cache.GetHitRate() * 100.0f, fCached);
+
+		//each instance points to the pose of its (snapped) frame
+		float fError = 0.0f;
+		std::set<float> frameSet;
+		for (uint i = 0; i < uCount; ++i)
+		{
+			float fFrame = instanceList[i].m_fFrame;
+			if (fQuantization[q] > 0.0f)
+				fFrame = floorf(fFrame / fQuantization[q] + 0.5f) * fQuantization[q];
+			frameSet.insert(fFrame);
+			if (i % 37 != 0)
+				continue;
+			clip.Sample(fFrame, poseList.data());
+			for (uint t = 0; t < uTrackCount; ++t)
+				for (uint c = 0; c < 4; ++c)
+					for (uint r = 0; r < 4; ++r)
+						fError = (std::max)(fError, fabs(poseList[t][c][r] - instanceList[i].m_pPose[t][c][r]));
+		}
+		bPassed = Check(fError < 0.0001f, "instances point to the wrong poses") && bPassed;
+		bPassed = Check(cache.GetPoseCount() == frameSet.size(), "instances on the same frame did not share a pose") && bPassed;
+	}
+	return bPassed;
+}
\ No newline at end of file
@@ -13,6 +13,16 @@ uniform float LightPower;
 
 uniform vec3 CameraPosition;
 
+//Clustered point lights, binned on the CPU (nClusterLights is 0 when there are none)
+uniform int nClusterLights = 0;
+uniform ivec3 ClusterGrid;
+uniform vec4 ClusterScreen; //origin of the viewport and size of a tile in pixels
+uniform vec2 ClusterDepth; //depth the slices start at and slices per unit of log(depth / start)
+uniform mat4 ClusterView;
+uniform samplerBuffer LightData; //position and radius, color times intensity
+uniform usamplerBuffer ClusterData; //first index and count of each cluster
+uniform usamplerBuffer ClusterIndex; //lights of all the clusters
+
 in vec3 Position_W;
 in vec3 Normal_W;
 in vec3 Tangent_W;
@@ -97,6 +107,33 @@ vec4 ComputeSpecularLight(vec3 Normal)
 	vec3 Computation = LightColor * LightPower * pow(SpecularFactor, 5) * attenuationFactor;
 	return vec4(Computation, 1);
 }
+void ComputeClusteredLights(vec3 Normal, inout vec4 Diffuse, inout vec4 Specular)
+{
+	float depth = max(-(ClusterView * vec4(Position_W, 1)).z, 0.0001);
+	ivec3 cluster;
+	cluster.xy = clamp(ivec2((gl_FragCoord.xy - ClusterScreen.xy) / ClusterScreen.zw), ivec2(0), ClusterGrid.xy - 1);
+	cluster.z = clamp(int(floor(log(depth / ClusterDepth.x) * ClusterDepth.y)), 0, ClusterGrid.z - 1);
+	uvec2 range = texelFetch(ClusterData, (cluster.z * ClusterGrid.y + cluster.y) * ClusterGrid.x + cluster.x).xy;
+
+	vec3 VertexToEye = normalize(CameraPosition - Position_W);
+	for(uint i = 0u; i < range.y; ++i)
+	{
+		int light = int(texelFetch(ClusterIndex, int(range.x + i)).x);
+		vec4 PositionRadius = texelFetch(LightData, light * 2);
+		vec3 Power = texelFetch(LightData, light * 2 + 1).rgb;
+
+		//same falloff as the main light, windowed so it reaches zero at the radius
+		vec3 Direction = PositionRadius.xyz - Position_W;
+		float distance = length(Direction);
+		float window = clamp(1.0 - pow(distance / PositionRadius.w, 4.0), 0.0, 1.0);
+		float attenuation = window * window / max(distance * distance, 0.01);
+		Direction = Direction / max(distance, 0.0001);
+
+		Diffuse.rgb += Power * clamp(dot(Normal, Direction), 0.0, 1.0) * attenuation;
+		float SpecularFactor = clamp(dot(VertexToEye, reflect(-Direction, Normal)), 0, 1);
+		Specular.rgb += Power * pow(SpecularFactor, 5) * attenuation;
+	}
+}
 void main()
 {
 	if(ComputeDiffuseAndAmbient() == false)
@@ -108,9 +145,13 @@ void main()
 	vec3 Normal = ComputeNormal();
 
 	vec4 Diffuse = ComputeDiffuseLight(Normal);
-	MaterialDiffuseColor = MaterialDiffuseColor * Diffuse;
-	
 	vec4 Specular = ComputeSpecularLight(Normal);
+	if(nClusterLights > 0)
+	{
+		ComputeClusteredLights(Normal, Diffuse, Specular);
+	}
+
+	MaterialDiffuseColor = MaterialDiffuseColor * Diffuse;
 	MaterialSpecularColor = MaterialSpecularColor * Specular;
 
 	Fragment = MaterialAmbientColor + MaterialSpecularColor + MaterialDiffuseColor;
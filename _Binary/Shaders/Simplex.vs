@@ -19,14 +19,23 @@ out vec3 Color;
 
 void main()
 {
+	//the last row of the matrix carries the rectangle of the texture in an atlas page:
+	//offset (x, y), scale minus one (z) and scale (w), (0, 0, 0, 1) leaves the UVs as they are
+	mat4 ToWorld = m4ToWorld[gl_InstanceID];
+	vec4 AtlasRect = vec4(ToWorld[0][3], ToWorld[1][3], ToWorld[2][3] + 1.0, ToWorld[3][3]);
+	ToWorld[0][3] = 0.0;
+	ToWorld[1][3] = 0.0;
+	ToWorld[2][3] = 0.0;
+	ToWorld[3][3] = 1.0;
+
 	//gl_InstanceID
-	gl_Position = (VP * m4ToWorld[gl_InstanceID]) * vec4(Position_b, 1);
+	gl_Position = (VP * ToWorld) * vec4(Position_b, 1);
 	
-	UV = UV_b.xy;
+	UV = UV_b.xy * AtlasRect.zw + AtlasRect.xy;
 	Color = Color_b;
 
-	Position_W =	(m4ToWorld[gl_InstanceID] * vec4(Position_b,1)).xyz;
-	Normal_W =		(m4ToWorld[gl_InstanceID] * vec4(Normal_b,0)).xyz;
-	Tangent_W =		(m4ToWorld[gl_InstanceID] * vec4(Tangent_b, 0.0)).xyz;
-	Binormal_W =	(m4ToWorld[gl_InstanceID] * vec4(Binormal_b, 0.0)).xyz;
+	Position_W =	(ToWorld * vec4(Position_b,1)).xyz;
+	Normal_W =		(ToWorld * vec4(Normal_b,0)).xyz;
+	Tangent_W =		(ToWorld * vec4(Tangent_b, 0.0)).xyz;
+	Binormal_W =	(ToWorld * vec4(Binormal_b, 0.0)).xyz;
 }
\ No newline at end of file